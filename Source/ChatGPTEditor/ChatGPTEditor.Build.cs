@@ -28,6 +28,8 @@ public class ChatGPTEditor : ModuleRules
 				"HTTP",
 				"Json",
 				"JsonUtilities",
+				"Sockets",
+				"Networking",
 				"BlueprintGraph",
 				"Kismet",
 				"KismetCompiler",
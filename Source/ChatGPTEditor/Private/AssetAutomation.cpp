@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AssetAutomation.h"
+#include "AuditLogger.h"
 #include "Misc/MessageDialog.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -278,34 +279,19 @@ bool FAssetAutomation::ShowConfirmationDialog(const FAssetOperation& Operation)
 
 void FAssetAutomation::WriteAuditLog(const FAssetAuditLogEntry& Entry)
 {
-	FString AuditLogPath = GetAuditLogPath();
-	
-	// Create directory if it doesn't exist
-	FString LogDir = FPaths::GetPath(AuditLogPath);
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*LogDir))
-	{
-		PlatformFile.CreateDirectoryTree(*LogDir);
-	}
-	
-	// Format log entry
-	FString LogEntry = FString::Printf(
-		TEXT("[%s] User: %s | Operation: %s | Asset: %s | Success: %s | Details: %s\n"),
-		*Entry.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M:%S")),
-		*Entry.User,
-		*Entry.Operation,
-		*Entry.AssetName,
-		Entry.bSucceeded ? TEXT("YES") : TEXT("NO"),
-		*Entry.Details
-	);
-	
-	// Append to log file
-	FFileHelper::SaveStringToFile(LogEntry, *AuditLogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	FAuditEvent Event(EAuditSource::Asset, TEXT("ASSET_OPERATION"));
+	Event.Timestamp = Entry.Timestamp;
+	Event.Add(TEXT("User"), Entry.User)
+		.Add(TEXT("Operation"), Entry.Operation)
+		.Add(TEXT("Asset"), Entry.AssetName)
+		.AddBool(TEXT("Success"), Entry.bSucceeded)
+		.Add(TEXT("Details"), Entry.Details);
+	FAuditLogger::Get().Submit(MoveTemp(Event));
 }
 
 FString FAssetAutomation::GetAuditLogPath()
 {
-	return FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
+	return FAuditLogger::Get().GetAuditLogPath();
 }
 
 bool FAssetAutomation::CreateMaterial(const FAssetOperation& Operation)
@@ -109,7 +109,7 @@ public:
 	static bool ShowConfirmationDialog(const FAssetOperation& Operation);
 
 	/**
-	 * Write an entry to the audit log
+	 * Write an entry to the audit log, through FAuditLogger
 	 * @param Entry The audit log entry to write
 	 */
 	static void WriteAuditLog(const FAssetAuditLogEntry& Entry);
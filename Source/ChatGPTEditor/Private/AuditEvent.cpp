@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AuditEvent.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+const TCHAR* LexToString(EAuditSource Source)
+{
+	switch (Source)
+	{
+		case EAuditSource::Editor: return TEXT("Editor");
+		case EAuditSource::SceneEdit: return TEXT("SceneEdit");
+		case EAuditSource::Asset: return TEXT("Asset");
+		case EAuditSource::Test: return TEXT("Test");
+		case EAuditSource::Blueprint: return TEXT("Blueprint");
+		case EAuditSource::Console: return TEXT("Console");
+		case EAuditSource::Python: return TEXT("Python");
+		case EAuditSource::MCP: return TEXT("MCP");
+	}
+	return TEXT("Unknown");
+}
+
+FAuditEvent::FAuditEvent(EAuditSource InSource, FName InType)
+	: Timestamp(FDateTime::Now())
+	, Source(InSource)
+	, Type(InType)
+{
+}
+
+FAuditEvent& FAuditEvent::Add(const TCHAR* Key, FString Value) &
+{
+	check(Key);
+	Fields.Add(FAuditField{ Key, MoveTemp(Value) });
+	return *this;
+}
+
+FAuditEvent& FAuditEvent::AddBool(const TCHAR* Key, bool bValue) &
+{
+	return Add(Key, bValue ? TEXT("YES") : TEXT("NO"));
+}
+
+FAuditEvent& FAuditEvent::AddMessage(FString Message) &
+{
+	Fields.Add(FAuditField{ nullptr, MoveTemp(Message) });
+	return *this;
+}
+
+void FAuditEvent::AppendLine(FString& Out) const
+{
+	Out.Appendf(TEXT("[%04d-%02d-%02d %02d:%02d:%02d] "),
+		Timestamp.GetYear(), Timestamp.GetMonth(), Timestamp.GetDay(),
+		Timestamp.GetHour(), Timestamp.GetMinute(), Timestamp.GetSecond());
+	Type.AppendString(Out);
+
+	// The plain message reads first wherever it was added
+	for (const FAuditField& Field : Fields)
+	{
+		if (!Field.Key)
+		{
+			Out += TEXT(" | ");
+			Out += Field.Value;
+		}
+	}
+
+	for (const FAuditField& Field : Fields)
+	{
+		if (Field.Key)
+		{
+			Out += TEXT(" | ");
+			Out += Field.Key;
+			Out += TEXT(": ");
+			Out += Field.Value;
+		}
+	}
+
+	Out += TEXT("\n");
+}
+
+void FAuditEvent::AppendJsonLine(FString& Out) const
+{
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+
+	// Local time without a zone, as audit/query reports it
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("time"), Timestamp.ToString(TEXT("%Y-%m-%dT%H:%M:%S.%s")));
+	Writer->WriteValue(TEXT("source"), LexToString(Source));
+	Writer->WriteValue(TEXT("type"), Type.ToString());
+
+	const FString* Message = nullptr;
+	Writer->WriteArrayStart(TEXT("fields"));
+	for (const FAuditField& Field : Fields)
+	{
+		if (!Field.Key)
+		{
+			Message = Message ? Message : &Field.Value;
+			continue;
+		}
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("key"), Field.Key);
+		Writer->WriteValue(TEXT("value"), Field.Value);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	if (Message)
+	{
+		Writer->WriteValue(TEXT("message"), *Message);
+	}
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	Out += Line;
+	Out += TEXT("\n");
+}
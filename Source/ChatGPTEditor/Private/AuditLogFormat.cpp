@@ -0,0 +1,410 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AuditLogFormat.h"
+#include "ChatGPTEditor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Compression.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+
+namespace
+{
+	/** Bounds-checked little-endian reads over a record; once anything runs past the end, every later read fails too */
+	struct FRecordCursor
+	{
+		const uint8* Pos;
+		const uint8* End;
+		bool bOk = true;
+
+		template <typename T>
+		T Read()
+		{
+			T Value{};
+			if (bOk && End - Pos >= static_cast<int64>(sizeof(T)))
+			{
+				FMemory::Memcpy(&Value, Pos, sizeof(T));
+				Pos += sizeof(T);
+			}
+			else
+			{
+				bOk = false;
+			}
+			return Value;
+		}
+
+		/** A uint32 byte length and UTF-8, into a string whose buffer is reused */
+		void ReadString(FString& Out)
+		{
+			const uint32 Length = Read<uint32>();
+			Out.Reset();
+			if (!bOk || static_cast<uint64>(End - Pos) < Length)
+			{
+				bOk = false;
+				return;
+			}
+
+			if (Length > 0)
+			{
+				FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Pos), Length);
+				Out.Append(Converted.Get(), Converted.Length());
+				Pos += Length;
+			}
+		}
+	};
+
+	template <typename ArrayType, typename T>
+	void AppendValue(ArrayType& Out, T Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+}
+
+bool AuditLogFormat::CompressSegment(const FString& Path, FName Format)
+{
+	TArray64<uint8> Raw;
+	if (!FFileHelper::LoadFileToArray(Raw, *Path))
+		return false;
+
+	// FCompression works on int32 sizes; segments rotate long before that
+	if (Raw.Num() > MAX_int32)
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Audit segment is too large to compress: %s"), *Path);
+		return false;
+	}
+
+	const FTCHARToUTF8 FormatName(*Format.ToString());
+	TArray64<uint8> Out;
+	AppendValue(Out, CompressedMagic);
+	AppendValue(Out, Version);
+	AppendValue(Out, static_cast<uint32>(FormatName.Length()));
+	Out.Append(reinterpret_cast<const uint8*>(FormatName.Get()), FormatName.Length());
+	AppendValue(Out, static_cast<int64>(Raw.Num()));
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(Format, static_cast<int32>(Raw.Num()));
+	const int64 DataStart = Out.Num() + sizeof(int64);
+	Out.SetNumUninitialized(DataStart + CompressedSize);
+	if (!FCompression::CompressMemory(Format, Out.GetData() + DataStart, CompressedSize, Raw.GetData(), static_cast<int32>(Raw.Num())))
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Failed to compress audit segment with %s: %s"), *Format.ToString(), *Path);
+		return false;
+	}
+	const int64 StoredSize = CompressedSize;
+	FMemory::Memcpy(Out.GetData() + DataStart - sizeof(int64), &StoredSize, sizeof(int64));
+	Out.SetNum(DataStart + CompressedSize);
+
+	const FString CompressedPath = FPaths::ChangeExtension(Path, CompressedExtension);
+	const FString TempPath = CompressedPath + TEXT(".tmp");
+	IFileManager& FileManager = IFileManager::Get();
+	{
+		TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*TempPath));
+		if (!Writer)
+			return false;
+
+		Writer->Serialize(Out.GetData(), Out.Num());
+		if (!Writer->Close() || Writer->IsError())
+		{
+			Writer.Reset();
+			FileManager.Delete(*TempPath, false, false, true);
+			return false;
+		}
+	}
+
+	if (!FileManager.Move(*CompressedPath, *TempPath))
+	{
+		FileManager.Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	// Readers prefer the .audz, which would hide everything still to be appended to the segment
+	if (!FileManager.Delete(*Path, false, false, true))
+	{
+		FileManager.Delete(*CompressedPath, false, false, true);
+		return false;
+	}
+	return true;
+}
+
+bool AuditLogFormat::DecompressSegment(const uint8* Data, int64 Size, TArray64<uint8>& OutSegment, FString& OutError)
+{
+	FRecordCursor Cursor{ Data, Data + Size };
+	const uint32 Magic = Cursor.Read<uint32>();
+	const uint32 FileVersion = Cursor.Read<uint32>();
+	FString FormatName;
+	Cursor.ReadString(FormatName);
+	const int64 UncompressedSize = Cursor.Read<int64>();
+	const int64 CompressedSize = Cursor.Read<int64>();
+	if (!Cursor.bOk || Magic != CompressedMagic || FileVersion != Version
+		|| UncompressedSize < 0 || UncompressedSize > MAX_int32 || CompressedSize < 0 || CompressedSize > Cursor.End - Cursor.Pos)
+	{
+		OutError = TEXT("Not a compressed audit segment");
+		return false;
+	}
+
+	OutSegment.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(FName(*FormatName), OutSegment.GetData(), static_cast<int32>(UncompressedSize), Cursor.Pos, static_cast<int32>(CompressedSize)))
+	{
+		OutError = FString::Printf(TEXT("Can't decompress it with %s"), *FormatName);
+		return false;
+	}
+	return true;
+}
+
+bool AuditLogFormat::HasSegmentHeader(const uint8* Data, int64 Size)
+{
+	FRecordCursor Header{ Data, Data + Size };
+	const uint32 Magic = Header.Read<uint32>();
+	const uint32 FileVersion = Header.Read<uint32>();
+	return Header.bOk && Magic == SegmentMagic && FileVersion == Version;
+}
+
+FAuditSegmentView::FAuditSegmentView()
+{
+}
+
+FAuditSegmentView::~FAuditSegmentView()
+{
+	Close();
+}
+
+bool FAuditSegmentView::Open(const FString& Path)
+{
+	Close();
+
+	// Shared for writing and deleting, so neither the writer nor the compressor is held up by a reader
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult Mapped = PlatformFile.OpenMappedEx(*Path, EOpenReadFlags::AllowWrite | EOpenReadFlags::AllowDelete);
+	if (Mapped.HasValue())
+	{
+		MappedFile = Mapped.StealValue();
+		if (MappedFile->GetFileSize() > 0)
+		{
+			MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		}
+		if (MappedRegion)
+		{
+			Data = MappedRegion->GetMappedPtr();
+			Size = MappedRegion->GetMappedSize();
+			return true;
+		}
+		MappedFile.Reset();
+	}
+
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenRead(*Path, true));
+	if (!File)
+		return false;
+
+	Buffer.SetNumUninitialized(File->Size());
+	if (!File->Read(Buffer.GetData(), Buffer.Num()))
+	{
+		Buffer.Reset();
+		return false;
+	}
+
+	Data = Buffer.GetData();
+	Size = Buffer.Num();
+	return true;
+}
+
+void FAuditSegmentView::Close()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Buffer.Reset();
+	Data = nullptr;
+	Size = 0;
+}
+
+void FAuditRecordDecoder::Reset()
+{
+	Types.Reset();
+	Keys.Reset();
+}
+
+bool FAuditRecordDecoder::DecodeNext(const uint8* Data, int64 Size, int64& Offset, bool& bOutEvent)
+{
+	using namespace AuditLogFormat;
+
+	bOutEvent = false;
+	if (Size - Offset < static_cast<int64>(sizeof(uint32)))
+		return false;
+
+	uint32 RecordSize = 0;
+	FMemory::Memcpy(&RecordSize, Data + Offset, sizeof(uint32));
+	if (Size - Offset - static_cast<int64>(sizeof(uint32)) < RecordSize)
+		return false;
+
+	FRecordCursor Cursor{ Data + Offset + sizeof(uint32), Data + Offset + sizeof(uint32) + RecordSize };
+	Offset += sizeof(uint32) + RecordSize;
+
+	switch (static_cast<ERecordKind>(Cursor.Read<uint8>()))
+	{
+		case ERecordKind::DefineType:
+		{
+			// Already known when decoding was seeded with the segment's definitions
+			const uint16 Id = Cursor.Read<uint16>();
+			if (Id == Types.Num())
+			{
+				FString Name;
+				Cursor.ReadString(Name);
+				if (Cursor.bOk)
+				{
+					Types.Add(FName(*Name));
+				}
+			}
+			break;
+		}
+
+		case ERecordKind::DefineKey:
+		{
+			const uint16 Id = Cursor.Read<uint16>();
+			if (Id == Keys.Num())
+			{
+				FString Name;
+				Cursor.ReadString(Name);
+				if (Cursor.bOk)
+				{
+					Keys.Add(MoveTemp(Name));
+				}
+			}
+			break;
+		}
+
+		case ERecordKind::Event:
+		{
+			Event.Timestamp = FDateTime(Cursor.Read<int64>());
+			Event.Source = static_cast<EAuditSource>(Cursor.Read<uint8>());
+			const uint16 TypeId = Cursor.Read<uint16>();
+			const int32 NumFields = Cursor.Read<uint8>();
+			Event.Type = Types.IsValidIndex(TypeId) ? Types[TypeId] : NAME_None;
+
+			// Keep the field strings' buffers from event to event
+			Event.Fields.SetNum(NumFields, EAllowShrinking::No);
+			for (FAuditField& Field : Event.Fields)
+			{
+				const uint16 KeyId = Cursor.Read<uint16>();
+				Field.Key = KeyId == MessageKeyId ? nullptr : Keys.IsValidIndex(KeyId) ? *Keys[KeyId] : TEXT("?");
+				Cursor.ReadString(Field.Value);
+			}
+			bOutEvent = Cursor.bOk;
+			break;
+		}
+
+		default:
+			// Written by a newer version; its length lets it be skipped
+			break;
+	}
+	return true;
+}
+
+TArray<FString> FAuditLogReader::FindSegments(const FString& Directory)
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, TEXT("*.aud*")), true, false);
+
+	// A segment caught between compression and deletion is read from its compressed copy
+	TMap<FString, FString> SegmentsByName;
+	for (const FString& File : Files)
+	{
+		const bool bCompressed = File.EndsWith(AuditLogFormat::CompressedExtension);
+		if (!bCompressed && !File.EndsWith(AuditLogFormat::SegmentExtension))
+			continue;
+
+		FString& Existing = SegmentsByName.FindOrAdd(FPaths::GetBaseFilename(File));
+		if (Existing.IsEmpty() || bCompressed)
+		{
+			Existing = File;
+		}
+	}
+
+	SegmentsByName.KeySort(TLess<FString>());
+
+	TArray<FString> Segments;
+	Segments.Reserve(SegmentsByName.Num());
+	for (const TPair<FString, FString>& Pair : SegmentsByName)
+	{
+		Segments.Add(FPaths::Combine(Directory, Pair.Value));
+	}
+	return Segments;
+}
+
+bool FAuditLogReader::ReadSegment(const FString& Path, TFunctionRef<bool(const FAuditEvent&)> Visitor, FString& OutError)
+{
+	if (!LoadSegment(Path, OutError))
+		return false;
+
+	DecodeRecords(Visitor);
+	return true;
+}
+
+int64 FAuditLogReader::ReadDirectory(const FString& Directory, TFunctionRef<bool(const FAuditEvent&)> Visitor)
+{
+	int64 NumVisited = 0;
+	for (const FString& Path : FindSegments(Directory))
+	{
+		FString Error;
+		if (!LoadSegment(Path, Error))
+		{
+			UE_LOG(LogChatGPTEditor, Warning, TEXT("Skipping audit segment %s: %s"), *Path, *Error);
+			continue;
+		}
+
+		const bool bContinue = DecodeRecords([&Visitor, &NumVisited](const FAuditEvent& Event)
+		{
+			++NumVisited;
+			return Visitor(Event);
+		});
+		if (!bContinue)
+			break;
+	}
+	return NumVisited;
+}
+
+bool FAuditLogReader::LoadSegment(const FString& Path, FString& OutError)
+{
+	SegmentData = nullptr;
+	SegmentSize = 0;
+	if (!View.Open(Path))
+	{
+		OutError = TEXT("Can't read the file");
+		return false;
+	}
+
+	if (Path.EndsWith(AuditLogFormat::CompressedExtension))
+	{
+		const bool bDecompressed = AuditLogFormat::DecompressSegment(View.GetData(), View.GetSize(), Decompressed, OutError);
+		View.Close();
+		if (!bDecompressed)
+			return false;
+
+		SegmentData = Decompressed.GetData();
+		SegmentSize = Decompressed.Num();
+	}
+	else
+	{
+		SegmentData = View.GetData();
+		SegmentSize = View.GetSize();
+	}
+
+	if (!AuditLogFormat::HasSegmentHeader(SegmentData, SegmentSize))
+	{
+		OutError = TEXT("Not an audit segment");
+		return false;
+	}
+	return true;
+}
+
+bool FAuditLogReader::DecodeRecords(TFunctionRef<bool(const FAuditEvent&)> Visitor)
+{
+	Decoder.Reset();
+
+	int64 Offset = AuditLogFormat::HeaderSize;
+	bool bEvent = false;
+	while (Decoder.DecodeNext(SegmentData, SegmentSize, Offset, bEvent))
+	{
+		if (bEvent && !Visitor(Decoder.Event))
+			return false;
+	}
+	return true;
+}
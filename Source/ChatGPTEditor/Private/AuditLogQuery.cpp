@@ -0,0 +1,722 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AuditLogQuery.h"
+#include "AuditLogger.h"
+#include "ChatGPTEditor.h"
+#include "Algo/AllOf.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Hash/CityHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 IndexMagic = 0x58445541; // "AUDX"
+	constexpr uint32 IndexVersion = 1;
+
+	/** Bloom filter probes and bits per name: about a 1% false positive rate */
+	constexpr int32 NumBloomProbes = 7;
+	constexpr int32 BloomBitsPerName = 10;
+
+	enum class ENameKind : uint8
+	{
+		Actor = 1,
+		Asset,
+		Tool
+	};
+
+	uint64 HashName(ENameKind Kind, FStringView Name)
+	{
+		TStringBuilder<128> Lower;
+		for (TCHAR Char : Name)
+		{
+			Lower.AppendChar(FChar::ToLower(Char));
+		}
+		return CityHash64WithSeed(reinterpret_cast<const char*>(Lower.GetData()), Lower.Len() * sizeof(TCHAR), static_cast<uint64>(Kind));
+	}
+
+	/** The names an event carries: scene edits list their actors in Affected, and the rest name one asset or tool */
+	template <typename CallbackType>
+	void ForEachName(const FAuditEvent& Event, CallbackType&& Callback)
+	{
+		for (const FAuditField& Field : Event.Fields)
+		{
+			if (!Field.Key)
+				continue;
+
+			if (FCString::Strcmp(Field.Key, TEXT("Affected")) == 0 || FCString::Strcmp(Field.Key, TEXT("Actor")) == 0)
+			{
+				FStringView Remaining(Field.Value);
+				while (!Remaining.IsEmpty())
+				{
+					int32 Comma = INDEX_NONE;
+					const FStringView Name = Remaining.FindChar(TEXT(','), Comma) ? Remaining.Left(Comma) : Remaining;
+					Remaining.RightChopInline(Comma == INDEX_NONE ? Remaining.Len() : Comma + 1);
+
+					const FStringView Trimmed = Name.TrimStartAndEnd();
+					if (!Trimmed.IsEmpty())
+					{
+						Callback(ENameKind::Actor, Trimmed);
+					}
+				}
+			}
+			else if (FCString::Strcmp(Field.Key, TEXT("Asset")) == 0)
+			{
+				Callback(ENameKind::Asset, FStringView(Field.Value));
+			}
+			else if (FCString::Strcmp(Field.Key, TEXT("Tool")) == 0)
+			{
+				Callback(ENameKind::Tool, FStringView(Field.Value));
+			}
+		}
+	}
+
+	bool HasName(const FAuditEvent& Event, ENameKind Kind, const FString& Name)
+	{
+		bool bFound = false;
+		ForEachName(Event, [Kind, &Name, &bFound](ENameKind NameKind, FStringView EventName)
+		{
+			bFound |= NameKind == Kind && EventName.Equals(Name, ESearchCase::IgnoreCase);
+		});
+		return bFound;
+	}
+
+	/** Split a search box into terms at whitespace outside quotes, dropping the quotes */
+	TArray<FString> SplitTerms(const FString& Text)
+	{
+		TArray<FString> Terms;
+		FString Term;
+		bool bQuoted = false;
+		for (TCHAR Char : Text)
+		{
+			if (Char == TEXT('"'))
+			{
+				bQuoted = !bQuoted;
+			}
+			else if (!bQuoted && FChar::IsWhitespace(Char))
+			{
+				if (!Term.IsEmpty())
+				{
+					Terms.Add(MoveTemp(Term));
+					Term.Reset();
+				}
+			}
+			else
+			{
+				Term.AppendChar(Char);
+			}
+		}
+		if (!Term.IsEmpty())
+		{
+			Terms.Add(MoveTemp(Term));
+		}
+		return Terms;
+	}
+}
+
+struct FAuditLogQueryEngine::FSegmentIndex
+{
+	/** The time span of EventsPerBlock events, from the offset of the first */
+	struct FBlock
+	{
+		int64 Offset = 0;
+		int64 MinTicks = 0;
+		int64 MaxTicks = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FBlock& Block)
+		{
+			return Ar << Block.Offset << Block.MinTicks << Block.MaxTicks;
+		}
+	};
+
+	FString Name;
+	FString Path;
+	bool bCompressed = false;
+
+	/** Compressed and indexed to the end, so it never needs looking at again */
+	bool bComplete = false;
+
+	/** Size of the file when it was last indexed, and the offset just past the last whole record indexed */
+	int64 FileSize = 0;
+	int64 IndexedEnd = 0;
+
+	int64 NumEvents = 0;
+	int64 MinTicks = MAX_int64;
+	int64 MaxTicks = MIN_int64;
+
+	/** The segment's definitions, which seed decoding from any block */
+	TArray<FName> Types;
+	TArray<FString> Keys;
+
+	TArray<FBlock> Blocks;
+
+	/** Hashes of the names its events carry, exact until the segment is complete and they are folded into Bloom */
+	TSet<uint64> NameHashes;
+	TArray<uint64> Bloom;
+
+	bool MayContain(uint64 Hash) const
+	{
+		if (Bloom.Num() == 0)
+			return NameHashes.Contains(Hash);
+
+		const uint64 NumBits = static_cast<uint64>(Bloom.Num()) * 64;
+		const uint64 Step = (Hash >> 32) | 1;
+		for (int32 Probe = 0; Probe < NumBloomProbes; ++Probe)
+		{
+			const uint64 Bit = (Hash + Probe * Step) & (NumBits - 1);
+			if (!(Bloom[Bit / 64] & (uint64(1) << (Bit % 64))))
+				return false;
+		}
+		return true;
+	}
+
+	void BuildBloom()
+	{
+		const uint64 NumBits = FMath::RoundUpToPowerOfTwo64(FMath::Max<uint64>(64, static_cast<uint64>(NameHashes.Num()) * BloomBitsPerName));
+		Bloom.SetNumZeroed(static_cast<int32>(NumBits / 64));
+		for (uint64 Hash : NameHashes)
+		{
+			const uint64 Step = (Hash >> 32) | 1;
+			for (int32 Probe = 0; Probe < NumBloomProbes; ++Probe)
+			{
+				const uint64 Bit = (Hash + Probe * Step) & (NumBits - 1);
+				Bloom[Bit / 64] |= uint64(1) << (Bit % 64);
+			}
+		}
+		NameHashes.Empty();
+	}
+
+	bool HasAnyType(const TArray<FName>& QueryTypes) const
+	{
+		for (FName Type : QueryTypes)
+		{
+			if (Types.Contains(Type))
+				return true;
+		}
+		return false;
+	}
+
+	void Serialize(FArchive& Ar)
+	{
+		Ar << FileSize << IndexedEnd << NumEvents << MinTicks << MaxTicks;
+		Ar << Types << Keys << Blocks << Bloom;
+	}
+};
+
+bool FAuditQuery::Parse(const FString& Text, FAuditQuery& OutQuery, FString& OutError)
+{
+	OutQuery = FAuditQuery();
+	for (const FString& Term : SplitTerms(Text))
+	{
+		FString Key;
+		FString Value;
+		if (!Term.Split(TEXT(":"), &Key, &Value) || Key.IsEmpty() || Value.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("Expected key:value, got '%s'"), *Term);
+			return false;
+		}
+
+		if (Key.Equals(TEXT("type"), ESearchCase::IgnoreCase))
+		{
+			TArray<FString> Types;
+			Value.ParseIntoArray(Types, TEXT(","));
+			for (const FString& Type : Types)
+			{
+				OutQuery.Types.Add(FName(*Type.TrimStartAndEnd()));
+			}
+		}
+		else if (Key.Equals(TEXT("actor"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.Actor = Value;
+		}
+		else if (Key.Equals(TEXT("asset"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.Asset = Value;
+		}
+		else if (Key.Equals(TEXT("tool"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.Tool = Value;
+		}
+		else if (Key.Equals(TEXT("since"), ESearchCase::IgnoreCase))
+		{
+			const TCHAR Unit = FChar::ToLower(Value[Value.Len() - 1]);
+			const double UnitSeconds = Unit == TEXT('s') ? 1.0 : Unit == TEXT('m') ? 60.0 : Unit == TEXT('h') ? 3600.0 : Unit == TEXT('d') ? 86400.0 : 0.0;
+			double Amount = 0.0;
+			if (UnitSeconds == 0.0 || !LexTryParseString(Amount, *Value.LeftChop(1)) || Amount < 0.0)
+			{
+				OutError = FString::Printf(TEXT("Expected a duration such as 30m, 24h or 7d, got '%s'"), *Value);
+				return false;
+			}
+			OutQuery.From = FDateTime::Now() - FTimespan::FromSeconds(Amount * UnitSeconds);
+		}
+		else if (Key.Equals(TEXT("from"), ESearchCase::IgnoreCase) || Key.Equals(TEXT("to"), ESearchCase::IgnoreCase))
+		{
+			FDateTime& Date = Key.Equals(TEXT("from"), ESearchCase::IgnoreCase) ? OutQuery.From : OutQuery.To;
+			if (!ParseLocalDate(Value, Date))
+			{
+				OutError = FString::Printf(TEXT("Expected a local date such as 2024-10-27 or 2024-10-27T10:30:00, without a zone, got '%s'"), *Value);
+				return false;
+			}
+		}
+		else if (Key.Equals(TEXT("limit"), ESearchCase::IgnoreCase))
+		{
+			if (!LexTryParseString(OutQuery.MaxResults, *Value) || OutQuery.MaxResults <= 0)
+			{
+				OutError = FString::Printf(TEXT("Expected a positive limit, got '%s'"), *Value);
+				return false;
+			}
+		}
+		else if (Key.Equals(TEXT("cursor"), ESearchCase::IgnoreCase))
+		{
+			FString Segment;
+			int64 Offset = 0;
+			if (!ParseCursor(Value, Segment, Offset))
+			{
+				OutError = FString::Printf(TEXT("Expected a cursor returned by an earlier search, got '%s'"), *Value);
+				return false;
+			}
+			OutQuery.Cursor = Value;
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Unknown search term '%s'; use type, actor, asset, tool, since, from, to, limit or cursor"), *Key);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAuditQuery::ParseLocalDate(const FString& Text, FDateTime& OutDate)
+{
+	// ParseIso8601 converts a zoned time to UTC, which would be off by the editor's offset from UTC
+	int32 TimeStart = INDEX_NONE;
+	if (Text.FindChar(TEXT('T'), TimeStart) || Text.FindChar(TEXT(' '), TimeStart))
+	{
+		for (const TCHAR Char : Text.RightChop(TimeStart + 1))
+		{
+			if (Char == TEXT('Z') || Char == TEXT('z') || Char == TEXT('+') || Char == TEXT('-'))
+				return false;
+		}
+	}
+	return FDateTime::ParseIso8601(*Text, OutDate) || FDateTime::Parse(Text, OutDate);
+}
+
+bool FAuditQuery::ParseCursor(const FString& Cursor, FString& OutSegment, int64& OutOffset)
+{
+	FString OffsetText;
+	if (!Cursor.Split(TEXT("@"), &OutSegment, &OffsetText, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+		|| OutSegment.IsEmpty() || FPaths::GetCleanFilename(OutSegment) != OutSegment
+		|| OffsetText.IsEmpty() || !Algo::AllOf(OffsetText, [](TCHAR Char) { return FChar::IsDigit(Char); })
+		|| !LexTryParseString(OutOffset, *OffsetText))
+	{
+		return false;
+	}
+	return OutOffset >= AuditLogFormat::HeaderSize;
+}
+
+FAuditLogQueryEngine& FAuditLogQueryEngine::Get()
+{
+	static FAuditLogQueryEngine Instance(FAuditLogger::Get().GetAuditLogDirectory());
+	return Instance;
+}
+
+FAuditLogQueryEngine::FAuditLogQueryEngine(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+}
+
+FAuditLogQueryEngine::~FAuditLogQueryEngine()
+{
+}
+
+FString FAuditLogQueryEngine::Query(const FAuditQuery& Query, TFunctionRef<bool(const FAuditEvent&)> Visitor, FAuditQueryStats* OutStats)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	FAuditQueryStats Stats;
+	const int64 FromTicks = Query.From.GetTicks();
+	const int64 ToTicks = Query.To.GetTicks();
+
+	// Names are hashed once for the bloom filters, and compared in full against the events that get past them
+	TArray<uint64, TInlineAllocator<3>> NameHashes;
+	if (!Query.Actor.IsEmpty()) NameHashes.Add(HashName(ENameKind::Actor, Query.Actor));
+	if (!Query.Asset.IsEmpty()) NameHashes.Add(HashName(ENameKind::Asset, Query.Asset));
+	if (!Query.Tool.IsEmpty()) NameHashes.Add(HashName(ENameKind::Tool, Query.Tool));
+
+	FString CursorName;
+	int64 CursorOffset = 0;
+	if (!Query.Cursor.IsEmpty() && !FAuditQuery::ParseCursor(Query.Cursor, CursorName, CursorOffset))
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Ignoring a malformed audit query cursor: %s"), *Query.Cursor);
+	}
+
+	// A match, and where a query that stops after it carries on from
+	struct FMatch
+	{
+		FAuditEvent Event;
+		int32 Segment = 0;
+		int64 Offset = 0;
+	};
+	TArray<FMatch> Matches;
+	TArray<FString> MatchSegments;
+
+	// Matched events point at their keys, so each segment's keys are kept until the matches have been visited
+	FAuditRecordDecoder Decoder;
+	TArray<TArray<FString>> UsedKeys;
+	bool bReachedLimit = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		RefreshChanged();
+
+		for (FSegmentIndex* Index : Segments)
+		{
+			if (Index->Name < CursorName)
+				continue;
+
+			const int64 StartOffset = Index->Name == CursorName ? CursorOffset : 0;
+			++Stats.NumSegments;
+
+			const bool bMayMatch = Index->NumEvents > 0
+				&& StartOffset < Index->IndexedEnd
+				&& Index->MaxTicks >= FromTicks && Index->MinTicks < ToTicks
+				&& (Query.Types.Num() == 0 || Index->HasAnyType(Query.Types))
+				&& !NameHashes.ContainsByPredicate([Index](uint64 Hash) { return !Index->MayContain(Hash); });
+
+			const uint8* Data = nullptr;
+			int64 Size = 0;
+			if (!bMayMatch || !LoadSegment(*Index, Data, Size))
+			{
+				++Stats.NumSegmentsSkipped;
+				continue;
+			}
+
+			if (Decoder.Keys.Num() > 0)
+			{
+				UsedKeys.Add(MoveTemp(Decoder.Keys));
+			}
+			Decoder.Types = Index->Types;
+			Decoder.Keys = Index->Keys;
+			MatchSegments.Add(Index->Name);
+
+			const int32 NumBlocks = Index->Blocks.Num();
+			for (int32 BlockIndex = 0; BlockIndex < NumBlocks && !bReachedLimit; ++BlockIndex)
+			{
+				const FSegmentIndex::FBlock& Block = Index->Blocks[BlockIndex];
+				const int64 BlockEnd = FMath::Min(Size, BlockIndex + 1 < NumBlocks ? Index->Blocks[BlockIndex + 1].Offset : Index->IndexedEnd);
+				if (BlockEnd <= StartOffset || Block.MaxTicks < FromTicks || Block.MinTicks >= ToTicks)
+					continue;
+
+				int64 Offset = FMath::Max(Block.Offset, StartOffset);
+				bool bEvent = false;
+				while (Decoder.DecodeNext(Data, BlockEnd, Offset, bEvent))
+				{
+					if (!bEvent)
+						continue;
+
+					++Stats.NumEventsScanned;
+					const FAuditEvent& Event = Decoder.Event;
+					const int64 Ticks = Event.Timestamp.GetTicks();
+					if (Ticks < FromTicks || Ticks >= ToTicks
+						|| (Query.Types.Num() > 0 && !Query.Types.Contains(Event.Type))
+						|| (!Query.Actor.IsEmpty() && !HasName(Event, ENameKind::Actor, Query.Actor))
+						|| (!Query.Asset.IsEmpty() && !HasName(Event, ENameKind::Asset, Query.Asset))
+						|| (!Query.Tool.IsEmpty() && !HasName(Event, ENameKind::Tool, Query.Tool)))
+						continue;
+
+					Matches.Add({ Event, MatchSegments.Num() - 1, Offset });
+					if (Matches.Num() >= Query.MaxResults)
+					{
+						bReachedLimit = true;
+						break;
+					}
+				}
+			}
+
+			if (bReachedLimit)
+				break;
+		}
+
+		View.Close();
+	}
+
+	// Visited outside the lock, since a visitor may be streaming a response to a slow client
+	FString NextCursor;
+	for (const FMatch& Match : Matches)
+	{
+		++Stats.NumMatched;
+		if (!Visitor(Match.Event) || (bReachedLimit && Stats.NumMatched == Matches.Num()))
+		{
+			NextCursor = FString::Printf(TEXT("%s@%lld"), *MatchSegments[Match.Segment], Match.Offset);
+			break;
+		}
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartSeconds;
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+	return NextCursor;
+}
+
+void FAuditLogQueryEngine::Refresh()
+{
+	FScopeLock ScopeLock(&Lock);
+	LastScanSeconds = FPlatformTime::Seconds();
+
+	const TArray<FString> Paths = FAuditLogReader::FindSegments(Directory);
+	TMap<FString, TUniquePtr<FSegmentIndex>> Previous = MoveTemp(Indexes);
+	Indexes.Reset();
+	Segments.Reset();
+
+	for (const FString& Path : Paths)
+	{
+		const FString Name = FPaths::GetBaseFilename(Path);
+		TUniquePtr<FSegmentIndex> Index;
+		if (TUniquePtr<FSegmentIndex>* Found = Previous.Find(Name))
+		{
+			Index = MoveTemp(*Found);
+		}
+		else
+		{
+			Index = MakeUnique<FSegmentIndex>();
+			Index->Name = Name;
+		}
+
+		// Offsets are into the segment's own bytes, so an index carries on across its compression
+		if (Index->Path != Path)
+		{
+			Index->Path = Path;
+			Index->bCompressed = Path.EndsWith(AuditLogFormat::CompressedExtension);
+			if (Index->bCompressed && Index->IndexedEnd == 0)
+			{
+				Index->bComplete = LoadIndexFile(*Index);
+			}
+		}
+
+		if (!Index->bComplete)
+		{
+			UpdateSegment(*Index, IFileManager::Get().FileSize(*Path));
+		}
+
+		Segments.Add(Index.Get());
+		Indexes.Add(Name, MoveTemp(Index));
+	}
+	View.Close();
+
+	if (!bRemovedStaleIndexFiles)
+	{
+		bRemovedStaleIndexFiles = true;
+		TArray<FString> IndexFiles;
+		IFileManager::Get().FindFiles(IndexFiles, *FPaths::Combine(Directory, FString(TEXT("*")) + IndexExtension), true, false);
+		for (const FString& IndexFile : IndexFiles)
+		{
+			if (!Indexes.Contains(FPaths::GetBaseFilename(IndexFile)))
+			{
+				IFileManager::Get().Delete(*FPaths::Combine(Directory, IndexFile), false, false, true);
+			}
+		}
+	}
+}
+
+void FAuditLogQueryEngine::RefreshChanged()
+{
+	// A new segment is only noticed here when it's the log's own; others wait for the next rescan
+	const FString WriterPath = FAuditLogger::Get().GetAuditLogPath();
+	if (FPlatformTime::Seconds() - LastScanSeconds >= RescanSeconds
+		|| (FPaths::IsSamePath(FPaths::GetPath(WriterPath), Directory) && !Indexes.Contains(FPaths::GetBaseFilename(WriterPath))))
+	{
+		Refresh();
+		return;
+	}
+
+	for (FSegmentIndex* Index : Segments)
+	{
+		if (Index->bComplete)
+			continue;
+
+		// Gone when it has been compressed, or the log was cleared
+		const int64 FileSize = IFileManager::Get().FileSize(*Index->Path);
+		if (FileSize < 0)
+		{
+			Refresh();
+			return;
+		}
+		UpdateSegment(*Index, FileSize);
+	}
+	View.Close();
+}
+
+void FAuditLogQueryEngine::UpdateSegment(FSegmentIndex& Index, int64 FileSize)
+{
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	if ((Index.bCompressed || FileSize != Index.FileSize) && LoadSegment(Index, Data, Size))
+	{
+		IndexSegment(Index, Data, Size);
+		Index.FileSize = FileSize;
+		if (Index.bCompressed)
+		{
+			Index.bComplete = true;
+			Index.BuildBloom();
+			SaveIndexFile(Index);
+		}
+	}
+}
+
+bool FAuditLogQueryEngine::IsValidCursor(const FString& Cursor, FString& OutError) const
+{
+	FString Name;
+	int64 Offset = 0;
+	if (!FAuditQuery::ParseCursor(Cursor, Name, Offset))
+	{
+		OutError = TEXT("'cursor' must be a nextCursor returned by an earlier query");
+		return false;
+	}
+
+	// A segment is renamed when it is compressed, so either extension will do
+	const FString Base = FPaths::Combine(Directory, Name);
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FileManager.FileExists(*(Base + AuditLogFormat::SegmentExtension)) && !FileManager.FileExists(*(Base + AuditLogFormat::CompressedExtension)))
+	{
+		OutError = FString::Printf(TEXT("'cursor' names an audit segment that doesn't exist: %s"), *Name);
+		return false;
+	}
+	return true;
+}
+
+void FAuditLogQueryEngine::IndexSegment(FSegmentIndex& Index, const uint8* Data, int64 Size)
+{
+	if (Index.IndexedEnd == 0)
+	{
+		if (!AuditLogFormat::HasSegmentHeader(Data, Size))
+			return;
+
+		Index.IndexedEnd = AuditLogFormat::HeaderSize;
+	}
+
+	FAuditRecordDecoder Decoder;
+	Decoder.Types = MoveTemp(Index.Types);
+	Decoder.Keys = MoveTemp(Index.Keys);
+
+	int64 Offset = Index.IndexedEnd;
+	int64 RecordOffset = Offset;
+	bool bEvent = false;
+	while (Decoder.DecodeNext(Data, Size, Offset, bEvent))
+	{
+		if (bEvent)
+		{
+			const int64 Ticks = Decoder.Event.Timestamp.GetTicks();
+			if (Index.NumEvents % EventsPerBlock == 0)
+			{
+				Index.Blocks.Add({ RecordOffset, Ticks, Ticks });
+			}
+
+			// Events are queued from many threads, so timestamps are only roughly in order
+			FSegmentIndex::FBlock& Block = Index.Blocks.Last();
+			Block.MinTicks = FMath::Min(Block.MinTicks, Ticks);
+			Block.MaxTicks = FMath::Max(Block.MaxTicks, Ticks);
+			Index.MinTicks = FMath::Min(Index.MinTicks, Ticks);
+			Index.MaxTicks = FMath::Max(Index.MaxTicks, Ticks);
+			++Index.NumEvents;
+
+			ForEachName(Decoder.Event, [&Index](ENameKind Kind, FStringView Name)
+			{
+				Index.NameHashes.Add(HashName(Kind, Name));
+			});
+		}
+		Index.IndexedEnd = Offset;
+		RecordOffset = Offset;
+	}
+
+	Index.Types = MoveTemp(Decoder.Types);
+	Index.Keys = MoveTemp(Decoder.Keys);
+}
+
+bool FAuditLogQueryEngine::LoadSegment(FSegmentIndex& Index, const uint8*& OutData, int64& OutSize)
+{
+	if (Index.bCompressed && DecompressedName == Index.Name)
+	{
+		OutData = Decompressed.GetData();
+		OutSize = Decompressed.Num();
+		return true;
+	}
+
+	if (!View.Open(Index.Path))
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Can't open audit segment: %s"), *Index.Path);
+		return false;
+	}
+
+	if (!Index.bCompressed)
+	{
+		OutData = View.GetData();
+		OutSize = View.GetSize();
+		return true;
+	}
+
+	// Kept for the next query, which is usually after the same segment
+	FString Error;
+	DecompressedName.Reset();
+	const bool bDecompressed = AuditLogFormat::DecompressSegment(View.GetData(), View.GetSize(), Decompressed, Error);
+	View.Close();
+	if (!bDecompressed)
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Can't read audit segment %s: %s"), *Index.Path, *Error);
+		return false;
+	}
+
+	DecompressedName = Index.Name;
+	OutData = Decompressed.GetData();
+	OutSize = Decompressed.Num();
+	return true;
+}
+
+bool FAuditLogQueryEngine::LoadIndexFile(FSegmentIndex& Index) const
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FPaths::Combine(Directory, Index.Name + IndexExtension), FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != IndexMagic || Version != IndexVersion)
+		return false;
+
+	FSegmentIndex Loaded;
+	Loaded.Serialize(Reader);
+	if (Reader.IsError() || Loaded.FileSize != IFileManager::Get().FileSize(*Index.Path))
+		return false;
+
+	Index.FileSize = Loaded.FileSize;
+	Index.IndexedEnd = Loaded.IndexedEnd;
+	Index.NumEvents = Loaded.NumEvents;
+	Index.MinTicks = Loaded.MinTicks;
+	Index.MaxTicks = Loaded.MaxTicks;
+	Index.Types = MoveTemp(Loaded.Types);
+	Index.Keys = MoveTemp(Loaded.Keys);
+	Index.Blocks = MoveTemp(Loaded.Blocks);
+	Index.Bloom = MoveTemp(Loaded.Bloom);
+	return true;
+}
+
+void FAuditLogQueryEngine::SaveIndexFile(FSegmentIndex& Index) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = IndexMagic;
+	uint32 Version = IndexVersion;
+	Writer << Magic << Version;
+	Index.Serialize(Writer);
+
+	// Only saves the next session a decompression, so a failure is no more than a warning
+	const FString IndexPath = FPaths::Combine(Directory, Index.Name + IndexExtension);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *IndexPath))
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Failed to save audit segment index: %s"), *IndexPath);
+	}
+}
@@ -3,10 +3,59 @@
 #include "AuditLogger.h"
 #include "ChatGPTEditor.h"
 #include "SceneEditingTypes.h"
+#include "AuditEvent.h"
+#include "AuditSegmentWriter.h"
+#include "AuditLogFormat.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/DateTime.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Algo/BinarySearch.h"
+
+namespace AuditLoggerPrivate
+{
+	/** Runs the writer loop on an FRunnableThread */
+	class FWriterRunnable : public FRunnable
+	{
+	public:
+		explicit FWriterRunnable(TFunction<uint32()> InBody)
+			: Body(MoveTemp(InBody))
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			return Body();
+		}
+
+	private:
+		TFunction<uint32()> Body;
+	};
+
+	/** Identifies spilled entry segments */
+	constexpr uint32 SegmentMagic = 0x47534541; // "AESG"
+	constexpr uint32 SegmentVersion = 1;
+
+	/** Segments left behind by a session that didn't shut down are removed after this long */
+	constexpr double StaleSegmentSeconds = 24.0 * 60.0 * 60.0;
+
+	void SerializeEntry(FArchive& Ar, FAuditLogEntry& Entry)
+	{
+		Ar << Entry.Sequence;
+		Ar << Entry.Timestamp;
+		Ar << Entry.UserCommand;
+		Ar << Entry.OperationType;
+		Ar << Entry.AffectedActors;
+		Ar << Entry.bWasSuccessful;
+		Ar << Entry.ErrorMessage;
+	}
+}
 
 FAuditLogger& FAuditLogger::Get()
 {
@@ -16,7 +65,28 @@ FAuditLogger& FAuditLogger::Get()
 
 FAuditLogger::FAuditLogger()
 	: bInitialized(false)
+	, FirstSequence(0)
+	, RingFirstSequence(0)
+	, NextSequence(0)
+	, SegmentSession(FGuid::NewGuid())
+	, CachedSegmentIndex(INDEX_NONE)
+	, WriterEvent(nullptr)
+	, WriterRunnable(nullptr)
+	, WriterThread(nullptr)
+	, bWriterRunning(false)
+	, bStopRequested(false)
+	, FlushPolicy(static_cast<uint8>(EAuditLogFlushPolicy::Batch))
+	, NumQueued(0)
+	, NumWritten(0)
+	, NumFlushRequests(0)
+	, NumFlushesDone(0)
+{
+	LogWriter = MakeUnique<FAuditSegmentWriter>(GetAuditLogDirectory());
+}
+
+FAuditLogger::~FAuditLogger()
 {
+	StopWriter();
 }
 
 void FAuditLogger::Initialize()
@@ -32,13 +102,15 @@ void FAuditLogger::Initialize()
 	UE_LOG(LogChatGPTEditor, Log, TEXT("Initializing AuditLogger..."));
 	
 	EnsureLogDirectoryExists();
+	DeleteStaleSegments();
 	
-	FString InitMessage = FString::Printf(
-		TEXT("=== Audit Log Initialized ===\nTimestamp: %s\n"),
-		*GetTimestamp()
-	);
+	// Each session writes its own log segment; anything an earlier one left uncompressed is compressed in the
+	// background, and only Shutdown waits for that
+	LogWriter->Rotate();
+	LogWriter->CompressClosedSegments();
+	StartWriter();
 	
-	WriteLog(InitMessage);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("AUDIT_LOG")).AddMessage(TEXT("Audit log initialized")));
 	bInitialized = true;
 	
 	UE_LOG(LogChatGPTEditor, Log, TEXT("AuditLogger initialized successfully. Log path: %s"), *GetAuditLogPath());
@@ -56,12 +128,10 @@ void FAuditLogger::Shutdown()
 	
 	UE_LOG(LogChatGPTEditor, Log, TEXT("Shutting down AuditLogger..."));
 	
-	FString ShutdownMessage = FString::Printf(
-		TEXT("=== Audit Log Shutdown ===\nTimestamp: %s\n\n"),
-		*GetTimestamp()
-	);
-	
-	WriteLog(ShutdownMessage);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("AUDIT_LOG")).AddMessage(TEXT("Audit log shut down")));
+	StopWriter();
+	DeleteSegments();
+	WaitForCompression(DefaultFlushTimeoutSeconds);
 	bInitialized = false;
 	
 	UE_LOG(LogChatGPTEditor, Log, TEXT("AuditLogger shutdown complete"));
@@ -69,136 +139,200 @@ void FAuditLogger::Shutdown()
 
 void FAuditLogger::LogAPIConnection(const FString& Endpoint, const FString& Method, bool bApproved)
 {
-	FString Status = bApproved ? TEXT("APPROVED") : TEXT("DENIED");
-	FString LogEntry = FString::Printf(
-		TEXT("[%s] API_CONNECTION | Status: %s | Method: %s | Endpoint: %s\n"),
-		*GetTimestamp(),
-		*Status,
-		*Method,
-		*Endpoint
-	);
-	
-	WriteLog(LogEntry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("API_CONNECTION"))
+		.Add(TEXT("Status"), bApproved ? TEXT("APPROVED") : TEXT("DENIED"))
+		.Add(TEXT("Method"), Method)
+		.Add(TEXT("Endpoint"), Endpoint));
 }
 
 void FAuditLogger::LogCodeChange(const FString& Description, const FString& CodePreview, bool bApproved)
 {
-	FString Status = bApproved ? TEXT("APPROVED") : TEXT("DENIED");
-	FString LogEntry = FString::Printf(
-		TEXT("[%s] CODE_CHANGE | Status: %s | Description: %s\nCode Preview:\n%s\n---\n"),
-		*GetTimestamp(),
-		*Status,
-		*Description,
-		*CodePreview
-	);
-	
-	WriteLog(LogEntry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("CODE_CHANGE"))
+		.Add(TEXT("Status"), bApproved ? TEXT("APPROVED") : TEXT("DENIED"))
+		.Add(TEXT("Description"), Description)
+		.Add(TEXT("Code Preview"), CodePreview));
 }
 
 void FAuditLogger::LogEvent(const FString& EventType, const FString& Message)
 {
-	FString LogEntry = FString::Printf(
-		TEXT("[%s] %s | %s\n"),
-		*GetTimestamp(),
-		*EventType,
-		*Message
-	);
-	
-	WriteLog(LogEntry);
+	Submit(FAuditEvent(EAuditSource::Editor, FName(*EventType)).AddMessage(Message));
 }
 
 void FAuditLogger::LogFileRead(const FString& FilePath)
 {
-	FString Entry = FString::Printf(TEXT("FILE_READ: %s"), *FilePath);
-	WriteLogEntry(Entry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("FILE_READ")).Add(TEXT("Path"), FilePath));
 }
 
 void FAuditLogger::LogFileWrite(const FString& FilePath, const FString& Operation)
 {
-	FString Entry = FString::Printf(TEXT("FILE_WRITE: %s - Operation: %s"), *FilePath, *Operation);
-	WriteLogEntry(Entry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("FILE_WRITE"))
+		.Add(TEXT("Path"), FilePath)
+		.Add(TEXT("Operation"), Operation));
 }
 
 void FAuditLogger::LogPermissionChange(const FString& PermissionName, bool bEnabled)
 {
-	FString Entry = FString::Printf(TEXT("PERMISSION_CHANGE: %s = %s"), *PermissionName, bEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
-	WriteLogEntry(Entry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("PERMISSION_CHANGE"))
+		.Add(TEXT("Permission"), PermissionName)
+		.Add(TEXT("State"), bEnabled ? TEXT("ENABLED") : TEXT("DISABLED")));
 }
 
 void FAuditLogger::LogOperation(const FString& Category, const FString& Message)
 {
-	FString Entry = FString::Printf(TEXT("%s: %s"), *Category, *Message);
-	WriteLogEntry(Entry);
+	Submit(FAuditEvent(EAuditSource::Editor, FName(*Category)).AddMessage(Message));
 }
 
 void FAuditLogger::LogError(const FString& Category, const FString& ErrorMessage)
 {
-	FString Entry = FString::Printf(TEXT("ERROR [%s]: %s"), *Category, *ErrorMessage);
-	WriteLogEntry(Entry);
+	Submit(FAuditEvent(EAuditSource::Editor, TEXT("ERROR"))
+		.Add(TEXT("Category"), Category)
+		.Add(TEXT("Error"), ErrorMessage));
 }
 
 void FAuditLogger::LogOperation(const FString& UserCommand, const FString& OperationType, 
 	const FString& AffectedActors, bool bSuccess, const FString& ErrorMessage)
 {
+	FAuditEvent Event(EAuditSource::SceneEdit, TEXT("SCENE_EDIT"));
+	Event.Add(TEXT("Operation"), OperationType)
+		.Add(TEXT("Command"), UserCommand)
+		.Add(TEXT("Affected"), AffectedActors)
+		.Add(TEXT("Status"), bSuccess ? TEXT("SUCCESS") : TEXT("FAILED"));
+	if (!ErrorMessage.IsEmpty())
+	{
+		Event.Add(TEXT("Error"), ErrorMessage);
+	}
+
 	FScopeLock Lock(&LogMutex);
 
 	FAuditLogEntry Entry;
-	Entry.Timestamp = FDateTime::Now();
+	Entry.Timestamp = Event.Timestamp;
 	Entry.UserCommand = UserCommand;
 	Entry.OperationType = OperationType;
 	Entry.AffectedActors = AffectedActors;
 	Entry.bWasSuccessful = bSuccess;
 	Entry.ErrorMessage = ErrorMessage;
 
-	LogEntries.Add(Entry);
+	AddEntry(MoveTemp(Entry));
 
-	// Also write to the audit log file
-	FString LogText = FString::Printf(
-		TEXT("[SceneEdit] %s: %s - Affected: %s - Status: %s"),
-		*OperationType, *UserCommand, *AffectedActors, bSuccess ? TEXT("SUCCESS") : TEXT("FAILED")
-	);
-	if (!ErrorMessage.IsEmpty())
-	{
-		LogText += FString::Printf(TEXT(" - Error: %s"), *ErrorMessage);
-	}
-	WriteLogEntry(LogText);
+	// Also write to the audit log file, under the lock so the file and the entries agree on the order
+	Submit(MoveTemp(Event));
 }
 
 TArray<FAuditLogEntry> FAuditLogger::GetLogEntries() const
 {
 	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
-	return LogEntries;
+
+	TArray<FAuditLogEntry> Entries;
+	Entries.Reserve(static_cast<int32>(NextSequence - RingFirstSequence));
+	for (int64 Sequence = RingFirstSequence; Sequence < NextSequence; ++Sequence)
+	{
+		Entries.Add(Ring[Sequence % RingCapacity]);
+	}
+	return Entries;
 }
 
 TArray<FAuditLogEntry> FAuditLogger::GetRecentEntries(int32 Count) const
 {
-	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
-	
 	TArray<FAuditLogEntry> RecentEntries;
-	int32 StartIndex = FMath::Max(0, LogEntries.Num() - Count);
-	
-	for (int32 i = StartIndex; i < LogEntries.Num(); ++i)
+	VisitRecentEntries(Count, [&RecentEntries](const FAuditLogEntry& Entry)
 	{
-		RecentEntries.Add(LogEntries[i]);
-	}
-	
+		RecentEntries.Add(Entry);
+	});
 	return RecentEntries;
 }
 
+int64 FAuditLogger::VisitEntries(int64 Cursor, int32 MaxEntries, TFunctionRef<void(const FAuditLogEntry&)> Visitor) const
+{
+	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
+
+	Cursor = FMath::Clamp(Cursor, FirstSequence, NextSequence);
+	const int64 End = FMath::Min(NextSequence, Cursor + FMath::Max(MaxEntries, 0));
+
+	while (Cursor < End)
+	{
+		if (Cursor >= RingFirstSequence)
+		{
+			Visitor(Ring[Cursor % RingCapacity]);
+			++Cursor;
+			continue;
+		}
+
+		const int32 SegmentIndex = FindSegment(Cursor);
+		if (SegmentIndex == INDEX_NONE)
+		{
+			Cursor = RingFirstSequence;
+			continue;
+		}
+
+		const FAuditSegment& Segment = Segments[SegmentIndex];
+		const int64 SegmentEnd = FMath::Min(End, Segment.FirstSequence + Segment.NumEntries);
+		const TArray<FAuditLogEntry>* Entries = LoadSegment(SegmentIndex);
+		if (Entries)
+		{
+			for (; Cursor < SegmentEnd; ++Cursor)
+			{
+				Visitor((*Entries)[static_cast<int32>(Cursor - Segment.FirstSequence)]);
+			}
+		}
+		else
+		{
+			// Entries that can't be read back are skipped rather than ending the page early
+			Cursor = SegmentEnd;
+		}
+	}
+
+	return Cursor;
+}
+
+int32 FAuditLogger::VisitRecentEntries(int32 Count, TFunctionRef<void(const FAuditLogEntry&)> Visitor) const
+{
+	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
+
+	const int64 Start = FMath::Max(FirstSequence, NextSequence - FMath::Max(Count, 0));
+	int32 NumVisited = 0;
+	VisitEntries(Start, Count, [&Visitor, &NumVisited](const FAuditLogEntry& Entry)
+	{
+		Visitor(Entry);
+		++NumVisited;
+	});
+	return NumVisited;
+}
+
+int64 FAuditLogger::GetFirstSequence() const
+{
+	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
+	return FirstSequence;
+}
+
+int64 FAuditLogger::GetNextSequence() const
+{
+	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
+	return NextSequence;
+}
+
+int32 FAuditLogger::GetNumEntriesInMemory() const
+{
+	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
+	return static_cast<int32>(NextSequence - RingFirstSequence);
+}
+
 void FAuditLogger::ClearLog()
 {
 	FScopeLock Lock(&LogMutex);
-	LogEntries.Empty();
+
+	// Sequences keep counting, so a cursor taken before the clear just finds nothing older
+	Ring.Empty();
+	RingFirstSequence = NextSequence;
+	DeleteSegments();
+
 	LogEvent(TEXT("AUDIT_LOG"), TEXT("Log cleared by user"));
 }
 
 FString FAuditLogger::ExportLogToString() const
 {
-	FScopeLock Lock(&const_cast<FCriticalSection&>(LogMutex));
-	
 	FString Result = TEXT("=== Scene Editing Audit Log ===\n\n");
-	
-	for (const FAuditLogEntry& Entry : LogEntries)
+
+	VisitEntries(0, MAX_int32, [&Result](const FAuditLogEntry& Entry)
 	{
 		Result += FString::Printf(TEXT("[%s] %s\n"), 
 			*Entry.Timestamp.ToString(), 
@@ -214,64 +348,450 @@ FString FAuditLogger::ExportLogToString() const
 		}
 		
 		Result += TEXT("\n");
-	}
-	
+	});
+
 	return Result;
 }
 
-FString FAuditLogger::GetAuditLogPath() const
+bool FAuditLogger::ExportToFile(const FString& Path, EAuditLogExportFormat Format, FString& OutError)
 {
-	FString SavedDir = FPaths::ProjectSavedDir();
-	return FPaths::Combine(SavedDir, TEXT("ChatGPTEditor"), TEXT("audit.log"));
+	// Everything logged so far should be in the segments before they are read
+	Flush();
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		OutError = FString::Printf(TEXT("Could not open %s for writing"), *Path);
+		return false;
+	}
+
+	// Written a chunk at a time, so a long log is never held as one string
+	FString Chunk;
+	Chunk.Reserve(ExportChunkChars + 1024);
+	auto WriteChunk = [&Writer, &Chunk]()
+	{
+		FTCHARToUTF8 Utf8Chunk(*Chunk, Chunk.Len());
+		Writer->Serialize(const_cast<void*>(static_cast<const void*>(Utf8Chunk.Get())), Utf8Chunk.Length());
+		Chunk.Reset();
+	};
+
+	FAuditLogReader Reader;
+	Reader.ReadDirectory(GetAuditLogDirectory(), [&Chunk, &WriteChunk, Format](const FAuditEvent& Event)
+	{
+		if (Format == EAuditLogExportFormat::JsonLines)
+		{
+			Event.AppendJsonLine(Chunk);
+		}
+		else
+		{
+			Event.AppendLine(Chunk);
+		}
+
+		if (Chunk.Len() >= ExportChunkChars)
+		{
+			WriteChunk();
+		}
+		return true;
+	});
+	WriteChunk();
+
+	if (!Writer->Close() || Writer->IsError())
+	{
+		OutError = FString::Printf(TEXT("Failed to write %s"), *Path);
+		return false;
+	}
+	return true;
 }
 
-void FAuditLogger::WriteLog(const FString& Entry)
+void FAuditLogger::AddEntry(FAuditLogEntry&& Entry)
 {
-	FScopeLock Lock(&LogMutex);
-	
-	FString AuditLogPath = GetAuditLogPath();
-	
-	// Append to log file
+	if (Ring.Num() == 0)
+	{
+		Ring.SetNum(RingCapacity);
+	}
+
+	ApplySpillResults();
+	if (NextSequence - RingFirstSequence >= RingCapacity)
+	{
+		SpillOldestEntries();
+	}
+
+	Entry.Sequence = NextSequence;
+	Ring[NextSequence % RingCapacity] = MoveTemp(Entry);
+	++NextSequence;
+}
+
+void FAuditLogger::SpillOldestEntries()
+{
+	FAuditSegment Segment;
+	Segment.FirstSequence = RingFirstSequence;
+	Segment.NumEntries = static_cast<int32>(FMath::Min<int64>(SpillBlockSize, NextSequence - RingFirstSequence));
+	Segment.Path = FPaths::Combine(GetSegmentDirectory(),
+		FString::Printf(TEXT("%s-%lld.seg"), *SegmentSession.ToString(EGuidFormats::Digits), Segment.FirstSequence));
+
+	// Only moves happen under the lock; the block stays readable from memory until its file is written
+	TSharedRef<TArray<FAuditLogEntry>, ESPMode::ThreadSafe> Entries = MakeShared<TArray<FAuditLogEntry>, ESPMode::ThreadSafe>();
+	Entries->Reserve(Segment.NumEntries);
+	for (int64 Sequence = Segment.FirstSequence; Sequence < Segment.FirstSequence + Segment.NumEntries; ++Sequence)
+	{
+		Entries->Add(MoveTemp(Ring[Sequence % RingCapacity]));
+		Ring[Sequence % RingCapacity] = FAuditLogEntry();
+	}
+	Segment.PendingEntries = Entries;
+
+	FAuditSpill Spill;
+	Spill.Path = Segment.Path;
+	Spill.FirstSequence = Segment.FirstSequence;
+	Spill.Entries = Entries;
+
+	Segments.Add(MoveTemp(Segment));
+	RingFirstSequence += Entries->Num();
+	FirstSequence = Segments[0].FirstSequence;
+
+	{
+		FReadScopeLock Lock(WriterLock);
+		if (bWriterRunning)
+		{
+			SpillQueue.Enqueue(MoveTemp(Spill));
+			WriterEvent->Trigger();
+			return;
+		}
+	}
+
+	// No writer before Initialize and after Shutdown
+	WriteSpill(Spill);
+	ApplySpillResults();
+}
+
+void FAuditLogger::WriteSpill(const FAuditSpill& Spill)
+{
+	bool bWritten = false;
+	if (TUniquePtr<FArchive> Writer = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*Spill.Path)))
+	{
+		uint32 Magic = AuditLoggerPrivate::SegmentMagic;
+		uint32 Version = AuditLoggerPrivate::SegmentVersion;
+		int64 First = Spill.FirstSequence;
+		int32 NumEntries = Spill.Entries->Num();
+		*Writer << Magic << Version << First << NumEntries;
+		for (FAuditLogEntry& Entry : *Spill.Entries)
+		{
+			AuditLoggerPrivate::SerializeEntry(*Writer, Entry);
+		}
+		bWritten = Writer->Close() && !Writer->IsError();
+	}
+
+	FAuditSpillResult Result;
+	Result.Path = Spill.Path;
+	Result.bWritten = bWritten;
+	SpillResults.Enqueue(MoveTemp(Result));
+}
+
+void FAuditLogger::ApplySpillResults()
+{
+	FAuditSpillResult Result;
+	while (SpillResults.Dequeue(Result))
+	{
+		const int32 Index = Segments.IndexOfByPredicate([&Result](const FAuditSegment& Segment) { return Segment.Path == Result.Path; });
+		if (Index == INDEX_NONE)
+		{
+			// Cleared while it was being written
+			IFileManager::Get().Delete(*Result.Path, false, false, true);
+			continue;
+		}
+
+		if (Result.bWritten)
+		{
+			Segments[Index].PendingEntries.Reset();
+			continue;
+		}
+
+		// Keep what is stored contiguous: without this block the older segments can't be paged to either
+		UE_LOG(LogChatGPTEditor, Error, TEXT("Failed to spill %d audit entries to %s; older entries are dropped"), Segments[Index].NumEntries, *Result.Path);
+		for (int32 DropIndex = 0; DropIndex <= Index; ++DropIndex)
+		{
+			IFileManager::Get().Delete(*Segments[DropIndex].Path, false, false, true);
+		}
+		Segments.RemoveAt(0, Index + 1);
+		CachedSegmentIndex = INDEX_NONE;
+		CachedSegmentEntries.Empty();
+		FirstSequence = Segments.Num() > 0 ? Segments[0].FirstSequence : RingFirstSequence;
+	}
+}
+
+void FAuditLogger::DeleteSegments()
+{
+	// Spills still being written are deleted when their results come back
+	ApplySpillResults();
+	for (const FAuditSegment& Segment : Segments)
+	{
+		IFileManager::Get().Delete(*Segment.Path, false, false, true);
+	}
+	Segments.Empty();
+	CachedSegmentIndex = INDEX_NONE;
+	CachedSegmentEntries.Empty();
+	FirstSequence = RingFirstSequence;
+}
+
+void FAuditLogger::DeleteStaleSegments()
+{
+	TArray<FString> Files;
 	IFileManager& FileManager = IFileManager::Get();
-	FArchive* LogFile = FileManager.CreateFileWriter(*AuditLogPath, FILEWRITE_Append);
-	
-	if (LogFile)
+	FileManager.FindFiles(Files, *FPaths::Combine(GetSegmentDirectory(), TEXT("*.seg")), true, false);
+
+	const FDateTime Now = FDateTime::UtcNow();
+	for (const FString& File : Files)
 	{
-		FString EntryWithNewline = Entry;
-		if (!Entry.EndsWith(TEXT("\n")))
+		const FString Path = FPaths::Combine(GetSegmentDirectory(), File);
+		const FDateTime Modified = FileManager.GetTimeStamp(*Path);
+		if (Modified != FDateTime::MinValue() && (Now - Modified).GetTotalSeconds() > AuditLoggerPrivate::StaleSegmentSeconds)
 		{
-			EntryWithNewline += TEXT("\n");
+			FileManager.Delete(*Path, false, false, true);
+		}
+	}
+}
+
+FString FAuditLogger::GetSegmentDirectory() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ChatGPTEditor"), TEXT("AuditSegments"));
+}
+
+int32 FAuditLogger::FindSegment(int64 Sequence) const
+{
+	const int32 Index = Algo::UpperBoundBy(Segments, Sequence, &FAuditSegment::FirstSequence) - 1;
+	if (Index < 0 || Sequence >= Segments[Index].FirstSequence + Segments[Index].NumEntries)
+		return INDEX_NONE;
+	return Index;
+}
+
+const TArray<FAuditLogEntry>* FAuditLogger::LoadSegment(int32 Index) const
+{
+	if (Segments[Index].PendingEntries.IsValid())
+		return Segments[Index].PendingEntries.Get();
+
+	if (CachedSegmentIndex == Index)
+		return &CachedSegmentEntries;
+
+	CachedSegmentIndex = INDEX_NONE;
+	CachedSegmentEntries.Reset();
+
+	const FAuditSegment& Segment = Segments[Index];
+	TUniquePtr<FArchive> Reader = TUniquePtr<FArchive>(IFileManager::Get().CreateFileReader(*Segment.Path));
+	if (!Reader)
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Audit segment is missing: %s"), *Segment.Path);
+		return nullptr;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int64 First = 0;
+	int32 NumEntries = 0;
+	*Reader << Magic << Version << First << NumEntries;
+	if (Magic != AuditLoggerPrivate::SegmentMagic || Version != AuditLoggerPrivate::SegmentVersion || First != Segment.FirstSequence || NumEntries != Segment.NumEntries)
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Audit segment doesn't match what was spilled: %s"), *Segment.Path);
+		return nullptr;
+	}
+
+	CachedSegmentEntries.SetNum(NumEntries);
+	for (FAuditLogEntry& Entry : CachedSegmentEntries)
+	{
+		AuditLoggerPrivate::SerializeEntry(*Reader, Entry);
+	}
+	if (Reader->IsError())
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Audit segment is truncated: %s"), *Segment.Path);
+		CachedSegmentEntries.Reset();
+		return nullptr;
+	}
+
+	CachedSegmentIndex = Index;
+	return &CachedSegmentEntries;
+}
+
+FString FAuditLogger::GetAuditLogPath() const
+{
+	return LogWriter->GetSegmentPath();
+}
+
+FString FAuditLogger::GetAuditLogDirectory() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ChatGPTEditor"), TEXT("AuditLog"));
+}
+
+void FAuditLogger::SetRotationLimits(int64 MaxSegmentBytes, double MaxSegmentSeconds)
+{
+	LogWriter->SetRotationLimits(MaxSegmentBytes, MaxSegmentSeconds);
+}
+
+bool FAuditLogger::WaitForCompression(double TimeoutSeconds)
+{
+	return FAuditSegmentWriter::WaitForCompression(TimeoutSeconds);
+}
+
+void FAuditLogger::Submit(FAuditEvent&& Event)
+{
+	{
+		// Held across the enqueue and the trigger, so StopWriter can't drain the queue or release the event in between
+		FReadScopeLock Lock(WriterLock);
+		if (bWriterRunning)
+		{
+			WriteQueue.Enqueue(MoveTemp(Event));
+
+			// The writer wakes on its own every group commit interval; only a backlog needs it sooner
+			if (++NumQueued - NumWritten >= WakeWriterThreshold)
+			{
+				WriterEvent->Trigger();
+			}
+			return;
 		}
-		
-		// Convert to UTF-8
-		FTCHARToUTF8 UTF8String(*EntryWithNewline);
-		LogFile->Serialize((void*)UTF8String.Get(), UTF8String.Length());
-		LogFile->Close();
-		delete LogFile;
 	}
-	else
+
+	WriteLogDirect(Event);
+}
+
+void FAuditLogger::WriteLogDirect(const FAuditEvent& Event)
+{
+	FScopeLock Lock(&LogMutex);
+	
+	LogWriter->Add(Event);
+	LogWriter->Write(GetFlushPolicy(), false);
+	LogWriter->CloseFile();
+}
+
+void FAuditLogger::StartWriter()
+{
+	if (bWriterRunning)
+		return;
+
+	bStopRequested = false;
+	WriterEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	WriterRunnable = new AuditLoggerPrivate::FWriterRunnable([this]() { return RunWriter(); });
+	WriterThread = FRunnableThread::Create(WriterRunnable, TEXT("ChatGPTAuditWriter"), 0, TPri_BelowNormal);
+	if (!WriterThread)
 	{
-		UE_LOG(LogChatGPTEditor, Error, TEXT("Failed to open audit log file for writing: %s"), *AuditLogPath);
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Could not start the audit writer thread; audit lines will be written directly"));
+		delete WriterRunnable;
+		WriterRunnable = nullptr;
+		FPlatformProcess::ReturnSynchEventToPool(WriterEvent);
+		WriterEvent = nullptr;
+		return;
 	}
+
+	bWriterRunning = true;
+
+	// Whatever is queued when the editor crashes still reaches the log, within a bounded wait
+	SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &FAuditLogger::OnSystemError);
 }
 
-void FAuditLogger::WriteLogEntry(const FString& Entry)
+void FAuditLogger::StopWriter()
 {
-	FString Timestamp = GetTimestamp();
-	FString LogEntry = FString::Printf(TEXT("[%s] %s"), *Timestamp, *Entry);
-	WriteLog(LogEntry);
+	if (!WriterThread)
+		return;
+
+	FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+	SystemErrorHandle.Reset();
+
+	// The writer drains the queue before it exits
+	bStopRequested = true;
+	WriterEvent->Trigger();
+	WriterThread->WaitForCompletion();
+	delete WriterThread;
+	WriterThread = nullptr;
+	delete WriterRunnable;
+	WriterRunnable = nullptr;
+
+	// Once no producer is inside Submit or Flush, events from here on are written directly and none can touch the event
+	{
+		FWriteScopeLock Lock(WriterLock);
+		bWriterRunning = false;
+	}
+
+	// This thread is now the only reader; write whatever was queued while the writer was exiting
+	WriteQueuedEvents();
+	LogWriter->CloseFile();
+
+	FPlatformProcess::ReturnSynchEventToPool(WriterEvent);
+	WriterEvent = nullptr;
+}
+
+uint32 FAuditLogger::RunWriter()
+{
+	while (!bStopRequested)
+	{
+		WriterEvent->Wait(GroupCommitMilliseconds);
+		WriteQueuedEvents();
+	}
+
+	WriteQueuedEvents();
+	return 0;
+}
+
+void FAuditLogger::WriteQueuedEvents()
+{
+	// Read the flush requests first: every event a Flush is waiting for was queued before it asked
+	const int64 FlushRequests = NumFlushRequests;
+
+	FAuditSpill Spill;
+	while (SpillQueue.Dequeue(Spill))
+	{
+		WriteSpill(Spill);
+	}
+
+	int64 NumEvents = 0;
+	FAuditEvent Event;
+	while (WriteQueue.Dequeue(Event))
+	{
+		LogWriter->Add(Event);
+		++NumEvents;
+	}
+
+	const bool bFlushRequested = FlushRequests != NumFlushesDone;
+	if (NumEvents == 0 && !bFlushRequested)
+		return;
+
+	LogWriter->Write(GetFlushPolicy(), bFlushRequested);
+
+	// Counted even when the write failed, so Flush doesn't wait on events that will never land
+	NumWritten += NumEvents;
+	NumFlushesDone = FlushRequests;
+}
+
+bool FAuditLogger::Flush(double TimeoutSeconds)
+{
+	int64 Target = 0;
+	int64 Request = 0;
+	{
+		FReadScopeLock Lock(WriterLock);
+		if (!bWriterRunning)
+			return true;
+
+		Target = NumQueued;
+		Request = ++NumFlushRequests;
+		WriterEvent->Trigger();
+	}
+
+	// A stop that lands while waiting drains the queue and serves the request itself
+
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (NumWritten < Target || NumFlushesDone < Request)
+	{
+		if (FPlatformTime::Seconds() >= Deadline)
+			return false;
+
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+	return true;
 }
 
-FString FAuditLogger::GetTimestamp() const
+void FAuditLogger::OnSystemError()
 {
-	FDateTime Now = FDateTime::Now();
-	return Now.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+	Flush(CrashFlushTimeoutSeconds);
 }
 
 void FAuditLogger::EnsureLogDirectoryExists()
 {
-	FString AuditLogPath = GetAuditLogPath();
-	FString LogDir = FPaths::GetPath(AuditLogPath);
+	FString LogDir = GetAuditLogDirectory();
 	
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	if (!PlatformFile.DirectoryExists(*LogDir))
@@ -0,0 +1,390 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AuditSegmentWriter.h"
+#include "AuditLogFormat.h"
+#include "AuditLogger.h"
+#include "ChatGPTEditor.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+
+std::atomic<int32> FAuditSegmentWriter::NumCompressing(0);
+FCriticalSection FAuditSegmentWriter::CompressingLock;
+TSet<FString> FAuditSegmentWriter::CompressingPaths;
+
+namespace
+{
+	template <typename T>
+	void AppendValue(TArray<uint8>& Out, T Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	/** A marker that still can't be read after this long was cut short by a crash rather than being written */
+	constexpr double UnreadableMarkerSeconds = 60.0;
+}
+
+FAuditSegmentWriter::FAuditSegmentWriter(const FString& InDirectory)
+	: Directory(InDirectory)
+	, MaxSegmentBytes(DefaultMaxSegmentBytes)
+	, MaxSegmentSeconds(DefaultMaxSegmentSeconds)
+{
+	StartSegment();
+	FirstSegmentName = FPaths::GetBaseFilename(SegmentPath);
+}
+
+FAuditSegmentWriter::~FAuditSegmentWriter()
+{
+	CloseFile();
+	if (!SessionMarkerPath.IsEmpty())
+	{
+		IFileManager::Get().Delete(*SessionMarkerPath, false, false, true);
+	}
+}
+
+void FAuditSegmentWriter::Add(const FAuditEvent& Event)
+{
+	using namespace AuditLogFormat;
+
+	const int32 NumFields = FMath::Min(Event.Fields.Num(), MaxFieldsPerEvent);
+	if (NeedsRotation(NumFields))
+	{
+		Rotate();
+	}
+
+	if (!bSegmentHasHeader)
+	{
+		AppendValue(Pending, SegmentMagic);
+		AppendValue(Pending, Version);
+		bSegmentHasHeader = true;
+		SegmentStartSeconds = FPlatformTime::Seconds();
+	}
+
+	// Definitions go ahead of the event that first uses them
+	const uint16 TypeId = InternType(Event.Type);
+	uint16 KeyIdsOfFields[MaxFieldsPerEvent];
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		const TCHAR* Key = Event.Fields[Index].Key;
+		KeyIdsOfFields[Index] = Key ? InternKey(Key) : MessageKeyId;
+	}
+
+	const int32 RecordStart = BeginRecord(static_cast<uint8>(ERecordKind::Event));
+	AppendValue(Pending, Event.Timestamp.GetTicks());
+	AppendValue(Pending, static_cast<uint8>(Event.Source));
+	AppendValue(Pending, TypeId);
+	AppendValue(Pending, static_cast<uint8>(NumFields));
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		const FString& Value = Event.Fields[Index].Value;
+		AppendValue(Pending, KeyIdsOfFields[Index]);
+		AppendString(*Value, Value.Len());
+	}
+	EndRecord(RecordStart);
+}
+
+bool FAuditSegmentWriter::Write(EAuditLogFlushPolicy Policy, bool bSync)
+{
+	const bool bWritten = WritePending();
+	if (File)
+	{
+		if (bSync || Policy == EAuditLogFlushPolicy::Sync)
+		{
+			File->Flush(true);
+		}
+		else if (Policy == EAuditLogFlushPolicy::Batch)
+		{
+			File->Flush(false);
+		}
+	}
+	return bWritten;
+}
+
+bool FAuditSegmentWriter::WritePending()
+{
+	if (Pending.Num() == 0)
+		return true;
+
+	const FString Path = GetSegmentPath();
+	if (!File)
+	{
+		WriteSessionMarker();
+
+		// Events logged before Initialize can arrive ahead of the directory
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		File.Reset(PlatformFile.OpenWrite(*Path, true, true));
+		if (!File && PlatformFile.CreateDirectoryTree(*Directory))
+		{
+			File.Reset(PlatformFile.OpenWrite(*Path, true, true));
+		}
+	}
+
+	if (File && File->Write(Pending.GetData(), Pending.Num()))
+	{
+		SegmentSize += Pending.Num();
+		Pending.Reset();
+		return true;
+	}
+
+	UE_LOG(LogChatGPTEditor, Error, TEXT("Failed to write %d bytes to the audit log: %s"), Pending.Num(), *Path);
+	Pending.Reset();
+
+	// What this batch defined is lost with it, so later events can't refer back to it
+	if (SegmentSize > 0)
+	{
+		Rotate();
+	}
+	else
+	{
+		CloseFile();
+		StartSegment();
+	}
+	return false;
+}
+
+void FAuditSegmentWriter::CloseFile()
+{
+	File.Reset();
+}
+
+void FAuditSegmentWriter::Rotate()
+{
+	// Nothing was written to this segment, so it can carry on as the next one
+	if (!bSegmentHasHeader && SegmentSize == 0)
+		return;
+
+	WritePending();
+	CloseFile();
+	const FString Closed = GetSegmentPath();
+	StartSegment();
+
+	if (IFileManager::Get().FileExists(*Closed))
+	{
+		CompressInBackground(Closed);
+	}
+}
+
+void FAuditSegmentWriter::CompressClosedSegments()
+{
+	// Counted from the start, so a WaitForCompression right after this sees the scan as well
+	++NumCompressing;
+	Async(EAsyncExecution::ThreadPool, [OwnFirstSegment = FirstSegmentName, ScanDirectory = Directory]()
+	{
+		// Markers are listed before segments: a session whose marker is missed starts after this one did,
+		// so its segments are named later than OwnFirstSegment anyway
+		const FString OldestLive = FindOldestLiveSegment(ScanDirectory, OwnFirstSegment);
+		for (const FString& Path : FAuditLogReader::FindSegments(ScanDirectory))
+		{
+			if (Path.EndsWith(AuditLogFormat::SegmentExtension) && FPaths::GetBaseFilename(Path) < OldestLive)
+			{
+				CompressInBackground(Path);
+			}
+		}
+		--NumCompressing;
+	});
+}
+
+void FAuditSegmentWriter::WriteSessionMarker()
+{
+	if (!SessionMarkerPath.IsEmpty())
+		return;
+
+	const FString Path = FPaths::Combine(Directory, FirstSegmentName + AuditLogFormat::SessionExtension);
+	if (FFileHelper::SaveStringToFile(LexToString(FPlatformProcess::GetCurrentProcessId()), *Path))
+	{
+		SessionMarkerPath = Path;
+	}
+	else
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Failed to write audit session marker: %s"), *Path);
+	}
+}
+
+FString FAuditSegmentWriter::FindOldestLiveSegment(const FString& ScanDirectory, const FString& OwnFirstSegment)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	TArray<FString> Markers;
+	FileManager.FindFiles(Markers, *FPaths::Combine(ScanDirectory, FString(TEXT("*")) + AuditLogFormat::SessionExtension), true, false);
+
+	FString Oldest = OwnFirstSegment;
+	for (const FString& Marker : Markers)
+	{
+		const FString Name = FPaths::GetBaseFilename(Marker);
+		const FString Path = FPaths::Combine(ScanDirectory, Marker);
+		if (Name == OwnFirstSegment)
+			continue;
+
+		FString ProcessIdText;
+		uint32 ProcessId = 0;
+		bool bGone = false;
+		if (FFileHelper::LoadFileToString(ProcessIdText, *Path, FFileHelper::EHashOptions::None, FILEREAD_Silent)
+			&& LexTryParseString(ProcessId, *ProcessIdText.TrimStartAndEnd()))
+		{
+			bGone = ProcessId != FPlatformProcess::GetCurrentProcessId() && !FPlatformProcess::IsApplicationRunning(ProcessId);
+		}
+		else
+		{
+			const FDateTime Modified = FileManager.GetTimeStamp(*Path);
+			bGone = Modified != FDateTime::MinValue() && (FDateTime::UtcNow() - Modified).GetTotalSeconds() > UnreadableMarkerSeconds;
+		}
+
+		if (bGone)
+		{
+			FileManager.Delete(*Path, false, false, true);
+		}
+		else if (Name < Oldest)
+		{
+			Oldest = Name;
+		}
+	}
+	return Oldest;
+}
+
+FString FAuditSegmentWriter::GetSegmentPath() const
+{
+	FScopeLock Lock(&PathLock);
+	return SegmentPath;
+}
+
+void FAuditSegmentWriter::SetRotationLimits(int64 InMaxSegmentBytes, double InMaxSegmentSeconds)
+{
+	MaxSegmentBytes = InMaxSegmentBytes;
+	MaxSegmentSeconds = InMaxSegmentSeconds;
+}
+
+bool FAuditSegmentWriter::WaitForCompression(double TimeoutSeconds)
+{
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (NumCompressing > 0)
+	{
+		if (FPlatformTime::Seconds() >= Deadline)
+			return false;
+
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+	return true;
+}
+
+void FAuditSegmentWriter::StartSegment()
+{
+	// Named by UTC start time to the millisecond, so segments sort oldest first; the counter only breaks ties
+	const FString Stamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S%s"));
+	IFileManager& FileManager = IFileManager::Get();
+	FString Path;
+	for (int32 Counter = 0; ; ++Counter)
+	{
+		const FString Base = FPaths::Combine(Directory, FString::Printf(TEXT("Audit-%s-%03d"), *Stamp, Counter));
+		Path = Base + AuditLogFormat::SegmentExtension;
+		if (!FileManager.FileExists(*Path) && !FileManager.FileExists(*(Base + AuditLogFormat::CompressedExtension)))
+			break;
+	}
+
+	{
+		FScopeLock Lock(&PathLock);
+		SegmentPath = Path;
+	}
+
+	SegmentSize = 0;
+	bSegmentHasHeader = false;
+	TypeIds.Reset();
+	KeyNames.Reset();
+	KeyIds.Reset();
+}
+
+bool FAuditSegmentWriter::NeedsRotation(int32 NumFields) const
+{
+	if (!bSegmentHasHeader)
+		return false;
+
+	// Key ids stop short of MessageKeyId
+	return SegmentSize + Pending.Num() >= MaxSegmentBytes
+		|| FPlatformTime::Seconds() - SegmentStartSeconds >= MaxSegmentSeconds
+		|| TypeIds.Num() >= AuditLogFormat::MaxIdsPerSegment
+		|| KeyNames.Num() + NumFields >= AuditLogFormat::MaxIdsPerSegment;
+}
+
+uint16 FAuditSegmentWriter::InternType(FName Type)
+{
+	if (const uint16* Id = TypeIds.Find(Type))
+		return *Id;
+
+	const uint16 Id = static_cast<uint16>(TypeIds.Num());
+	TypeIds.Add(Type, Id);
+
+	const FString Name = Type.ToString();
+	const int32 RecordStart = BeginRecord(static_cast<uint8>(AuditLogFormat::ERecordKind::DefineType));
+	AppendValue(Pending, Id);
+	AppendString(*Name, Name.Len());
+	EndRecord(RecordStart);
+	return Id;
+}
+
+uint16 FAuditSegmentWriter::InternKey(const TCHAR* Key)
+{
+	if (const uint16* Id = KeyIds.Find(Key))
+	{
+		if (FCString::Strcmp(*KeyNames[*Id], Key) == 0)
+			return *Id;
+	}
+
+	const uint16 Id = static_cast<uint16>(KeyNames.Num());
+	KeyNames.Add(Key);
+	KeyIds.Add(Key, Id);
+
+	const int32 RecordStart = BeginRecord(static_cast<uint8>(AuditLogFormat::ERecordKind::DefineKey));
+	AppendValue(Pending, Id);
+	AppendString(Key, FCString::Strlen(Key));
+	EndRecord(RecordStart);
+	return Id;
+}
+
+int32 FAuditSegmentWriter::BeginRecord(uint8 Kind)
+{
+	const int32 RecordStart = Pending.Num();
+	AppendValue(Pending, uint32(0));
+	Pending.Add(Kind);
+	return RecordStart;
+}
+
+void FAuditSegmentWriter::EndRecord(int32 RecordStart)
+{
+	const uint32 RecordSize = static_cast<uint32>(Pending.Num() - RecordStart - sizeof(uint32));
+	FMemory::Memcpy(Pending.GetData() + RecordStart, &RecordSize, sizeof(uint32));
+}
+
+void FAuditSegmentWriter::AppendString(const TCHAR* Text, int32 Length)
+{
+	const FTCHARToUTF8 Converted(Text, Length);
+	AppendValue(Pending, static_cast<uint32>(Converted.Length()));
+	Pending.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+}
+
+void FAuditSegmentWriter::CompressInBackground(const FString& Path)
+{
+	{
+		FScopeLock Lock(&CompressingLock);
+		if (CompressingPaths.Contains(Path))
+			return;
+		CompressingPaths.Add(Path);
+	}
+
+	++NumCompressing;
+	Async(EAsyncExecution::ThreadPool, [Path]()
+	{
+		// Oodle comes with the engine and decompresses several times faster than zlib
+		if (!AuditLogFormat::CompressSegment(Path, NAME_Oodle))
+		{
+			UE_LOG(LogChatGPTEditor, Warning, TEXT("Audit segment left uncompressed: %s"), *Path);
+		}
+
+		{
+			FScopeLock Lock(&CompressingLock);
+			CompressingPaths.Remove(Path);
+		}
+		--NumCompressing;
+	});
+}
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuditEvent.h"
+#include <atomic>
+
+class IFileHandle;
+enum class EAuditLogFlushPolicy : uint8;
+
+/**
+ * Encodes audit events into the segment files described in AuditLogFormat.h
+ * Events are encoded into a pending batch and written with one call; a new segment is started once the
+ * current one reaches its size or age limit, and the closed one is compressed on the thread pool.
+ * Before its first segment is created the writer leaves a .session marker named after it, holding the
+ * process id, so other processes sharing the directory leave that segment and every later one alone.
+ * Not thread-safe: FAuditLogger only uses it from the writer thread, or under its lock when that isn't running.
+ */
+class FAuditSegmentWriter
+{
+public:
+	explicit FAuditSegmentWriter(const FString& InDirectory);
+	~FAuditSegmentWriter();
+
+	/** Encode an event into the pending batch, starting a new segment first if the current one is full */
+	void Add(const FAuditEvent& Event);
+
+	/** Append the pending batch to the segment, then flush as far as the policy asks; false if it couldn't be written */
+	bool Write(EAuditLogFlushPolicy Policy, bool bSync);
+
+	/** Close the file handle; the next write opens it again and carries on in the same segment */
+	void CloseFile();
+
+	/** End the current segment and compress it; the next event starts a new one */
+	void Rotate();
+
+	/**
+	 * Compress segments left behind uncompressed, by an earlier session or an earlier Rotate that failed.
+	 * Only segments older than the first of every live session, this one included, are closed for certain;
+	 * later ones are left for their own writer's Rotate or a later scan. Returns at once; the directory is
+	 * listed on the thread pool too, and WaitForCompression covers both.
+	 */
+	void CompressClosedSegments();
+
+	/** Path of the segment being written; safe from any thread */
+	FString GetSegmentPath() const;
+
+	const FString& GetDirectory() const { return Directory; }
+
+	/** Start a new segment once the current one holds this many bytes or was started this long ago */
+	void SetRotationLimits(int64 InMaxSegmentBytes, double InMaxSegmentSeconds);
+
+	/** Wait until no segment is being compressed, for at most the timeout; false if it ran out */
+	static bool WaitForCompression(double TimeoutSeconds);
+
+	static constexpr int64 DefaultMaxSegmentBytes = 8 * 1024 * 1024;
+	static constexpr double DefaultMaxSegmentSeconds = 24.0 * 60.0 * 60.0;
+
+private:
+	/** Choose the next segment's path and forget the current one's definitions; its header is written with its first event */
+	void StartSegment();
+
+	/** Whether the current segment is full, or an event with this many fields could run out of ids */
+	bool NeedsRotation(int32 NumFields) const;
+
+	/** Append the pending batch to the segment; on failure the batch is dropped and a new segment started */
+	bool WritePending();
+
+	/** Id of a type or key in this segment, encoding its definition the first time */
+	uint16 InternType(FName Type);
+	uint16 InternKey(const TCHAR* Key);
+
+	/** Start a record in the pending batch; EndRecord fills in its length */
+	int32 BeginRecord(uint8 Kind);
+	void EndRecord(int32 RecordStart);
+
+	void AppendString(const TCHAR* Text, int32 Length);
+
+	static void CompressInBackground(const FString& Path);
+
+	/** Write this session's marker, if it hasn't been yet */
+	void WriteSessionMarker();
+
+	/**
+	 * The oldest first segment of a session still writing to the directory, given this session's own;
+	 * markers left by processes that have gone are deleted
+	 */
+	static FString FindOldestLiveSegment(const FString& ScanDirectory, const FString& OwnFirstSegment);
+
+	FString Directory;
+
+	/** Name of this writer's first segment, and its marker once written */
+	FString FirstSegmentName;
+	FString SessionMarkerPath;
+
+	mutable FCriticalSection PathLock;
+	FString SegmentPath;
+
+	TUniquePtr<IFileHandle> File;
+	TArray<uint8> Pending;
+
+	/** Bytes written to the segment so far, and when it was started */
+	int64 SegmentSize = 0;
+	double SegmentStartSeconds = 0.0;
+	bool bSegmentHasHeader = false;
+
+	/** This segment's interned types and keys; keys are literals, so they are found by pointer and checked by content */
+	TMap<FName, uint16> TypeIds;
+	TArray<FString> KeyNames;
+	TMap<const TCHAR*, uint16> KeyIds;
+
+	std::atomic<int64> MaxSegmentBytes;
+	std::atomic<double> MaxSegmentSeconds;
+
+	/** Compressions running on the thread pool, across every writer */
+	static std::atomic<int32> NumCompressing;
+	static FCriticalSection CompressingLock;
+	static TSet<FString> CompressingPaths;
+};
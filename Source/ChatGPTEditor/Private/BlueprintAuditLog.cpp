@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BlueprintAuditLog.h"
+#include "AuditLogger.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
@@ -50,12 +51,45 @@ void FBlueprintAuditLog::AddEntry(EBlueprintAuditType Type, const FString& Descr
 	Entry.GeneratedContent = GeneratedContent;
 	Entry.bWasApproved = false;
 
+	// Kept here for ExportToFile, and written to the shared audit log with everything else
+	FAuditEvent Event(EAuditSource::Blueprint, GetEventType(Type));
+	Event.Timestamp = Entry.Timestamp;
+	Event.AddMessage(Description);
+	if (!UserPrompt.IsEmpty())
+	{
+		Event.Add(TEXT("Prompt"), UserPrompt);
+	}
+	if (!GeneratedContent.IsEmpty())
+	{
+		Event.Add(TEXT("Content"), GeneratedContent);
+	}
+	FAuditLogger::Get().Submit(MoveTemp(Event));
+
 	Entries.Add(Entry);
 
 	// Log to output for debugging
 	UE_LOG(LogTemp, Log, TEXT("[BlueprintAudit] %s: %s"), *Entry.Timestamp.ToString(), *Description);
 }
 
+FName FBlueprintAuditLog::GetEventType(EBlueprintAuditType Type)
+{
+	switch (Type)
+	{
+	case EBlueprintAuditType::Generation:
+		return TEXT("BLUEPRINT_GENERATION");
+	case EBlueprintAuditType::Explanation:
+		return TEXT("BLUEPRINT_EXPLANATION");
+	case EBlueprintAuditType::PreviewShown:
+		return TEXT("BLUEPRINT_PREVIEW");
+	case EBlueprintAuditType::UserApproved:
+		return TEXT("BLUEPRINT_APPROVED");
+	case EBlueprintAuditType::UserRejected:
+		return TEXT("BLUEPRINT_REJECTED");
+	default:
+		return TEXT("BLUEPRINT_UNKNOWN");
+	}
+}
+
 bool FBlueprintAuditLog::ExportToFile(const FString& FilePath) const
 {
 	FString LogContent = TEXT("Blueprint Scripting Assistant - Audit Log\n");
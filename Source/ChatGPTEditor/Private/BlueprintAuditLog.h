@@ -39,6 +39,7 @@ struct FBlueprintAuditEntry
 /**
  * Audit logging system for Blueprint Scripting Assistant
  * Tracks all Blueprint generation and explanation requests for security and compliance
+ * Entries are kept for ExportToFile and also submitted to FAuditLogger, so the audit log has them in order with everything else
  */
 class FBlueprintAuditLog
 {
@@ -76,4 +77,7 @@ private:
 	TArray<FBlueprintAuditEntry> Entries;
 
 	void AddEntry(EBlueprintAuditType Type, const FString& Description, const FString& UserPrompt = TEXT(""), const FString& GeneratedContent = TEXT(""));
+
+	/** Event type of an entry in the shared audit log */
+	static FName GetEventType(EBlueprintAuditType Type);
 };
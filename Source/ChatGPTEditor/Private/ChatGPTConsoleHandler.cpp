@@ -1,11 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ChatGPTConsoleHandler.h"
+#include "AuditLogger.h"
 #include "Engine/Engine.h"
 #include "Misc/MessageDialog.h"
-#include "HAL/PlatformFileManager.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "ChatGPTConsoleHandler"
 
@@ -193,27 +191,14 @@ bool FChatGPTConsoleHandler::ParseNaturalLanguageCommand(const FString& NaturalL
 
 void FChatGPTConsoleHandler::LogCommandExecution(const FString& Command, bool bSuccess, const FString& ErrorMessage)
 {
-	// Get the audit log path
-	FString AuditLogPath = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
-	
-	// Ensure directory exists
-	FString LogDir = FPaths::GetPath(AuditLogPath);
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*LogDir))
+	FAuditEvent Event(EAuditSource::Console, TEXT("CONSOLE_COMMAND"));
+	Event.AddMessage(Command)
+		.AddBool(TEXT("Success"), bSuccess);
+	if (!ErrorMessage.IsEmpty())
 	{
-		PlatformFile.CreateDirectoryTree(*LogDir);
+		Event.Add(TEXT("Error"), ErrorMessage);
 	}
-	
-	// Format log entry
-	FDateTime Now = FDateTime::Now();
-	FString LogEntry = FString::Printf(TEXT("[%s] CONSOLE_COMMAND: %s | Success: %s%s\n"),
-		*Now.ToString(),
-		*Command,
-		bSuccess ? TEXT("YES") : TEXT("NO"),
-		ErrorMessage.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" | Error: %s"), *ErrorMessage));
-	
-	// Append to log file
-	FFileHelper::SaveStringToFile(LogEntry, *AuditLogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	FAuditLogger::Get().Submit(MoveTemp(Event));
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -4,6 +4,7 @@
 #include "SChatGPTWindow.h"
 #include "MCP/SMCPTestWindow.h"
 #include "AuditLogger.h"
+#include "SceneEditingManager.h"
 #include "Styling/SlateStyleRegistry.h"
 #include "Framework/Application/SlateApplication.h"
 #include "LevelEditor.h"
@@ -24,6 +25,12 @@ void FChatGPTEditorModule::StartupModule()
 	FAuditLogger::Get().Initialize();
 	FAuditLogger::Get().LogEvent(TEXT("MODULE_STARTUP"), TEXT("ChatGPT Editor module started"));
 	
+	// Headless runs (e.g. the ChatGPTEditorMCP commandlet) have no tabs to spawn
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+	
 	// Register legacy ChatGPT tab spawner - Make it visible in the Window menu
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(ChatGPTEditorTabName, FOnSpawnTab::CreateRaw(this, &FChatGPTEditorModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FChatGPTEditorTabTitle", "ChatGPT (Legacy)"))
@@ -41,9 +48,15 @@ void FChatGPTEditorModule::ShutdownModule()
 	FAuditLogger::Get().LogEvent(TEXT("MODULE_SHUTDOWN"), TEXT("ChatGPT Editor module shutting down"));
 	FAuditLogger::Get().Shutdown();
 	
+	// Release the scene actor index before the engine delegates it listens to go away
+	FSceneEditingManager::Get().Shutdown();
+	
 	// Unregister tab spawners
-	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ChatGPTEditorTabName);
-	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(MCPTestWindowTabName);
+	if (!IsRunningCommandlet())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ChatGPTEditorTabName);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(MCPTestWindowTabName);
+	}
 }
 
 TSharedRef<SDockTab> FChatGPTEditorModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
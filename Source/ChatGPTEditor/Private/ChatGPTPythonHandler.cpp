@@ -1,10 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ChatGPTPythonHandler.h"
+#include "AuditLogger.h"
 #include "Misc/MessageDialog.h"
-#include "HAL/PlatformFileManager.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
 
 // Python execution support
 #if defined(WITH_PYTHON) && WITH_PYTHON
@@ -210,30 +208,18 @@ bool FChatGPTPythonHandler::IsPythonScriptRequest(const FString& NaturalLanguage
 
 void FChatGPTPythonHandler::LogScriptExecution(const FString& Script, bool bSuccess, const FString& ErrorMessage)
 {
-	// Get the audit log path
-	FString AuditLogPath = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
-	
-	// Ensure directory exists
-	FString LogDir = FPaths::GetPath(AuditLogPath);
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*LogDir))
-	{
-		PlatformFile.CreateDirectoryTree(*LogDir);
-	}
-	
-	// Format log entry - sanitize script for logging (truncate if too long)
+	// Sanitize script for logging (truncate if too long)
 	FString ScriptPreview = Script.Len() > 200 ? Script.Left(200) + TEXT("...") : Script;
 	ScriptPreview.ReplaceInline(TEXT("\n"), TEXT(" "));
-	
-	FDateTime Now = FDateTime::Now();
-	FString LogEntry = FString::Printf(TEXT("[%s] PYTHON_SCRIPT: %s | Success: %s%s\n"),
-		*Now.ToString(),
-		*ScriptPreview,
-		bSuccess ? TEXT("YES") : TEXT("NO"),
-		ErrorMessage.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" | Error: %s"), *ErrorMessage));
-	
-	// Append to log file
-	FFileHelper::SaveStringToFile(LogEntry, *AuditLogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+	FAuditEvent Event(EAuditSource::Python, TEXT("PYTHON_SCRIPT"));
+	Event.AddMessage(MoveTemp(ScriptPreview))
+		.AddBool(TEXT("Success"), bSuccess);
+	if (!ErrorMessage.IsEmpty())
+	{
+		Event.Add(TEXT("Error"), ErrorMessage);
+	}
+	FAuditLogger::Get().Submit(MoveTemp(Event));
 }
 
 FString FChatGPTPythonHandler::SanitizeScriptForPreview(const FString& Script) const
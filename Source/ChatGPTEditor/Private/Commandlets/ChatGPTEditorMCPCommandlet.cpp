@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ChatGPTEditorMCPCommandlet.h"
+#include "ChatGPTEditor.h"
+#include "AuditLogger.h"
+#include "MCP/MCPServer.h"
+#include "MCP/MCPTransport.h"
+#include "MCP/Tools/MCPBuiltInTools.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDeviceConsole.h"
+
+namespace ChatGPTEditorMCPCommandlet
+{
+	static constexpr int32 DefaultTcpPort = 8765;
+
+	static double BytesToMegabytes(uint64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+}
+
+UChatGPTEditorMCPCommandlet::UChatGPTEditorMCPCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = false;
+	ShowErrorCount = false;
+}
+
+int32 UChatGPTEditorMCPCommandlet::Main(const FString& Params)
+{
+	using namespace ChatGPTEditorMCPCommandlet;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const bool bUseTcp = ParamValues.FindRef(TEXT("transport")).Equals(TEXT("tcp"), ESearchCase::IgnoreCase);
+	const FString* PortValue = ParamValues.Find(TEXT("port"));
+	const int32 Port = PortValue ? FCString::Atoi(**PortValue) : DefaultTcpPort;
+
+	// stdout carries the protocol; keep log lines out of it
+	if (!bUseTcp && GLogConsole)
+	{
+		GLog->RemoveOutputDevice(GLogConsole);
+	}
+
+	// Tools that edit the scene need a level; the default is the editor's startup map
+	if (const FString* MapPath = ParamValues.Find(TEXT("map")))
+	{
+		if (!FEditorFileUtils::LoadMap(*MapPath, false, false))
+		{
+			UE_LOG(LogChatGPTEditor, Error, TEXT("ChatGPTEditorMCP: failed to load map %s"), **MapPath);
+			return 1;
+		}
+	}
+
+	FMCPServer Server;
+	Server.Initialize();
+	MCPTools::RegisterBuiltInTools(Server);
+
+	TSharedPtr<FMCPTransport, ESPMode::ThreadSafe> Transport;
+	if (bUseTcp)
+	{
+		Transport = MakeShared<FMCPTcpTransport, ESPMode::ThreadSafe>(Server, Port);
+	}
+	else
+	{
+		Transport = MakeShared<FMCPStdioTransport, ESPMode::ThreadSafe>(Server);
+	}
+
+	if (!Transport->Start())
+	{
+		UE_LOG(LogChatGPTEditor, Error, TEXT("ChatGPTEditorMCP: failed to start %s transport"), bUseTcp ? TEXT("TCP") : TEXT("stdio"));
+		return 1;
+	}
+
+	// Startup cost as seen by a CI agent: process launch to accepting requests
+	const double ReadySeconds = FPlatformTime::Seconds() - GStartTime;
+	const FPlatformMemoryStats ReadyMemory = FPlatformMemory::GetStats();
+	const FString ReadyMessage = FString::Printf(TEXT("MCP commandlet ready in %.2f s, %.1f MB resident (peak %.1f MB), transport=%s"),
+		ReadySeconds, BytesToMegabytes(ReadyMemory.UsedPhysical), BytesToMegabytes(ReadyMemory.PeakUsedPhysical),
+		bUseTcp ? TEXT("tcp") : TEXT("stdio"));
+	UE_LOG(LogChatGPTEditor, Display, TEXT("%s"), *ReadyMessage);
+	FAuditLogger::Get().LogEvent(TEXT("MCP_COMMANDLET_READY"), ReadyMessage);
+
+	// Tools run on the game thread; pump its task queue and the core ticker until told to stop.
+	// The TCP transport keeps listening after a client leaves, so it runs until the process is asked to exit.
+	double LastTickTime = FPlatformTime::Seconds();
+	while (!IsEngineExitRequested() && !Transport->IsClosedByPeer())
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		const float DeltaSeconds = static_cast<float>(CurrentTime - LastTickTime);
+		LastTickTime = CurrentTime;
+
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaSeconds);
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	Transport->Stop();
+	Transport.Reset();
+
+	// Let async tool calls that were still completing finish before the server goes away
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	Server.Shutdown();
+
+	const FPlatformMemoryStats FinalMemory = FPlatformMemory::GetStats();
+	const FString ExitMessage = FString::Printf(TEXT("MCP commandlet exiting after %.1f s, peak %.1f MB resident"),
+		FPlatformTime::Seconds() - GStartTime, BytesToMegabytes(FinalMemory.PeakUsedPhysical));
+	UE_LOG(LogChatGPTEditor, Display, TEXT("%s"), *ExitMessage);
+	FAuditLogger::Get().LogEvent(TEXT("MCP_COMMANDLET_EXIT"), ExitMessage);
+
+	return 0;
+}
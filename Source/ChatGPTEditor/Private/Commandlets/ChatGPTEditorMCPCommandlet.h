@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChatGPTEditorMCPCommandlet.generated.h"
+
+/**
+ * Headless MCP server for CI agents and batch scene-processing jobs
+ * Brings up only the MCP server, its built-in tools and the audit logger (no Slate windows) and
+ * serves newline-delimited JSON-RPC until the client disconnects or the process is asked to exit.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=ChatGPTEditorMCP -nullrhi -unattended -nosplash
+ *       [-transport=stdio|tcp] [-port=8765] [-map=/Game/Maps/MyLevel]
+ *
+ * With the stdio transport, stdout carries the protocol; do not pass -stdout.
+ */
+UCLASS()
+class UChatGPTEditorMCPCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChatGPTEditorMCPCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,418 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCP/MCPJsonWriter.h"
+
+FMCPJsonWriter::FMCPJsonWriter(TArray<uint8>& InBuffer)
+	: Buffer(InBuffer)
+	, Depth(0)
+	, NumBufferGrowths(0)
+	, bNeedsComma(false)
+{
+}
+
+void FMCPJsonWriter::WriteObjectStart()
+{
+	WriteSeparator();
+	PushContainer('{');
+}
+
+void FMCPJsonWriter::WriteObjectStart(const ANSICHAR* Identifier)
+{
+	WriteIdentifier(Identifier);
+	PushContainer('{');
+}
+
+void FMCPJsonWriter::WriteObjectEnd()
+{
+	PopContainer('}');
+}
+
+void FMCPJsonWriter::WriteArrayStart()
+{
+	WriteSeparator();
+	PushContainer('[');
+}
+
+void FMCPJsonWriter::WriteArrayStart(const ANSICHAR* Identifier)
+{
+	WriteIdentifier(Identifier);
+	PushContainer('[');
+}
+
+void FMCPJsonWriter::WriteArrayEnd()
+{
+	PopContainer(']');
+}
+
+void FMCPJsonWriter::WriteIdentifier(const ANSICHAR* Identifier)
+{
+	if (bNeedsComma)
+	{
+		AppendByte(',');
+	}
+	AppendByte('"');
+	AppendAnsi(Identifier);
+	AppendAnsi("\":", 2);
+
+	// The value that follows belongs to this key
+	bNeedsComma = false;
+}
+
+void FMCPJsonWriter::WriteValue(FStringView Value)
+{
+	WriteSeparator();
+	WriteEscapedString(Value);
+}
+
+void FMCPJsonWriter::WriteValue(int64 Value)
+{
+	WriteSeparator();
+
+	ANSICHAR Digits[24];
+	int32 Length = 0;
+	uint64 Magnitude = Value < 0 ? static_cast<uint64>(-(Value + 1)) + 1 : static_cast<uint64>(Value);
+	do
+	{
+		Digits[Length++] = static_cast<ANSICHAR>('0' + (Magnitude % 10));
+		Magnitude /= 10;
+	}
+	while (Magnitude != 0);
+
+	if (Value < 0)
+	{
+		AppendByte('-');
+	}
+	while (Length > 0)
+	{
+		AppendByte(static_cast<uint8>(Digits[--Length]));
+	}
+}
+
+void FMCPJsonWriter::WriteValue(double Value)
+{
+	// Integral values (ids, counts, coordinates) print without an exponent or fraction
+	if (FMath::IsFinite(Value) && FMath::Abs(Value) < 9007199254740992.0 && Value == FMath::FloorToDouble(Value))
+	{
+		WriteValue(static_cast<int64>(Value));
+		return;
+	}
+
+	WriteSeparator();
+
+	if (!FMath::IsFinite(Value))
+	{
+		// JSON has no NaN/Inf
+		AppendAnsi("null", 4);
+		return;
+	}
+
+	ANSICHAR Number[32];
+	const int32 Length = FCStringAnsi::Snprintf(Number, UE_ARRAY_COUNT(Number), "%.17g", Value);
+	AppendAnsi(Number, FMath::Clamp(Length, 0, static_cast<int32>(UE_ARRAY_COUNT(Number)) - 1));
+}
+
+void FMCPJsonWriter::WriteValue(bool Value)
+{
+	WriteSeparator();
+	if (Value)
+	{
+		AppendAnsi("true", 4);
+	}
+	else
+	{
+		AppendAnsi("false", 5);
+	}
+}
+
+void FMCPJsonWriter::WriteNull()
+{
+	WriteSeparator();
+	AppendAnsi("null", 4);
+}
+
+void FMCPJsonWriter::WriteRawJSONValue(const TArray<uint8>& Utf8Json)
+{
+	WriteSeparator();
+
+	const int32 PreviousMax = Buffer.Max();
+	Buffer.Append(Utf8Json);
+	NoteGrowth(PreviousMax);
+}
+
+void FMCPJsonWriter::WriteRawJSONValue(const ANSICHAR* Identifier, const TArray<uint8>& Utf8Json)
+{
+	WriteIdentifier(Identifier);
+	WriteRawJSONValue(Utf8Json);
+}
+
+void FMCPJsonWriter::WriteJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	switch (Value->Type)
+	{
+		case EJson::String:
+			WriteValue(Value->AsString());
+			break;
+
+		case EJson::Number:
+			WriteValue(Value->AsNumber());
+			break;
+
+		case EJson::Boolean:
+			WriteValue(Value->AsBool());
+			break;
+
+		case EJson::Array:
+		{
+			WriteArrayStart();
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				WriteJsonValue(Element);
+			}
+			WriteArrayEnd();
+			break;
+		}
+
+		case EJson::Object:
+			WriteJsonObject(Value->AsObject());
+			break;
+
+		case EJson::None:
+		case EJson::Null:
+		default:
+			WriteNull();
+			break;
+	}
+}
+
+void FMCPJsonWriter::WriteJsonObject(const TSharedPtr<FJsonObject>& Object)
+{
+	if (!Object.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	WriteObjectStart();
+	for (const auto& FieldPair : Object->Values)
+	{
+		// DOM keys are arbitrary strings, so escape them like values
+		if (bNeedsComma)
+		{
+			AppendByte(',');
+		}
+		WriteEscapedString(FieldPair.Key);
+		AppendByte(':');
+		bNeedsComma = false;
+
+		WriteJsonValue(FieldPair.Value);
+	}
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteJsonObject(const ANSICHAR* Identifier, const TSharedPtr<FJsonObject>& Object)
+{
+	WriteIdentifier(Identifier);
+	WriteJsonObject(Object);
+}
+
+void FMCPJsonWriter::BeginResultResponse(const FMCPRequestId& Id)
+{
+	WriteObjectStart();
+	WriteValue("jsonrpc", TEXT("2.0"));
+	WriteIdentifier("id");
+	Id.Write(*this);
+	WriteIdentifier("result");
+}
+
+void FMCPJsonWriter::EndResponse()
+{
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteErrorResponse(const FMCPRequestId& Id, int32 Code, FStringView Message)
+{
+	WriteObjectStart();
+	WriteValue("jsonrpc", TEXT("2.0"));
+	WriteIdentifier("id");
+	Id.Write(*this);
+	WriteObjectStart("error");
+	WriteValue("code", Code);
+	WriteIdentifier("message");
+	WriteValue(Message);
+	WriteObjectEnd();
+	WriteObjectEnd();
+}
+
+FMCPJsonWriter::FMark FMCPJsonWriter::GetMark() const
+{
+	FMark Mark;
+	Mark.BufferSize = Buffer.Num();
+	Mark.Depth = Depth;
+	Mark.bNeedsComma = bNeedsComma;
+	return Mark;
+}
+
+void FMCPJsonWriter::RestoreMark(const FMark& Mark)
+{
+	Buffer.SetNum(Mark.BufferSize, EAllowShrinking::No);
+	Depth = Mark.Depth;
+	bNeedsComma = Mark.bNeedsComma;
+}
+
+FString FMCPJsonWriter::ToString(const TArray<uint8>& Utf8Json)
+{
+	if (Utf8Json.Num() == 0)
+	{
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void FMCPJsonWriter::WriteSeparator()
+{
+	if (bNeedsComma)
+	{
+		AppendByte(',');
+	}
+	bNeedsComma = true;
+}
+
+void FMCPJsonWriter::PushContainer(ANSICHAR OpenChar)
+{
+	AppendByte(static_cast<uint8>(OpenChar));
+	bNeedsComma = false;
+	++Depth;
+}
+
+void FMCPJsonWriter::PopContainer(ANSICHAR CloseChar)
+{
+	check(Depth > 0);
+	AppendByte(static_cast<uint8>(CloseChar));
+	--Depth;
+
+	// The closed container is a complete value in its parent
+	bNeedsComma = true;
+}
+
+void FMCPJsonWriter::WriteEscapedString(FStringView Value)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	const int32 PreviousMax = Buffer.Max();
+
+	// Worst case is 6 bytes per TCHAR (\u00XX); typical text is close to 1:1
+	Buffer.Reserve(Buffer.Num() + Value.Len() + 2);
+	Buffer.Add('"');
+
+	const TCHAR* Chars = Value.GetData();
+	const int32 Length = Value.Len();
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		uint32 CodePoint = static_cast<uint32>(Chars[Index]);
+
+		if (CodePoint >= 0x20 && CodePoint < 0x80)
+		{
+			if (CodePoint == '"' || CodePoint == '\\')
+			{
+				Buffer.Add('\\');
+			}
+			Buffer.Add(static_cast<uint8>(CodePoint));
+			continue;
+		}
+
+		if (CodePoint < 0x20)
+		{
+			Buffer.Add('\\');
+			switch (CodePoint)
+			{
+				case '\n': Buffer.Add('n'); break;
+				case '\r': Buffer.Add('r'); break;
+				case '\t': Buffer.Add('t'); break;
+				case '\b': Buffer.Add('b'); break;
+				case '\f': Buffer.Add('f'); break;
+				default:
+					Buffer.Add('u');
+					Buffer.Add('0');
+					Buffer.Add('0');
+					Buffer.Add(static_cast<uint8>(HexDigits[(CodePoint >> 4) & 0xF]));
+					Buffer.Add(static_cast<uint8>(HexDigits[CodePoint & 0xF]));
+					break;
+			}
+			continue;
+		}
+
+		// Combine UTF-16 surrogate pairs (TCHAR is 16-bit on Windows)
+		if (sizeof(TCHAR) == 2 && CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Index + 1 < Length)
+		{
+			const uint32 LowSurrogate = static_cast<uint32>(Chars[Index + 1]);
+			if (LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+				++Index;
+			}
+		}
+
+		if (CodePoint > 0x10FFFF || (CodePoint >= 0xD800 && CodePoint <= 0xDFFF))
+		{
+			// Unpaired surrogate or out of range: U+FFFD replacement character
+			CodePoint = 0xFFFD;
+		}
+
+		if (CodePoint < 0x800)
+		{
+			Buffer.Add(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Buffer.Add(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Buffer.Add(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	Buffer.Add('"');
+	NoteGrowth(PreviousMax);
+}
+
+void FMCPJsonWriter::AppendAnsi(const ANSICHAR* Text, int32 Length)
+{
+	const int32 PreviousMax = Buffer.Max();
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), Length);
+	NoteGrowth(PreviousMax);
+}
+
+void FMCPJsonWriter::AppendAnsi(const ANSICHAR* Text)
+{
+	AppendAnsi(Text, FCStringAnsi::Strlen(Text));
+}
+
+void FMCPJsonWriter::AppendByte(uint8 Byte)
+{
+	const int32 PreviousMax = Buffer.Max();
+	Buffer.Add(Byte);
+	NoteGrowth(PreviousMax);
+}
+
+void FMCPJsonWriter::NoteGrowth(int32 PreviousMax)
+{
+	if (Buffer.Max() != PreviousMax)
+	{
+		++NumBufferGrowths;
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCP/MCPMessageFramer.h"
+#include <cstring>
+
+FMCPMessageFramer::FMCPMessageFramer(int32 InMaxMessageBytes)
+	: MessageStart(0)
+	, ScanOffset(0)
+	, MaxMessageBytes(InMaxMessageBytes)
+	, NumDroppedMessages(0)
+	, bDiscarding(false)
+{
+}
+
+void FMCPMessageFramer::Append(const uint8* Data, int32 NumBytes)
+{
+	if (NumBytes > 0)
+	{
+		Buffer.Append(Data, NumBytes);
+	}
+}
+
+bool FMCPMessageFramer::NextMessage(FString& OutMessage)
+{
+	while (ScanOffset < Buffer.Num())
+	{
+		// Resume where the previous call stopped; bytes are never scanned twice
+		const uint8* ScanStart = Buffer.GetData() + ScanOffset;
+		const uint8* Delimiter = static_cast<const uint8*>(memchr(ScanStart, '\n', Buffer.Num() - ScanOffset));
+		
+		if (!Delimiter)
+		{
+			ScanOffset = Buffer.Num();
+			
+			if (Buffer.Num() - MessageStart > MaxMessageBytes)
+			{
+				// Drop what we have and skip to the next delimiter
+				if (!bDiscarding)
+				{
+					++NumDroppedMessages;
+					bDiscarding = true;
+				}
+				MessageStart = ScanOffset;
+			}
+			break;
+		}
+		
+		const int32 DelimiterIndex = static_cast<int32>(Delimiter - Buffer.GetData());
+		const int32 LineStart = MessageStart;
+		int32 LineEnd = DelimiterIndex;
+		
+		MessageStart = DelimiterIndex + 1;
+		ScanOffset = MessageStart;
+		
+		if (bDiscarding)
+		{
+			bDiscarding = false;
+			continue;
+		}
+		
+		if (LineEnd - LineStart > MaxMessageBytes)
+		{
+			++NumDroppedMessages;
+			continue;
+		}
+		
+		// Tolerate CRLF and surrounding whitespace from hand-written clients
+		while (LineEnd > LineStart && FChar::IsWhitespace(static_cast<TCHAR>(Buffer[LineEnd - 1])))
+		{
+			--LineEnd;
+		}
+		int32 TrimmedStart = LineStart;
+		while (TrimmedStart < LineEnd && FChar::IsWhitespace(static_cast<TCHAR>(Buffer[TrimmedStart])))
+		{
+			++TrimmedStart;
+		}
+		
+		if (TrimmedStart == LineEnd)
+		{
+			continue;
+		}
+		
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + TrimmedStart), LineEnd - TrimmedStart);
+		OutMessage = FString(Converted.Length(), Converted.Get());
+		return true;
+	}
+	
+	Compact();
+	return false;
+}
+
+void FMCPMessageFramer::Reset()
+{
+	Buffer.Reset();
+	MessageStart = 0;
+	ScanOffset = 0;
+	bDiscarding = false;
+}
+
+void FMCPMessageFramer::Compact()
+{
+	if (MessageStart == 0)
+	{
+		return;
+	}
+	
+	// Only the partial message is moved; consumed lines are simply dropped
+	const int32 NumPending = Buffer.Num() - MessageStart;
+	if (NumPending > 0)
+	{
+		FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + MessageStart, NumPending);
+	}
+	Buffer.SetNum(NumPending, EAllowShrinking::No);
+	
+	ScanOffset -= MessageStart;
+	MessageStart = 0;
+}
@@ -0,0 +1,560 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCP/MCPSchemaValidator.h"
+
+namespace
+{
+	/** Guards against self-referencing or absurdly deep schemas */
+	constexpr int32 MaxSchemaDepth = 32;
+
+	const TCHAR* GetTypeName(EMCPSchemaType Type)
+	{
+		switch (Type)
+		{
+			case EMCPSchemaType::Null: return TEXT("null");
+			case EMCPSchemaType::Boolean: return TEXT("boolean");
+			case EMCPSchemaType::Integer: return TEXT("integer");
+			case EMCPSchemaType::Number: return TEXT("number");
+			case EMCPSchemaType::String: return TEXT("string");
+			case EMCPSchemaType::Array: return TEXT("array");
+			case EMCPSchemaType::Object: return TEXT("object");
+			default: return TEXT("any");
+		}
+	}
+
+	bool ParseTypeName(const FString& TypeName, EMCPSchemaType& OutType)
+	{
+		static const TPair<const TCHAR*, EMCPSchemaType> TypeNames[] =
+		{
+			{ TEXT("null"), EMCPSchemaType::Null },
+			{ TEXT("boolean"), EMCPSchemaType::Boolean },
+			{ TEXT("integer"), EMCPSchemaType::Integer },
+			{ TEXT("number"), EMCPSchemaType::Number },
+			{ TEXT("string"), EMCPSchemaType::String },
+			{ TEXT("array"), EMCPSchemaType::Array },
+			{ TEXT("object"), EMCPSchemaType::Object }
+		};
+
+		for (const TPair<const TCHAR*, EMCPSchemaType>& Entry : TypeNames)
+		{
+			if (TypeName.Equals(Entry.Key, ESearchCase::CaseSensitive))
+			{
+				OutType = Entry.Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FString ToCondensedJson(const TSharedPtr<FJsonValue>& Value)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Value, FString(), Writer);
+		return Json;
+	}
+
+	FString MakeInvalidArgumentError(const FString& Path, const FString& Reason)
+	{
+		return FString::Printf(TEXT("Invalid argument '%s': %s"), *Path, *Reason);
+	}
+}
+
+const FMCPArgumentValue* FMCPToolArguments::Find(const TCHAR* Path) const
+{
+	if (!Validator.IsValid())
+	{
+		return nullptr;
+	}
+
+	const int32 Slot = Validator->FindSlot(Path);
+	return Slot != INDEX_NONE ? &Values[Slot] : nullptr;
+}
+
+bool FMCPToolArguments::IsSet(const TCHAR* Path) const
+{
+	const FMCPArgumentValue* Value = Find(Path);
+	return Value && Value->bIsSet;
+}
+
+FString FMCPToolArguments::GetString(const TCHAR* Path, const FString& Default) const
+{
+	const FMCPArgumentValue* Value = Find(Path);
+	return Value && Value->bIsSet ? Value->StringValue : Default;
+}
+
+double FMCPToolArguments::GetNumber(const TCHAR* Path, double Default) const
+{
+	const FMCPArgumentValue* Value = Find(Path);
+	return Value && Value->bIsSet ? Value->NumberValue : Default;
+}
+
+int32 FMCPToolArguments::GetInteger(const TCHAR* Path, int32 Default) const
+{
+	const FMCPArgumentValue* Value = Find(Path);
+	return Value && Value->bIsSet ? static_cast<int32>(Value->NumberValue) : Default;
+}
+
+bool FMCPToolArguments::GetBool(const TCHAR* Path, bool Default) const
+{
+	const FMCPArgumentValue* Value = Find(Path);
+	return Value && Value->bIsSet ? Value->BoolValue : Default;
+}
+
+FMCPSchemaValidatorPtr FMCPSchemaValidator::Compile(const TSharedPtr<FJsonObject>& Schema, FString& OutError)
+{
+	if (!Schema.IsValid())
+	{
+		OutError = TEXT("Input schema is missing");
+		return nullptr;
+	}
+
+	TSharedRef<FMCPSchemaValidator, ESPMode::ThreadSafe> Validator = MakeShared<FMCPSchemaValidator, ESPMode::ThreadSafe>();
+	const int32 RootNode = Validator->CompileNode(Schema, FString(), false, 0, OutError);
+	if (RootNode == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	if (Validator->Nodes[RootNode].Type != EMCPSchemaType::Object)
+	{
+		OutError = TEXT("Input schema must describe an object");
+		return nullptr;
+	}
+
+	return Validator;
+}
+
+int32 FMCPSchemaValidator::CompileNode(const TSharedPtr<FJsonObject>& Schema, const FString& Path, bool bHasSlot, int32 Depth, FString& OutError)
+{
+	if (Depth > MaxSchemaDepth)
+	{
+		OutError = FString::Printf(TEXT("Input schema is nested too deeply at '%s'"), *Path);
+		return INDEX_NONE;
+	}
+
+	// Nodes may reallocate while children compile, so only indices are kept across recursion
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	Nodes[NodeIndex].Path = Path;
+	if (bHasSlot)
+	{
+		Nodes[NodeIndex].Slot = SlotPaths.Add(Path);
+	}
+
+	// A property listed only in "required" has no schema of its own
+	if (!Schema.IsValid())
+	{
+		return NodeIndex;
+	}
+
+	{
+		FNode& Node = Nodes[NodeIndex];
+
+		FString TypeName;
+		if (Schema->TryGetStringField(TEXT("type"), TypeName))
+		{
+			if (!ParseTypeName(TypeName, Node.Type))
+			{
+				OutError = FString::Printf(TEXT("Unsupported schema type '%s' at '%s'"), *TypeName, *Path);
+				return INDEX_NONE;
+			}
+		}
+		else if (Schema->HasField(TEXT("properties")))
+		{
+			Node.Type = EMCPSchemaType::Object;
+		}
+
+		double Limit = 0.0;
+		if (Schema->TryGetNumberField(TEXT("minimum"), Limit))
+		{
+			Node.Minimum = Limit;
+		}
+		if (Schema->TryGetNumberField(TEXT("maximum"), Limit))
+		{
+			Node.Maximum = Limit;
+		}
+		if (Schema->TryGetNumberField(TEXT("minLength"), Limit))
+		{
+			Node.MinLength = static_cast<int32>(Limit);
+		}
+		if (Schema->TryGetNumberField(TEXT("maxLength"), Limit))
+		{
+			Node.MaxLength = static_cast<int32>(Limit);
+		}
+		if (Schema->TryGetNumberField(TEXT("minItems"), Limit))
+		{
+			Node.MinItems = static_cast<int32>(Limit);
+		}
+		if (Schema->TryGetNumberField(TEXT("maxItems"), Limit))
+		{
+			Node.MaxItems = static_cast<int32>(Limit);
+		}
+
+		// Only string enums are enforced
+		const TArray<TSharedPtr<FJsonValue>>* EnumValues = nullptr;
+		if (Schema->TryGetArrayField(TEXT("enum"), EnumValues))
+		{
+			for (const TSharedPtr<FJsonValue>& EnumValue : *EnumValues)
+			{
+				if (!EnumValue.IsValid() || EnumValue->Type != EJson::String)
+				{
+					Node.EnumValues.Reset();
+					break;
+				}
+				Node.EnumValues.Add(EnumValue->AsString());
+			}
+		}
+
+		Node.bHasDefault = ReadLiteral(Schema->TryGetField(TEXT("default")), Node.Default);
+		Node.Default.Type = Node.Type;
+
+		bool bAdditionalProperties = true;
+		if (Schema->TryGetBoolField(TEXT("additionalProperties"), bAdditionalProperties))
+		{
+			Node.bAdditionalProperties = bAdditionalProperties;
+		}
+	}
+
+	const EMCPSchemaType Type = Nodes[NodeIndex].Type;
+
+	if (Type == EMCPSchemaType::Object)
+	{
+		const TSharedPtr<FJsonObject>* PropertiesObject = nullptr;
+		const bool bHasProperties = Schema->TryGetObjectField(TEXT("properties"), PropertiesObject);
+
+		TArray<FString> RequiredNames;
+		const TArray<TSharedPtr<FJsonValue>>* RequiredValues = nullptr;
+		if (Schema->TryGetArrayField(TEXT("required"), RequiredValues))
+		{
+			for (const TSharedPtr<FJsonValue>& RequiredValue : *RequiredValues)
+			{
+				FString RequiredName;
+				if (RequiredValue.IsValid() && RequiredValue->TryGetString(RequiredName))
+				{
+					RequiredNames.AddUnique(RequiredName);
+				}
+			}
+		}
+
+		// Reserve this object's property range before children append their own
+		TArray<FString> PropertyNames;
+		if (bHasProperties)
+		{
+			(*PropertiesObject)->Values.GetKeys(PropertyNames);
+		}
+		for (const FString& RequiredName : RequiredNames)
+		{
+			PropertyNames.AddUnique(RequiredName);
+		}
+
+		const int32 FirstProperty = Properties.Num();
+		Properties.AddDefaulted(PropertyNames.Num());
+		Nodes[NodeIndex].FirstProperty = FirstProperty;
+		Nodes[NodeIndex].NumProperties = PropertyNames.Num();
+
+		for (int32 Index = 0; Index < PropertyNames.Num(); ++Index)
+		{
+			const FString& PropertyName = PropertyNames[Index];
+
+			const TSharedPtr<FJsonObject>* PropertySchema = nullptr;
+			if (bHasProperties)
+			{
+				(*PropertiesObject)->TryGetObjectField(PropertyName, PropertySchema);
+			}
+
+			const FString PropertyPath = Path.IsEmpty() ? PropertyName : Path + TEXT(".") + PropertyName;
+			const int32 ChildNode = CompileNode(PropertySchema ? *PropertySchema : TSharedPtr<FJsonObject>(), PropertyPath, bHasSlot || Path.IsEmpty(), Depth + 1, OutError);
+			if (ChildNode == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			FProperty& Property = Properties[FirstProperty + Index];
+			Property.Name = PropertyName;
+			Property.Node = ChildNode;
+			Property.bRequired = RequiredNames.Contains(PropertyName);
+		}
+	}
+	else if (Type == EMCPSchemaType::Array)
+	{
+		// Items have no slots of their own; their values are collected into the array's slot
+		const TSharedPtr<FJsonObject>* ItemsSchema = nullptr;
+		if (Schema->TryGetObjectField(TEXT("items"), ItemsSchema))
+		{
+			const int32 ItemsNode = CompileNode(*ItemsSchema, Path + TEXT("[]"), false, Depth + 1, OutError);
+			if (ItemsNode == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+			Nodes[NodeIndex].ItemsNode = ItemsNode;
+		}
+	}
+
+	return NodeIndex;
+}
+
+bool FMCPSchemaValidator::Validate(const TSharedPtr<FJsonObject>& Arguments, FMCPToolArguments& OutArguments, FString& OutError) const
+{
+	OutArguments.Validator = AsShared();
+	OutArguments.Values.Reset();
+	OutArguments.Values.SetNum(SlotPaths.Num());
+
+	if (!Arguments.IsValid())
+	{
+		const FJsonObject EmptyArguments;
+		return ValidateObject(Nodes[0], EmptyArguments, OutArguments, OutError);
+	}
+
+	return ValidateObject(Nodes[0], *Arguments, OutArguments, OutError);
+}
+
+int32 FMCPSchemaValidator::FindSlot(const TCHAR* Path) const
+{
+	// Tool schemas have a handful of properties; a scan beats hashing the path
+	for (int32 Slot = 0; Slot < SlotPaths.Num(); ++Slot)
+	{
+		if (FCString::Strcmp(*SlotPaths[Slot], Path) == 0)
+		{
+			return Slot;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FMCPSchemaValidator::ValidateObject(const FNode& Node, const FJsonObject& Object, FMCPToolArguments& OutArguments, FString& OutError) const
+{
+	int32 NumMatchedFields = 0;
+
+	for (int32 Index = Node.FirstProperty; Index < Node.FirstProperty + Node.NumProperties; ++Index)
+	{
+		const FProperty& Property = Properties[Index];
+		const FNode& PropertyNode = Nodes[Property.Node];
+
+		const TSharedPtr<FJsonValue>* Field = Object.Values.Find(Property.Name);
+		if (!Field || !Field->IsValid())
+		{
+			if (Property.bRequired)
+			{
+				OutError = FString::Printf(TEXT("Missing required argument '%s'"), *PropertyNode.Path);
+				return false;
+			}
+
+			if (PropertyNode.bHasDefault && PropertyNode.Slot != INDEX_NONE)
+			{
+				OutArguments.Values[PropertyNode.Slot] = PropertyNode.Default;
+			}
+			continue;
+		}
+
+		++NumMatchedFields;
+
+		FMCPArgumentValue UnslottedValue;
+		FMCPArgumentValue& Target = PropertyNode.Slot != INDEX_NONE ? OutArguments.Values[PropertyNode.Slot] : UnslottedValue;
+		if (!ValidateValue(PropertyNode, *Field, OutArguments, Target, OutError))
+		{
+			return false;
+		}
+	}
+
+	if (!Node.bAdditionalProperties && NumMatchedFields != Object.Values.Num())
+	{
+		for (const auto& FieldPair : Object.Values)
+		{
+			bool bDeclared = false;
+			for (int32 Index = Node.FirstProperty; Index < Node.FirstProperty + Node.NumProperties && !bDeclared; ++Index)
+			{
+				bDeclared = Properties[Index].Name.Equals(FieldPair.Key, ESearchCase::IgnoreCase);
+			}
+
+			if (!bDeclared)
+			{
+				OutError = FString::Printf(TEXT("Unknown argument '%s'"),
+					Node.Path.IsEmpty() ? *FieldPair.Key : *(Node.Path + TEXT(".") + FieldPair.Key));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FMCPSchemaValidator::ValidateValue(const FNode& Node, const TSharedPtr<FJsonValue>& Value, FMCPToolArguments& OutArguments, FMCPArgumentValue& OutValue, FString& OutError) const
+{
+	const EJson JsonType = Value.IsValid() ? Value->Type : EJson::None;
+
+	auto TypeMismatch = [&Node, &OutError]()
+	{
+		OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("expected %s"), GetTypeName(Node.Type)));
+		return false;
+	};
+
+	OutValue.Type = Node.Type;
+	OutValue.bIsSet = true;
+
+	switch (Node.Type)
+	{
+		case EMCPSchemaType::Any:
+			ReadLiteral(Value, OutValue);
+			return true;
+
+		case EMCPSchemaType::Null:
+			return JsonType == EJson::Null ? true : TypeMismatch();
+
+		case EMCPSchemaType::Boolean:
+			if (JsonType != EJson::Boolean)
+			{
+				return TypeMismatch();
+			}
+			OutValue.BoolValue = Value->AsBool();
+			return true;
+
+		case EMCPSchemaType::Integer:
+		case EMCPSchemaType::Number:
+		{
+			if (JsonType != EJson::Number)
+			{
+				return TypeMismatch();
+			}
+
+			const double Number = Value->AsNumber();
+			if (Node.Type == EMCPSchemaType::Integer && Number != FMath::FloorToDouble(Number))
+			{
+				return TypeMismatch();
+			}
+			if (Node.Minimum.IsSet() && Number < Node.Minimum.GetValue())
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must be at least %g"), Node.Minimum.GetValue()));
+				return false;
+			}
+			if (Node.Maximum.IsSet() && Number > Node.Maximum.GetValue())
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must be at most %g"), Node.Maximum.GetValue()));
+				return false;
+			}
+
+			OutValue.NumberValue = Number;
+			return true;
+		}
+
+		case EMCPSchemaType::String:
+		{
+			if (JsonType != EJson::String)
+			{
+				return TypeMismatch();
+			}
+
+			OutValue.StringValue = Value->AsString();
+			const int32 Length = OutValue.StringValue.Len();
+			if (Node.MinLength != INDEX_NONE && Length < Node.MinLength)
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must be at least %d characters"), Node.MinLength));
+				return false;
+			}
+			if (Node.MaxLength != INDEX_NONE && Length > Node.MaxLength)
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must be at most %d characters"), Node.MaxLength));
+				return false;
+			}
+			const FString& StringValue = OutValue.StringValue;
+			if (Node.EnumValues.Num() > 0 && !Node.EnumValues.ContainsByPredicate([&StringValue](const FString& EnumValue) { return EnumValue.Equals(StringValue, ESearchCase::CaseSensitive); }))
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must be one of: %s"), *FString::Join(Node.EnumValues, TEXT(", "))));
+				return false;
+			}
+			return true;
+		}
+
+		case EMCPSchemaType::Array:
+		{
+			if (JsonType != EJson::Array)
+			{
+				return TypeMismatch();
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+			if (Node.MinItems != INDEX_NONE && Elements.Num() < Node.MinItems)
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must have at least %d item(s)"), Node.MinItems));
+				return false;
+			}
+			if (Node.MaxItems != INDEX_NONE && Elements.Num() > Node.MaxItems)
+			{
+				OutError = MakeInvalidArgumentError(Node.Path, FString::Printf(TEXT("must have at most %d item(s)"), Node.MaxItems));
+				return false;
+			}
+
+			if (Node.ItemsNode == INDEX_NONE)
+			{
+				OutValue.StringValue = ToCondensedJson(Value);
+				return true;
+			}
+
+			const FNode& ItemsNode = Nodes[Node.ItemsNode];
+			OutValue.ArrayValues.Reset(Elements.Num());
+			for (const TSharedPtr<FJsonValue>& Element : Elements)
+			{
+				if (!ValidateValue(ItemsNode, Element, OutArguments, OutValue.ArrayValues.AddDefaulted_GetRef(), OutError))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		case EMCPSchemaType::Object:
+		{
+			if (JsonType != EJson::Object)
+			{
+				return TypeMismatch();
+			}
+
+			const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+			if (!ValidateObject(Node, *Object, OutArguments, OutError))
+			{
+				return false;
+			}
+
+			// Objects inside arrays have no property slots; keep them whole
+			if (Node.Slot == INDEX_NONE)
+			{
+				OutValue.StringValue = ToCondensedJson(Value);
+			}
+			return true;
+		}
+	}
+
+	return true;
+}
+
+bool FMCPSchemaValidator::ReadLiteral(const TSharedPtr<FJsonValue>& Value, FMCPArgumentValue& OutValue)
+{
+	if (!Value.IsValid())
+	{
+		return false;
+	}
+
+	OutValue.bIsSet = true;
+	switch (Value->Type)
+	{
+		case EJson::Boolean:
+			OutValue.BoolValue = Value->AsBool();
+			break;
+
+		case EJson::Number:
+			OutValue.NumberValue = Value->AsNumber();
+			break;
+
+		case EJson::String:
+			OutValue.StringValue = Value->AsString();
+			break;
+
+		case EJson::Array:
+		case EJson::Object:
+			OutValue.StringValue = ToCondensedJson(Value);
+			break;
+
+		default:
+			break;
+	}
+	return true;
+}
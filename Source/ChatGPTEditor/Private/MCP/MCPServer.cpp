@@ -2,25 +2,63 @@
 
 #include "MCP/MCPServer.h"
 #include "MCP/MCPTypes.h"
+#include "MCP/MCPJsonWriter.h"
+#include "MCP/MCPServerStats.h"
+#include "AuditLogger.h"
 #include "JsonUtilities.h"
+#include "Async/Async.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace
+{
+	/** Tool results built by FMCPToolBase::CreateErrorResponse, or flagged per the MCP spec */
+	bool IsToolErrorResult(const FJsonObject& Result)
+	{
+		bool bFlag = false;
+		if (Result.TryGetBoolField(TEXT("isError"), bFlag) && bFlag)
+		{
+			return true;
+		}
+		return Result.TryGetBoolField(TEXT("success"), bFlag) && !bFlag;
+	}
+	
+	/** Record a tool call that passed validation, so the audit log can be searched by tool */
+	void AuditToolCall(const FString& ToolName)
+	{
+		FAuditLogger::Get().Submit(FAuditEvent(EAuditSource::MCP, TEXT("MCP_TOOL_CALL")).Add(TEXT("Tool"), ToolName));
+	}
+}
 
 FMCPServer::FMCPServer()
-	: ProtocolVersion(MCPProtocol::Version)
+	: RegistryGeneration(0)
+	, InFlightRequests(MakeShared<FMCPInFlightRequests, ESPMode::ThreadSafe>())
+	, Lifetime(MakeShared<FMCPServerLifetime, ESPMode::ThreadSafe>())
+	, ProtocolVersion(MCPProtocol::Version)
 	, bIsInitialized(false)
-	, RequestsProcessed(0)
-	, ErrorsEncountered(0)
+	, Stats(MakeShared<FMCPServerStats, ESPMode::ThreadSafe>())
 {
+	PublishToolRegistry(MakeShared<FMCPToolRegistry, ESPMode::ThreadSafe>());
+	
 	ServerCapabilities = MakeShared<FJsonObject>();
 	
 	// Set up capabilities
 	TSharedPtr<FJsonObject> ToolsCap = MakeShared<FJsonObject>();
 	ToolsCap->SetBoolField(TEXT("listChanged"), true);
 	ServerCapabilities->SetObjectField(TEXT("tools"), ToolsCap);
+	ServerCapabilities->SetObjectField(TEXT("resources"), MakeShared<FJsonObject>());
+	ServerCapabilities->SetObjectField(TEXT("prompts"), MakeShared<FJsonObject>());
+	
+	MethodTable = MakeShared<FMCPMethodTable, ESPMode::ThreadSafe>();
+	RegisterBuiltInMethods();
 }
 
 FMCPServer::~FMCPServer()
 {
 	Shutdown();
+	
+	// Waits for batch entries dispatching right now; any still queued answer without the server
+	FWriteScopeLock Lock(Lifetime->Lock);
+	Lifetime->bServerAlive = false;
 }
 
 bool FMCPServer::Initialize()
@@ -38,13 +76,17 @@ bool FMCPServer::Initialize()
 
 void FMCPServer::Shutdown()
 {
+	CancelInFlightRequests();
+	
 	if (!bIsInitialized)
 	{
 		return;
 	}
 	
-	FScopeLock Lock(&RegistrationLock);
-	RegisteredTools.Empty();
+	{
+		FScopeLock Lock(&RegistrationLock);
+		PublishToolRegistry(MakeShared<FMCPToolRegistry, ESPMode::ThreadSafe>());
+	}
 	bIsInitialized = false;
 	
 	UE_LOG(LogTemp, Log, TEXT("MCP Server shutdown"));
@@ -57,112 +99,690 @@ void FMCPServer::RegisterTool(TSharedPtr<IMCPTool> Tool)
 		return;
 	}
 	
-	FScopeLock Lock(&RegistrationLock);
 	FString ToolName = Tool->GetName();
-	RegisteredTools.Add(ToolName, Tool);
+	
+	// Build the schema and descriptor once here rather than on every tools/list
+	FMCPRegisteredTool Entry;
+	Entry.Tool = Tool;
+	Entry.DescriptorJson = SerializeToolDescriptor(*Tool);
+	Entry.Stats = MakeShared<FMCPToolStats, ESPMode::ThreadSafe>();
+	
+	FString SchemaError;
+	Entry.ArgumentValidator = FMCPSchemaValidator::Compile(Tool->GetInputSchema(), SchemaError);
+	if (!Entry.ArgumentValidator.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MCP Tool %s: input schema not compiled, arguments will not be validated (%s)"), *ToolName, *SchemaError);
+	}
+	
+	{
+		FScopeLock Lock(&RegistrationLock);
+		TSharedRef<FMCPToolRegistry, ESPMode::ThreadSafe> NewRegistry = MakeShared<FMCPToolRegistry, ESPMode::ThreadSafe>(*GetToolRegistry());
+		NewRegistry->Tools.Add(ToolName, MoveTemp(Entry));
+		PublishToolRegistry(NewRegistry);
+	}
 	
 	UE_LOG(LogTemp, Log, TEXT("MCP Tool registered: %s"), *ToolName);
+	
+	NotifyToolsListChanged();
 }
 
 void FMCPServer::UnregisterTool(const FString& ToolName)
 {
-	FScopeLock Lock(&RegistrationLock);
-	RegisteredTools.Remove(ToolName);
+	{
+		FScopeLock Lock(&RegistrationLock);
+		FMCPToolRegistryPtr CurrentRegistry = GetToolRegistry();
+		if (!CurrentRegistry->Tools.Contains(ToolName))
+		{
+			return;
+		}
+		
+		TSharedRef<FMCPToolRegistry, ESPMode::ThreadSafe> NewRegistry = MakeShared<FMCPToolRegistry, ESPMode::ThreadSafe>(*CurrentRegistry);
+		NewRegistry->Tools.Remove(ToolName);
+		PublishToolRegistry(NewRegistry);
+	}
 	
 	UE_LOG(LogTemp, Log, TEXT("MCP Tool unregistered: %s"), *ToolName);
+	
+	NotifyToolsListChanged();
 }
 
 TArray<TSharedPtr<IMCPTool>> FMCPServer::GetRegisteredTools() const
 {
-	FScopeLock Lock(&RegistrationLock);
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
 	
 	TArray<TSharedPtr<IMCPTool>> Tools;
-	RegisteredTools.GenerateValueArray(Tools);
+	Tools.Reserve(Registry->Tools.Num());
+	for (const auto& ToolPair : Registry->Tools)
+	{
+		Tools.Add(ToolPair.Value.Tool);
+	}
 	return Tools;
 }
 
-FString FMCPServer::ProcessMessage(const FString& JsonMessage)
+TSharedPtr<IMCPTool> FMCPServer::FindTool(const FString& ToolName) const
+{
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
+	const FMCPRegisteredTool* Entry = Registry->Tools.Find(ToolName);
+	return Entry ? Entry->Tool : nullptr;
+}
+
+FMCPToolRegistryPtr FMCPServer::GetToolRegistry() const
+{
+	// Held only long enough to bump the snapshot's refcount
+	FReadScopeLock Lock(ToolRegistryLock);
+	return ToolRegistry;
+}
+
+const FMCPMethodEntry* FMCPMethodTable::Find(const FString& Method) const
+{
+	// FNAME_Find hashes the string once and never grows the name table with client input
+	const FName MethodName(*Method, FNAME_Find);
+	if (MethodName.IsNone())
+	{
+		return nullptr;
+	}
+	
+	const FMCPMethodEntry* Entry = Methods.Find(MethodName);
+	return Entry && Entry->Method.Equals(Method, ESearchCase::CaseSensitive) ? Entry : nullptr;
+}
+
+void FMCPServer::RegisterBuiltInMethods()
 {
-	RequestsProcessed++;
+	RegisterMethodHandler(MCPProtocol::Method_Initialize, FMCPMethodHandler::CreateLambda(
+		[this](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			WriteSuccessResponse(Writer, Request.Id, HandleInitialize(Request.Id, Request.Params));
+			return true;
+		}));
+	
+	// Served from the immutable registry snapshot, so safe to run concurrently
+	RegisterMethodHandler(MCPProtocol::Method_ToolsList, FMCPMethodHandler::CreateLambda(
+		[this](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			HandleToolsList(Request.Id, Writer);
+			return true;
+		}), true);
 	
-	// Parse request
-	FString Method;
-	int32 Id;
-	TSharedPtr<FJsonObject> Params;
+	RegisterMethodHandler(MCPProtocol::Method_ToolsCall, FMCPMethodHandler::CreateLambda(
+		[this](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			return HandleToolsCall(Request.Id, Request.Params, Writer);
+		}));
 	
-	if (!ParseRequest(JsonMessage, Method, Id, Params))
+	RegisterMethodHandler(MCPProtocol::Method_ResourcesList, FMCPMethodHandler::CreateRaw(this, &FMCPServer::HandleResourcesList), true);
+	RegisterMethodHandler(MCPProtocol::Method_ResourcesRead, FMCPMethodHandler::CreateRaw(this, &FMCPServer::HandleResourcesRead));
+	RegisterMethodHandler(MCPProtocol::Method_PromptsList, FMCPMethodHandler::CreateRaw(this, &FMCPServer::HandlePromptsList), true);
+	RegisterMethodHandler(MCPProtocol::Method_PromptsGet, FMCPMethodHandler::CreateRaw(this, &FMCPServer::HandlePromptsGet));
+	RegisterMethodHandler(MCPProtocol::Method_ServerStats, FMCPMethodHandler::CreateRaw(this, &FMCPServer::HandleServerStats), true);
+	
+	RegisterMethodHandler(MCPProtocol::Notification_Cancelled, FMCPMethodHandler::CreateLambda(
+		[this](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			HandleCancelled(Request.Params);
+			if (!Request.bIsNotification)
+			{
+				WriteSuccessResponse(Writer, Request.Id, MakeShared<FJsonObject>());
+			}
+			return true;
+		}));
+}
+
+void FMCPServer::RegisterMethodHandler(const FString& Method, FMCPMethodHandler Handler, bool bThreadSafe)
+{
+	if (Method.IsEmpty() || !Handler.IsBound())
 	{
-		ErrorsEncountered++;
-		return CreateErrorResponse(0, MCPProtocol::ParseError, TEXT("Failed to parse JSON-RPC request"));
+		return;
 	}
 	
-	// Handle method
-	TSharedPtr<FJsonObject> Result;
+	FMCPMethodEntry Entry;
+	Entry.Method = Method;
+	Entry.Handler = MoveTemp(Handler);
+	Entry.bThreadSafe = bThreadSafe;
+	Entry.Stats = MakeShared<FMCPMethodStats, ESPMode::ThreadSafe>();
+	
+	FWriteScopeLock Lock(MethodTableLock);
 	
-	if (Method == MCPProtocol::Method_Initialize)
+	// The table is keyed by FName, which ignores case; a second spelling would silently replace the first
+	const FMCPMethodEntry* Existing = MethodTable->Methods.Find(FName(*Method));
+	if (!ensureMsgf(!Existing || Existing->Method.Equals(Method, ESearchCase::CaseSensitive),
+		TEXT("MCP method %s differs only in case from registered method %s"), *Method, Existing ? *Existing->Method : TEXT("")))
 	{
-		Result = HandleInitialize(Id, Params);
+		return;
 	}
-	else if (Method == MCPProtocol::Method_ToolsList)
+	
+	TSharedRef<FMCPMethodTable, ESPMode::ThreadSafe> NewTable = MakeShared<FMCPMethodTable, ESPMode::ThreadSafe>(*MethodTable);
+	NewTable->Methods.Add(FName(*Method), MoveTemp(Entry));
+	MethodTable = NewTable;
+}
+
+void FMCPServer::UnregisterMethodHandler(const FString& Method)
+{
+	FWriteScopeLock Lock(MethodTableLock);
+	if (!MethodTable->Find(Method))
 	{
-		Result = HandleToolsList(Id);
+		return;
 	}
-	else if (Method == MCPProtocol::Method_ToolsCall)
+	
+	TSharedRef<FMCPMethodTable, ESPMode::ThreadSafe> NewTable = MakeShared<FMCPMethodTable, ESPMode::ThreadSafe>(*MethodTable);
+	NewTable->Methods.Remove(FName(*Method));
+	MethodTable = NewTable;
+}
+
+bool FMCPServer::HasMethodHandler(const FString& Method) const
+{
+	return GetMethodTable()->Find(Method) != nullptr;
+}
+
+FMCPMethodTablePtr FMCPServer::GetMethodTable() const
+{
+	FReadScopeLock Lock(MethodTableLock);
+	return MethodTable;
+}
+
+void FMCPServer::RegisterResource(const FMCPResourceInfo& Info, FMCPResourceReader Reader)
+{
+	if (Info.Uri.IsEmpty() || !Reader.IsBound())
 	{
-		Result = HandleToolsCall(Id, Params);
+		return;
 	}
-	else
+	
+	FMCPRegisteredResource Entry;
+	Entry.Info = Info;
+	Entry.Reader = MoveTemp(Reader);
+	
+	FWriteScopeLock Lock(ResourcesLock);
+	Resources.Add(Info.Uri, MoveTemp(Entry));
+}
+
+void FMCPServer::UnregisterResource(const FString& Uri)
+{
+	FWriteScopeLock Lock(ResourcesLock);
+	Resources.Remove(Uri);
+}
+
+void FMCPServer::RegisterPrompt(const FMCPPromptInfo& Info, FMCPPromptRenderer Renderer)
+{
+	if (Info.Name.IsEmpty() || !Renderer.IsBound())
 	{
-		ErrorsEncountered++;
-		return CreateErrorResponse(Id, MCPProtocol::MethodNotFound, 
-			FString::Printf(TEXT("Method not found: %s"), *Method));
+		return;
 	}
 	
-	if (!Result.IsValid())
+	FMCPRegisteredPrompt Entry;
+	Entry.Info = Info;
+	Entry.Renderer = MoveTemp(Renderer);
+	
+	FWriteScopeLock Lock(PromptsLock);
+	Prompts.Add(Info.Name, MoveTemp(Entry));
+}
+
+void FMCPServer::UnregisterPrompt(const FString& Name)
+{
+	FWriteScopeLock Lock(PromptsLock);
+	Prompts.Remove(Name);
+}
+
+void FMCPServer::PublishToolRegistry(TSharedRef<FMCPToolRegistry, ESPMode::ThreadSafe> NewRegistry)
+{
+	// Stitch the per-tool descriptors into the cached tools array
+	NewRegistry->ToolsListJson.Reset();
+	NewRegistry->ToolsListJson.Add('[');
+	for (const auto& ToolPair : NewRegistry->Tools)
+	{
+		if (NewRegistry->ToolsListJson.Num() > 1)
+		{
+			NewRegistry->ToolsListJson.Add(',');
+		}
+		NewRegistry->ToolsListJson.Append(ToolPair.Value.DescriptorJson);
+	}
+	NewRegistry->ToolsListJson.Add(']');
+	NewRegistry->Generation = ++RegistryGeneration;
+	
+	FMCPToolRegistryPtr OldRegistry;
 	{
-		ErrorsEncountered++;
-		return CreateErrorResponse(Id, MCPProtocol::InternalError, TEXT("Internal server error"));
+		FWriteScopeLock Lock(ToolRegistryLock);
+		OldRegistry = MoveTemp(ToolRegistry);
+		ToolRegistry = NewRegistry;
 	}
+	// OldRegistry is released here, outside the lock; readers still holding it keep it alive
+}
+
+TArray<uint8> FMCPServer::SerializeToolDescriptor(const IMCPTool& Tool)
+{
+	TSharedPtr<FJsonObject> ToolObj = MakeShared<FJsonObject>();
+	ToolObj->SetStringField(TEXT("name"), Tool.GetName());
+	ToolObj->SetStringField(TEXT("description"), Tool.GetDescription());
+	ToolObj->SetObjectField(TEXT("inputSchema"), Tool.GetInputSchema());
+	
+	FString DescriptorString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&DescriptorString);
+	FJsonSerializer::Serialize(ToolObj.ToSharedRef(), Writer);
 	
-	return CreateSuccessResponse(Id, Result);
+	FTCHARToUTF8 UTF8String(*DescriptorString);
+	TArray<uint8> Descriptor;
+	Descriptor.Append(reinterpret_cast<const uint8*>(UTF8String.Get()), UTF8String.Length());
+	return Descriptor;
 }
 
-bool FMCPServer::ParseRequest(const FString& JsonMessage, FString& OutMethod, int32& OutId, TSharedPtr<FJsonObject>& OutParams)
+void FMCPServer::NotifyToolsListChanged()
 {
-	TSharedPtr<FJsonObject> Request;
+	// Only clients that completed the handshake can receive notifications
+	if (!bIsInitialized || !NotificationDelegate.IsBound())
+	{
+		return;
+	}
+	
+	NotificationDelegate.Broadcast(CreateNotification(MCPProtocol::Notification_ToolsListChanged));
+}
+
+FString FMCPServer::ProcessMessage(const FString& JsonMessage)
+{
+	// Reuse a per-thread response buffer; fall back to a local one if a tool re-enters ProcessMessage
+	static thread_local TArray<uint8> ScratchBuffer;
+	static thread_local bool bScratchBufferInUse = false;
+	
+	TArray<uint8> LocalBuffer;
+	TArray<uint8>& ResponseBuffer = bScratchBufferInUse ? LocalBuffer : ScratchBuffer;
+	TGuardValue<bool> ScratchGuard(bScratchBufferInUse, true);
+	
+	ResponseBuffer.Reset();
+	ProcessMessage(JsonMessage, ResponseBuffer);
+	FString Response = FMCPJsonWriter::ToString(ResponseBuffer);
+	
+	// Don't pin memory from an unusually large result
+	static const int32 MaxRetainedScratchBytes = 1024 * 1024;
+	if (ResponseBuffer.Max() > MaxRetainedScratchBytes)
+	{
+		ResponseBuffer.Empty();
+	}
+	
+	return Response;
+}
+
+void FMCPServer::ProcessMessage(const FString& JsonMessage, TArray<uint8>& OutResponse)
+{
+	FMCPJsonWriter Writer(OutResponse);
+	
+	// A leading '[' means a JSON-RPC batch
+	const TCHAR* FirstChar = *JsonMessage;
+	while (FChar::IsWhitespace(*FirstChar))
+	{
+		++FirstChar;
+	}
+	
+	const uint64 ParseStart = FPlatformTime::Cycles64();
+	
+	if (*FirstChar == TEXT('['))
+	{
+		TArray<TSharedPtr<FJsonValue>> BatchValues;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonMessage);
+		const bool bParsed = FJsonSerializer::Deserialize(Reader, BatchValues);
+		Stats->Parse.RecordSince(ParseStart);
+		if (!bParsed)
+		{
+			Stats->RequestsProcessed++;
+			Stats->ErrorsEncountered++;
+			WriteErrorResponse(Writer, FMCPRequestId(), MCPProtocol::ParseError, TEXT("Failed to parse JSON-RPC batch"));
+			return;
+		}
+		
+		ProcessBatch(BatchValues, Writer);
+		return;
+	}
+	
+	TSharedPtr<FJsonObject> RequestObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonMessage);
+	if (!FJsonSerializer::Deserialize(Reader, RequestObject) || !RequestObject.IsValid())
+	{
+		Stats->Parse.RecordSince(ParseStart);
+		Stats->RequestsProcessed++;
+		Stats->ErrorsEncountered++;
+		WriteErrorResponse(Writer, FMCPRequestId(), MCPProtocol::ParseError, TEXT("Failed to parse JSON-RPC request"));
+		return;
+	}
 	
-	if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid())
+	FMCPRequest Request;
+	const bool bValidRequest = ParseRequest(RequestObject, Request);
+	Stats->Parse.RecordSince(ParseStart);
+	if (!bValidRequest)
+	{
+		Stats->RequestsProcessed++;
+		Stats->ErrorsEncountered++;
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::InvalidRequest, TEXT("Invalid JSON-RPC request"));
+		return;
+	}
+	
+	DispatchRequest(Request, Writer);
+}
+
+TFuture<FString> FMCPServer::ProcessMessageAsync(const FString& JsonMessage)
+{
+	const uint64 ParseStart = FPlatformTime::Cycles64();
+	TSharedPtr<FJsonObject> RequestObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonMessage);
+	
+	FMCPRequest Request;
+	if (FJsonSerializer::Deserialize(Reader, RequestObject) && ParseRequest(RequestObject, Request))
+	{
+		Stats->Parse.RecordSince(ParseStart);
+		
+		// Only a tools/call for a known tool can outlive this call; it needs an id to be tracked
+		FString ToolName;
+		if (Request.Method == MCPProtocol::Method_ToolsCall && !Request.bIsNotification
+			&& Request.Params.IsValid() && Request.Params->TryGetStringField(TEXT("name"), ToolName))
+		{
+			FMCPToolRegistryPtr Registry = GetToolRegistry();
+			if (const FMCPRegisteredTool* Entry = Registry->Tools.Find(ToolName))
+			{
+				return HandleToolsCallAsync(Request, *Entry);
+			}
+		}
+		
+		TArray<uint8> ResponseBuffer;
+		FMCPJsonWriter Writer(ResponseBuffer);
+		DispatchRequest(Request, Writer);
+		return MakeFulfilledPromise<FString>(FMCPJsonWriter::ToString(ResponseBuffer)).GetFuture();
+	}
+	
+	// Batches complete once their last entry does
+	TArray<TSharedPtr<FJsonValue>> BatchValues;
+	TSharedRef<TJsonReader<>> BatchReader = TJsonReaderFactory<>::Create(JsonMessage);
+	if (!RequestObject.IsValid() && FJsonSerializer::Deserialize(BatchReader, BatchValues))
+	{
+		Stats->Parse.RecordSince(ParseStart);
+		return ProcessBatchAsync(BatchValues).Next([](TArray<uint8> Response)
+		{
+			return FMCPJsonWriter::ToString(Response);
+		});
+	}
+	
+	// Malformed input takes the synchronous path, which reports it
+	return MakeFulfilledPromise<FString>(ProcessMessage(JsonMessage)).GetFuture();
+}
+
+int32 FMCPServer::GetNumInFlightRequests() const
+{
+	FScopeLock Lock(&InFlightRequests->Lock);
+	return InFlightRequests->Contexts.Num();
+}
+
+void FMCPServer::CancelInFlightRequests()
+{
+	FScopeLock Lock(&InFlightRequests->Lock);
+	for (const TPair<FMCPRequestId, FMCPToolExecutionContextRef>& Pair : InFlightRequests->Contexts)
+	{
+		Pair.Value->Cancel();
+		Pair.Value->DetachNotificationSink();
+	}
+}
+
+void FMCPServer::ProcessBatch(const TArray<TSharedPtr<FJsonValue>>& BatchValues, FMCPJsonWriter& Writer)
+{
+	// On the game thread the ordered entries run inline, so this only waits for the thread-safe ones
+	const TArray<uint8> Response = ProcessBatchAsync(BatchValues).Get();
+	if (Response.Num() > 0)
+	{
+		Writer.WriteRawJSONValue(Response);
+	}
+}
+
+TFuture<TArray<uint8>> FMCPServer::ProcessBatchAsync(const TArray<TSharedPtr<FJsonValue>>& BatchValues)
+{
+	if (BatchValues.Num() == 0)
+	{
+		Stats->RequestsProcessed++;
+		Stats->ErrorsEncountered++;
+		TArray<uint8> Response;
+		FMCPJsonWriter Writer(Response);
+		WriteErrorResponse(Writer, FMCPRequestId(), MCPProtocol::InvalidRequest, TEXT("Empty JSON-RPC batch"));
+		return MakeFulfilledPromise<TArray<uint8>>(MoveTemp(Response)).GetFuture();
+	}
+	
+	// One response slot per entry, so concurrent entries never share a buffer
+	struct FBatchEntry
+	{
+		FMCPRequest Request;
+		bool bIsValid = false;
+		bool bRunConcurrently = false;
+		TArray<uint8> Response;
+	};
+	
+	// Shared by every part of the batch; whichever finishes last stitches the response
+	struct FBatchState
+	{
+		TArray<FBatchEntry> Entries;
+		std::atomic<int32> NumPendingParts{0};
+		TPromise<TArray<uint8>> Promise;
+		
+		void CompletePart()
+		{
+			if (--NumPendingParts > 0)
+			{
+				return;
+			}
+			
+			// Stitch the responses together in request order; notifications contribute nothing
+			TArray<uint8> Response;
+			FMCPJsonWriter Writer(Response);
+			bool bHasResponses = false;
+			for (const FBatchEntry& Entry : Entries)
+			{
+				if (Entry.Response.Num() > 0)
+				{
+					if (!bHasResponses)
+					{
+						Writer.WriteArrayStart();
+						bHasResponses = true;
+					}
+					Writer.WriteRawJSONValue(Entry.Response);
+				}
+			}
+			
+			if (bHasResponses)
+			{
+				Writer.WriteArrayEnd();
+			}
+			Promise.SetValue(MoveTemp(Response));
+		}
+	};
+	
+	TSharedRef<FBatchState, ESPMode::ThreadSafe> State = MakeShared<FBatchState, ESPMode::ThreadSafe>();
+	State->Entries.SetNum(BatchValues.Num());
+	
+	bool bHasOrderedEntries = false;
+	for (int32 Index = 0; Index < BatchValues.Num(); ++Index)
+	{
+		FBatchEntry& Entry = State->Entries[Index];
+		const TSharedPtr<FJsonObject>* RequestObject = nullptr;
+		Entry.bIsValid = BatchValues[Index].IsValid()
+			&& BatchValues[Index]->TryGetObject(RequestObject)
+			&& ParseRequest(*RequestObject, Entry.Request);
+		Entry.bRunConcurrently = Entry.bIsValid && CanRunConcurrently(Entry.Request);
+		if (Entry.bRunConcurrently)
+		{
+			State->NumPendingParts++;
+		}
+		else
+		{
+			bHasOrderedEntries = true;
+		}
+	}
+	
+	// The ordered entries count as one part; the extra part held here stops the batch completing before every part has started
+	State->NumPendingParts += (bHasOrderedEntries ? 1 : 0) + 1;
+	TFuture<TArray<uint8>> Future = State->Promise.GetFuture();
+	
+	// An entry that outlives the server answers without it
+	TSharedRef<FMCPServerLifetime, ESPMode::ThreadSafe> ServerLifetime = Lifetime;
+	auto DispatchEntry = [this, ServerLifetime](FBatchEntry& Entry)
+	{
+		FMCPJsonWriter EntryWriter(Entry.Response);
+		FReadScopeLock Lock(ServerLifetime->Lock);
+		if (!ServerLifetime->bServerAlive)
+		{
+			if (!Entry.Request.bIsNotification)
+			{
+				EntryWriter.WriteErrorResponse(Entry.Request.Id, MCPProtocol::InternalError, TEXT("Server shut down"));
+			}
+			return;
+		}
+		
+		if (!Entry.bIsValid)
+		{
+			Stats->RequestsProcessed++;
+			Stats->ErrorsEncountered++;
+			WriteErrorResponse(EntryWriter, Entry.Request.Id, MCPProtocol::InvalidRequest, TEXT("Invalid JSON-RPC request"));
+			return;
+		}
+		
+		DispatchRequest(Entry.Request, EntryWriter);
+	};
+	
+	// Thread-safe entries fan out on the task graph...
+	for (FBatchEntry& Entry : State->Entries)
+	{
+		if (Entry.bRunConcurrently)
+		{
+			AsyncTask(ENamedThreads::AnyThread, [State, DispatchEntry, &Entry]()
+			{
+				DispatchEntry(Entry);
+				State->CompletePart();
+			});
+		}
+	}
+	
+	// ...while everything else runs in request order on the game thread, without blocking this one on it
+	if (bHasOrderedEntries)
+	{
+		auto RunOrderedEntries = [State, DispatchEntry]()
+		{
+			for (FBatchEntry& Entry : State->Entries)
+			{
+				if (!Entry.bRunConcurrently)
+				{
+					DispatchEntry(Entry);
+				}
+			}
+			State->CompletePart();
+		};
+		
+		if (IsInGameThread())
+		{
+			RunOrderedEntries();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(RunOrderedEntries));
+		}
+	}
+	
+	State->CompletePart();
+	return Future;
+}
+
+bool FMCPServer::CanRunConcurrently(const FMCPRequest& Request) const
+{
+	FMCPMethodTablePtr Methods = GetMethodTable();
+	const FMCPMethodEntry* Entry = Methods->Find(Request.Method);
+	if (!Entry)
+	{
+		return false;
+	}
+	
+	if (Entry->bThreadSafe)
+	{
+		return true;
+	}
+	
+	// tools/call inherits the tool's own thread safety
+	if (Request.Method == MCPProtocol::Method_ToolsCall && Request.Params.IsValid())
+	{
+		FString ToolName;
+		if (Request.Params->TryGetStringField(TEXT("name"), ToolName))
+		{
+			TSharedPtr<IMCPTool> Tool = FindTool(ToolName);
+			return Tool.IsValid() && Tool->IsThreadSafe();
+		}
+	}
+	
+	return false;
+}
+
+void FMCPServer::DispatchRequest(const FMCPRequest& Request, FMCPJsonWriter& Writer)
+{
+	Stats->RequestsProcessed++;
+	
+	// Notifications are executed but never answered
+	const FMCPJsonWriter::FMark ResponseStart = Writer.GetMark();
+	
+	const uint64 DispatchStart = FPlatformTime::Cycles64();
+	
+	// One table lookup per request
+	FMCPMethodTablePtr Methods = GetMethodTable();
+	if (const FMCPMethodEntry* Entry = Methods->Find(Request.Method))
+	{
+		const bool bSucceeded = Entry->Handler.Execute(Request, Writer);
+		
+		FMCPMethodStats& MethodStats = *Entry->Stats;
+		MethodStats.Requests++;
+		if (!bSucceeded)
+		{
+			MethodStats.Errors++;
+			Stats->ErrorsEncountered++;
+		}
+		MethodStats.Latency.RecordSince(DispatchStart);
+	}
+	else
+	{
+		Stats->ErrorsEncountered++;
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::MethodNotFound, 
+			FString::Printf(TEXT("Method not found: %s"), *Request.Method));
+	}
+	
+	Stats->Dispatch.RecordSince(DispatchStart);
+	
+	if (Request.bIsNotification)
+	{
+		Writer.RestoreMark(ResponseStart);
+	}
+}
+
+bool FMCPServer::ParseRequest(const TSharedPtr<FJsonObject>& RequestObject, FMCPRequest& OutRequest)
+{
+	if (!RequestObject.IsValid())
+	{
+		return false;
+	}
+	
+	// Extract id first so errors can still be correlated; only a missing id makes a notification
+	OutRequest.bIsNotification = !RequestObject->HasField(TEXT("id"));
+	if (!FMCPRequestId::FromJson(RequestObject->TryGetField(TEXT("id")), OutRequest.Id))
 	{
 		return false;
 	}
 	
 	// Validate JSON-RPC 2.0
-	if (!Request->HasField(TEXT("jsonrpc")) || Request->GetStringField(TEXT("jsonrpc")) != TEXT("2.0"))
+	if (!RequestObject->TryGetStringField(TEXT("jsonrpc"), OutRequest.JsonRpc) || OutRequest.JsonRpc != TEXT("2.0"))
 	{
 		return false;
 	}
 	
 	// Extract method
-	if (!Request->HasField(TEXT("method")))
+	if (!RequestObject->TryGetStringField(TEXT("method"), OutRequest.Method))
 	{
 		return false;
 	}
-	OutMethod = Request->GetStringField(TEXT("method"));
-	
-	// Extract id
-	OutId = Request->HasField(TEXT("id")) ? static_cast<int32>(Request->GetNumberField(TEXT("id"))) : 0;
 	
 	// Extract params (optional)
-	if (Request->HasField(TEXT("params")))
+	const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+	if (RequestObject->TryGetObjectField(TEXT("params"), ParamsObject))
 	{
-		OutParams = Request->GetObjectField(TEXT("params"));
+		OutRequest.Params = *ParamsObject;
 	}
 	
 	return true;
 }
 
-TSharedPtr<FJsonObject> FMCPServer::HandleInitialize(int32 Id, const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FMCPServer::HandleInitialize(const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Params)
 {
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetStringField(TEXT("protocolVersion"), ProtocolVersion);
@@ -179,88 +799,642 @@ TSharedPtr<FJsonObject> FMCPServer::HandleInitialize(int32 Id, const TSharedPtr<
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPServer::HandleToolsList(int32 Id)
+void FMCPServer::HandleToolsList(const FMCPRequestId& Id, FMCPJsonWriter& Writer)
 {
-	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-	TArray<TSharedPtr<FJsonValue>> ToolsArray;
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
 	
-	FScopeLock Lock(&RegistrationLock);
+	// Splice the cached tools array into the envelope; no schema rebuild, no DOM
+	Writer.BeginResultResponse(Id);
+	Writer.WriteObjectStart();
+	Writer.WriteRawJSONValue("tools", Registry->ToolsListJson);
+	Writer.WriteObjectEnd();
+	Writer.EndResponse();
+}
+
+bool FMCPServer::HandleToolsCall(const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Params, FMCPJsonWriter& Writer)
+{
+	if (!Params.IsValid() || !Params->HasField(TEXT("name")))
+	{
+		WriteErrorResponse(Writer, Id, MCPProtocol::InternalError, TEXT("Internal server error"));
+		return false;
+	}
+	
+	FString ToolName = Params->GetStringField(TEXT("name"));
+	
+	// Find tool (the snapshot keeps it alive even if it is unregistered mid-call)
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
+	const FMCPRegisteredTool* Entry = Registry->Tools.Find(ToolName);
+	
+	if (!Entry)
+	{
+		TSharedPtr<FJsonObject> ErrorResult = MakeShared<FJsonObject>();
+		ErrorResult->SetStringField(TEXT("error"), FString::Printf(TEXT("Tool not found: %s"), *ToolName));
+		WriteSuccessResponse(Writer, Id, ErrorResult);
+		return true;
+	}
+	
+	FMCPToolStats& ToolStats = *Entry->Stats;
+	ToolStats.Calls++;
+	
+	// Bad arguments are rejected before the tool runs
+	TSharedPtr<FJsonObject> Arguments;
+	FMCPToolArguments ValidatedArguments;
+	FString ArgumentsError;
+	if (!ValidateToolArguments(*Entry, Params, Arguments, ValidatedArguments, ArgumentsError))
+	{
+		ToolStats.Errors++;
+		WriteErrorResponse(Writer, Id, MCPProtocol::InvalidParams, ArgumentsError);
+		return false;
+	}
+	AuditToolCall(ToolName);
 	
-	for (const auto& ToolPair : RegisteredTools)
+	IMCPTool* Tool = Entry->Tool.Get();
+	const uint64 ExecuteStart = FPlatformTime::Cycles64();
+	
+	// Execute tool with no registry lock held
+	if (Tool->SupportsStreamingResult())
 	{
-		TSharedPtr<IMCPTool> Tool = ToolPair.Value;
+		// The tool writes its result object directly after the envelope
+		const FMCPJsonWriter::FMark ResponseStart = Writer.GetMark();
+		Writer.BeginResultResponse(Id);
+		const int32 ResultStart = Writer.GetBuffer().Num();
+		const int32 ResultDepth = Writer.GetDepth();
+		
+		Tool->ExecuteStreaming(Arguments, Writer);
+		
+		// Streaming tools serialize as they execute, so the whole call counts as execution
+		const uint64 ExecuteMicros = FMCPLatencyHistogram::MicrosSince(ExecuteStart);
+		ToolStats.Execute.RecordMicros(ExecuteMicros);
+		Stats->Execute.RecordMicros(ExecuteMicros);
 		
-		TSharedPtr<FJsonObject> ToolObj = MakeShared<FJsonObject>();
-		ToolObj->SetStringField(TEXT("name"), Tool->GetName());
-		ToolObj->SetStringField(TEXT("description"), Tool->GetDescription());
-		ToolObj->SetObjectField(TEXT("inputSchema"), Tool->GetInputSchema());
+		if (Writer.GetDepth() != ResultDepth || Writer.GetBuffer().Num() == ResultStart)
+		{
+			ToolStats.Errors++;
+			Writer.RestoreMark(ResponseStart);
+			WriteErrorResponse(Writer, Id, MCPProtocol::InternalError,
+				FString::Printf(TEXT("Tool produced a malformed result: %s"), *ToolName));
+			return false;
+		}
 		
-		ToolsArray.Add(MakeShared<FJsonValueObject>(ToolObj));
+		Writer.EndResponse();
+		return true;
 	}
 	
-	Result->SetArrayField(TEXT("tools"), ToolsArray);
+	TSharedPtr<FJsonObject> Result = ValidatedArguments.IsValid()
+		? Tool->ExecuteValidated(Arguments, ValidatedArguments)
+		: Tool->Execute(Arguments);
 	
-	return Result;
+	const uint64 ExecuteMicros = FMCPLatencyHistogram::MicrosSince(ExecuteStart);
+	ToolStats.Execute.RecordMicros(ExecuteMicros);
+	Stats->Execute.RecordMicros(ExecuteMicros);
+	
+	if (!Result.IsValid())
+	{
+		ToolStats.Errors++;
+		WriteErrorResponse(Writer, Id, MCPProtocol::InternalError, TEXT("Internal server error"));
+		return false;
+	}
+	
+	if (IsToolErrorResult(*Result))
+	{
+		ToolStats.Errors++;
+	}
+	
+	const uint64 SerializeStart = FPlatformTime::Cycles64();
+	WriteSuccessResponse(Writer, Id, Result);
+	const uint64 SerializeMicros = FMCPLatencyHistogram::MicrosSince(SerializeStart);
+	ToolStats.Serialize.RecordMicros(SerializeMicros);
+	Stats->Serialize.RecordMicros(SerializeMicros);
+	return true;
 }
 
-TSharedPtr<FJsonObject> FMCPServer::HandleToolsCall(int32 Id, const TSharedPtr<FJsonObject>& Params)
+TFuture<FString> FMCPServer::HandleToolsCallAsync(const FMCPRequest& Request, const FMCPRegisteredTool& Entry)
 {
-	if (!Params.IsValid() || !Params->HasField(TEXT("name")))
+	Stats->RequestsProcessed++;
+	const uint64 CallStart = FPlatformTime::Cycles64();
+	
+	const FMCPRequestId Id = Request.Id;
+	const TSharedPtr<FJsonObject>& Params = Request.Params;
+	TSharedRef<IMCPTool> Tool = Entry.Tool.ToSharedRef();
+	
+	// Async calls bypass DispatchRequest, so they record tools/call latency themselves
+	TSharedRef<FMCPToolStats, ESPMode::ThreadSafe> ToolStats = Entry.Stats.ToSharedRef();
+	TSharedPtr<FMCPMethodStats, ESPMode::ThreadSafe> MethodStats;
 	{
-		return nullptr;
+		FMCPMethodTablePtr Methods = GetMethodTable();
+		if (const FMCPMethodEntry* MethodEntry = Methods->Find(MCPProtocol::Method_ToolsCall))
+		{
+			MethodStats = MethodEntry->Stats;
+		}
+	}
+	if (MethodStats.IsValid())
+	{
+		MethodStats->Requests++;
 	}
+	ToolStats->Calls++;
 	
-	FString ToolName = Params->GetStringField(TEXT("name"));
-	TSharedPtr<FJsonObject> Arguments = Params->HasField(TEXT("arguments")) 
-		? Params->GetObjectField(TEXT("arguments"))
-		: MakeShared<FJsonObject>();
+	TSharedPtr<FJsonObject> Arguments;
+	FMCPToolArguments ValidatedArguments;
+	FString ArgumentsError;
+	if (!ValidateToolArguments(Entry, Params, Arguments, ValidatedArguments, ArgumentsError))
+	{
+		Stats->ErrorsEncountered++;
+		ToolStats->Errors++;
+		if (MethodStats.IsValid())
+		{
+			MethodStats->Errors++;
+			MethodStats->Latency.RecordSince(CallStart);
+		}
+		
+		TArray<uint8> ResponseBuffer;
+		FMCPJsonWriter Writer(ResponseBuffer);
+		WriteErrorResponse(Writer, Id, MCPProtocol::InvalidParams, ArgumentsError);
+		return MakeFulfilledPromise<FString>(FMCPJsonWriter::ToString(ResponseBuffer)).GetFuture();
+	}
+	AuditToolCall(Tool->GetName());
+	
+	// Progress is only reported when the client asks for it with _meta.progressToken
+	TSharedPtr<FJsonValue> ProgressToken;
+	const TSharedPtr<FJsonObject>* MetaObject = nullptr;
+	if (Params->TryGetObjectField(TEXT("_meta"), MetaObject))
+	{
+		ProgressToken = (*MetaObject)->TryGetField(TEXT("progressToken"));
+	}
 	
-	// Find tool
-	FScopeLock Lock(&RegistrationLock);
-	TSharedPtr<IMCPTool>* ToolPtr = RegisteredTools.Find(ToolName);
+	FMCPToolExecutionContextRef Context = MakeShared<FMCPToolExecutionContext, ESPMode::ThreadSafe>(Id, ProgressToken,
+		[this](const FString& Notification)
+		{
+			NotificationDelegate.Broadcast(Notification);
+		});
+	Context->SetArguments(MoveTemp(ValidatedArguments));
 	
-	if (!ToolPtr || !ToolPtr->IsValid())
 	{
-		TSharedPtr<FJsonObject> ErrorResult = MakeShared<FJsonObject>();
-		ErrorResult->SetStringField(TEXT("error"), FString::Printf(TEXT("Tool not found: %s"), *ToolName));
-		return ErrorResult;
+		FScopeLock Lock(&InFlightRequests->Lock);
+		if (InFlightRequests->Contexts.Contains(Id))
+		{
+			Stats->ErrorsEncountered++;
+			
+			TArray<uint8> ResponseBuffer;
+			FMCPJsonWriter Writer(ResponseBuffer);
+			WriteErrorResponse(Writer, Id, MCPProtocol::InvalidRequest,
+				FString::Printf(TEXT("Request id %s is already in flight"), *Id.ToString()));
+			return MakeFulfilledPromise<FString>(FMCPJsonWriter::ToString(ResponseBuffer)).GetFuture();
+		}
+		InFlightRequests->Contexts.Add(Id, Context);
 	}
 	
-	// Execute tool
-	TSharedPtr<IMCPTool> Tool = *ToolPtr;
-	TSharedPtr<FJsonObject> Result = Tool->Execute(Arguments);
+	// The continuation holds the tool, in-flight table and stats, not the server
+	TSharedRef<FMCPInFlightRequests, ESPMode::ThreadSafe> InFlight = InFlightRequests;
+	TSharedRef<FMCPServerStats, ESPMode::ThreadSafe> ServerStats = Stats;
+	const uint64 ExecuteStart = FPlatformTime::Cycles64();
+	return Tool->ExecuteAsync(Arguments, Context).Next([InFlight, Context, Tool, ServerStats, ToolStats, MethodStats, CallStart, ExecuteStart](TSharedPtr<FJsonObject> Result)
+	{
+		const uint64 ExecuteMicros = FMCPLatencyHistogram::MicrosSince(ExecuteStart);
+		ToolStats->Execute.RecordMicros(ExecuteMicros);
+		ServerStats->Execute.RecordMicros(ExecuteMicros);
+		
+		const FMCPRequestId RequestId = Context->GetRequestId();
+		{
+			FScopeLock Lock(&InFlight->Lock);
+			const FMCPToolExecutionContextRef* Tracked = InFlight->Contexts.Find(RequestId);
+			if (Tracked && *Tracked == Context)
+			{
+				InFlight->Contexts.Remove(RequestId);
+			}
+		}
+		
+		const bool bFailed = !Result.IsValid() || IsToolErrorResult(*Result);
+		if (bFailed)
+		{
+			ToolStats->Errors++;
+		}
+		
+		// A cancelled request gets no response
+		if (Context->IsCancelled())
+		{
+			if (MethodStats.IsValid())
+			{
+				MethodStats->Latency.RecordSince(CallStart);
+			}
+			return FString();
+		}
+		
+		const uint64 SerializeStart = FPlatformTime::Cycles64();
+		TArray<uint8> ResponseBuffer;
+		FMCPJsonWriter Writer(ResponseBuffer);
+		if (Result.IsValid())
+		{
+			Writer.BeginResultResponse(RequestId);
+			Writer.WriteJsonObject(Result);
+			Writer.EndResponse();
+		}
+		else
+		{
+			ServerStats->ErrorsEncountered++;
+			if (MethodStats.IsValid())
+			{
+				MethodStats->Errors++;
+			}
+			Writer.WriteErrorResponse(RequestId, MCPProtocol::InternalError, TEXT("Internal server error"));
+		}
+		FString Response = FMCPJsonWriter::ToString(ResponseBuffer);
+		
+		const uint64 SerializeMicros = FMCPLatencyHistogram::MicrosSince(SerializeStart);
+		ToolStats->Serialize.RecordMicros(SerializeMicros);
+		ServerStats->Serialize.RecordMicros(SerializeMicros);
+		if (MethodStats.IsValid())
+		{
+			MethodStats->Latency.RecordSince(CallStart);
+		}
+		return Response;
+	});
+}
+
+bool FMCPServer::ValidateToolArguments(const FMCPRegisteredTool& Entry, const TSharedPtr<FJsonObject>& Params,
+	TSharedPtr<FJsonObject>& OutArguments, FMCPToolArguments& OutValidatedArguments, FString& OutError)
+{
+	const TSharedPtr<FJsonValue> ArgumentsValue = Params.IsValid() ? Params->TryGetField(TEXT("arguments")) : TSharedPtr<FJsonValue>();
+	if (!ArgumentsValue.IsValid())
+	{
+		OutArguments = MakeShared<FJsonObject>();
+	}
+	else if (ArgumentsValue->Type == EJson::Object)
+	{
+		OutArguments = ArgumentsValue->AsObject();
+	}
+	else
+	{
+		OutError = TEXT("Tool arguments must be an object");
+		return false;
+	}
 	
-	return Result;
+	// Tools whose schema did not compile validate their own arguments
+	if (!Entry.ArgumentValidator.IsValid())
+	{
+		return true;
+	}
+	
+	return Entry.ArgumentValidator->Validate(OutArguments, OutValidatedArguments, OutError);
+}
+
+void FMCPServer::HandleCancelled(const TSharedPtr<FJsonObject>& Params)
+{
+	FMCPRequestId RequestId;
+	if (!Params.IsValid() || !Params->HasField(TEXT("requestId")) || !FMCPRequestId::FromJson(Params->TryGetField(TEXT("requestId")), RequestId))
+	{
+		return;
+	}
+	
+	// Unknown or already completed ids are ignored, as the protocol allows
+	FScopeLock Lock(&InFlightRequests->Lock);
+	if (const FMCPToolExecutionContextRef* Context = InFlightRequests->Contexts.Find(RequestId))
+	{
+		(*Context)->Cancel();
+	}
+}
+
+bool FMCPServer::HandleResourcesList(const FMCPRequest& Request, FMCPJsonWriter& Writer)
+{
+	Writer.BeginResultResponse(Request.Id);
+	Writer.WriteObjectStart();
+	Writer.WriteArrayStart("resources");
+	{
+		FReadScopeLock Lock(ResourcesLock);
+		for (const TPair<FString, FMCPRegisteredResource>& Pair : Resources)
+		{
+			const FMCPResourceInfo& Info = Pair.Value.Info;
+			Writer.WriteObjectStart();
+			Writer.WriteValue("uri", Info.Uri);
+			Writer.WriteValue("name", Info.Name);
+			if (!Info.Description.IsEmpty())
+			{
+				Writer.WriteValue("description", Info.Description);
+			}
+			if (!Info.MimeType.IsEmpty())
+			{
+				Writer.WriteValue("mimeType", Info.MimeType);
+			}
+			Writer.WriteObjectEnd();
+		}
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+	Writer.EndResponse();
+	return true;
 }
 
-FString FMCPServer::CreateSuccessResponse(int32 Id, const TSharedPtr<FJsonObject>& Result) const
+bool FMCPServer::HandleResourcesRead(const FMCPRequest& Request, FMCPJsonWriter& Writer)
 {
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
-	Response->SetNumberField(TEXT("id"), Id);
-	Response->SetObjectField(TEXT("result"), Result);
+	FString Uri;
+	if (!Request.Params.IsValid() || !Request.Params->TryGetStringField(TEXT("uri"), Uri))
+	{
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::InvalidParams, TEXT("Missing required parameter: uri"));
+		return false;
+	}
+	
+	// Copy the entry out so a slow reader never holds the lock
+	FMCPRegisteredResource Resource;
+	{
+		FReadScopeLock Lock(ResourcesLock);
+		const FMCPRegisteredResource* Found = Resources.Find(Uri);
+		if (!Found)
+		{
+			WriteErrorResponse(Writer, Request.Id, MCPProtocol::ResourceNotFound, FString::Printf(TEXT("Resource not found: %s"), *Uri));
+			return false;
+		}
+		Resource = *Found;
+	}
 	
-	FString ResponseString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
-	FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+	FString Text;
+	FString Error;
+	if (!Resource.Reader.Execute(Uri, Text, Error))
+	{
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::InternalError, Error.IsEmpty() ? FString(TEXT("Internal server error")) : Error);
+		return false;
+	}
 	
-	return ResponseString;
+	Writer.BeginResultResponse(Request.Id);
+	Writer.WriteObjectStart();
+	Writer.WriteArrayStart("contents");
+	Writer.WriteObjectStart();
+	Writer.WriteValue("uri", Uri);
+	if (!Resource.Info.MimeType.IsEmpty())
+	{
+		Writer.WriteValue("mimeType", Resource.Info.MimeType);
+	}
+	Writer.WriteValue("text", Text);
+	Writer.WriteObjectEnd();
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+	Writer.EndResponse();
+	return true;
 }
 
-FString FMCPServer::CreateErrorResponse(int32 Id, int32 Code, const FString& Message) const
+bool FMCPServer::HandlePromptsList(const FMCPRequest& Request, FMCPJsonWriter& Writer)
 {
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
-	Response->SetNumberField(TEXT("id"), Id);
+	Writer.BeginResultResponse(Request.Id);
+	Writer.WriteObjectStart();
+	Writer.WriteArrayStart("prompts");
+	{
+		FReadScopeLock Lock(PromptsLock);
+		for (const TPair<FString, FMCPRegisteredPrompt>& Pair : Prompts)
+		{
+			const FMCPPromptInfo& Info = Pair.Value.Info;
+			Writer.WriteObjectStart();
+			Writer.WriteValue("name", Info.Name);
+			if (!Info.Description.IsEmpty())
+			{
+				Writer.WriteValue("description", Info.Description);
+			}
+			Writer.WriteArrayStart("arguments");
+			for (const FMCPPromptArgument& Argument : Info.Arguments)
+			{
+				Writer.WriteObjectStart();
+				Writer.WriteValue("name", Argument.Name);
+				if (!Argument.Description.IsEmpty())
+				{
+					Writer.WriteValue("description", Argument.Description);
+				}
+				Writer.WriteValue("required", Argument.bRequired);
+				Writer.WriteObjectEnd();
+			}
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectEnd();
+		}
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPServer::HandlePromptsGet(const FMCPRequest& Request, FMCPJsonWriter& Writer)
+{
+	FString Name;
+	if (!Request.Params.IsValid() || !Request.Params->TryGetStringField(TEXT("name"), Name))
+	{
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::InvalidParams, TEXT("Missing required parameter: name"));
+		return false;
+	}
+	
+	FMCPRegisteredPrompt Prompt;
+	{
+		FReadScopeLock Lock(PromptsLock);
+		const FMCPRegisteredPrompt* Found = Prompts.Find(Name);
+		if (!Found)
+		{
+			WriteErrorResponse(Writer, Request.Id, MCPProtocol::InvalidParams, FString::Printf(TEXT("Prompt not found: %s"), *Name));
+			return false;
+		}
+		Prompt = *Found;
+	}
 	
-	TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
-	Error->SetNumberField(TEXT("code"), Code);
-	Error->SetStringField(TEXT("message"), Message);
-	Response->SetObjectField(TEXT("error"), Error);
+	// Prompt arguments are string-valued per the protocol
+	TMap<FString, FString> Arguments;
+	const TSharedPtr<FJsonObject>* ArgumentsObject = nullptr;
+	if (Request.Params->TryGetObjectField(TEXT("arguments"), ArgumentsObject))
+	{
+		for (const auto& Field : (*ArgumentsObject)->Values)
+		{
+			FString Value;
+			if (Field.Value.IsValid() && Field.Value->TryGetString(Value))
+			{
+				Arguments.Add(Field.Key, Value);
+			}
+		}
+	}
+	
+	for (const FMCPPromptArgument& Argument : Prompt.Info.Arguments)
+	{
+		if (Argument.bRequired && !Arguments.Contains(Argument.Name))
+		{
+			WriteErrorResponse(Writer, Request.Id, MCPProtocol::InvalidParams,
+				FString::Printf(TEXT("Missing required prompt argument: %s"), *Argument.Name));
+			return false;
+		}
+	}
+	
+	TArray<FMCPPromptMessage> Messages;
+	FString Error;
+	if (!Prompt.Renderer.Execute(Arguments, Messages, Error))
+	{
+		WriteErrorResponse(Writer, Request.Id, MCPProtocol::InternalError, Error.IsEmpty() ? FString(TEXT("Internal server error")) : Error);
+		return false;
+	}
 	
-	FString ResponseString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
-	FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+	Writer.BeginResultResponse(Request.Id);
+	Writer.WriteObjectStart();
+	if (!Prompt.Info.Description.IsEmpty())
+	{
+		Writer.WriteValue("description", Prompt.Info.Description);
+	}
+	Writer.WriteArrayStart("messages");
+	for (const FMCPPromptMessage& Message : Messages)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue("role", Message.Role);
+		Writer.WriteObjectStart("content");
+		Writer.WriteValue("type", TEXT("text"));
+		Writer.WriteValue("text", Message.Text);
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPServer::HandleServerStats(const FMCPRequest& Request, FMCPJsonWriter& Writer)
+{
+	Writer.BeginResultResponse(Request.Id);
+	WriteStats(Writer);
+	Writer.EndResponse();
+	
+	// {"reset": true} starts a fresh measurement window after reporting
+	bool bReset = false;
+	if (Request.Params.IsValid() && Request.Params->TryGetBoolField(TEXT("reset"), bReset) && bReset)
+	{
+		ResetStats();
+	}
+	return true;
+}
+
+void FMCPServer::WriteStats(FMCPJsonWriter& Writer) const
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue("requestsProcessed", GetRequestsProcessed());
+	Writer.WriteValue("errorsEncountered", GetErrorsEncountered());
+	Writer.WriteValue("inFlightRequests", GetNumInFlightRequests());
+	
+	Writer.WriteObjectStart("phases");
+	Writer.WriteIdentifier("parse");
+	Stats->Parse.Summarize().Write(Writer);
+	Writer.WriteIdentifier("dispatch");
+	Stats->Dispatch.Summarize().Write(Writer);
+	Writer.WriteIdentifier("execute");
+	Stats->Execute.Summarize().Write(Writer);
+	Writer.WriteIdentifier("serialize");
+	Stats->Serialize.Summarize().Write(Writer);
+	Writer.WriteObjectEnd();
+	
+	// Methods and tools that have been called, most total time first
+	struct FMethodRow
+	{
+		const FString* Method;
+		const FMCPMethodStats* MethodStats;
+		FMCPLatencySummary Latency;
+	};
+	
+	FMCPMethodTablePtr Methods = GetMethodTable();
+	TArray<FMethodRow> MethodRows;
+	for (const TPair<FName, FMCPMethodEntry>& Pair : Methods->Methods)
+	{
+		if (Pair.Value.Stats->Requests.load(std::memory_order_relaxed) > 0)
+		{
+			MethodRows.Add({ &Pair.Value.Method, Pair.Value.Stats.Get(), Pair.Value.Stats->Latency.Summarize() });
+		}
+	}
+	MethodRows.Sort([](const FMethodRow& A, const FMethodRow& B) { return A.Latency.TotalMicros > B.Latency.TotalMicros; });
+	
+	Writer.WriteArrayStart("methods");
+	for (const FMethodRow& Row : MethodRows)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue("method", *Row.Method);
+		Writer.WriteValue("requests", Row.MethodStats->Requests.load(std::memory_order_relaxed));
+		Writer.WriteValue("errors", Row.MethodStats->Errors.load(std::memory_order_relaxed));
+		Writer.WriteIdentifier("latency");
+		Row.Latency.Write(Writer);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+	
+	struct FToolRow
+	{
+		const FString* Name;
+		const FMCPToolStats* ToolStats;
+		FMCPLatencySummary Execute;
+		FMCPLatencySummary Serialize;
+	};
+	
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
+	TArray<FToolRow> ToolRows;
+	for (const TPair<FString, FMCPRegisteredTool>& Pair : Registry->Tools)
+	{
+		if (Pair.Value.Stats->Calls.load(std::memory_order_relaxed) > 0)
+		{
+			ToolRows.Add({ &Pair.Key, Pair.Value.Stats.Get(), Pair.Value.Stats->Execute.Summarize(), Pair.Value.Stats->Serialize.Summarize() });
+		}
+	}
+	ToolRows.Sort([](const FToolRow& A, const FToolRow& B) { return A.Execute.TotalMicros > B.Execute.TotalMicros; });
+	
+	Writer.WriteArrayStart("tools");
+	for (const FToolRow& Row : ToolRows)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue("name", *Row.Name);
+		Writer.WriteValue("calls", Row.ToolStats->Calls.load(std::memory_order_relaxed));
+		Writer.WriteValue("errors", Row.ToolStats->Errors.load(std::memory_order_relaxed));
+		Writer.WriteIdentifier("execute");
+		Row.Execute.Write(Writer);
+		Writer.WriteIdentifier("serialize");
+		Row.Serialize.Write(Writer);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+	
+	Writer.WriteObjectEnd();
+}
+
+void FMCPServer::ResetStats()
+{
+	Stats->RequestsProcessed = 0;
+	Stats->ErrorsEncountered = 0;
+	Stats->Parse.Reset();
+	Stats->Dispatch.Reset();
+	Stats->Execute.Reset();
+	Stats->Serialize.Reset();
+	
+	FMCPMethodTablePtr Methods = GetMethodTable();
+	for (const TPair<FName, FMCPMethodEntry>& Pair : Methods->Methods)
+	{
+		Pair.Value.Stats->Requests = 0;
+		Pair.Value.Stats->Errors = 0;
+		Pair.Value.Stats->Latency.Reset();
+	}
+	
+	FMCPToolRegistryPtr Registry = GetToolRegistry();
+	for (const TPair<FString, FMCPRegisteredTool>& Pair : Registry->Tools)
+	{
+		Pair.Value.Stats->Calls = 0;
+		Pair.Value.Stats->Errors = 0;
+		Pair.Value.Stats->Execute.Reset();
+		Pair.Value.Stats->Serialize.Reset();
+	}
+}
+
+void FMCPServer::WriteSuccessResponse(FMCPJsonWriter& Writer, const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Result) const
+{
+	// Streams the DOM directly into the UTF-8 buffer; no intermediate FString
+	Writer.BeginResultResponse(Id);
+	Writer.WriteJsonObject(Result);
+	Writer.EndResponse();
+}
+
+void FMCPServer::WriteErrorResponse(FMCPJsonWriter& Writer, const FMCPRequestId& Id, int32 Code, const FString& Message) const
+{
+	Writer.WriteErrorResponse(Id, Code, Message);
+}
+
+FString FMCPServer::CreateNotification(const FString& Method) const
+{
+	TArray<uint8> NotificationBuffer;
+	FMCPJsonWriter Writer(NotificationBuffer);
+	Writer.WriteObjectStart();
+	Writer.WriteValue("jsonrpc", TEXT("2.0"));
+	Writer.WriteValue("method", Method);
+	Writer.WriteObjectEnd();
 	
-	return ResponseString;
+	return FMCPJsonWriter::ToString(NotificationBuffer);
 }
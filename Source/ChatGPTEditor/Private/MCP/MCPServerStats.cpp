@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCP/MCPServerStats.h"
+#include "MCP/MCPJsonWriter.h"
+
+void FMCPLatencySummary::Write(FMCPJsonWriter& Writer) const
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue("count", Count);
+	Writer.WriteValue("totalMs", TotalMicros / 1000.0);
+	Writer.WriteValue("meanUs", FMath::RoundToDouble(MeanMicros));
+	Writer.WriteValue("p50Us", P50Micros);
+	Writer.WriteValue("p90Us", P90Micros);
+	Writer.WriteValue("p99Us", P99Micros);
+	Writer.WriteValue("maxUs", MaxMicros);
+	Writer.WriteObjectEnd();
+}
+
+FMCPLatencyHistogram::FMCPLatencyHistogram()
+{
+	Reset();
+}
+
+int32 FMCPLatencyHistogram::GetBucketIndex(uint64 Micros)
+{
+	if (Micros < SubBucketCount)
+	{
+		return static_cast<int32>(Micros);
+	}
+
+	const int32 Exponent = static_cast<int32>(FMath::FloorLog2_64(Micros));
+	if (Exponent > MaxExponent)
+	{
+		return NumBuckets - 1;
+	}
+
+	// The top SubBucketBits below the leading one select the linear sub-bucket
+	const int32 SubBucket = static_cast<int32>(Micros >> (Exponent - SubBucketBits)) - SubBucketCount;
+	return (Exponent - SubBucketBits + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FMCPLatencyHistogram::GetBucketUpperBound(int32 Index)
+{
+	if (Index < SubBucketCount)
+	{
+		return static_cast<uint64>(Index);
+	}
+
+	const int32 Shift = Index / SubBucketCount - 1;
+	const uint64 SubBucket = static_cast<uint64>(Index % SubBucketCount);
+	const uint64 LowerBound = (SubBucketCount + SubBucket) << Shift;
+	return LowerBound + (uint64(1) << Shift) - 1;
+}
+
+void FMCPLatencyHistogram::RecordMicros(uint64 Micros)
+{
+	Buckets[GetBucketIndex(Micros)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	TotalMicros.fetch_add(Micros, std::memory_order_relaxed);
+
+	uint64 CurrentMax = MaxMicros.load(std::memory_order_relaxed);
+	while (Micros > CurrentMax && !MaxMicros.compare_exchange_weak(CurrentMax, Micros, std::memory_order_relaxed))
+	{
+	}
+}
+
+void FMCPLatencyHistogram::RecordSince(uint64 StartCycles)
+{
+	RecordMicros(MicrosSince(StartCycles));
+}
+
+uint64 FMCPLatencyHistogram::MicrosSince(uint64 StartCycles)
+{
+	const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+	return static_cast<uint64>(FPlatformTime::ToSeconds64(ElapsedCycles) * 1000000.0);
+}
+
+FMCPLatencySummary FMCPLatencyHistogram::Summarize() const
+{
+	// Snapshot the buckets once; concurrent records may land on either side of the copy
+	uint64 Snapshot[NumBuckets];
+	uint64 SnapshotCount = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Snapshot[Index] = Buckets[Index].load(std::memory_order_relaxed);
+		SnapshotCount += Snapshot[Index];
+	}
+
+	FMCPLatencySummary Summary;
+	if (SnapshotCount == 0)
+	{
+		return Summary;
+	}
+
+	Summary.Count = static_cast<int64>(SnapshotCount);
+	Summary.TotalMicros = static_cast<double>(TotalMicros.load(std::memory_order_relaxed));
+	Summary.MeanMicros = Summary.TotalMicros / static_cast<double>(FMath::Max(Count.load(std::memory_order_relaxed), uint64(1)));
+	Summary.MaxMicros = static_cast<double>(MaxMicros.load(std::memory_order_relaxed));
+
+	constexpr int32 NumPercentiles = 3;
+	const double Percentiles[NumPercentiles] = { 0.50, 0.90, 0.99 };
+	double* Results[NumPercentiles] = { &Summary.P50Micros, &Summary.P90Micros, &Summary.P99Micros };
+
+	int32 NextPercentile = 0;
+	uint64 Cumulative = 0;
+	for (int32 Index = 0; Index < NumBuckets && NextPercentile < NumPercentiles; ++Index)
+	{
+		Cumulative += Snapshot[Index];
+		while (NextPercentile < NumPercentiles
+			&& Cumulative >= static_cast<uint64>(FMath::CeilToDouble(Percentiles[NextPercentile] * SnapshotCount)))
+		{
+			*Results[NextPercentile] = FMath::Min(static_cast<double>(GetBucketUpperBound(Index)), Summary.MaxMicros);
+			++NextPercentile;
+		}
+	}
+
+	return Summary;
+}
+
+void FMCPLatencyHistogram::Reset()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	TotalMicros.store(0, std::memory_order_relaxed);
+	MaxMicros.store(0, std::memory_order_relaxed);
+}
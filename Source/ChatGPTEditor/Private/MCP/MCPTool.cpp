@@ -1,6 +1,61 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MCP/MCPTool.h"
+#include "MCP/MCPJsonWriter.h"
+#include "MCP/MCPTypes.h"
+
+FMCPToolExecutionContext::FMCPToolExecutionContext(const FMCPRequestId& InRequestId, const TSharedPtr<FJsonValue>& InProgressToken, TFunction<void(const FString&)> InNotificationSink)
+	: RequestId(InRequestId)
+	, ProgressToken(InProgressToken)
+	, bCancelled(false)
+	, NotificationSink(MoveTemp(InNotificationSink))
+{
+}
+
+void FMCPToolExecutionContext::ReportProgress(double Progress, double Total, const FString& Message)
+{
+	if (!ProgressToken.IsValid())
+	{
+		return;
+	}
+	
+	TArray<uint8> NotificationBuffer;
+	FMCPJsonWriter Writer(NotificationBuffer);
+	Writer.WriteObjectStart();
+	Writer.WriteValue("jsonrpc", TEXT("2.0"));
+	Writer.WriteValue("method", MCPProtocol::Notification_Progress);
+	Writer.WriteObjectStart("params");
+	Writer.WriteIdentifier("progressToken");
+	Writer.WriteJsonValue(ProgressToken);
+	Writer.WriteValue("progress", Progress);
+	if (Total > 0.0)
+	{
+		Writer.WriteValue("total", Total);
+	}
+	if (!Message.IsEmpty())
+	{
+		Writer.WriteValue("message", Message);
+	}
+	Writer.WriteObjectEnd();
+	Writer.WriteObjectEnd();
+	
+	FScopeLock Lock(&NotificationSinkLock);
+	if (NotificationSink)
+	{
+		NotificationSink(FMCPJsonWriter::ToString(NotificationBuffer));
+	}
+}
+
+void FMCPToolExecutionContext::DetachNotificationSink()
+{
+	FScopeLock Lock(&NotificationSinkLock);
+	NotificationSink = nullptr;
+}
+
+TFuture<TSharedPtr<FJsonObject>> IMCPTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(Execute(Arguments)).GetFuture();
+}
 
 FMCPToolBase::FMCPToolBase(const FString& InName, const FString& InDescription)
 	: Name(InName)
@@ -8,7 +63,7 @@ FMCPToolBase::FMCPToolBase(const FString& InName, const FString& InDescription)
 {
 }
 
-TSharedPtr<FJsonObject> FMCPToolBase::CreateSuccessResponse(const FString& Message) const
+TSharedPtr<FJsonObject> FMCPToolBase::CreateSuccessResponse(const FString& Message)
 {
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	
@@ -24,7 +79,7 @@ TSharedPtr<FJsonObject> FMCPToolBase::CreateSuccessResponse(const FString& Messa
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPToolBase::CreateErrorResponse(const FString& ErrorMessage) const
+TSharedPtr<FJsonObject> FMCPToolBase::CreateErrorResponse(const FString& ErrorMessage)
 {
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetBoolField(TEXT("success"), false);
@@ -42,10 +97,84 @@ TSharedPtr<FJsonObject> FMCPToolBase::CreateErrorResponse(const FString& ErrorMe
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPToolBase::CreateTextContent(const FString& Text) const
+TSharedPtr<FJsonObject> FMCPToolBase::CreateTextContent(const FString& Text)
 {
 	TSharedPtr<FJsonObject> Content = MakeShared<FJsonObject>();
 	Content->SetStringField(TEXT("type"), TEXT("text"));
 	Content->SetStringField(TEXT("text"), Text);
 	return Content;
 }
+
+FString FMCPToolBase::ToPropertyText(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		return FString();
+	}
+	
+	switch (Value->Type)
+	{
+		case EJson::Boolean:
+			return Value->AsBool() ? TEXT("True") : TEXT("False");
+		
+		case EJson::Number:
+		{
+			const double Number = Value->AsNumber();
+			return Number == FMath::FloorToDouble(Number) && FMath::Abs(Number) < 9007199254740992.0
+				? FString::Printf(TEXT("%lld"), static_cast<int64>(Number))
+				: FString::SanitizeFloat(Number);
+		}
+		
+		default:
+			return Value->AsString();
+	}
+}
+
+void FMCPToolBase::WriteSuccessResponse(FMCPJsonWriter& Writer, FStringView Message) const
+{
+	Writer.WriteObjectStart();
+	Writer.WriteArrayStart("content");
+	Writer.WriteObjectStart();
+	Writer.WriteValue("type", TEXT("text"));
+	Writer.WriteIdentifier("text");
+	Writer.WriteValue(Message);
+	Writer.WriteObjectEnd();
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+}
+
+void FMCPToolBase::WriteErrorResponse(FMCPJsonWriter& Writer, FStringView ErrorMessage) const
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue("success", false);
+	Writer.WriteIdentifier("error");
+	Writer.WriteValue(ErrorMessage);
+	
+	// Also include in content array for MCP compatibility
+	Writer.WriteArrayStart("content");
+	Writer.WriteObjectStart();
+	Writer.WriteValue("type", TEXT("text"));
+	Writer.WriteValue("text", FString::Printf(TEXT("Error: %.*s"), ErrorMessage.Len(), ErrorMessage.GetData()));
+	Writer.WriteObjectEnd();
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+}
+
+bool FMCPToolBase::ValidateArguments(const TSharedPtr<FJsonObject>& Arguments, FMCPToolArguments& OutArguments, FString& OutError) const
+{
+	FMCPSchemaValidatorPtr Validator;
+	{
+		FScopeLock Lock(&ArgumentValidatorLock);
+		if (!ArgumentValidator.IsValid())
+		{
+			ArgumentValidator = FMCPSchemaValidator::Compile(GetInputSchema(), OutError);
+			if (!ArgumentValidator.IsValid())
+			{
+				return false;
+			}
+		}
+		Validator = ArgumentValidator;
+	}
+	
+	return Validator->Validate(Arguments, OutArguments, OutError);
+}
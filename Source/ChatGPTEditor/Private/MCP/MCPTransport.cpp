@@ -0,0 +1,551 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCP/MCPTransport.h"
+#include "MCP/MCPServer.h"
+#include "Async/Async.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace MCPTransportPrivate
+{
+	/** Bytes requested per Read call */
+	static constexpr int32 ReadChunkSize = 64 * 1024;
+
+	/** How long Read may block before re-checking for Stop */
+	static constexpr int32 ReadPollMilliseconds = 50;
+
+	/** Runs a function on an FRunnableThread */
+	class FTransportRunnable : public FRunnable
+	{
+	public:
+		explicit FTransportRunnable(TFunction<uint32()> InBody)
+			: Body(MoveTemp(InBody))
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			return Body();
+		}
+
+	private:
+		TFunction<uint32()> Body;
+	};
+}
+
+FMCPTransport::FMCPTransport(FMCPServer& InServer)
+	: Server(InServer)
+	, SendEvent(nullptr)
+	, ReaderRunnable(nullptr)
+	, WriterRunnable(nullptr)
+	, ReaderThread(nullptr)
+	, WriterThread(nullptr)
+	, bRunning(false)
+	, bStopRequested(false)
+	, bClosedByPeer(false)
+	, ConnectionId(0)
+	, bDispatchOnGameThread(true)
+	, NumMessagesReceived(0)
+	, NumMessagesSent(0)
+{
+	// Lives as long as the transport so a late Send after Stop is harmless
+	SendEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FMCPTransport::~FMCPTransport()
+{
+	// Subclass destructors stop the threads while their Read/Write overrides still exist
+	check(!bRunning);
+
+	FPlatformProcess::ReturnSynchEventToPool(SendEvent);
+	SendEvent = nullptr;
+}
+
+bool FMCPTransport::Start()
+{
+	if (bRunning)
+	{
+		return true;
+	}
+
+	if (!Open())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: failed to open transport"), GetTransportName());
+		return false;
+	}
+
+	bStopRequested = false;
+	bClosedByPeer = false;
+	bRunning = true;
+
+	// Server notifications (progress, tools/list_changed) go out on the same queue as responses
+	TWeakPtr<FMCPTransport, ESPMode::ThreadSafe> WeakTransport = AsShared();
+	NotificationHandle = Server.OnNotification().AddLambda([WeakTransport](const FString& Notification)
+	{
+		if (TSharedPtr<FMCPTransport, ESPMode::ThreadSafe> Transport = WeakTransport.Pin())
+		{
+			Transport->Send(Notification);
+		}
+	});
+
+	ReaderRunnable = new MCPTransportPrivate::FTransportRunnable([this]() { return RunReader(); });
+	WriterRunnable = new MCPTransportPrivate::FTransportRunnable([this]() { return RunWriter(); });
+	WriterThread = FRunnableThread::Create(WriterRunnable, *FString::Printf(TEXT("%sWriter"), GetTransportName()));
+	ReaderThread = FRunnableThread::Create(ReaderRunnable, *FString::Printf(TEXT("%sReader"), GetTransportName()));
+
+	UE_LOG(LogTemp, Log, TEXT("%s: transport started"), GetTransportName());
+	return true;
+}
+
+void FMCPTransport::Stop()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	Server.OnNotification().Remove(NotificationHandle);
+	NotificationHandle.Reset();
+
+	bStopRequested = true;
+	SendEvent->Trigger();
+
+	if (ReaderThread)
+	{
+		ReaderThread->WaitForCompletion();
+		delete ReaderThread;
+		ReaderThread = nullptr;
+	}
+	if (WriterThread)
+	{
+		WriterThread->WaitForCompletion();
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+
+	delete ReaderRunnable;
+	ReaderRunnable = nullptr;
+	delete WriterRunnable;
+	WriterRunnable = nullptr;
+
+	Close();
+	bRunning = false;
+
+	UE_LOG(LogTemp, Log, TEXT("%s: transport stopped (%lld received, %lld sent)"),
+		GetTransportName(), NumMessagesReceived.load(), NumMessagesSent.load());
+}
+
+void FMCPTransport::Send(const FString& Message)
+{
+	SendToConnection(Message, ConnectionId);
+}
+
+void FMCPTransport::SendToConnection(const FString& Message, uint32 MessageConnectionId)
+{
+	// A response to a client that has since gone away is dropped here, or by the writer if it is queued first
+	if (Message.IsEmpty() || !bRunning || bStopRequested || MessageConnectionId != ConnectionId)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8Message(*Message, Message.Len());
+
+	FOutgoingLine Outgoing;
+	Outgoing.ConnectionId = MessageConnectionId;
+	Outgoing.Line.Reserve(Utf8Message.Length() + 1);
+	Outgoing.Line.Append(reinterpret_cast<const uint8*>(Utf8Message.Get()), Utf8Message.Length());
+	Outgoing.Line.Add('\n');
+
+	SendQueue.Enqueue(MoveTemp(Outgoing));
+	SendEvent->Trigger();
+}
+
+void FMCPTransport::BeginConnection()
+{
+	FScopeLock Lock(&ConnectionLock);
+	++ConnectionId;
+}
+
+uint32 FMCPTransport::RunReader()
+{
+	FMCPMessageFramer Framer;
+	TArray<uint8> ReadBuffer;
+	ReadBuffer.SetNumUninitialized(MCPTransportPrivate::ReadChunkSize);
+
+	FString Message;
+	uint32 ReaderConnectionId = ConnectionId;
+	while (!bStopRequested)
+	{
+		const int32 BytesRead = Read(ReadBuffer.GetData(), ReadBuffer.Num());
+		if (BytesRead < 0)
+		{
+			bClosedByPeer = true;
+			break;
+		}
+
+		// Read accepts new clients, so these bytes may be the first from a new one; the last one's partial message is dropped
+		const uint32 CurrentConnectionId = ConnectionId;
+		if (CurrentConnectionId != ReaderConnectionId)
+		{
+			Framer.Reset();
+			ReaderConnectionId = CurrentConnectionId;
+		}
+
+		Framer.Append(ReadBuffer.GetData(), BytesRead);
+		while (Framer.NextMessage(Message))
+		{
+			++NumMessagesReceived;
+			Dispatch(MoveTemp(Message), ReaderConnectionId);
+		}
+	}
+
+	if (Framer.GetNumDroppedMessages() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: dropped %d oversized message(s)"), GetTransportName(), Framer.GetNumDroppedMessages());
+	}
+
+	return 0;
+}
+
+void FMCPTransport::Dispatch(FString&& Message, uint32 MessageConnectionId)
+{
+	TWeakPtr<FMCPTransport, ESPMode::ThreadSafe> WeakTransport = AsShared();
+	FMCPServer* TargetServer = &Server;
+
+	// The response goes back to the connection the request came from, or nowhere
+	auto ProcessOnThisThread = [WeakTransport, TargetServer, MessageConnectionId](const FString& Request)
+	{
+		TargetServer->ProcessMessageAsync(Request).Next([WeakTransport, MessageConnectionId](const FString& Response)
+		{
+			if (TSharedPtr<FMCPTransport, ESPMode::ThreadSafe> Transport = WeakTransport.Pin())
+			{
+				Transport->SendToConnection(Response, MessageConnectionId);
+			}
+		});
+	};
+
+	if (bDispatchOnGameThread)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakTransport, ProcessOnThisThread, Request = MoveTemp(Message)]()
+		{
+			// The transport may have been stopped while this task was queued
+			if (TSharedPtr<FMCPTransport, ESPMode::ThreadSafe> Transport = WeakTransport.Pin())
+			{
+				if (Transport->IsRunning())
+				{
+					ProcessOnThisThread(Request);
+				}
+			}
+		});
+	}
+	else
+	{
+		ProcessOnThisThread(Message);
+	}
+}
+
+uint32 FMCPTransport::RunWriter()
+{
+	TArray<uint8> WriteBuffer;
+	while (!bStopRequested)
+	{
+		SendEvent->Wait(MCPTransportPrivate::ReadPollMilliseconds);
+		FlushSendQueue(WriteBuffer);
+	}
+
+	// Deliver whatever was queued before Stop
+	FlushSendQueue(WriteBuffer);
+	return 0;
+}
+
+void FMCPTransport::FlushSendQueue(TArray<uint8>& WriteBuffer)
+{
+	// Coalesce everything queued into one write; pipelined clients get one syscall per burst
+	WriteBuffer.Reset();
+	int32 NumLines = 0;
+
+	// Held through the write, so BeginConnection can't hand the stream to a new client mid-batch
+	FScopeLock Lock(&ConnectionLock);
+	const uint32 CurrentConnectionId = ConnectionId;
+
+	FOutgoingLine Outgoing;
+	while (SendQueue.Dequeue(Outgoing))
+	{
+		if (Outgoing.ConnectionId == CurrentConnectionId)
+		{
+			WriteBuffer.Append(Outgoing.Line);
+			++NumLines;
+		}
+	}
+
+	if (NumLines > 0)
+	{
+		if (Write(WriteBuffer.GetData(), WriteBuffer.Num()))
+		{
+			NumMessagesSent += NumLines;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: failed to write %d message(s)"), GetTransportName(), NumLines);
+		}
+	}
+}
+
+FMCPStdioTransport::FMCPStdioTransport(FMCPServer& InServer)
+	: FMCPTransport(InServer)
+{
+}
+
+FMCPStdioTransport::~FMCPStdioTransport()
+{
+	Stop();
+}
+
+bool FMCPStdioTransport::Open()
+{
+	return true;
+}
+
+void FMCPStdioTransport::Close()
+{
+}
+
+int32 FMCPStdioTransport::Read(uint8* Data, int32 MaxBytes)
+{
+#if PLATFORM_WINDOWS
+	HANDLE StdIn = ::GetStdHandle(STD_INPUT_HANDLE);
+	if (StdIn == INVALID_HANDLE_VALUE || StdIn == nullptr)
+	{
+		return -1;
+	}
+
+	// Poll pipes so the reader can notice Stop; consoles fall back to a blocking read
+	DWORD BytesAvailable = 0;
+	if (::PeekNamedPipe(StdIn, nullptr, 0, nullptr, &BytesAvailable, nullptr))
+	{
+		if (BytesAvailable == 0)
+		{
+			FPlatformProcess::Sleep(MCPTransportPrivate::ReadPollMilliseconds / 1000.0f);
+			return 0;
+		}
+		MaxBytes = FMath::Min<int32>(MaxBytes, static_cast<int32>(BytesAvailable));
+	}
+	else if (::GetLastError() == ERROR_BROKEN_PIPE)
+	{
+		return -1;
+	}
+
+	DWORD BytesRead = 0;
+	if (!::ReadFile(StdIn, Data, static_cast<DWORD>(MaxBytes), &BytesRead, nullptr))
+	{
+		return -1;
+	}
+	return BytesRead > 0 ? static_cast<int32>(BytesRead) : -1;
+#else
+	pollfd PollDescriptor;
+	PollDescriptor.fd = STDIN_FILENO;
+	PollDescriptor.events = POLLIN;
+	PollDescriptor.revents = 0;
+
+	const int32 PollResult = ::poll(&PollDescriptor, 1, MCPTransportPrivate::ReadPollMilliseconds);
+	if (PollResult == 0 || (PollResult < 0 && errno == EINTR))
+	{
+		return 0;
+	}
+	if (PollResult < 0)
+	{
+		return -1;
+	}
+
+	const ssize_t BytesRead = ::read(STDIN_FILENO, Data, MaxBytes);
+	if (BytesRead < 0)
+	{
+		return errno == EINTR || errno == EAGAIN ? 0 : -1;
+	}
+	return BytesRead > 0 ? static_cast<int32>(BytesRead) : -1;
+#endif
+}
+
+bool FMCPStdioTransport::Write(const uint8* Data, int32 NumBytes)
+{
+#if PLATFORM_WINDOWS
+	HANDLE StdOut = ::GetStdHandle(STD_OUTPUT_HANDLE);
+	while (NumBytes > 0)
+	{
+		DWORD BytesWritten = 0;
+		if (!::WriteFile(StdOut, Data, static_cast<DWORD>(NumBytes), &BytesWritten, nullptr))
+		{
+			return false;
+		}
+		Data += BytesWritten;
+		NumBytes -= static_cast<int32>(BytesWritten);
+	}
+	::FlushFileBuffers(StdOut);
+	return true;
+#else
+	while (NumBytes > 0)
+	{
+		const ssize_t BytesWritten = ::write(STDOUT_FILENO, Data, NumBytes);
+		if (BytesWritten < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+		Data += BytesWritten;
+		NumBytes -= static_cast<int32>(BytesWritten);
+	}
+	return true;
+#endif
+}
+
+FMCPTcpTransport::FMCPTcpTransport(FMCPServer& InServer, int32 InPort)
+	: FMCPTransport(InServer)
+	, Port(InPort)
+	, BoundPort(0)
+	, ListenSocket(nullptr)
+	, ClientSocket(nullptr)
+{
+}
+
+FMCPTcpTransport::~FMCPTcpTransport()
+{
+	Stop();
+}
+
+bool FMCPTcpTransport::Open()
+{
+	// Loopback only; the MCP server has no authentication
+	ListenSocket = FTcpSocketBuilder(TEXT("MCPTcpListener"))
+		.AsReusable()
+		.BoundToEndpoint(FIPv4Endpoint(FIPv4Address::InternalLoopback, static_cast<uint16>(Port)))
+		.Listening(1)
+		.Build();
+
+	if (!ListenSocket)
+	{
+		return false;
+	}
+
+	BoundPort = ListenSocket->GetPortNo();
+	UE_LOG(LogTemp, Log, TEXT("MCPTcp: listening on 127.0.0.1:%d"), BoundPort);
+	return true;
+}
+
+void FMCPTcpTransport::Close()
+{
+	CloseClient();
+
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+}
+
+FSocket* FMCPTcpTransport::AcceptClient()
+{
+	{
+		FScopeLock Lock(&ClientLock);
+		if (ClientSocket)
+		{
+			return ClientSocket;
+		}
+	}
+
+	bool bHasPendingConnection = false;
+	if (!ListenSocket->WaitForPendingConnection(bHasPendingConnection, FTimespan::FromMilliseconds(MCPTransportPrivate::ReadPollMilliseconds))
+		|| !bHasPendingConnection)
+	{
+		return nullptr;
+	}
+
+	FSocket* NewClient = ListenSocket->Accept(TEXT("MCPTcpClient"));
+	if (NewClient)
+	{
+		// Reads are gated by Wait; blocking sends keep the writer simple
+		NewClient->SetNonBlocking(false);
+		NewClient->SetNoDelay(true);
+		BeginConnection();
+		UE_LOG(LogTemp, Log, TEXT("MCPTcp: client connected"));
+	}
+
+	FScopeLock Lock(&ClientLock);
+	ClientSocket = NewClient;
+	return ClientSocket;
+}
+
+void FMCPTcpTransport::CloseClient()
+{
+	FScopeLock Lock(&ClientLock);
+	if (ClientSocket)
+	{
+		ClientSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
+		ClientSocket = nullptr;
+	}
+}
+
+int32 FMCPTcpTransport::Read(uint8* Data, int32 MaxBytes)
+{
+	FSocket* Client = AcceptClient();
+	if (!Client)
+	{
+		return 0;
+	}
+
+	if (!Client->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(MCPTransportPrivate::ReadPollMilliseconds)))
+	{
+		return 0;
+	}
+
+	int32 BytesRead = 0;
+	if (!Client->Recv(Data, MaxBytes, BytesRead) || BytesRead == 0)
+	{
+		// Client went away; keep listening for the next one
+		UE_LOG(LogTemp, Log, TEXT("MCPTcp: client disconnected"));
+		CloseClient();
+		return 0;
+	}
+
+	return BytesRead;
+}
+
+bool FMCPTcpTransport::Write(const uint8* Data, int32 NumBytes)
+{
+	FScopeLock Lock(&ClientLock);
+	if (!ClientSocket)
+	{
+		return false;
+	}
+
+	while (NumBytes > 0)
+	{
+		int32 BytesSent = 0;
+		if (!ClientSocket->Send(Data, NumBytes, BytesSent))
+		{
+			return false;
+		}
+		Data += BytesSent;
+		NumBytes -= BytesSent;
+	}
+	return true;
+}
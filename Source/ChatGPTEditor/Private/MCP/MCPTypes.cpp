@@ -1,26 +1,83 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MCP/MCPTypes.h"
-#include "JsonUtilities.h"
+#include "MCP/MCPJsonWriter.h"
+
+bool FMCPRequestId::FromJson(const TSharedPtr<FJsonValue>& Value, FMCPRequestId& OutId)
+{
+	OutId = FMCPRequestId();
+	if (!Value.IsValid() || Value->IsNull())
+	{
+		return true;
+	}
+	
+	if (Value->Type == EJson::Number)
+	{
+		OutId.Kind = EKind::Number;
+		OutId.Number = Value->AsNumber();
+		return true;
+	}
+	
+	if (Value->Type == EJson::String)
+	{
+		OutId.Kind = EKind::String;
+		OutId.String = Value->AsString();
+		return true;
+	}
+	
+	return false;
+}
+
+void FMCPRequestId::Write(FMCPJsonWriter& Writer) const
+{
+	switch (Kind)
+	{
+		case EKind::Number:
+			Writer.WriteValue(Number);
+			break;
+		
+		case EKind::String:
+			Writer.WriteValue(String);
+			break;
+		
+		case EKind::Null:
+		default:
+			Writer.WriteNull();
+			break;
+	}
+}
+
+FString FMCPRequestId::ToString() const
+{
+	TArray<uint8> Buffer;
+	FMCPJsonWriter Writer(Buffer);
+	Write(Writer);
+	return FMCPJsonWriter::ToString(Buffer);
+}
 
 FString FMCPResponse::ToJsonString() const
 {
-	TSharedPtr<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-	ResponseObj->SetStringField(TEXT("jsonrpc"), JsonRpc);
-	ResponseObj->SetNumberField(TEXT("id"), Id);
+	TArray<uint8> ResponseBuffer;
+	WriteJson(ResponseBuffer);
+	return FMCPJsonWriter::ToString(ResponseBuffer);
+}
+
+void FMCPResponse::WriteJson(TArray<uint8>& OutBuffer) const
+{
+	FMCPJsonWriter Writer(OutBuffer);
+	Writer.WriteObjectStart();
+	Writer.WriteValue("jsonrpc", JsonRpc);
+	Writer.WriteIdentifier("id");
+	Id.Write(Writer);
 	
 	if (Result.IsValid())
 	{
-		ResponseObj->SetObjectField(TEXT("result"), Result);
+		Writer.WriteJsonObject("result", Result);
 	}
 	else if (Error.IsValid())
 	{
-		ResponseObj->SetObjectField(TEXT("error"), Error);
+		Writer.WriteJsonObject("error", Error);
 	}
 	
-	FString ResponseString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
-	FJsonSerializer::Serialize(ResponseObj.ToSharedRef(), Writer);
-	
-	return ResponseString;
+	Writer.WriteObjectEnd();
 }
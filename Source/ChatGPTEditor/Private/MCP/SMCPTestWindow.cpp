@@ -2,14 +2,15 @@
 
 #include "SMCPTestWindow.h"
 #include "MCP/MCPServer.h"
-#include "MCP/Tools/EchoTool.h"
-#include "MCP/Tools/SpawnActorTool.h"
+#include "MCP/MCPJsonWriter.h"
+#include "MCP/Tools/MCPBuiltInTools.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Styling/AppStyle.h"
+#include "Async/Async.h"
 
 #define LOCTEXT_NAMESPACE "SMCPTestWindow"
 
@@ -22,8 +23,7 @@ void SMCPTestWindow::Construct(const FArguments& InArgs)
 	MCPServer->Initialize();
 	
 	// Register tools
-	MCPServer->RegisterTool(MakeShared<FEchoTool>());
-	MCPServer->RegisterTool(MakeShared<FSpawnActorTool>());
+	MCPTools::RegisterBuiltInTools(*MCPServer);
 	
 	ChildSlot
 	[
@@ -65,6 +65,16 @@ void SMCPTestWindow::Construct(const FArguments& InArgs)
 				.OnClicked(this, &SMCPTestWindow::OnListToolsClicked)
 				.ToolTipText(LOCTEXT("ListToolsTooltip", "List all available MCP tools"))
 			]
+			
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f, 0.0f, 5.0f, 0.0f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ResetStats", "Reset Stats"))
+				.OnClicked(this, &SMCPTestWindow::OnResetStatsClicked)
+				.ToolTipText(LOCTEXT("ResetStatsTooltip", "Clear the server's request counters and latency histograms"))
+			]
 		]
 		
 		// Input section
@@ -140,10 +150,40 @@ void SMCPTestWindow::Construct(const FArguments& InArgs)
 				.AlwaysShowScrollbars(true)
 			]
 		]
+		
+		// Stats section
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(10.0f, 5.0f, 10.0f, 10.0f)
+		[
+			SNew(SVerticalBox)
+			
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 0.0f, 0.0f, 5.0f)
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("StatsLabel", "Server Stats (latency in microseconds):"))
+				.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
+			]
+			
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(StatsTextBlock, STextBlock)
+				.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+			]
+		]
 	];
 	
+	RefreshStats(0.0, 0.0f);
+	RegisterActiveTimer(1.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SMCPTestWindow::RefreshStats));
+	
+	// Show server-initiated notifications (e.g. tools/list_changed) alongside responses
+	MCPServer->OnNotification().AddSP(this, &SMCPTestWindow::OnServerNotification);
+	
 	AppendOutput(TEXT("MCP Server initialized and ready.\n"));
-	AppendOutput(TEXT("Registered tools: echo, spawn_actor\n"));
+	AppendOutput(TEXT("Registered tools: echo, spawn_actor, spawn_actors, query_actors, set_property\n"));
 	AppendOutput(TEXT("Click 'Initialize' to start, or enter custom JSON-RPC messages.\n\n"));
 }
 
@@ -227,6 +267,114 @@ FReply SMCPTestWindow::OnListToolsClicked()
 	return OnSendMessageClicked();
 }
 
+FReply SMCPTestWindow::OnResetStatsClicked()
+{
+	if (MCPServer.IsValid())
+	{
+		MCPServer->ResetStats();
+		RefreshStats(0.0, 0.0f);
+	}
+	return FReply::Handled();
+}
+
+EActiveTimerReturnType SMCPTestWindow::RefreshStats(double InCurrentTime, float InDeltaTime)
+{
+	if (StatsTextBlock.IsValid() && MCPServer.IsValid())
+	{
+		StatsTextBlock->SetText(FText::FromString(FormatStats()));
+	}
+	return EActiveTimerReturnType::Continue;
+}
+
+FString SMCPTestWindow::FormatStats() const
+{
+	// Read the same JSON server/stats returns, without counting as a request
+	TArray<uint8> StatsBuffer;
+	FMCPJsonWriter Writer(StatsBuffer);
+	MCPServer->WriteStats(Writer);
+	
+	TSharedPtr<FJsonObject> StatsJson;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FMCPJsonWriter::ToString(StatsBuffer));
+	if (!FJsonSerializer::Deserialize(Reader, StatsJson) || !StatsJson.IsValid())
+	{
+		return FString();
+	}
+	
+	auto FormatRow = [](const FString& Label, const TSharedPtr<FJsonObject>& Summary)
+	{
+		if (!Summary.IsValid())
+		{
+			return FString();
+		}
+		return FString::Printf(TEXT("%-22s %8d %10.0f %10.0f %10.0f %10.1f\n"), *Label.Left(22),
+			static_cast<int32>(Summary->GetNumberField(TEXT("count"))),
+			Summary->GetNumberField(TEXT("p50Us")),
+			Summary->GetNumberField(TEXT("p99Us")),
+			Summary->GetNumberField(TEXT("maxUs")),
+			Summary->GetNumberField(TEXT("totalMs")));
+	};
+	
+	FString Text = FString::Printf(TEXT("Requests: %d   Errors: %d   In flight: %d\n\n"),
+		static_cast<int32>(StatsJson->GetNumberField(TEXT("requestsProcessed"))),
+		static_cast<int32>(StatsJson->GetNumberField(TEXT("errorsEncountered"))),
+		static_cast<int32>(StatsJson->GetNumberField(TEXT("inFlightRequests"))));
+	
+	const FString Header = FString::Printf(TEXT("%-22s %8s %10s %10s %10s %10s\n"), TEXT("phase"), TEXT("count"), TEXT("p50"), TEXT("p99"), TEXT("max"), TEXT("total ms"));
+	
+	const TSharedPtr<FJsonObject>* Phases = nullptr;
+	if (StatsJson->TryGetObjectField(TEXT("phases"), Phases))
+	{
+		Text += Header;
+		for (const TCHAR* Phase : { TEXT("parse"), TEXT("dispatch"), TEXT("execute"), TEXT("serialize") })
+		{
+			Text += FormatRow(Phase, (*Phases)->GetObjectField(Phase));
+		}
+	}
+	
+	// Tools are listed slowest first, so the one dominating turn latency is on top
+	const TArray<TSharedPtr<FJsonValue>>* Tools = nullptr;
+	if (StatsJson->TryGetArrayField(TEXT("tools"), Tools) && Tools->Num() > 0)
+	{
+		Text += FString::Printf(TEXT("\n%-22s %8s %10s %10s %10s %10s\n"), TEXT("tool (execute)"), TEXT("calls"), TEXT("p50"), TEXT("p99"), TEXT("max"), TEXT("total ms"));
+		for (const TSharedPtr<FJsonValue>& ToolValue : *Tools)
+		{
+			const TSharedPtr<FJsonObject>& Tool = ToolValue->AsObject();
+			Text += FormatRow(Tool->GetStringField(TEXT("name")), Tool->GetObjectField(TEXT("execute")));
+		}
+	}
+	
+	const TArray<TSharedPtr<FJsonValue>>* Methods = nullptr;
+	if (StatsJson->TryGetArrayField(TEXT("methods"), Methods) && Methods->Num() > 0)
+	{
+		Text += FString::Printf(TEXT("\n%-22s %8s %10s %10s %10s %10s\n"), TEXT("method"), TEXT("requests"), TEXT("p50"), TEXT("p99"), TEXT("max"), TEXT("total ms"));
+		for (const TSharedPtr<FJsonValue>& MethodValue : *Methods)
+		{
+			const TSharedPtr<FJsonObject>& Method = MethodValue->AsObject();
+			Text += FormatRow(Method->GetStringField(TEXT("method")), Method->GetObjectField(TEXT("latency")));
+		}
+	}
+	
+	return Text;
+}
+
+void SMCPTestWindow::OnServerNotification(const FString& NotificationJson)
+{
+	if (!IsInGameThread())
+	{
+		TWeakPtr<SMCPTestWindow> WeakWindow = SharedThis(this);
+		AsyncTask(ENamedThreads::GameThread, [WeakWindow, NotificationJson]()
+		{
+			if (TSharedPtr<SMCPTestWindow> Window = WeakWindow.Pin())
+			{
+				Window->OnServerNotification(NotificationJson);
+			}
+		});
+		return;
+	}
+	
+	AppendOutput(FString::Printf(TEXT("<< Notification:\n%s\n\n"), *NotificationJson));
+}
+
 void SMCPTestWindow::AppendOutput(const FString& Text)
 {
 	if (OutputTextBox.IsValid())
@@ -9,6 +9,7 @@
 class FMCPServer;
 class SMultiLineEditableTextBox;
 class SEditableTextBox;
+class STextBlock;
 
 /**
  * Simple test window for MCP server
@@ -30,6 +31,14 @@ private:
 	FReply OnClearClicked();
 	FReply OnInitializeClicked();
 	FReply OnListToolsClicked();
+	FReply OnResetStatsClicked();
+	
+	// Refresh the stats panel from FMCPServer::WriteStats (active timer)
+	EActiveTimerReturnType RefreshStats(double InCurrentTime, float InDeltaTime);
+	FString FormatStats() const;
+	
+	// Server notification sink (may be called off the game thread)
+	void OnServerNotification(const FString& NotificationJson);
 	
 	// Helper to append text to output
 	void AppendOutput(const FString& Text);
@@ -40,6 +49,7 @@ private:
 	// UI widgets
 	TSharedPtr<SEditableTextBox> InputTextBox;
 	TSharedPtr<SMultiLineEditableTextBox> OutputTextBox;
+	TSharedPtr<STextBlock> StatsTextBlock;
 	
 	// Message ID counter
 	int32 MessageIdCounter;
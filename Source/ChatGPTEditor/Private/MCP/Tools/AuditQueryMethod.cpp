@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AuditQueryMethod.h"
+#include "AuditLogQuery.h"
+#include "MCP/MCPServer.h"
+#include "MCP/MCPTypes.h"
+#include "MCP/MCPJsonWriter.h"
+
+namespace
+{
+	constexpr int32 MaxLimit = 1000;
+
+	bool ParseDateParam(const FJsonObject& Params, const TCHAR* Name, FDateTime& OutDate, FString& OutError)
+	{
+		FString Text;
+		if (!Params.TryGetStringField(Name, Text))
+			return true;
+
+		// Events are in the editor's local time, so a zoned date can't be compared with them
+		if (!FAuditQuery::ParseLocalDate(Text, OutDate))
+		{
+			OutError = FString::Printf(TEXT("'%s' must be a local ISO 8601 date without a zone, such as 2024-10-27T10:30:00"), Name);
+			return false;
+		}
+		return true;
+	}
+
+	bool ParseQueryParams(const TSharedPtr<FJsonObject>& Params, FAuditQuery& OutQuery, FString& OutError)
+	{
+		if (!Params.IsValid())
+			return true;
+
+		if (!ParseDateParam(*Params, TEXT("from"), OutQuery.From, OutError)
+			|| !ParseDateParam(*Params, TEXT("to"), OutQuery.To, OutError))
+		{
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Types = nullptr;
+		FString Type;
+		if (Params->TryGetArrayField(TEXT("types"), Types))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Types)
+			{
+				if (!Value.IsValid() || !Value->TryGetString(Type) || Type.IsEmpty())
+				{
+					OutError = TEXT("'types' must be an array of event type names");
+					return false;
+				}
+				OutQuery.Types.Add(FName(*Type));
+			}
+		}
+		else if (Params->TryGetStringField(TEXT("type"), Type) && !Type.IsEmpty())
+		{
+			OutQuery.Types.Add(FName(*Type));
+		}
+
+		Params->TryGetStringField(TEXT("actor"), OutQuery.Actor);
+		Params->TryGetStringField(TEXT("asset"), OutQuery.Asset);
+		Params->TryGetStringField(TEXT("tool"), OutQuery.Tool);
+		if (Params->TryGetStringField(TEXT("cursor"), OutQuery.Cursor) && !OutQuery.Cursor.IsEmpty()
+			&& !FAuditLogQueryEngine::Get().IsValidCursor(OutQuery.Cursor, OutError))
+		{
+			return false;
+		}
+
+		int32 Limit = 0;
+		if (Params->TryGetNumberField(TEXT("limit"), Limit))
+		{
+			OutQuery.MaxResults = FMath::Clamp(Limit, 1, MaxLimit);
+		}
+		return true;
+	}
+
+	void WriteEvent(FMCPJsonWriter& Writer, const FAuditEvent& Event)
+	{
+		// Local time without a zone, like the from and to params
+		Writer.WriteObjectStart();
+		Writer.WriteValue("time", Event.Timestamp.ToString(TEXT("%Y-%m-%dT%H:%M:%S.%s")));
+		Writer.WriteValue("source", LexToString(Event.Source));
+		Writer.WriteValue("type", Event.Type.ToString());
+
+		const FString* Message = nullptr;
+		Writer.WriteArrayStart("fields");
+		for (const FAuditField& Field : Event.Fields)
+		{
+			if (!Field.Key)
+			{
+				Message = Message ? Message : &Field.Value;
+				continue;
+			}
+			Writer.WriteObjectStart();
+			Writer.WriteValue("key", Field.Key);
+			Writer.WriteValue("value", Field.Value);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		if (Message)
+		{
+			Writer.WriteValue("message", *Message);
+		}
+		Writer.WriteObjectEnd();
+	}
+
+	bool HandleAuditQuery(const FMCPRequest& Request, FMCPJsonWriter& Writer)
+	{
+		FAuditQuery Query;
+		FString Error;
+		if (!ParseQueryParams(Request.Params, Query, Error))
+		{
+			Writer.WriteErrorResponse(Request.Id, MCPProtocol::InvalidParams, Error);
+			return false;
+		}
+
+		// Events are streamed into the response as the engine finds them
+		Writer.BeginResultResponse(Request.Id);
+		Writer.WriteObjectStart();
+		Writer.WriteArrayStart("events");
+		FAuditQueryStats Stats;
+		const FString NextCursor = FAuditLogQueryEngine::Get().Query(Query, [&Writer](const FAuditEvent& Event)
+		{
+			WriteEvent(Writer, Event);
+			return true;
+		}, &Stats);
+		Writer.WriteArrayEnd();
+
+		if (NextCursor.IsEmpty())
+		{
+			Writer.WriteIdentifier("nextCursor");
+			Writer.WriteNull();
+		}
+		else
+		{
+			Writer.WriteValue("nextCursor", NextCursor);
+		}
+
+		Writer.WriteObjectStart("stats");
+		Writer.WriteValue("segments", Stats.NumSegments);
+		Writer.WriteValue("segmentsSkipped", Stats.NumSegmentsSkipped);
+		Writer.WriteValue("eventsScanned", Stats.NumEventsScanned);
+		Writer.WriteValue("milliseconds", Stats.Seconds * 1000.0);
+		Writer.WriteObjectEnd();
+
+		Writer.WriteObjectEnd();
+		Writer.EndResponse();
+		return true;
+	}
+}
+
+namespace MCPTools
+{
+	void RegisterAuditQueryMethod(FMCPServer& Server)
+	{
+		// The engine takes its own lock, so queries can run off the game thread
+		Server.RegisterMethodHandler(MCPProtocol::Method_AuditQuery, FMCPMethodHandler::CreateStatic(&HandleAuditQuery), true);
+	}
+}
@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMCPServer;
+
+namespace MCPTools
+{
+	/**
+	 * Register audit/query, which searches the audit log through FAuditLogQueryEngine
+	 * Params (all optional): from and to (ISO 8601, local time), types (array) or type, actor, asset, tool,
+	 * limit (1-1000, default 100) and cursor. The result is {"events":[...],"nextCursor":...,"stats":{...}},
+	 * with nextCursor null once the search reached the end of the log.
+	 */
+	void RegisterAuditQueryMethod(FMCPServer& Server);
+}
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "EchoTool.h"
+#include "MCP/MCPJsonWriter.h"
+#include "Async/Async.h"
 
 FEchoTool::FEchoTool()
 	: FMCPToolBase(TEXT("echo"), TEXT("Echo back the input message"))
@@ -40,3 +42,34 @@ TSharedPtr<FJsonObject> FEchoTool::Execute(const TSharedPtr<FJsonObject>& Argume
 	FString Message = Arguments->GetStringField(TEXT("message"));
 	return CreateSuccessResponse(FString::Printf(TEXT("Echo: %s"), *Message));
 }
+
+TFuture<TSharedPtr<FJsonObject>> FEchoTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	// Read arguments here; the DOM is not shared with the worker
+	FString Message;
+	if (!Arguments.IsValid() || !Arguments->TryGetStringField(TEXT("message"), Message))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(TEXT("Missing required parameter: message"))).GetFuture();
+	}
+	
+	// Echo touches no editor state, so it completes on a worker thread
+	return Async(EAsyncExecution::TaskGraph, [Message = MoveTemp(Message), Context]() -> TSharedPtr<FJsonObject>
+	{
+		Context->ReportProgress(0.0, 1.0);
+		TSharedPtr<FJsonObject> Result = CreateSuccessResponse(FString::Printf(TEXT("Echo: %s"), *Message));
+		Context->ReportProgress(1.0, 1.0);
+		return Result;
+	});
+}
+
+void FEchoTool::ExecuteStreaming(const TSharedPtr<FJsonObject>& Arguments, FMCPJsonWriter& ResultWriter)
+{
+	FString Message;
+	if (!Arguments.IsValid() || !Arguments->TryGetStringField(TEXT("message"), Message))
+	{
+		WriteErrorResponse(ResultWriter, TEXT("Missing required parameter: message"));
+		return;
+	}
+	
+	WriteSuccessResponse(ResultWriter, FString::Printf(TEXT("Echo: %s"), *Message));
+}
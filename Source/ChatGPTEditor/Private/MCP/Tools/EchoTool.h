@@ -15,4 +15,9 @@ public:
 	
 	virtual TSharedPtr<FJsonObject> GetInputSchema() const override;
 	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override;
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override;
+	
+	virtual bool SupportsStreamingResult() const override { return true; }
+	virtual bool IsThreadSafe() const override { return true; }
+	virtual void ExecuteStreaming(const TSharedPtr<FJsonObject>& Arguments, FMCPJsonWriter& ResultWriter) override;
 };
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPBuiltInTools.h"
+#include "MCP/MCPServer.h"
+#include "EchoTool.h"
+#include "SpawnActorTool.h"
+#include "SpawnActorsTool.h"
+#include "QueryActorsTool.h"
+#include "SetPropertyTool.h"
+#include "AuditQueryMethod.h"
+
+namespace MCPTools
+{
+	void RegisterBuiltInTools(FMCPServer& Server)
+	{
+		Server.RegisterTool(MakeShared<FEchoTool>());
+		Server.RegisterTool(MakeShared<FSpawnActorTool>());
+		Server.RegisterTool(MakeShared<FSpawnActorsTool>());
+		Server.RegisterTool(MakeShared<FQueryActorsTool>());
+		Server.RegisterTool(MakeShared<FSetPropertyTool>());
+
+		RegisterAuditQueryMethod(Server);
+	}
+}
@@ -0,0 +1,13 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMCPServer;
+
+namespace MCPTools
+{
+	/** Register every tool and method that ships with the plugin; shared by the MCP test window and the headless commandlet */
+	void RegisterBuiltInTools(FMCPServer& Server);
+}
@@ -0,0 +1,308 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "QueryActorsTool.h"
+#include "SceneEditingManager.h"
+#include "SceneActorIndex.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Volume.h"
+#include "Async/Async.h"
+
+namespace
+{
+	TSharedPtr<FJsonObject> MakeVectorSchema(const FString& Description)
+	{
+		TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+		for (const TCHAR* Axis : { TEXT("x"), TEXT("y"), TEXT("z") })
+		{
+			TSharedPtr<FJsonObject> AxisProp = MakeShared<FJsonObject>();
+			AxisProp->SetStringField(TEXT("type"), TEXT("number"));
+			Properties->SetObjectField(Axis, AxisProp);
+		}
+
+		TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+		Schema->SetStringField(TEXT("type"), TEXT("object"));
+		Schema->SetStringField(TEXT("description"), Description);
+		Schema->SetObjectField(TEXT("properties"), Properties);
+		return Schema;
+	}
+
+	FVector GetVector(const FMCPToolArguments& Arguments, const FString& Path)
+	{
+		return FVector(
+			Arguments.GetNumber(*(Path + TEXT(".x"))),
+			Arguments.GetNumber(*(Path + TEXT(".y"))),
+			Arguments.GetNumber(*(Path + TEXT(".z"))));
+	}
+
+	TSharedPtr<FJsonObject> MakeVectorJson(const FVector& Vector)
+	{
+		TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("x"), Vector.X);
+		Object->SetNumberField(TEXT("y"), Vector.Y);
+		Object->SetNumberField(TEXT("z"), Vector.Z);
+		return Object;
+	}
+
+	AVolume* FindVolume(FSceneActorIndex& Index, const FString& Name)
+	{
+		TArray<AActor*> Candidates;
+		Index.FindByLabel(Name, Candidates);
+		for (AActor* Candidate : Candidates)
+		{
+			if (AVolume* Volume = Cast<AVolume>(Candidate))
+			{
+				return Volume;
+			}
+		}
+
+		// Fall back to the object name; there are few volumes in a level
+		Candidates.Reset();
+		Index.FindByClass(AVolume::StaticClass(), Candidates);
+		for (AActor* Candidate : Candidates)
+		{
+			if (Candidate->GetName().Equals(Name, ESearchCase::IgnoreCase))
+			{
+				return Cast<AVolume>(Candidate);
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+FQueryActorsTool::FQueryActorsTool()
+	: FMCPToolBase(TEXT("query_actors"), TEXT("Find actors inside a sphere, box or volume, optionally filtered by type, tag, label or folder"))
+{
+}
+
+TSharedPtr<FJsonObject> FQueryActorsTool::GetInputSchema() const
+{
+	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+
+	// sphere property
+	TSharedPtr<FJsonObject> SphereProperties = MakeShared<FJsonObject>();
+	SphereProperties->SetObjectField(TEXT("center"), MakeVectorSchema(TEXT("Sphere center")));
+	TSharedPtr<FJsonObject> RadiusProp = MakeShared<FJsonObject>();
+	RadiusProp->SetStringField(TEXT("type"), TEXT("number"));
+	RadiusProp->SetNumberField(TEXT("minimum"), 0);
+	SphereProperties->SetObjectField(TEXT("radius"), RadiusProp);
+
+	TSharedPtr<FJsonObject> SphereProp = MakeShared<FJsonObject>();
+	SphereProp->SetStringField(TEXT("type"), TEXT("object"));
+	SphereProp->SetStringField(TEXT("description"), TEXT("Select actors whose bounds intersect this sphere"));
+	SphereProp->SetObjectField(TEXT("properties"), SphereProperties);
+	TArray<TSharedPtr<FJsonValue>> SphereRequired;
+	SphereRequired.Add(MakeShared<FJsonValueString>(TEXT("center")));
+	SphereRequired.Add(MakeShared<FJsonValueString>(TEXT("radius")));
+	SphereProp->SetArrayField(TEXT("required"), SphereRequired);
+	Properties->SetObjectField(TEXT("sphere"), SphereProp);
+
+	// box property
+	TSharedPtr<FJsonObject> BoxProperties = MakeShared<FJsonObject>();
+	BoxProperties->SetObjectField(TEXT("min"), MakeVectorSchema(TEXT("Minimum corner")));
+	BoxProperties->SetObjectField(TEXT("max"), MakeVectorSchema(TEXT("Maximum corner")));
+
+	TSharedPtr<FJsonObject> BoxProp = MakeShared<FJsonObject>();
+	BoxProp->SetStringField(TEXT("type"), TEXT("object"));
+	BoxProp->SetStringField(TEXT("description"), TEXT("Select actors whose bounds intersect this axis-aligned box"));
+	BoxProp->SetObjectField(TEXT("properties"), BoxProperties);
+	TArray<TSharedPtr<FJsonValue>> BoxRequired;
+	BoxRequired.Add(MakeShared<FJsonValueString>(TEXT("min")));
+	BoxRequired.Add(MakeShared<FJsonValueString>(TEXT("max")));
+	BoxProp->SetArrayField(TEXT("required"), BoxRequired);
+	Properties->SetObjectField(TEXT("box"), BoxProp);
+
+	// volume property
+	TSharedPtr<FJsonObject> VolumeProp = MakeShared<FJsonObject>();
+	VolumeProp->SetStringField(TEXT("type"), TEXT("string"));
+	VolumeProp->SetStringField(TEXT("description"), TEXT("Label or name of a volume actor; selects actors located inside it"));
+	Properties->SetObjectField(TEXT("volume"), VolumeProp);
+
+	// pattern property
+	TSharedPtr<FJsonObject> PatternProp = MakeShared<FJsonObject>();
+	PatternProp->SetStringField(TEXT("type"), TEXT("string"));
+	PatternProp->SetStringField(TEXT("description"), TEXT("Optional filter: an actor type (lights, cameras, triggers, props, all) or tag:, label: or folder: followed by a name"));
+	Properties->SetObjectField(TEXT("pattern"), PatternProp);
+
+	// limit property
+	TSharedPtr<FJsonObject> LimitProp = MakeShared<FJsonObject>();
+	LimitProp->SetStringField(TEXT("type"), TEXT("integer"));
+	LimitProp->SetNumberField(TEXT("minimum"), 1);
+	LimitProp->SetNumberField(TEXT("maximum"), MaxResults);
+	LimitProp->SetNumberField(TEXT("default"), 1000);
+	LimitProp->SetStringField(TEXT("description"), TEXT("Maximum number of actors to return"));
+	Properties->SetObjectField(TEXT("limit"), LimitProp);
+
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetBoolField(TEXT("additionalProperties"), false);
+
+	return Schema;
+}
+
+bool FQueryActorsTool::ParseArguments(const FMCPToolArguments& Arguments, FQueryActorsRequest& OutRequest, FString& OutError) const
+{
+	// Types and ranges are enforced by the input schema; only the choice of region is checked here
+	const int32 NumShapes = (Arguments.IsSet(TEXT("sphere")) ? 1 : 0) + (Arguments.IsSet(TEXT("box")) ? 1 : 0) + (Arguments.IsSet(TEXT("volume")) ? 1 : 0);
+	if (NumShapes > 1)
+	{
+		OutError = TEXT("Give at most one of 'sphere', 'box' and 'volume'");
+		return false;
+	}
+
+	OutRequest.Pattern = Arguments.GetString(TEXT("pattern"));
+	OutRequest.Limit = Arguments.GetInteger(TEXT("limit"), 1000);
+
+	if (Arguments.IsSet(TEXT("sphere")))
+	{
+		OutRequest.Shape = EQueryShape::Sphere;
+		OutRequest.Center = GetVector(Arguments, TEXT("sphere.center"));
+		OutRequest.Radius = Arguments.GetNumber(TEXT("sphere.radius"));
+	}
+	else if (Arguments.IsSet(TEXT("box")))
+	{
+		OutRequest.Shape = EQueryShape::Box;
+		const FVector Min = GetVector(Arguments, TEXT("box.min"));
+		const FVector Max = GetVector(Arguments, TEXT("box.max"));
+		OutRequest.Box = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+	}
+	else if (Arguments.IsSet(TEXT("volume")))
+	{
+		OutRequest.Shape = EQueryShape::Volume;
+		OutRequest.VolumeName = Arguments.GetString(TEXT("volume"));
+	}
+	else if (OutRequest.Pattern.IsEmpty())
+	{
+		OutError = TEXT("Give a region ('sphere', 'box' or 'volume'), a 'pattern', or both");
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FQueryActorsTool::Execute(const TSharedPtr<FJsonObject>& Arguments)
+{
+	FMCPToolArguments ValidatedArguments;
+	FString Error;
+	if (!ValidateArguments(Arguments, ValidatedArguments, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return ExecuteValidated(Arguments, ValidatedArguments);
+}
+
+TSharedPtr<FJsonObject> FQueryActorsTool::ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments)
+{
+	FQueryActorsRequest Request;
+	FString Error;
+	if (!ParseArguments(ValidatedArguments, Request, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return RunQuery(Request);
+}
+
+TFuture<TSharedPtr<FJsonObject>> FQueryActorsTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	// Arguments are read on the calling thread; only plain values cross to the game thread
+	FMCPToolArguments LocalArguments;
+	FString Error;
+	if (!Context->GetArguments().IsValid() && !ValidateArguments(Arguments, LocalArguments, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	FQueryActorsRequest Request;
+	if (!ParseArguments(Context->GetArguments().IsValid() ? Context->GetArguments() : LocalArguments, Request, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	TSharedRef<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe>();
+	TFuture<TSharedPtr<FJsonObject>> Result = Promise->GetFuture();
+
+	AsyncTask(ENamedThreads::GameThread, [Request, Promise]()
+	{
+		Promise->SetValue(RunQuery(Request));
+	});
+
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FQueryActorsTool::RunQuery(const FQueryActorsRequest& Request)
+{
+	check(IsInGameThread());
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No active world found. Please open a level."));
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	FSceneActorIndex& Index = Manager.GetActorIndex(World);
+
+	TArray<AActor*> Actors;
+	switch (Request.Shape)
+	{
+		case EQueryShape::Sphere:
+			Index.FindInSphere(Request.Center, Request.Radius, Actors);
+			break;
+
+		case EQueryShape::Box:
+			Index.FindInBox(Request.Box, Actors);
+			break;
+
+		case EQueryShape::Volume:
+		{
+			AVolume* Volume = FindVolume(Index, Request.VolumeName);
+			if (!Volume)
+			{
+				return CreateErrorResponse(FString::Printf(TEXT("No volume named '%s'"), *Request.VolumeName));
+			}
+			Index.FindInVolume(Volume, Actors);
+			break;
+		}
+
+		default:
+			Actors = Manager.FindActorsByPattern(Request.Pattern, World);
+			break;
+	}
+
+	if (Request.Shape != EQueryShape::All && !Request.Pattern.IsEmpty())
+	{
+		Actors.RemoveAllSwap([&Manager, &Request](const AActor* Actor) { return !Manager.MatchesPattern(Actor, Request.Pattern); });
+	}
+
+	const double QueryMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	const int32 NumReturned = FMath::Min(Actors.Num(), Request.Limit);
+
+	TArray<TSharedPtr<FJsonValue>> ActorValues;
+	ActorValues.Reserve(NumReturned);
+	for (int32 ActorIndex = 0; ActorIndex < NumReturned; ++ActorIndex)
+	{
+		const AActor* Actor = Actors[ActorIndex];
+		TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+		ActorObject->SetStringField(TEXT("name"), Actor->GetName());
+		ActorObject->SetStringField(TEXT("label"), Actor->GetActorLabel());
+		ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		ActorObject->SetObjectField(TEXT("location"), MakeVectorJson(Actor->GetActorLocation()));
+		ActorValues.Add(MakeShared<FJsonValueObject>(ActorObject));
+	}
+
+	TSharedPtr<FJsonObject> Result = CreateSuccessResponse(FString::Printf(TEXT("Found %d actor(s) in %.2f ms%s"),
+		Actors.Num(), QueryMs, NumReturned < Actors.Num() ? *FString::Printf(TEXT(", returning the first %d"), NumReturned) : TEXT("")));
+	Result->SetNumberField(TEXT("count"), Actors.Num());
+	Result->SetBoolField(TEXT("truncated"), NumReturned < Actors.Num());
+	Result->SetNumberField(TEXT("queryMs"), QueryMs);
+	Result->SetArrayField(TEXT("actors"), ActorValues);
+
+	return Result;
+}
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MCP/MCPTool.h"
+
+/**
+ * Tool for finding actors by location
+ * Selects actors inside a sphere, a box or a volume, optionally filtered by a scene edit pattern
+ * ("lights", "props", "tag:Tree"). Queries go through the scene actor index, so they cost about
+ * as much as the number of actors in the region rather than the size of the level.
+ */
+class FQueryActorsTool : public FMCPToolBase
+{
+public:
+	FQueryActorsTool();
+
+	virtual TSharedPtr<FJsonObject> GetInputSchema() const override;
+	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override;
+	virtual TSharedPtr<FJsonObject> ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments) override;
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override;
+
+	/** Largest number of actors returned by one call */
+	static constexpr int32 MaxResults = 10000;
+
+private:
+	enum class EQueryShape : uint8
+	{
+		All,
+		Sphere,
+		Box,
+		Volume
+	};
+
+	/** Validated tool arguments, plain values only so they can cross to the game thread */
+	struct FQueryActorsRequest
+	{
+		EQueryShape Shape = EQueryShape::All;
+		FVector Center = FVector::ZeroVector;
+		double Radius = 0.0;
+		FBox Box = FBox(ForceInit);
+		FString VolumeName;
+		FString Pattern;
+		int32 Limit = 0;
+	};
+
+	bool ParseArguments(const FMCPToolArguments& Arguments, FQueryActorsRequest& OutRequest, FString& OutError) const;
+
+	/** Run the query; game thread only. Static, so the queued task never needs the tool */
+	static TSharedPtr<FJsonObject> RunQuery(const FQueryActorsRequest& Request);
+};
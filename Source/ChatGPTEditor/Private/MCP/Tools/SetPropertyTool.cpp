@@ -0,0 +1,200 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SetPropertyTool.h"
+#include "SceneEditingManager.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+
+FSetPropertyTool::FSetPropertyTool()
+	: FMCPToolBase(TEXT("set_property"), TEXT("Set a property, such as LightComponent.Intensity, on every actor matching a type, tag, label or folder"))
+{
+}
+
+TSharedPtr<FJsonObject> FSetPropertyTool::GetInputSchema() const
+{
+	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+
+	// pattern property
+	TSharedPtr<FJsonObject> PatternProp = MakeShared<FJsonObject>();
+	PatternProp->SetStringField(TEXT("type"), TEXT("string"));
+	PatternProp->SetStringField(TEXT("description"), TEXT("Actors to change: an actor type (lights, cameras, props, all) or tag:, label: or folder: followed by a name"));
+	Properties->SetObjectField(TEXT("pattern"), PatternProp);
+
+	// property property
+	TSharedPtr<FJsonObject> PropertyProp = MakeShared<FJsonObject>();
+	PropertyProp->SetStringField(TEXT("type"), TEXT("string"));
+	PropertyProp->SetNumberField(TEXT("minLength"), 1);
+	PropertyProp->SetStringField(TEXT("description"), TEXT("Property path from the actor, through components and structs (e.g. LightComponent.Intensity, LightComponent.LightColor.R, bHidden)"));
+	Properties->SetObjectField(TEXT("property"), PropertyProp);
+
+	// value property; any JSON type
+	TSharedPtr<FJsonObject> ValueProp = MakeShared<FJsonObject>();
+	ValueProp->SetStringField(TEXT("description"), TEXT("New value: a number, a boolean, or Unreal text format for structs and references (e.g. \"(R=255,G=0,B=0,A=255)\")"));
+	Properties->SetObjectField(TEXT("value"), ValueProp);
+
+	// dryRun property
+	TSharedPtr<FJsonObject> DryRunProp = MakeShared<FJsonObject>();
+	DryRunProp->SetStringField(TEXT("type"), TEXT("boolean"));
+	DryRunProp->SetBoolField(TEXT("default"), false);
+	DryRunProp->SetStringField(TEXT("description"), TEXT("Report what would change without changing anything"));
+	Properties->SetObjectField(TEXT("dryRun"), DryRunProp);
+
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetBoolField(TEXT("additionalProperties"), false);
+
+	// Required fields
+	TArray<TSharedPtr<FJsonValue>> Required;
+	Required.Add(MakeShared<FJsonValueString>(TEXT("pattern")));
+	Required.Add(MakeShared<FJsonValueString>(TEXT("property")));
+	Required.Add(MakeShared<FJsonValueString>(TEXT("value")));
+	Schema->SetArrayField(TEXT("required"), Required);
+
+	return Schema;
+}
+
+bool FSetPropertyTool::ParseArguments(const TSharedPtr<FJsonObject>& RawArguments, const FMCPToolArguments& Arguments, FSetPropertyRequest& OutRequest, FString& OutError) const
+{
+	// Presence and types are enforced by the input schema; the value may be any JSON type, so it comes from the raw arguments
+	OutRequest.Pattern = Arguments.GetString(TEXT("pattern"));
+	OutRequest.Property = Arguments.GetString(TEXT("property"));
+	OutRequest.bDryRun = Arguments.GetBool(TEXT("dryRun"));
+
+	const TSharedPtr<FJsonValue> Value = RawArguments.IsValid() ? RawArguments->TryGetField(TEXT("value")) : nullptr;
+	if (!Value.IsValid() || Value->Type == EJson::Object || Value->Type == EJson::Array || Value->Type == EJson::Null)
+	{
+		OutError = TEXT("'value' must be a number, a boolean or a string");
+		return false;
+	}
+	OutRequest.Value = ToPropertyText(Value);
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FSetPropertyTool::Execute(const TSharedPtr<FJsonObject>& Arguments)
+{
+	FMCPToolArguments ValidatedArguments;
+	FString Error;
+	if (!ValidateArguments(Arguments, ValidatedArguments, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return ExecuteValidated(Arguments, ValidatedArguments);
+}
+
+TSharedPtr<FJsonObject> FSetPropertyTool::ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments)
+{
+	FSetPropertyRequest Request;
+	FString Error;
+	if (!ParseArguments(Arguments, ValidatedArguments, Request, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return SetProperty(Request);
+}
+
+TFuture<TSharedPtr<FJsonObject>> FSetPropertyTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	// Arguments are read on the calling thread; only plain values cross to the game thread
+	FMCPToolArguments LocalArguments;
+	FString Error;
+	if (!Context->GetArguments().IsValid() && !ValidateArguments(Arguments, LocalArguments, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	FSetPropertyRequest Request;
+	if (!ParseArguments(Arguments, Context->GetArguments().IsValid() ? Context->GetArguments() : LocalArguments, Request, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	// The whole batch is one transaction, so it runs in a single game thread task
+	TSharedRef<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe>();
+	TFuture<TSharedPtr<FJsonObject>> Result = Promise->GetFuture();
+
+	AsyncTask(ENamedThreads::GameThread, [Request, Promise]()
+	{
+		Promise->SetValue(SetProperty(Request));
+	});
+
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FSetPropertyTool::SetProperty(const FSetPropertyRequest& Request)
+{
+	check(IsInGameThread());
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No active world found. Please open a level."));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FSceneEditAction Action;
+	Action.Operation = ESceneEditOperation::ModifyProperty;
+	Action.SearchPattern = Request.Pattern;
+	Action.PropertyName = Request.Property;
+	Action.PropertyValue = Request.Value;
+	Action.Description = FString::Printf(TEXT("MCP: set %s on %s to %s"), *Request.Property, *Request.Pattern, *Request.Value);
+
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	FSceneEditPlan Plan;
+	Plan.World = World;
+	Plan.Actions.Add(Manager.PlanAction(Action, World));
+	const FSceneEditActionPlan& ActionPlan = Plan.Actions[0];
+
+	if (ActionPlan.Changes.Num() == 0)
+	{
+		return ActionPlan.Warning.IsEmpty()
+			? CreateSuccessResponse(FString::Printf(TEXT("No actors matching '%s' needed a change"), *Request.Pattern))
+			: CreateErrorResponse(ActionPlan.Warning);
+	}
+
+	if (!Request.bDryRun)
+	{
+		Manager.ExecutePlan(Plan);
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	const int32 NumListed = FMath::Min(ActionPlan.Changes.Num(), MaxListedChanges);
+	TArray<TSharedPtr<FJsonValue>> ChangeValues;
+	ChangeValues.Reserve(NumListed);
+	for (int32 Index = 0; Index < NumListed; ++Index)
+	{
+		const FSceneEditActorChange& Change = ActionPlan.Changes[Index];
+		TSharedPtr<FJsonObject> ChangeObject = MakeShared<FJsonObject>();
+		ChangeObject->SetStringField(TEXT("actor"), Change.ActorName);
+		ChangeObject->SetStringField(TEXT("old"), Change.OldValue);
+		ChangeObject->SetStringField(TEXT("new"), Change.NewValue);
+		ChangeValues.Add(MakeShared<FJsonValueObject>(ChangeObject));
+	}
+
+	TSharedPtr<FJsonObject> Result = CreateSuccessResponse(FString::Printf(TEXT("%s %s on %d actor(s) in %.1f ms%s"),
+		Request.bDryRun ? TEXT("Would set") : TEXT("Set"), *Request.Property, ActionPlan.Changes.Num(), Seconds * 1000.0,
+		ActionPlan.Warning.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" (%s)"), *ActionPlan.Warning)));
+	Result->SetNumberField(TEXT("count"), ActionPlan.Changes.Num());
+	Result->SetBoolField(TEXT("dryRun"), Request.bDryRun);
+	Result->SetNumberField(TEXT("seconds"), Seconds);
+	Result->SetArrayField(TEXT("changes"), ChangeValues);
+	if (!ActionPlan.Warning.IsEmpty())
+	{
+		Result->SetStringField(TEXT("warning"), ActionPlan.Warning);
+	}
+
+	return Result;
+}
+
+TArray<FString> FSetPropertyTool::GetRequiredPermissions() const
+{
+	TArray<FString> Permissions;
+	Permissions.Add(TEXT("scene_editing"));
+	return Permissions;
+}
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MCP/MCPTool.h"
+
+/**
+ * Tool for setting one property on every actor matching a scene edit pattern
+ * The property is a dotted path ("LightComponent.Intensity") resolved once per actor class; the
+ * change runs as a scene edit plan, so it is audited and undoes as a single transaction.
+ */
+class FSetPropertyTool : public FMCPToolBase
+{
+public:
+	FSetPropertyTool();
+
+	virtual TSharedPtr<FJsonObject> GetInputSchema() const override;
+	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override;
+	virtual TSharedPtr<FJsonObject> ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments) override;
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override;
+
+	virtual bool RequiresConfirmation() const override { return true; }
+	virtual TArray<FString> GetRequiredPermissions() const override;
+
+	/** Changes listed in a response; the count covers all of them */
+	static constexpr int32 MaxListedChanges = 100;
+
+private:
+	/** Validated tool arguments, plain values only so they can cross to the game thread */
+	struct FSetPropertyRequest
+	{
+		FString Pattern;
+		FString Property;
+		FString Value;
+		bool bDryRun = false;
+	};
+
+	bool ParseArguments(const TSharedPtr<FJsonObject>& RawArguments, const FMCPToolArguments& Arguments, FSetPropertyRequest& OutRequest, FString& OutError) const;
+
+	/** Plan and, unless dry running, apply the change; game thread only. Static, so the queued task never needs the tool */
+	static TSharedPtr<FJsonObject> SetProperty(const FSetPropertyRequest& Request);
+};
@@ -1,12 +1,25 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SpawnActorTool.h"
+#include "ScenePlacement.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "Engine/PointLight.h"
 #include "Engine/SpotLight.h"
 #include "Engine/DirectionalLight.h"
 #include "Camera/CameraActor.h"
+#include "Async/Async.h"
+
+namespace
+{
+	TSharedPtr<FJsonObject> MakeValueSchema(const TCHAR* Type, const TCHAR* Description)
+	{
+		TSharedPtr<FJsonObject> Prop = MakeShared<FJsonObject>();
+		Prop->SetStringField(TEXT("type"), Type);
+		Prop->SetStringField(TEXT("description"), Description);
+		return Prop;
+	}
+}
 
 FSpawnActorTool::FSpawnActorTool()
 	: FMCPToolBase(TEXT("spawn_actor"), TEXT("Spawn one or more actors in the active Unreal Engine level"))
@@ -57,6 +70,58 @@ TSharedPtr<FJsonObject> FSpawnActorTool::GetInputSchema() const
 	LocationProp->SetObjectField(TEXT("properties"), LocationProperties);
 	Properties->SetObjectField(TEXT("location"), LocationProp);
 	
+	// placement property (optional); items start at location
+	TSharedPtr<FJsonObject> PlacementProp = MakeShared<FJsonObject>();
+	PlacementProp->SetStringField(TEXT("type"), TEXT("object"));
+	PlacementProp->SetStringField(TEXT("description"), TEXT("How multiple actors are laid out (optional, defaults to a row 100 units apart)"));
+	
+	TSharedPtr<FJsonObject> PlacementProperties = MakeShared<FJsonObject>();
+	
+	TSharedPtr<FJsonObject> PatternProp = MakeShared<FJsonObject>();
+	PatternProp->SetStringField(TEXT("type"), TEXT("string"));
+	PatternProp->SetStringField(TEXT("description"), TEXT("row, grid, ring, spline (through path), scatter (Poisson disk within radius) or surface (scatter aligned to the ground)"));
+	TArray<TSharedPtr<FJsonValue>> PatternNames;
+	for (const TCHAR* Name : { TEXT("row"), TEXT("grid"), TEXT("ring"), TEXT("spline"), TEXT("scatter"), TEXT("surface") })
+	{
+		PatternNames.Add(MakeShared<FJsonValueString>(Name));
+	}
+	PatternProp->SetArrayField(TEXT("enum"), PatternNames);
+	PatternProp->SetStringField(TEXT("default"), TEXT("row"));
+	PlacementProperties->SetObjectField(TEXT("pattern"), PatternProp);
+	
+	TSharedPtr<FJsonObject> SpacingProp = MakeValueSchema(TEXT("number"), TEXT("Units between items; the minimum distance for scatters"));
+	SpacingProp->SetNumberField(TEXT("minimum"), 1);
+	PlacementProperties->SetObjectField(TEXT("spacing"), SpacingProp);
+	
+	TSharedPtr<FJsonObject> RadiusProp = MakeValueSchema(TEXT("number"), TEXT("Radius of rings and scatters"));
+	RadiusProp->SetNumberField(TEXT("minimum"), 1);
+	PlacementProperties->SetObjectField(TEXT("radius"), RadiusProp);
+	
+	TSharedPtr<FJsonObject> ColumnsProp = MakeValueSchema(TEXT("integer"), TEXT("Grid columns (defaults to a square grid)"));
+	ColumnsProp->SetNumberField(TEXT("minimum"), 1);
+	PlacementProperties->SetObjectField(TEXT("columns"), ColumnsProp);
+	
+	PlacementProperties->SetObjectField(TEXT("seed"), MakeValueSchema(TEXT("integer"), TEXT("Random seed for scatters; the same seed gives the same layout")));
+	
+	TSharedPtr<FJsonObject> SnapProp = MakeShared<FJsonObject>();
+	SnapProp->SetStringField(TEXT("type"), TEXT("boolean"));
+	SnapProp->SetStringField(TEXT("description"), TEXT("Drop each item onto the first surface below it"));
+	PlacementProperties->SetObjectField(TEXT("snapToGround"), SnapProp);
+	
+	TSharedPtr<FJsonObject> PointSchema = MakeShared<FJsonObject>();
+	PointSchema->SetStringField(TEXT("type"), TEXT("object"));
+	PointSchema->SetObjectField(TEXT("properties"), LocationProperties);
+	
+	TSharedPtr<FJsonObject> PathProp = MakeShared<FJsonObject>();
+	PathProp->SetStringField(TEXT("type"), TEXT("array"));
+	PathProp->SetStringField(TEXT("description"), TEXT("Spline control points in world space"));
+	PathProp->SetNumberField(TEXT("maxItems"), MaxSplinePoints);
+	PathProp->SetObjectField(TEXT("items"), PointSchema);
+	PlacementProperties->SetObjectField(TEXT("path"), PathProp);
+	
+	PlacementProp->SetObjectField(TEXT("properties"), PlacementProperties);
+	Properties->SetObjectField(TEXT("placement"), PlacementProp);
+	
 	Schema->SetObjectField(TEXT("properties"), Properties);
 	
 	// Required fields
@@ -68,85 +133,218 @@ TSharedPtr<FJsonObject> FSpawnActorTool::GetInputSchema() const
 	return Schema;
 }
 
-TSharedPtr<FJsonObject> FSpawnActorTool::Execute(const TSharedPtr<FJsonObject>& Arguments)
+bool FSpawnActorTool::ParseArguments(const TSharedPtr<FJsonObject>& RawArguments, const FMCPToolArguments& Arguments, FSpawnActorRequest& OutRequest, FString& OutError) const
 {
-	// Extract parameters
-	if (!Arguments.IsValid() || !Arguments->HasField(TEXT("actorClass")) || !Arguments->HasField(TEXT("count")))
-	{
-		return CreateErrorResponse(TEXT("Missing required parameters: actorClass and count"));
-	}
+	// Presence, types and the 1-100 count range are enforced by the input schema
+	OutRequest.ActorClassName = Arguments.GetString(TEXT("actorClass"));
+	OutRequest.Count = Arguments.GetInteger(TEXT("count"), 1);
 	
-	FString ActorClass = Arguments->GetStringField(TEXT("actorClass"));
-	int32 Count = static_cast<int32>(Arguments->GetNumberField(TEXT("count")));
+	// Missing location components default to the origin
+	OutRequest.Location.X = Arguments.GetNumber(TEXT("location.x"));
+	OutRequest.Location.Y = Arguments.GetNumber(TEXT("location.y"));
+	OutRequest.Location.Z = Arguments.GetNumber(TEXT("location.z"));
 	
-	// Validate count
-	if (Count < 1 || Count > 100)
-	{
-		return CreateErrorResponse(TEXT("Count must be between 1 and 100"));
-	}
+	FScenePlacementSettings& Placement = OutRequest.Placement;
+	FScenePlacement::ParsePattern(Arguments.GetString(TEXT("placement.pattern"), TEXT("row")), Placement.Pattern);
+	Placement.Spacing = Arguments.GetNumber(TEXT("placement.spacing"), Placement.Spacing);
+	Placement.Radius = Arguments.GetNumber(TEXT("placement.radius"), Placement.Radius);
+	Placement.Columns = Arguments.GetInteger(TEXT("placement.columns"), 0);
+	Placement.Seed = Arguments.GetInteger(TEXT("placement.seed"), 0);
+	Placement.bSnapToGround = Arguments.GetBool(TEXT("placement.snapToGround"));
 	
-	// Get location if provided
-	FVector SpawnLocation = FVector::ZeroVector;
-	if (Arguments->HasField(TEXT("location")))
+	// Argument slots don't cover array items, so the path comes from the raw arguments
+	const TSharedPtr<FJsonObject>* PlacementObject = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+	if (RawArguments.IsValid() && RawArguments->TryGetObjectField(TEXT("placement"), PlacementObject)
+		&& (*PlacementObject)->TryGetArrayField(TEXT("path"), PathValues))
 	{
-		const TSharedPtr<FJsonObject>& LocObj = Arguments->GetObjectField(TEXT("location"));
-		SpawnLocation.X = LocObj->GetNumberField(TEXT("x"));
-		SpawnLocation.Y = LocObj->GetNumberField(TEXT("y"));
-		SpawnLocation.Z = LocObj->GetNumberField(TEXT("z"));
+		Placement.SplinePoints.Reserve(PathValues->Num());
+		for (const TSharedPtr<FJsonValue>& PointValue : *PathValues)
+		{
+			const TSharedPtr<FJsonObject> Point = PointValue->AsObject();
+			double X = 0.0;
+			double Y = 0.0;
+			double Z = 0.0;
+			Point->TryGetNumberField(TEXT("x"), X);
+			Point->TryGetNumberField(TEXT("y"), Y);
+			Point->TryGetNumberField(TEXT("z"), Z);
+			Placement.SplinePoints.Emplace(X, Y, Z);
+		}
 	}
 	
-	// Get world
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	if (!World)
+	if (Placement.Pattern == EScenePlacementPattern::Spline && Placement.SplinePoints.Num() < 2)
 	{
-		return CreateErrorResponse(TEXT("No active world found. Please open a level."));
+		OutError = TEXT("Spline placement needs a path of at least 2 points");
+		return false;
 	}
 	
 	// Determine actor class to spawn
-	UClass* ClassToSpawn = nullptr;
-	
+	const FString& ActorClass = OutRequest.ActorClassName;
 	if (ActorClass.Contains(TEXT("PointLight"), ESearchCase::IgnoreCase))
 	{
-		ClassToSpawn = APointLight::StaticClass();
+		OutRequest.ActorClass = APointLight::StaticClass();
 	}
 	else if (ActorClass.Contains(TEXT("SpotLight"), ESearchCase::IgnoreCase))
 	{
-		ClassToSpawn = ASpotLight::StaticClass();
+		OutRequest.ActorClass = ASpotLight::StaticClass();
 	}
 	else if (ActorClass.Contains(TEXT("DirectionalLight"), ESearchCase::IgnoreCase))
 	{
-		ClassToSpawn = ADirectionalLight::StaticClass();
+		OutRequest.ActorClass = ADirectionalLight::StaticClass();
 	}
 	else if (ActorClass.Contains(TEXT("Camera"), ESearchCase::IgnoreCase))
 	{
-		ClassToSpawn = ACameraActor::StaticClass();
+		OutRequest.ActorClass = ACameraActor::StaticClass();
 	}
 	else
 	{
-		return CreateErrorResponse(FString::Printf(TEXT("Unsupported actor class: %s"), *ActorClass));
+		OutError = FString::Printf(TEXT("Unsupported actor class: %s"), *ActorClass);
+		return false;
+	}
+	
+	return true;
+}
+
+UWorld* FSpawnActorTool::GetEditorWorld()
+{
+	return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
+
+AActor* FSpawnActorTool::SpawnActorAt(UWorld* World, const FSpawnActorRequest& Request, const FTransform& Transform)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = MakeUniqueObjectName(World, Request.ActorClass);
+	
+	return World->SpawnActor<AActor>(Request.ActorClass, &Transform, SpawnParams);
+}
+
+FString FSpawnActorTool::FormatResult(const FSpawnActorRequest& Request, const TArray<FString>& SpawnedActorNames)
+{
+	return FString::Printf(TEXT("Successfully spawned %d %s actor(s): %s"),
+		SpawnedActorNames.Num(), *Request.ActorClassName, *FString::Join(SpawnedActorNames, TEXT(", ")));
+}
+
+TSharedPtr<FJsonObject> FSpawnActorTool::Execute(const TSharedPtr<FJsonObject>& Arguments)
+{
+	FMCPToolArguments ValidatedArguments;
+	FString Error;
+	if (!ValidateArguments(Arguments, ValidatedArguments, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+	
+	return ExecuteValidated(Arguments, ValidatedArguments);
+}
+
+TSharedPtr<FJsonObject> FSpawnActorTool::ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments)
+{
+	FSpawnActorRequest Request;
+	FString Error;
+	if (!ParseArguments(Arguments, ValidatedArguments, Request, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+	
+	// Get world
+	UWorld* World = GetEditorWorld();
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No active world found. Please open a level."));
 	}
 	
 	// Spawn actors
+	TArray<FTransform> Transforms;
+	FScenePlacement::MakeTransforms(World, Request.Placement, Request.Location, FRotator::ZeroRotator, Request.Count, Transforms);
+	
 	TArray<FString> SpawnedActorNames;
-	for (int32 i = 0; i < Count; ++i)
-	{
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Name = MakeUniqueObjectName(World, ClassToSpawn);
-		
-		FVector ActualLocation = SpawnLocation + FVector(i * 100.0f, 0, 0);
-		AActor* NewActor = World->SpawnActor<AActor>(ClassToSpawn, ActualLocation, FRotator::ZeroRotator, SpawnParams);
-		
-		if (NewActor)
+	for (const FTransform& Transform : Transforms)
+	{
+		if (AActor* NewActor = SpawnActorAt(World, Request, Transform))
 		{
 			SpawnedActorNames.Add(NewActor->GetName());
 		}
 	}
 	
-	// Create response
-	FString ResponseMessage = FString::Printf(TEXT("Successfully spawned %d %s actor(s): %s"),
-		SpawnedActorNames.Num(), *ActorClass, *FString::Join(SpawnedActorNames, TEXT(", ")));
+	return CreateSuccessResponse(FormatResult(Request, SpawnedActorNames));
+}
+
+TFuture<TSharedPtr<FJsonObject>> FSpawnActorTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	// Arguments are read on the calling thread; only plain values cross to the game thread
+	FMCPToolArguments LocalArguments;
+	FString Error;
+	if (!Context->GetArguments().IsValid() && !ValidateArguments(Arguments, LocalArguments, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+	
+	FSpawnActorRequest Request;
+	if (!ParseArguments(Arguments, Context->GetArguments().IsValid() ? Context->GetArguments() : LocalArguments, Request, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+	
+	TSharedRef<FSpawnActorJob, ESPMode::ThreadSafe> Job = MakeShared<FSpawnActorJob, ESPMode::ThreadSafe>(Request, Context);
+	TFuture<TSharedPtr<FJsonObject>> Result = Job->Promise.GetFuture();
+	
+	AsyncTask(ENamedThreads::GameThread, [Job]()
+	{
+		SpawnNextChunk(Job);
+	});
+	
+	return Result;
+}
+
+void FSpawnActorTool::SpawnNextChunk(const TSharedRef<FSpawnActorJob, ESPMode::ThreadSafe>& Job)
+{
+	check(IsInGameThread());
+	
+	const FSpawnActorRequest& Request = Job->Request;
+	
+	// Actors spawned before the cancel stay in the level
+	if (Job->Context->IsCancelled())
+	{
+		Job->Promise.SetValue(CreateErrorResponse(FString::Printf(TEXT("Cancelled after spawning %d of %d actor(s)"),
+			Job->SpawnedActorNames.Num(), Request.Count)));
+		return;
+	}
+	
+	UWorld* World = GetEditorWorld();
+	if (!World)
+	{
+		Job->Promise.SetValue(CreateErrorResponse(TEXT("No active world found. Please open a level.")));
+		return;
+	}
+	
+	if (Job->NextIndex == 0)
+	{
+		FScenePlacement::MakeTransforms(World, Request.Placement, Request.Location, FRotator::ZeroRotator, Request.Count, Job->Transforms);
+	}
+	
+	// Scatters may fit fewer items than asked for
+	const int32 Total = Job->Transforms.Num();
+	const int32 ChunkEnd = FMath::Min(Job->NextIndex + SpawnChunkSize, Total);
+	for (; Job->NextIndex < ChunkEnd; ++Job->NextIndex)
+	{
+		if (AActor* NewActor = SpawnActorAt(World, Request, Job->Transforms[Job->NextIndex]))
+		{
+			Job->SpawnedActorNames.Add(NewActor->GetName());
+		}
+	}
+	
+	Job->Context->ReportProgress(Job->NextIndex, Total);
+	
+	if (Job->NextIndex < Total)
+	{
+		// Yield the game thread between chunks so the editor stays responsive
+		AsyncTask(ENamedThreads::GameThread, [Job]()
+		{
+			SpawnNextChunk(Job);
+		});
+		return;
+	}
 	
-	return CreateSuccessResponse(ResponseMessage);
+	Job->Promise.SetValue(CreateSuccessResponse(FormatResult(Request, Job->SpawnedActorNames)));
 }
 
 TArray<FString> FSpawnActorTool::GetRequiredPermissions() const
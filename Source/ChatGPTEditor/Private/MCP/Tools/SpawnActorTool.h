@@ -3,9 +3,11 @@
 #pragma once
 
 #include "MCP/MCPTool.h"
+#include "SceneEditingTypes.h"
 
 /**
  * Tool for spawning actors in the Unreal Engine level
+ * ExecuteAsync spawns in chunks on the game thread, reporting progress and honouring cancellation between chunks.
  */
 class FSpawnActorTool : public FMCPToolBase
 {
@@ -14,7 +16,55 @@ public:
 	
 	virtual TSharedPtr<FJsonObject> GetInputSchema() const override;
 	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override;
+	virtual TSharedPtr<FJsonObject> ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments) override;
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override;
 	
 	virtual bool RequiresConfirmation() const override { return true; }
 	virtual TArray<FString> GetRequiredPermissions() const override;
+	
+private:
+	/** Validated tool arguments */
+	struct FSpawnActorRequest
+	{
+		UClass* ActorClass = nullptr;
+		FString ActorClassName;
+		int32 Count = 0;
+		FVector Location = FVector::ZeroVector;
+		FScenePlacementSettings Placement;
+	};
+	
+	/** State of an ExecuteAsync call, carried from chunk to chunk */
+	struct FSpawnActorJob
+	{
+		FSpawnActorJob(const FSpawnActorRequest& InRequest, const FMCPToolExecutionContextRef& InContext)
+			: Request(InRequest)
+			, Context(InContext)
+		{
+		}
+		
+		FSpawnActorRequest Request;
+		FMCPToolExecutionContextRef Context;
+		TPromise<TSharedPtr<FJsonObject>> Promise;
+		TArray<FString> SpawnedActorNames;
+		
+		/** Generated by the first chunk, since ground snapping traces against the world */
+		TArray<FTransform> Transforms;
+		int32 NextIndex = 0;
+	};
+	
+	/** Actors spawned per game thread task in ExecuteAsync */
+	static constexpr int32 SpawnChunkSize = 10;
+	
+	/** Most control points a spline placement path may have */
+	static constexpr int32 MaxSplinePoints = 256;
+	
+	/** Arguments have already passed the input schema; only the actor class and the raw placement path need resolving */
+	bool ParseArguments(const TSharedPtr<FJsonObject>& RawArguments, const FMCPToolArguments& Arguments, FSpawnActorRequest& OutRequest, FString& OutError) const;
+	
+	/** Static, so a queued chunk needs only its job and never the tool, which may be unregistered meanwhile */
+	static void SpawnNextChunk(const TSharedRef<FSpawnActorJob, ESPMode::ThreadSafe>& Job);
+	
+	static UWorld* GetEditorWorld();
+	static AActor* SpawnActorAt(UWorld* World, const FSpawnActorRequest& Request, const FTransform& Transform);
+	static FString FormatResult(const FSpawnActorRequest& Request, const TArray<FString>& SpawnedActorNames);
 };
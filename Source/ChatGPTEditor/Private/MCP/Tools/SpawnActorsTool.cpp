@@ -0,0 +1,453 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpawnActorsTool.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "ScopedTransaction.h"
+#include "UObject/UObjectGlobals.h"
+#include "Async/Async.h"
+
+#define LOCTEXT_NAMESPACE "MCPSpawnActorsTool"
+
+namespace
+{
+	/** Progress notifications are sent every this many actors */
+	constexpr int32 ProgressInterval = 250;
+
+	TSharedPtr<FJsonObject> MakeNumberSchema(const FString& Description)
+	{
+		TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+		Schema->SetStringField(TEXT("type"), TEXT("number"));
+		if (!Description.IsEmpty())
+		{
+			Schema->SetStringField(TEXT("description"), Description);
+		}
+		return Schema;
+	}
+
+	/** {"type":"object","properties":{A,B,C: number}} */
+	TSharedPtr<FJsonObject> MakeTripleSchema(const TCHAR* A, const TCHAR* B, const TCHAR* C, const FString& Description)
+	{
+		TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+		Properties->SetObjectField(A, MakeNumberSchema(FString()));
+		Properties->SetObjectField(B, MakeNumberSchema(FString()));
+		Properties->SetObjectField(C, MakeNumberSchema(FString()));
+
+		TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+		Schema->SetStringField(TEXT("type"), TEXT("object"));
+		Schema->SetStringField(TEXT("description"), Description);
+		Schema->SetObjectField(TEXT("properties"), Properties);
+		return Schema;
+	}
+
+	double GetNumberOr(const FJsonObject& Object, const TCHAR* Field, double Default)
+	{
+		double Value = Default;
+		Object.TryGetNumberField(Field, Value);
+		return Value;
+	}
+
+	UWorld* GetEditorWorld()
+	{
+		return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	}
+}
+
+FSpawnActorsTool::FSpawnActorsTool()
+	: FMCPToolBase(TEXT("spawn_actors"), TEXT("Spawn many actors in one undoable step. Each entry sets the class, transform, label and property values of one actor"))
+{
+}
+
+TSharedPtr<FJsonObject> FSpawnActorsTool::GetInputSchema() const
+{
+	// One actor
+	TSharedPtr<FJsonObject> ActorProperties = MakeShared<FJsonObject>();
+
+	TSharedPtr<FJsonObject> ClassProp = MakeShared<FJsonObject>();
+	ClassProp->SetStringField(TEXT("type"), TEXT("string"));
+	ClassProp->SetStringField(TEXT("description"), TEXT("Actor class: a native class name (PointLight, StaticMeshActor) or a class path (/Game/BP_Tree.BP_Tree_C)"));
+	ActorProperties->SetObjectField(TEXT("class"), ClassProp);
+
+	ActorProperties->SetObjectField(TEXT("location"), MakeTripleSchema(TEXT("x"), TEXT("y"), TEXT("z"), TEXT("World location (defaults to origin)")));
+	ActorProperties->SetObjectField(TEXT("rotation"), MakeTripleSchema(TEXT("pitch"), TEXT("yaw"), TEXT("roll"), TEXT("Rotation in degrees")));
+	ActorProperties->SetObjectField(TEXT("scale"), MakeTripleSchema(TEXT("x"), TEXT("y"), TEXT("z"), TEXT("Scale (defaults to 1)")));
+
+	TSharedPtr<FJsonObject> LabelProp = MakeShared<FJsonObject>();
+	LabelProp->SetStringField(TEXT("type"), TEXT("string"));
+	LabelProp->SetStringField(TEXT("description"), TEXT("Label shown in the World Outliner"));
+	ActorProperties->SetObjectField(TEXT("label"), LabelProp);
+
+	TSharedPtr<FJsonObject> PropertiesProp = MakeShared<FJsonObject>();
+	PropertiesProp->SetStringField(TEXT("type"), TEXT("object"));
+	PropertiesProp->SetStringField(TEXT("description"), TEXT("Editable actor properties by name, in Unreal text format (e.g. {\"bHidden\": true, \"Tags\": \"(\\\"Tree\\\")\"})"));
+	ActorProperties->SetObjectField(TEXT("properties"), PropertiesProp);
+
+	TSharedPtr<FJsonObject> ActorSchema = MakeShared<FJsonObject>();
+	ActorSchema->SetStringField(TEXT("type"), TEXT("object"));
+	ActorSchema->SetObjectField(TEXT("properties"), ActorProperties);
+	TArray<TSharedPtr<FJsonValue>> ActorRequired;
+	ActorRequired.Add(MakeShared<FJsonValueString>(TEXT("class")));
+	ActorSchema->SetArrayField(TEXT("required"), ActorRequired);
+
+	// actors property
+	TSharedPtr<FJsonObject> ActorsProp = MakeShared<FJsonObject>();
+	ActorsProp->SetStringField(TEXT("type"), TEXT("array"));
+	ActorsProp->SetStringField(TEXT("description"), TEXT("Actors to spawn"));
+	ActorsProp->SetNumberField(TEXT("minItems"), 1);
+	ActorsProp->SetNumberField(TEXT("maxItems"), MaxActorsPerCall);
+	ActorsProp->SetObjectField(TEXT("items"), ActorSchema);
+
+	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+	Properties->SetObjectField(TEXT("actors"), ActorsProp);
+
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+	Schema->SetObjectField(TEXT("properties"), Properties);
+
+	// Required fields
+	TArray<TSharedPtr<FJsonValue>> Required;
+	Required.Add(MakeShared<FJsonValueString>(TEXT("actors")));
+	Schema->SetArrayField(TEXT("required"), Required);
+
+	return Schema;
+}
+
+bool FSpawnActorsTool::ParseActorSpecs(const TSharedPtr<FJsonObject>& Arguments, TArray<FActorSpec>& OutSpecs, FString& OutError) const
+{
+	// Shape and types are guaranteed by the input schema; this only converts to plain values
+	const TArray<TSharedPtr<FJsonValue>>* ActorValues = nullptr;
+	if (!Arguments.IsValid() || !Arguments->TryGetArrayField(TEXT("actors"), ActorValues))
+	{
+		OutError = TEXT("Missing required parameter: actors");
+		return false;
+	}
+
+	OutSpecs.Reset(ActorValues->Num());
+	for (const TSharedPtr<FJsonValue>& ActorValue : *ActorValues)
+	{
+		const FJsonObject& ActorObject = *ActorValue->AsObject();
+		FActorSpec& Spec = OutSpecs.AddDefaulted_GetRef();
+
+		Spec.ClassName = ActorObject.GetStringField(TEXT("class"));
+		ActorObject.TryGetStringField(TEXT("label"), Spec.Label);
+
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		FVector Scale = FVector::OneVector;
+
+		const TSharedPtr<FJsonObject>* Vector = nullptr;
+		if (ActorObject.TryGetObjectField(TEXT("location"), Vector))
+		{
+			Location = FVector(GetNumberOr(**Vector, TEXT("x"), 0.0), GetNumberOr(**Vector, TEXT("y"), 0.0), GetNumberOr(**Vector, TEXT("z"), 0.0));
+		}
+		if (ActorObject.TryGetObjectField(TEXT("rotation"), Vector))
+		{
+			Rotation = FRotator(GetNumberOr(**Vector, TEXT("pitch"), 0.0), GetNumberOr(**Vector, TEXT("yaw"), 0.0), GetNumberOr(**Vector, TEXT("roll"), 0.0));
+		}
+		if (ActorObject.TryGetObjectField(TEXT("scale"), Vector))
+		{
+			Scale = FVector(GetNumberOr(**Vector, TEXT("x"), 1.0), GetNumberOr(**Vector, TEXT("y"), 1.0), GetNumberOr(**Vector, TEXT("z"), 1.0));
+		}
+		Spec.Transform = FTransform(Rotation, Location, Scale);
+
+		const TSharedPtr<FJsonObject>* PropertyValues = nullptr;
+		if (ActorObject.TryGetObjectField(TEXT("properties"), PropertyValues))
+		{
+			Spec.Properties.Reserve((*PropertyValues)->Values.Num());
+			for (const auto& PropertyPair : (*PropertyValues)->Values)
+			{
+				Spec.Properties.Emplace(PropertyPair.Key, ToPropertyText(PropertyPair.Value));
+			}
+		}
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FSpawnActorsTool::Execute(const TSharedPtr<FJsonObject>& Arguments)
+{
+	FMCPToolArguments ValidatedArguments;
+	FString Error;
+	if (!ValidateArguments(Arguments, ValidatedArguments, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return ExecuteValidated(Arguments, ValidatedArguments);
+}
+
+TSharedPtr<FJsonObject> FSpawnActorsTool::ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments)
+{
+	TArray<FActorSpec> Specs;
+	FString Error;
+	if (!ParseActorSpecs(Arguments, Specs, Error))
+	{
+		return CreateErrorResponse(Error);
+	}
+
+	return SpawnBatch(Specs, nullptr);
+}
+
+TFuture<TSharedPtr<FJsonObject>> FSpawnActorsTool::ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context)
+{
+	// Arguments are read on the calling thread; only plain values cross to the game thread
+	FString Error;
+	FMCPToolArguments LocalArguments;
+	if (!Context->GetArguments().IsValid() && !ValidateArguments(Arguments, LocalArguments, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	TArray<FActorSpec> Specs;
+	if (!ParseActorSpecs(Arguments, Specs, Error))
+	{
+		return MakeFulfilledPromise<TSharedPtr<FJsonObject>>(CreateErrorResponse(Error)).GetFuture();
+	}
+
+	// The whole batch is one transaction, so it runs in a single game thread task
+	TSharedRef<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe>();
+	TFuture<TSharedPtr<FJsonObject>> Result = Promise->GetFuture();
+
+	AsyncTask(ENamedThreads::GameThread, [Specs = MoveTemp(Specs), Context, Promise]()
+	{
+		Promise->SetValue(SpawnBatch(Specs, &Context.Get()));
+	});
+
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FSpawnActorsTool::SpawnBatch(const TArray<FActorSpec>& Specs, const FMCPToolExecutionContext* Context)
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Resolve every class and property first, so a bad entry fails the call before anything is spawned
+	struct FPropertyAssignment
+	{
+		FProperty* Property;
+		const FString* Value;
+		const FString* Name;
+	};
+
+	TArray<UClass*> Classes;
+	TArray<FPropertyAssignment> Assignments;
+	TArray<int32> FirstAssignment;
+	Classes.Reserve(Specs.Num());
+	FirstAssignment.Reserve(Specs.Num() + 1);
+
+	TMap<FString, UClass*> ClassCache;
+	TMap<TPair<UClass*, FString>, FProperty*> PropertyCache;
+
+	for (int32 Index = 0; Index < Specs.Num(); ++Index)
+	{
+		const FActorSpec& Spec = Specs[Index];
+
+		UClass* Class = nullptr;
+		if (UClass** CachedClass = ClassCache.Find(Spec.ClassName))
+		{
+			Class = *CachedClass;
+		}
+		else
+		{
+			FString ClassError;
+			Class = ResolveActorClass(Spec.ClassName, ClassError);
+			if (!Class)
+			{
+				return CreateErrorResponse(FString::Printf(TEXT("actors[%d].class: %s"), Index, *ClassError));
+			}
+			ClassCache.Add(Spec.ClassName, Class);
+		}
+		Classes.Add(Class);
+
+		FirstAssignment.Add(Assignments.Num());
+		for (const TPair<FString, FString>& PropertyValue : Spec.Properties)
+		{
+			const TPair<UClass*, FString> Key(Class, PropertyValue.Key);
+			FProperty* Property = nullptr;
+			if (FProperty** CachedProperty = PropertyCache.Find(Key))
+			{
+				Property = *CachedProperty;
+			}
+			else
+			{
+				Property = FindFProperty<FProperty>(Class, FName(*PropertyValue.Key));
+				PropertyCache.Add(Key, Property);
+			}
+
+			// Only what the Details panel could change
+			if (!Property || !Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_EditConst))
+			{
+				return CreateErrorResponse(FString::Printf(TEXT("actors[%d].properties.%s: no editable property with that name on %s"),
+					Index, *PropertyValue.Key, *Class->GetName()));
+			}
+
+			Assignments.Add({ Property, &PropertyValue.Value, &PropertyValue.Key });
+		}
+	}
+	FirstAssignment.Add(Assignments.Num());
+
+	UWorld* World = GetEditorWorld();
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No active world found. Please open a level."));
+	}
+
+	ULevel* Level = World->GetCurrentLevel();
+
+	FScopedTransaction Transaction(FText::Format(LOCTEXT("SpawnActorsTransaction", "MCP: Spawn {0} Actor(s)"), FText::AsNumber(Specs.Num())));
+	Level->Modify();
+
+	const int32 TotalSteps = Specs.Num() * 2;
+	TArray<TPair<AActor*, int32>> SpawnedActors;
+	SpawnedActors.Reserve(Specs.Num());
+	TArray<FString> Warnings;
+	bool bCancelled = false;
+
+	// Pass 1: spawn without running construction, then apply properties
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.bDeferConstruction = true;
+	SpawnParams.OverrideLevel = Level;
+	SpawnParams.ObjectFlags |= RF_Transactional;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < Specs.Num(); ++Index)
+	{
+		if (Context && Context->IsCancelled())
+		{
+			bCancelled = true;
+			break;
+		}
+
+		AActor* Actor = World->SpawnActor(Classes[Index], &Specs[Index].Transform, SpawnParams);
+		if (!Actor)
+		{
+			Warnings.Add(FString::Printf(TEXT("actors[%d]: %s could not be spawned"), Index, *Classes[Index]->GetName()));
+			continue;
+		}
+
+		for (int32 AssignmentIndex = FirstAssignment[Index]; AssignmentIndex < FirstAssignment[Index + 1]; ++AssignmentIndex)
+		{
+			const FPropertyAssignment& Assignment = Assignments[AssignmentIndex];
+			void* ValuePtr = Assignment.Property->ContainerPtrToValuePtr<void>(Actor);
+			if (!Assignment.Property->ImportText_Direct(**Assignment.Value, ValuePtr, Actor, PPF_None))
+			{
+				Warnings.Add(FString::Printf(TEXT("actors[%d].properties.%s: could not import '%s'"), Index, **Assignment.Name, **Assignment.Value));
+			}
+		}
+
+		SpawnedActors.Emplace(Actor, Index);
+
+		if (Context && (Index + 1) % ProgressInterval == 0)
+		{
+			Context->ReportProgress(Index + 1, TotalSteps, TEXT("Spawning"));
+		}
+	}
+
+	// Pass 2: run construction scripts and register components for the whole batch
+	TArray<TSharedPtr<FJsonValue>> ActorNames;
+	ActorNames.Reserve(SpawnedActors.Num());
+	for (int32 Finished = 0; Finished < SpawnedActors.Num(); ++Finished)
+	{
+		AActor* Actor = SpawnedActors[Finished].Key;
+		const FActorSpec& Spec = Specs[SpawnedActors[Finished].Value];
+
+		Actor->FinishSpawning(Spec.Transform);
+		if (!Spec.Label.IsEmpty())
+		{
+			Actor->SetActorLabel(Spec.Label);
+		}
+		ActorNames.Add(MakeShared<FJsonValueString>(Actor->GetName()));
+
+		if (Context && (Finished + 1) % ProgressInterval == 0)
+		{
+			Context->ReportProgress(Specs.Num() + Finished + 1, TotalSteps, TEXT("Finishing construction"));
+		}
+	}
+
+	// Nothing to undo
+	if (SpawnedActors.Num() == 0)
+	{
+		Transaction.Cancel();
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const double ActorsPerSecond = Seconds > 0.0 ? SpawnedActors.Num() / Seconds : 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("spawn_actors: %d of %d actor(s) in %.1f ms (%.0f actors/sec)"),
+		SpawnedActors.Num(), Specs.Num(), Seconds * 1000.0, ActorsPerSecond);
+
+	if (bCancelled)
+	{
+		return CreateErrorResponse(FString::Printf(TEXT("Cancelled after spawning %d of %d actor(s)"), SpawnedActors.Num(), Specs.Num()));
+	}
+
+	TSharedPtr<FJsonObject> Result = CreateSuccessResponse(FString::Printf(TEXT("Spawned %d of %d actor(s) in %.1f ms (%.0f actors/sec)%s"),
+		SpawnedActors.Num(), Specs.Num(), Seconds * 1000.0, ActorsPerSecond,
+		Warnings.Num() > 0 ? *FString::Printf(TEXT(", %d warning(s)"), Warnings.Num()) : TEXT("")));
+	Result->SetNumberField(TEXT("spawned"), SpawnedActors.Num());
+	Result->SetNumberField(TEXT("requested"), Specs.Num());
+	Result->SetNumberField(TEXT("seconds"), Seconds);
+	Result->SetNumberField(TEXT("actorsPerSecond"), ActorsPerSecond);
+	Result->SetArrayField(TEXT("actors"), ActorNames);
+
+	if (Warnings.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> WarningValues;
+		for (const FString& Warning : Warnings)
+		{
+			WarningValues.Add(MakeShared<FJsonValueString>(Warning));
+		}
+		Result->SetArrayField(TEXT("warnings"), WarningValues);
+	}
+
+	return Result;
+}
+
+UClass* FSpawnActorsTool::ResolveActorClass(const FString& ClassName, FString& OutError)
+{
+	UClass* Class = nullptr;
+	if (ClassName.StartsWith(TEXT("/")))
+	{
+		// Full path; loads Blueprint classes on demand
+		Class = LoadObject<UClass>(nullptr, *ClassName);
+	}
+	else
+	{
+		// Native classes by the name the editor shows, with or without the A prefix
+		Class = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+		if (!Class && ClassName.Len() > 1 && ClassName[0] == TEXT('A'))
+		{
+			Class = FindFirstObject<UClass>(*ClassName.Mid(1), EFindFirstObjectOptions::NativeFirst);
+		}
+	}
+
+	if (!Class)
+	{
+		OutError = FString::Printf(TEXT("Unknown actor class '%s'"), *ClassName);
+		return nullptr;
+	}
+	if (!Class->IsChildOf(AActor::StaticClass()))
+	{
+		OutError = FString::Printf(TEXT("'%s' is not an actor class"), *ClassName);
+		return nullptr;
+	}
+	if (Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists | CLASS_NotPlaceable))
+	{
+		OutError = FString::Printf(TEXT("'%s' cannot be placed in a level"), *ClassName);
+		return nullptr;
+	}
+
+	return Class;
+}
+
+TArray<FString> FSpawnActorsTool::GetRequiredPermissions() const
+{
+	TArray<FString> Permissions;
+	Permissions.Add(TEXT("scene_editing"));
+	return Permissions;
+}
+
+#undef LOCTEXT_NAMESPACE
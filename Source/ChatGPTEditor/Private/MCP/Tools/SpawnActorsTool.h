@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MCP/MCPTool.h"
+
+/**
+ * Tool for spawning many actors in one call
+ * Each entry names a class, a transform, an optional label and property values. Classes and
+ * properties are resolved before anything is spawned; actors are then spawned deferred, have their
+ * properties applied and finish construction together inside one transaction (a single undo step).
+ */
+class FSpawnActorsTool : public FMCPToolBase
+{
+public:
+	FSpawnActorsTool();
+
+	virtual TSharedPtr<FJsonObject> GetInputSchema() const override;
+	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override;
+	virtual TSharedPtr<FJsonObject> ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments) override;
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override;
+
+	virtual bool RequiresConfirmation() const override { return true; }
+	virtual TArray<FString> GetRequiredPermissions() const override;
+
+	/** Upper bound on actors per call, enforced by the input schema */
+	static constexpr int32 MaxActorsPerCall = 10000;
+
+private:
+	/** One requested actor, read from the arguments on the calling thread */
+	struct FActorSpec
+	{
+		FString ClassName;
+		FTransform Transform;
+		FString Label;
+
+		/** Property name and ImportText value */
+		TArray<TPair<FString, FString>> Properties;
+	};
+
+	bool ParseActorSpecs(const TSharedPtr<FJsonObject>& Arguments, TArray<FActorSpec>& OutSpecs, FString& OutError) const;
+
+	/**
+	 * Resolve, spawn and finish the batch; game thread only. Context may be null for direct calls.
+	 * Static, so the queued task never touches the tool, which may be unregistered before it runs.
+	 */
+	static TSharedPtr<FJsonObject> SpawnBatch(const TArray<FActorSpec>& Specs, const FMCPToolExecutionContext* Context);
+
+	static UClass* ResolveActorClass(const FString& ClassName, FString& OutError);
+};
@@ -3,6 +3,7 @@
 #include "SChatGPTWindow.h"
 #include "AssetAutomation.h"
 #include "AuditLogger.h"
+#include "AuditLogQuery.h"
 #include "BlueprintAuditLog.h"
 #include "ChatGPTConsoleHandler.h"
 #include "ChatGPTPythonHandler.h"
@@ -75,6 +76,29 @@ void SChatGPTWindow::Construct(const FArguments& InArgs)
 				.Font(FCoreStyle::GetDefaultFontStyle("Bold", 16))
 			]
 			
+			// Audit log search
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f, 0.0f, 5.0f, 0.0f)
+			[
+				SNew(SBox)
+				.WidthOverride(260.0f)
+				[
+					SAssignNew(AuditQueryBox, SEditableTextBox)
+					.HintText(LOCTEXT("AuditQueryHint", "type:SCENE_EDIT actor:Cube_1 since:24h"))
+					.ToolTipText(LOCTEXT("AuditQueryTooltip", "Search terms: type, actor, asset, tool, since (30m, 24h, 7d), from, to and limit"))
+				]
+			]
+			
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f, 0.0f, 5.0f, 0.0f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("SearchAuditLog", "Search Audit Log"))
+				.OnClicked(this, &SChatGPTWindow::OnSearchAuditLogClicked)
+			]
+			
 			// Audit Log button
 			+ SHorizontalBox::Slot()
 			.AutoWidth()
@@ -989,7 +1013,7 @@ void SChatGPTWindow::OnExternalAPIPermissionChanged(ECheckBoxState NewState)
 			"- Potential security risks\n"
 			"- Network activity\n\n"
 			"All requests will require preview and approval before execution.\n"
-			"All connections are logged in Saved/ChatGPTEditor/audit.log\n\n"
+			"All connections are logged in Saved/ChatGPTEditor/AuditLog\n\n"
 			"Do you want to continue?")
 	);
 }
@@ -1084,9 +1108,9 @@ FReply SChatGPTWindow::OnConfirmTestCodeClicked()
 			                     "2. Create a new .cpp file in your Tests folder\n"
 			                     "3. Compile your project\n"
 			                     "4. Run the test via Window → Test Automation\n\n"
-			                     "The test code has been logged to: %s"),
+			                     "The test code has been recorded in the audit log (%s). Use Export Audit Log to read it as text."),
 			                *PendingTestName,
-			                *FTestAutomationHelper::GetAuditLogPath()));
+			                *FAuditLogger::Get().GetAuditLogDirectory()));
 		
 		// Clear pending state
 		PendingTestCode.Empty();
@@ -1587,13 +1611,20 @@ void SChatGPTWindow::ProcessSceneEditingCommand(const FString& Command)
 			"- 'Add 5 lights to this room'\n"
 			"- 'Place a camera at PlayerStart'\n"
 			"- 'Move all props up by 100 units'\n"
-			"- 'Delete all trigger volumes'"));
+			"- 'Add 500 instanced cubes'\n"
+			"- 'Convert all props to instances'\n"
+			"- 'Delete all trigger volumes'\n"
+			"- 'Add 3 spot lights and move cameras up 2 m'"));
 		return;
 	}
 
+	// Resolve the actions without changing the level, so the preview shows exactly what will be touched
+	TSharedRef<const FSceneEditPlan> Plan = MakeShared<const FSceneEditPlan>(FSceneEditingManager::Get().PlanActions(Actions, World));
+
 	// Show preview dialog
 	TSharedRef<SSceneEditPreviewDialog> PreviewDialog = SNew(SSceneEditPreviewDialog)
-		.Actions(Actions);
+		.Actions(Actions)
+		.Plan(Plan);
 
 	TSharedRef<SWindow> PreviewWindow = SNew(SWindow)
 		.Title(LOCTEXT("PreviewWindowTitle", "Scene Editing Preview"))
@@ -1609,8 +1640,8 @@ void SChatGPTWindow::ProcessSceneEditingCommand(const FString& Command)
 	// Check if user confirmed
 	if (PreviewDialog->WasConfirmed())
 	{
-		// Execute the actions
-		bool bSuccess = FSceneEditingManager::Get().ExecuteActions(Actions, World, false);
+		// Execute the previewed plan rather than resolving the actions again
+		bool bSuccess = FSceneEditingManager::Get().ExecutePlan(*Plan);
 		
 		if (bSuccess)
 		{
@@ -1631,33 +1662,34 @@ void SChatGPTWindow::ProcessSceneEditingCommand(const FString& Command)
 
 FReply SChatGPTWindow::OnViewAuditLogClicked()
 {
-	TArray<FAuditLogEntry> Entries = FAuditLogger::Get().GetLogEntries();
+	FAuditLogger& Logger = FAuditLogger::Get();
 	
 	FString AuditLogText = TEXT("=== AUDIT LOG ===\n\n");
 	
-	if (Entries.Num() == 0)
+	// Show last 50 entries, formatted straight from the log rather than from a copy of it
+	const int32 NumShown = Logger.VisitRecentEntries(50, [&AuditLogText](const FAuditLogEntry& Entry)
+	{
+		AuditLogText += FString::Printf(TEXT("[%s] %s | %s | Actors: %s | Success: %s"),
+			*Entry.Timestamp.ToString(),
+			*Entry.OperationType,
+			*Entry.UserCommand,
+			*Entry.AffectedActors,
+			Entry.bWasSuccessful ? TEXT("Yes") : TEXT("No"));
+		if (!Entry.ErrorMessage.IsEmpty())
+		{
+			AuditLogText += FString::Printf(TEXT(" | Error: %s"), *Entry.ErrorMessage);
+		}
+		AuditLogText += TEXT("\n");
+	});
+	
+	if (NumShown == 0)
 	{
 		AuditLogText += TEXT("No entries yet.\n");
 	}
 	else
 	{
-		// Show last 50 entries
-		int32 StartIdx = FMath::Max(0, Entries.Num() - 50);
-		for (int32 i = StartIdx; i < Entries.Num(); ++i)
-		{
-			const FAuditLogEntry& Entry = Entries[i];
-			FString EntryText = FString::Printf(TEXT("[%s] %s | %s | Actors: %s | Success: %s"),
-				*Entry.Timestamp.ToString(),
-				*Entry.OperationType,
-				*Entry.UserCommand,
-				*Entry.AffectedActors,
-				Entry.bWasSuccessful ? TEXT("Yes") : TEXT("No"));
-			if (!Entry.ErrorMessage.IsEmpty())
-			{
-				EntryText += FString::Printf(TEXT(" | Error: %s"), *Entry.ErrorMessage);
-			}
-			AuditLogText += EntryText + TEXT("\n");
-		}
+		const int64 NumKept = Logger.GetNextSequence() - Logger.GetFirstSequence();
+		AuditLogText += FString::Printf(TEXT("\n(Last %d of %lld entries)\n"), NumShown, NumKept);
 	}
 	
 	AuditLogText += TEXT("\n=== END OF AUDIT LOG ===");
@@ -1668,6 +1700,46 @@ FReply SChatGPTWindow::OnViewAuditLogClicked()
 	return FReply::Handled();
 }
 
+FReply SChatGPTWindow::OnSearchAuditLogClicked()
+{
+	FAuditQuery Query;
+	Query.MaxResults = 50;
+	FString Error;
+	if (!FAuditQuery::Parse(AuditQueryBox.IsValid() ? AuditQueryBox->GetText().ToString() : FString(), Query, Error))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Error));
+		return FReply::Handled();
+	}
+	
+	FString ResultText = TEXT("=== AUDIT LOG SEARCH ===\n\n");
+	
+	FAuditQueryStats Stats;
+	const FString NextCursor = FAuditLogQueryEngine::Get().Query(Query, [&ResultText](const FAuditEvent& Event)
+	{
+		Event.AppendLine(ResultText);
+		return true;
+	}, &Stats);
+	
+	if (Stats.NumMatched == 0)
+	{
+		ResultText += TEXT("No matching entries.\n");
+	}
+	
+	ResultText += FString::Printf(TEXT("\n(%d matches%s; %lld events scanned in %d of %d segments, %.1f ms)\n"),
+		Stats.NumMatched,
+		NextCursor.IsEmpty() ? TEXT("") : TEXT(", more not shown"),
+		Stats.NumEventsScanned,
+		Stats.NumSegments - Stats.NumSegmentsSkipped,
+		Stats.NumSegments,
+		Stats.Seconds * 1000.0);
+	
+	ResultText += TEXT("\n=== END OF SEARCH ===");
+	
+	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(ResultText));
+	
+	return FReply::Handled();
+}
+
 // Blueprint Scripting Assistant Implementation
 
 FReply SChatGPTWindow::OnGenerateBlueprintClicked()
@@ -2026,22 +2098,27 @@ FReply SChatGPTWindow::OnExportAuditLogClicked()
 		return FReply::Handled();
 	}
 	
+	// The log itself is binary; this writes every subsystem's events, Blueprint operations included, as text or JSON Lines
 	TArray<FString> OutFiles;
 	const FString DefaultPath = FPaths::ProjectSavedDir();
-	const FString DefaultFile = FString::Printf(TEXT("BlueprintAuditLog_%s.txt"), *FDateTime::Now().ToString());
+	const FString DefaultFile = FString::Printf(TEXT("AuditLog_%s.txt"), *FDateTime::Now().ToString());
 	
 	if (DesktopPlatform->SaveFileDialog(
 		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared()),
 		TEXT("Export Audit Log"),
 		DefaultPath,
 		DefaultFile,
-		TEXT("Text Files (*.txt)|*.txt"),
+		TEXT("Text Files (*.txt)|*.txt|JSON Lines (*.jsonl)|*.jsonl"),
 		EFileDialogFlags::None,
 		OutFiles))
 	{
 		if (OutFiles.Num() > 0)
 		{
-			if (FBlueprintAuditLog::Get().ExportToFile(OutFiles[0]))
+			const EAuditLogExportFormat Format = FPaths::GetExtension(OutFiles[0]).Equals(TEXT("jsonl"), ESearchCase::IgnoreCase)
+				? EAuditLogExportFormat::JsonLines : EAuditLogExportFormat::Text;
+			
+			FString Error;
+			if (FAuditLogger::Get().ExportToFile(OutFiles[0], Format, Error))
 			{
 				FMessageDialog::Open(EAppMsgType::Ok, 
 					FText::Format(LOCTEXT("ExportSuccess", "Audit log exported successfully to:\n{0}"), 
@@ -2050,7 +2127,7 @@ FReply SChatGPTWindow::OnExportAuditLogClicked()
 			else
 			{
 				FMessageDialog::Open(EAppMsgType::Ok, 
-					LOCTEXT("ExportFailed", "Failed to export audit log."));
+					FText::Format(LOCTEXT("ExportFailed", "Failed to export audit log.\n{0}"), FText::FromString(Error)));
 			}
 		}
 	}
@@ -59,6 +59,7 @@ private:
 	FReply OnConfirmTestCodeClicked();
 	FReply OnCancelTestCodeClicked();
 	FReply OnViewAuditLogClicked();
+	FReply OnSearchAuditLogClicked();
 	FReply OnGenerateBlueprintClicked();
 	FReply OnExplainBlueprintClicked();
 	FReply OnExportAuditLogClicked();
@@ -232,6 +233,7 @@ private:
 	TSharedPtr<SWindow> TestPreviewWindow;
 	TSharedPtr<SEditableTextBox> BlueprintPromptBox;
 	TSharedPtr<SEditableTextBox> BlueprintNameBox;
+	TSharedPtr<SEditableTextBox> AuditQueryBox;
 	TSharedPtr<SButton> SendButton;
 	TSharedPtr<SButton> ClearButton;
 	
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SSceneEditPreviewDialog.h"
+#include "SceneEditingManager.h"
+#include "ScenePlacement.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Layout/SBox.h"
@@ -9,12 +11,14 @@
 #include "Widgets/SWindow.h"
 #include "Styling/AppStyle.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "SSceneEditPreviewDialog"
 
 void SSceneEditPreviewDialog::Construct(const FArguments& InArgs)
 {
 	PendingActions = InArgs._Actions;
+	Plan = InArgs._Plan;
 	bConfirmed = false;
 
 	ChildSlot
@@ -159,6 +163,11 @@ FString SSceneEditPreviewDialog::GeneratePreviewText(const TArray<FSceneEditActi
 				{
 					PreviewText += FString::Printf(TEXT("  Location: %s\n"), *Action.Location.ToString());
 				}
+				if (FSceneEditingManager::Get().ShouldSpawnInstanced(Action))
+				{
+					PreviewText += FString::Printf(TEXT("  Placement: %d instances of %s in one instanced mesh actor\n"), Action.Count,
+						Action.MeshPath.IsEmpty() ? TEXT("a cube") : *FPaths::GetBaseFilename(Action.MeshPath));
+				}
 				break;
 				
 			case ESceneEditOperation::DeleteActor:
@@ -178,6 +187,35 @@ FString SSceneEditPreviewDialog::GeneratePreviewText(const TArray<FSceneEditActi
 				PreviewText += FString::Printf(TEXT("  Target: All actors matching '%s'\n"), *Action.SearchPattern);
 				PreviewText += FString::Printf(TEXT("  Property: %s = %s\n"), *Action.PropertyName, *Action.PropertyValue);
 				break;
+				
+			case ESceneEditOperation::ConvertToInstances:
+				PreviewText += FString::Printf(TEXT("  Operation: CONVERT TO INSTANCES\n"));
+				PreviewText += FString::Printf(TEXT("  Target: Static mesh actors matching '%s'\n"), *Action.SearchPattern);
+				PreviewText += FString::Printf(TEXT("  Actors sharing a mesh and materials are replaced by instances (at least %d per mesh)\n"), FSceneEditingManager::MinActorsToConvert);
+				break;
+		}
+		
+		if (Action.Region.IsSet())
+		{
+			FString Anchor;
+			switch (Action.Region.Anchor)
+			{
+				case ESceneLocationAnchor::PlayerStart:
+					Anchor = TEXT("PlayerStart");
+					break;
+				case ESceneLocationAnchor::ViewportCamera:
+					Anchor = TEXT("the viewport camera");
+					break;
+				default:
+					Anchor = Action.Region.Location.ToString();
+					break;
+			}
+			PreviewText += FString::Printf(TEXT("  Region: within %.0f units of %s\n"), Action.Region.Radius, *Anchor);
+		}
+		
+		if (Plan.IsValid() && Plan->Actions.IsValidIndex(i))
+		{
+			AppendPlanDetails(Plan->Actions[i], PreviewText);
 		}
 		
 		PreviewText += FString::Printf(TEXT("  Command: \"%s\"\n"), *Action.Description);
@@ -188,4 +226,76 @@ FString SSceneEditPreviewDialog::GeneratePreviewText(const TArray<FSceneEditActi
 	return PreviewText;
 }
 
+void SSceneEditPreviewDialog::AppendPlanDetails(const FSceneEditActionPlan& ActionPlan, FString& PreviewText) const
+{
+	// Long lists are cut short; the audit log records every actor
+	static const int32 MaxListedActors = 25;
+
+	auto FormatLocation = [](const FVector& Location)
+	{
+		return FString::Printf(TEXT("(%.0f, %.0f, %.0f)"), Location.X, Location.Y, Location.Z);
+	};
+
+	if (!ActionPlan.Warning.IsEmpty())
+	{
+		PreviewText += FString::Printf(TEXT("  Note: %s\n"), *ActionPlan.Warning);
+	}
+
+	const FSceneEditAction& Action = ActionPlan.Action;
+	if (Action.Operation == ESceneEditOperation::SpawnActor)
+	{
+		if (ActionPlan.SpawnTransforms.Num() > 0)
+		{
+			const UClass* SpawnClass = ActionPlan.SpawnClass.Get();
+			PreviewText += FString::Printf(TEXT("  Resolved: %d x %s from %s to %s\n"), ActionPlan.SpawnTransforms.Num(),
+				ActionPlan.bSpawnInstanced ? TEXT("instance") : SpawnClass ? *SpawnClass->GetName() : *Action.ActorClass,
+				*FormatLocation(ActionPlan.SpawnTransforms[0].GetLocation()), *FormatLocation(ActionPlan.SpawnTransforms.Last().GetLocation()));
+		}
+		if (Action.Placement.Pattern != EScenePlacementPattern::Row || Action.Placement.bSnapToGround)
+		{
+			PreviewText += FString::Printf(TEXT("  Pattern: %s%s\n"), FScenePlacement::GetPatternName(Action.Placement.Pattern),
+				Action.Placement.bSnapToGround ? TEXT(", snapped to ground") : TEXT(""));
+		}
+		return;
+	}
+
+	if (ActionPlan.Changes.Num() == 0)
+	{
+		PreviewText += TEXT("  Affects: no actors match\n");
+		return;
+	}
+
+	PreviewText += FString::Printf(TEXT("  Affects: %d actor(s)\n"), ActionPlan.Changes.Num());
+	if (Action.Operation == ESceneEditOperation::ConvertToInstances)
+	{
+		PreviewText += FString::Printf(TEXT("  Instance sets: %d\n"), ActionPlan.InstanceGroups.Num());
+	}
+
+	const int32 NumListed = FMath::Min(ActionPlan.Changes.Num(), MaxListedActors);
+	for (int32 Index = 0; Index < NumListed; ++Index)
+	{
+		const FSceneEditActorChange& Change = ActionPlan.Changes[Index];
+		switch (Action.Operation)
+		{
+			case ESceneEditOperation::MoveActor:
+				PreviewText += FString::Printf(TEXT("    - %s: %s -> %s\n"), *Change.ActorName,
+					*FormatLocation(Change.OldTransform.GetLocation()), *FormatLocation(Change.NewTransform.GetLocation()));
+				break;
+				
+			case ESceneEditOperation::ModifyProperty:
+				PreviewText += FString::Printf(TEXT("    - %s: %s -> %s\n"), *Change.ActorName, *Change.OldValue, *Change.NewValue);
+				break;
+				
+			default:
+				PreviewText += FString::Printf(TEXT("    - %s at %s\n"), *Change.ActorName, *FormatLocation(Change.OldTransform.GetLocation()));
+				break;
+		}
+	}
+
+	if (ActionPlan.Changes.Num() > NumListed)
+	{
+		PreviewText += FString::Printf(TEXT("    ... and %d more\n"), ActionPlan.Changes.Num() - NumListed);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -20,6 +20,9 @@ public:
 	SLATE_BEGIN_ARGS(SSceneEditPreviewDialog)
 	{}
 		SLATE_ARGUMENT(TArray<FSceneEditAction>, Actions)
+
+		/** Dry-run resolution of the actions; when set, the preview lists the actors each one affects */
+		SLATE_ARGUMENT(TSharedPtr<const FSceneEditPlan>, Plan)
 	SLATE_END_ARGS()
 
 	/** Constructs this widget with InArgs */
@@ -36,8 +39,12 @@ private:
 	// Generate preview text
 	FString GeneratePreviewText(const TArray<FSceneEditAction>& Actions);
 
+	// Append the resolved actors, transforms and values of one planned action
+	void AppendPlanDetails(const FSceneEditActionPlan& ActionPlan, FString& PreviewText) const;
+
 private:
 	TArray<FSceneEditAction> PendingActions;
+	TSharedPtr<const FSceneEditPlan> Plan;
 	bool bConfirmed = false;
 	TSharedPtr<SMultiLineEditableTextBox> PreviewTextBox;
 };
@@ -0,0 +1,418 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SceneActorIndex.h"
+#include "ChatGPTEditor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Volume.h"
+#include "EngineUtils.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** Half size of the octree root; actors outside it are still indexed, just less tightly */
+	constexpr double OctreeExtent = UE_OLD_HALF_WORLD_MAX;
+
+	template <typename KeyType>
+	void RemoveFromBucket(TMap<KeyType, TSet<TWeakObjectPtr<AActor>>>& Buckets, const KeyType& Key, const TWeakObjectPtr<AActor>& Actor)
+	{
+		if (TSet<TWeakObjectPtr<AActor>>* Bucket = Buckets.Find(Key))
+		{
+			Bucket->Remove(Actor);
+			if (Bucket->Num() == 0)
+			{
+				Buckets.Remove(Key);
+			}
+		}
+	}
+}
+
+FSceneActorIndex::FSceneActorIndex(UWorld* InWorld)
+	: World(InWorld)
+{
+	check(IsInGameThread());
+
+	if (InWorld)
+	{
+		ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FSceneActorIndex::OnActorAdded));
+	}
+
+	// Editor placement, deletion and wholesale changes (level loads, undo of large edits)
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FSceneActorIndex::OnActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FSceneActorIndex::OnActorDeleted);
+		ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FSceneActorIndex::OnActorMoved);
+		ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FSceneActorIndex::OnActorListChanged);
+		ActorFolderChangedHandle = GEngine->OnLevelActorFolderChanged().AddRaw(this, &FSceneActorIndex::OnActorFolderChanged);
+	}
+
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FSceneActorIndex::OnActorLabelChanged);
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FSceneActorIndex::OnObjectPropertyChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FSceneActorIndex::OnLevelAddedOrRemoved);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FSceneActorIndex::OnLevelAddedOrRemoved);
+}
+
+FSceneActorIndex::~FSceneActorIndex()
+{
+	if (UWorld* IndexedWorld = World.Get())
+	{
+		IndexedWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+		GEngine->OnLevelActorFolderChanged().Remove(ActorFolderChangedHandle);
+	}
+
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+}
+
+int32 FSceneActorIndex::Num()
+{
+	EnsureUpToDate();
+	return Entries.Num();
+}
+
+void FSceneActorIndex::FindByClass(const UClass* Class, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	// One bucket per concrete class; a level has far fewer classes than actors
+	for (const TPair<const UClass*, FActorSet>& Pair : ByClass)
+	{
+		if (Pair.Key->IsChildOf(Class))
+		{
+			AppendValid(Pair.Value, OutActors);
+		}
+	}
+}
+
+void FSceneActorIndex::FindByTag(FName Tag, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	if (const FActorSet* Set = ByTag.Find(Tag))
+	{
+		AppendValid(*Set, OutActors);
+	}
+}
+
+void FSceneActorIndex::FindByLabel(const FString& Label, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	if (const FActorSet* Set = ByLabel.Find(Label.ToLower()))
+	{
+		AppendValid(*Set, OutActors);
+	}
+}
+
+void FSceneActorIndex::FindByFolder(FName Folder, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	const FString FolderPath = Folder.ToString();
+	const FString FolderPrefix = FolderPath + TEXT("/");
+	for (const TPair<FName, FActorSet>& Pair : ByFolder)
+	{
+		const FString Path = Pair.Key.ToString();
+		if (Path.Equals(FolderPath, ESearchCase::IgnoreCase) || Path.StartsWith(FolderPrefix, ESearchCase::IgnoreCase))
+		{
+			AppendValid(Pair.Value, OutActors);
+		}
+	}
+}
+
+void FSceneActorIndex::GetAllActors(TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	OutActors.Reserve(OutActors.Num() + Entries.Num());
+	for (const TPair<TWeakObjectPtr<AActor>, FEntry>& Pair : Entries)
+	{
+		AActor* Actor = Pair.Key.Get();
+		if (IsValid(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void FSceneActorIndex::FindInSphere(const FVector& Center, double Radius, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	const double RadiusSquared = FMath::Square(Radius);
+	Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Center, FVector(Radius)), [&OutActors, &Center, RadiusSquared](const FOctreeElement& Element)
+	{
+		AActor* Actor = Element.Actor.Get();
+		if (IsValid(Actor) && FMath::SphereAABBIntersection(Center, RadiusSquared, Element.Bounds.GetBox()))
+		{
+			OutActors.Add(Actor);
+		}
+	});
+}
+
+void FSceneActorIndex::FindInBox(const FBox& Box, TArray<AActor*>& OutActors)
+{
+	EnsureUpToDate();
+
+	Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Box), [&OutActors](const FOctreeElement& Element)
+	{
+		AActor* Actor = Element.Actor.Get();
+		if (IsValid(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	});
+}
+
+void FSceneActorIndex::FindInVolume(const AVolume* Volume, TArray<AActor*>& OutActors)
+{
+	if (!IsValid(Volume))
+	{
+		return;
+	}
+
+	// Broad phase on the volume's bounds, then the exact brush test on the few candidates
+	TArray<AActor*> Candidates;
+	FindInBox(Volume->GetComponentsBoundingBox(true), Candidates);
+	for (AActor* Actor : Candidates)
+	{
+		if (Actor != Volume && Volume->EncompassesPoint(Actor->GetActorLocation()))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void FSceneActorIndex::UpdateBounds(AActor* Actor)
+{
+	if (bDirty)
+	{
+		return;
+	}
+
+	FEntry* Entry = Entries.Find(TWeakObjectPtr<AActor>(Actor));
+	if (!Entry)
+	{
+		return;
+	}
+
+	if (Entry->OctreeId.IsValidId())
+	{
+		Octree->RemoveElement(Entry->OctreeId);
+		Entry->OctreeId = FOctreeElementId2();
+	}
+	Octree->AddElement(FOctreeElement{ Actor, FBoxCenterAndExtent(GetActorBounds(Actor)), this });
+}
+
+void FSceneActorIndex::Rebuild()
+{
+	check(IsInGameThread());
+
+	Entries.Reset();
+	ByClass.Reset();
+	ByTag.Reset();
+	ByLabel.Reset();
+	ByFolder.Reset();
+	Octree = MakeUnique<FActorOctree>(FVector::ZeroVector, OctreeExtent);
+	bDirty = false;
+
+	UWorld* IndexedWorld = World.Get();
+	if (!IndexedWorld)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (TActorIterator<AActor> It(IndexedWorld); It; ++It)
+	{
+		AddActor(*It);
+	}
+
+	UE_LOG(LogChatGPTEditor, Verbose, TEXT("Indexed %d actors in %s (%.1f ms)"),
+		Entries.Num(), *IndexedWorld->GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FSceneActorIndex::EnsureUpToDate()
+{
+	check(IsInGameThread());
+
+	if (bDirty)
+	{
+		Rebuild();
+	}
+}
+
+bool FSceneActorIndex::IsIndexable(const AActor* Actor) const
+{
+	return IsValid(Actor) && !Actor->IsTemplate() && Actor->GetWorld() == World.Get();
+}
+
+void FSceneActorIndex::AddActor(AActor* Actor)
+{
+	if (!IsIndexable(Actor))
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<AActor> Key(Actor);
+	if (Entries.Contains(Key))
+	{
+		RemoveActor(Actor);
+	}
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Class = Actor->GetClass();
+	Entry.Tags = Actor->Tags;
+	Entry.Label = Actor->GetActorLabel().ToLower();
+	Entry.Folder = Actor->GetFolderPath();
+
+	ByClass.FindOrAdd(Entry.Class).Add(Key);
+	for (const FName& Tag : Entry.Tags)
+	{
+		ByTag.FindOrAdd(Tag).Add(Key);
+	}
+	if (!Entry.Label.IsEmpty())
+	{
+		ByLabel.FindOrAdd(Entry.Label).Add(Key);
+	}
+	if (!Entry.Folder.IsNone())
+	{
+		ByFolder.FindOrAdd(Entry.Folder).Add(Key);
+	}
+
+	// Sets Entry.OctreeId through FOctreeSemantics::SetElementId
+	Octree->AddElement(FOctreeElement{ Key, FBoxCenterAndExtent(GetActorBounds(Actor)), this });
+}
+
+void FSceneActorIndex::RemoveActor(AActor* Actor)
+{
+	const TWeakObjectPtr<AActor> Key(Actor);
+
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	RemoveFromBucket(ByClass, Entry.Class, Key);
+	for (const FName& Tag : Entry.Tags)
+	{
+		RemoveFromBucket(ByTag, Tag, Key);
+	}
+	RemoveFromBucket(ByLabel, Entry.Label, Key);
+	RemoveFromBucket(ByFolder, Entry.Folder, Key);
+
+	if (Entry.OctreeId.IsValidId())
+	{
+		Octree->RemoveElement(Entry.OctreeId);
+	}
+}
+
+void FSceneActorIndex::RefreshActor(AActor* Actor)
+{
+	// Untracked actors are picked up by the next rebuild, or were never ours
+	if (!bDirty && Entries.Contains(TWeakObjectPtr<AActor>(Actor)))
+	{
+		AddActor(Actor);
+	}
+}
+
+void FSceneActorIndex::AppendValid(const FActorSet& Set, TArray<AActor*>& OutActors)
+{
+	OutActors.Reserve(OutActors.Num() + Set.Num());
+	for (const TWeakObjectPtr<AActor>& WeakActor : Set)
+	{
+		AActor* Actor = WeakActor.Get();
+		if (IsValid(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+FBox FSceneActorIndex::GetActorBounds(const AActor* Actor)
+{
+	// Actors without primitives (lights, cameras, empties) are indexed as a point
+	const FBox Bounds = Actor->GetComponentsBoundingBox(true);
+	return Bounds.IsValid ? Bounds : FBox(Actor->GetActorLocation(), Actor->GetActorLocation());
+}
+
+void FSceneActorIndex::FOctreeSemantics::SetElementId(const FOctreeElement& Element, FOctreeElementId2 Id)
+{
+	if (FEntry* Entry = Element.Index->Entries.Find(Element.Actor))
+	{
+		Entry->OctreeId = Id;
+	}
+}
+
+void FSceneActorIndex::OnActorAdded(AActor* Actor)
+{
+	// While dirty the next query re-reads everything anyway
+	if (!bDirty)
+	{
+		AddActor(Actor);
+	}
+}
+
+void FSceneActorIndex::OnActorDeleted(AActor* Actor)
+{
+	if (!bDirty)
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void FSceneActorIndex::OnActorMoved(AActor* Actor)
+{
+	UpdateBounds(Actor);
+}
+
+void FSceneActorIndex::OnActorListChanged()
+{
+	bDirty = true;
+}
+
+void FSceneActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+	RefreshActor(Actor);
+}
+
+void FSceneActorIndex::OnActorFolderChanged(const AActor* Actor, FName OldFolder)
+{
+	RefreshActor(const_cast<AActor*>(Actor));
+}
+
+void FSceneActorIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// Tags have no dedicated delegate; they change through the Details panel
+	if (Event.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(AActor, Tags))
+	{
+		if (AActor* Actor = Cast<AActor>(Object))
+		{
+			RefreshActor(Actor);
+		}
+	}
+}
+
+void FSceneActorIndex::OnLevelAddedOrRemoved(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld == World.Get())
+	{
+		bDirty = true;
+	}
+}
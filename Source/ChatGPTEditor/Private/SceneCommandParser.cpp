@@ -0,0 +1,883 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SceneCommandParser.h"
+#include "SceneEditingManager.h"
+#include "ScenePlacement.h"
+
+namespace
+{
+	enum class EKeyword : uint8
+	{
+		None,
+
+		// Verbs
+		Spawn,
+		Delete,
+		Move,
+		Modify,
+		Convert,
+
+		// Actor types
+		Light,
+		SpotLight,
+		Point,
+		Spot,
+		Directional,
+		Camera,
+		Trigger,
+		Prop,
+		Static,
+		Mesh,
+		Shape,
+
+		// Places
+		At,
+		Near,
+		Within,
+		Of,
+		The,
+		Here,
+		Nearby,
+		This,
+		Room,
+		Me,
+		PlayerStart,
+		Player,
+		Start,
+
+		// Movement
+		Direction,
+		By,
+		Unit,
+		Meter,
+
+		// Properties
+		ColorWord,
+		ColorName,
+
+		// Placement
+		Instance,
+		Actor,
+		As,
+		Separate,
+		Pattern,
+		Ground,
+		Spacing,
+		RadiusWord,
+
+		// Property values ("to 5000")
+		To,
+
+		// Clause joiners
+		And,
+		Then,
+
+		// Keyed patterns ("tag:Tree")
+		PatternKey
+	};
+
+	/** What a word means to the grammar; Data indexes the shape, color, direction or pattern key tables, or is an EScenePlacementPattern */
+	struct FWordInfo
+	{
+		EKeyword Keyword = EKeyword::None;
+		uint8 Data = 0;
+	};
+
+	struct FKeywordEntry
+	{
+		FStringView Word;
+		FWordInfo Info;
+	};
+
+	struct FShapeEntry
+	{
+		const TCHAR* MeshPath;
+	};
+
+	struct FColorEntry
+	{
+		const TCHAR* Name;
+		FLinearColor Color;
+	};
+
+	const FShapeEntry Shapes[] =
+	{
+		{ TEXT("/Engine/BasicShapes/Cube.Cube") },
+		{ TEXT("/Engine/BasicShapes/Sphere.Sphere") },
+		{ TEXT("/Engine/BasicShapes/Cylinder.Cylinder") },
+		{ TEXT("/Engine/BasicShapes/Cone.Cone") },
+		{ TEXT("/Engine/BasicShapes/Plane.Plane") }
+	};
+
+	// Literal values rather than FLinearColor::Red and friends, which may not be initialized yet
+	const FColorEntry Colors[] =
+	{
+		{ TEXT("Red"), FLinearColor(1.0f, 0.0f, 0.0f) },
+		{ TEXT("Green"), FLinearColor(0.0f, 1.0f, 0.0f) },
+		{ TEXT("Blue"), FLinearColor(0.0f, 0.0f, 1.0f) },
+		{ TEXT("White"), FLinearColor(1.0f, 1.0f, 1.0f) },
+		{ TEXT("Black"), FLinearColor(0.0f, 0.0f, 0.0f) },
+		{ TEXT("Yellow"), FLinearColor(1.0f, 1.0f, 0.0f) },
+		{ TEXT("Orange"), FLinearColor(1.0f, 0.5f, 0.0f) },
+		{ TEXT("Purple"), FLinearColor(0.5f, 0.0f, 1.0f) },
+		{ TEXT("Cyan"), FLinearColor(0.0f, 1.0f, 1.0f) },
+		{ TEXT("Magenta"), FLinearColor(1.0f, 0.0f, 1.0f) },
+		{ TEXT("Pink"), FLinearColor(1.0f, 0.4f, 0.7f) }
+	};
+
+	const FVector Directions[] =
+	{
+		FVector(0.0, 0.0, 1.0),
+		FVector(0.0, 0.0, -1.0),
+		FVector(1.0, 0.0, 0.0),
+		FVector(-1.0, 0.0, 0.0),
+		FVector(0.0, 1.0, 0.0),
+		FVector(0.0, -1.0, 0.0)
+	};
+
+	const TCHAR* PatternKeys[] = { TEXT("tag"), TEXT("label"), TEXT("folder") };
+
+	/** Singular forms only; plurals are matched by dropping "s" or "es" */
+	const FKeywordEntry Keywords[] =
+	{
+		{ TEXTVIEW("add"), { EKeyword::Spawn } },
+		{ TEXTVIEW("spawn"), { EKeyword::Spawn } },
+		{ TEXTVIEW("place"), { EKeyword::Spawn } },
+		{ TEXTVIEW("create"), { EKeyword::Spawn } },
+		{ TEXTVIEW("put"), { EKeyword::Spawn } },
+		{ TEXTVIEW("delete"), { EKeyword::Delete } },
+		{ TEXTVIEW("remove"), { EKeyword::Delete } },
+		{ TEXTVIEW("destroy"), { EKeyword::Delete } },
+		{ TEXTVIEW("move"), { EKeyword::Move } },
+		{ TEXTVIEW("shift"), { EKeyword::Move } },
+		{ TEXTVIEW("nudge"), { EKeyword::Move } },
+		{ TEXTVIEW("change"), { EKeyword::Modify } },
+		{ TEXTVIEW("set"), { EKeyword::Modify } },
+		{ TEXTVIEW("modify"), { EKeyword::Modify } },
+		{ TEXTVIEW("convert"), { EKeyword::Convert } },
+		{ TEXTVIEW("merge"), { EKeyword::Convert } },
+		{ TEXTVIEW("replace"), { EKeyword::Convert } },
+
+		{ TEXTVIEW("light"), { EKeyword::Light } },
+		{ TEXTVIEW("lamp"), { EKeyword::Light } },
+		{ TEXTVIEW("spotlight"), { EKeyword::SpotLight } },
+		{ TEXTVIEW("point"), { EKeyword::Point } },
+		{ TEXTVIEW("spot"), { EKeyword::Spot } },
+		{ TEXTVIEW("directional"), { EKeyword::Directional } },
+		{ TEXTVIEW("camera"), { EKeyword::Camera } },
+		{ TEXTVIEW("trigger"), { EKeyword::Trigger } },
+		{ TEXTVIEW("prop"), { EKeyword::Prop } },
+		{ TEXTVIEW("static"), { EKeyword::Static } },
+		{ TEXTVIEW("mesh"), { EKeyword::Mesh } },
+		{ TEXTVIEW("cube"), { EKeyword::Shape, 0 } },
+		{ TEXTVIEW("box"), { EKeyword::Shape, 0 } },
+		{ TEXTVIEW("sphere"), { EKeyword::Shape, 1 } },
+		{ TEXTVIEW("ball"), { EKeyword::Shape, 1 } },
+		{ TEXTVIEW("cylinder"), { EKeyword::Shape, 2 } },
+		{ TEXTVIEW("cone"), { EKeyword::Shape, 3 } },
+		{ TEXTVIEW("plane"), { EKeyword::Shape, 4 } },
+
+		{ TEXTVIEW("at"), { EKeyword::At } },
+		{ TEXTVIEW("near"), { EKeyword::Near } },
+		{ TEXTVIEW("around"), { EKeyword::Near } },
+		{ TEXTVIEW("close"), { EKeyword::Near } },
+		{ TEXTVIEW("within"), { EKeyword::Within } },
+		{ TEXTVIEW("of"), { EKeyword::Of } },
+		{ TEXTVIEW("the"), { EKeyword::The } },
+		{ TEXTVIEW("here"), { EKeyword::Here } },
+		{ TEXTVIEW("nearby"), { EKeyword::Nearby } },
+		{ TEXTVIEW("this"), { EKeyword::This } },
+		{ TEXTVIEW("room"), { EKeyword::Room } },
+		{ TEXTVIEW("area"), { EKeyword::Room } },
+		{ TEXTVIEW("me"), { EKeyword::Me } },
+		{ TEXTVIEW("playerstart"), { EKeyword::PlayerStart } },
+		{ TEXTVIEW("player"), { EKeyword::Player } },
+		{ TEXTVIEW("start"), { EKeyword::Start } },
+
+		{ TEXTVIEW("up"), { EKeyword::Direction, 0 } },
+		{ TEXTVIEW("upward"), { EKeyword::Direction, 0 } },
+		{ TEXTVIEW("down"), { EKeyword::Direction, 1 } },
+		{ TEXTVIEW("downward"), { EKeyword::Direction, 1 } },
+		{ TEXTVIEW("forward"), { EKeyword::Direction, 2 } },
+		{ TEXTVIEW("back"), { EKeyword::Direction, 3 } },
+		{ TEXTVIEW("backward"), { EKeyword::Direction, 3 } },
+		{ TEXTVIEW("right"), { EKeyword::Direction, 4 } },
+		{ TEXTVIEW("left"), { EKeyword::Direction, 5 } },
+		{ TEXTVIEW("by"), { EKeyword::By } },
+		{ TEXTVIEW("unit"), { EKeyword::Unit } },
+		{ TEXTVIEW("cm"), { EKeyword::Unit } },
+		{ TEXTVIEW("centimeter"), { EKeyword::Unit } },
+		{ TEXTVIEW("m"), { EKeyword::Meter } },
+		{ TEXTVIEW("meter"), { EKeyword::Meter } },
+		{ TEXTVIEW("metre"), { EKeyword::Meter } },
+
+		{ TEXTVIEW("color"), { EKeyword::ColorWord } },
+		{ TEXTVIEW("colour"), { EKeyword::ColorWord } },
+		{ TEXTVIEW("red"), { EKeyword::ColorName, 0 } },
+		{ TEXTVIEW("green"), { EKeyword::ColorName, 1 } },
+		{ TEXTVIEW("blue"), { EKeyword::ColorName, 2 } },
+		{ TEXTVIEW("white"), { EKeyword::ColorName, 3 } },
+		{ TEXTVIEW("black"), { EKeyword::ColorName, 4 } },
+		{ TEXTVIEW("yellow"), { EKeyword::ColorName, 5 } },
+		{ TEXTVIEW("orange"), { EKeyword::ColorName, 6 } },
+		{ TEXTVIEW("purple"), { EKeyword::ColorName, 7 } },
+		{ TEXTVIEW("cyan"), { EKeyword::ColorName, 8 } },
+		{ TEXTVIEW("magenta"), { EKeyword::ColorName, 9 } },
+		{ TEXTVIEW("pink"), { EKeyword::ColorName, 10 } },
+
+		{ TEXTVIEW("instance"), { EKeyword::Instance } },
+		{ TEXTVIEW("instanced"), { EKeyword::Instance } },
+		{ TEXTVIEW("actor"), { EKeyword::Actor } },
+		{ TEXTVIEW("as"), { EKeyword::As } },
+		{ TEXTVIEW("separate"), { EKeyword::Separate } },
+		{ TEXTVIEW("grid"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Grid) } },
+		{ TEXTVIEW("ring"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Ring) } },
+		{ TEXTVIEW("circle"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Ring) } },
+		{ TEXTVIEW("scatter"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Scatter) } },
+		{ TEXTVIEW("scattered"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Scatter) } },
+		{ TEXTVIEW("random"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Scatter) } },
+		{ TEXTVIEW("randomly"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::Scatter) } },
+		{ TEXTVIEW("surface"), { EKeyword::Pattern, static_cast<uint8>(EScenePlacementPattern::SurfaceScatter) } },
+		{ TEXTVIEW("ground"), { EKeyword::Ground } },
+		{ TEXTVIEW("floor"), { EKeyword::Ground } },
+		{ TEXTVIEW("terrain"), { EKeyword::Ground } },
+		{ TEXTVIEW("spaced"), { EKeyword::Spacing } },
+		{ TEXTVIEW("spacing"), { EKeyword::Spacing } },
+		{ TEXTVIEW("radius"), { EKeyword::RadiusWord } },
+
+		{ TEXTVIEW("to"), { EKeyword::To } },
+
+		{ TEXTVIEW("and"), { EKeyword::And } },
+		{ TEXTVIEW("then"), { EKeyword::Then } },
+
+		{ TEXTVIEW("tag"), { EKeyword::PatternKey, 0 } },
+		{ TEXTVIEW("label"), { EKeyword::PatternKey, 1 } },
+		{ TEXTVIEW("folder"), { EKeyword::PatternKey, 2 } }
+	};
+
+	bool FindKeyword(FStringView Word, FWordInfo& OutInfo)
+	{
+		for (const FKeywordEntry& Entry : Keywords)
+		{
+			if (Entry.Word.Len() == Word.Len() && Entry.Word.Equals(Word, ESearchCase::IgnoreCase))
+			{
+				OutInfo = Entry.Info;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FWordInfo ClassifyWord(FStringView Word)
+	{
+		FWordInfo Info;
+		if (FindKeyword(Word, Info))
+			return Info;
+
+		// Plurals: "lights", "instances", "boxes", "meshes"
+		if (Word.Len() > 2 && FChar::ToLower(Word[Word.Len() - 1]) == TEXT('s'))
+		{
+			if (FindKeyword(Word.LeftChop(1), Info))
+				return Info;
+			if (FChar::ToLower(Word[Word.Len() - 2]) == TEXT('e') && FindKeyword(Word.LeftChop(2), Info))
+				return Info;
+		}
+
+		return FWordInfo();
+	}
+
+	bool IsVerb(EKeyword Keyword)
+	{
+		return Keyword == EKeyword::Spawn || Keyword == EKeyword::Delete || Keyword == EKeyword::Move
+			|| Keyword == EKeyword::Modify || Keyword == EKeyword::Convert;
+	}
+
+	bool IsJoiner(const FSceneToken& Token, const FWordInfo& Info)
+	{
+		return Token.Type == ESceneTokenType::Comma || Token.Type == ESceneTokenType::Separator
+			|| Info.Keyword == EKeyword::And || Info.Keyword == EKeyword::Then;
+	}
+
+	/** "N, N, N" starting at Index */
+	bool ReadCoordinates(TConstArrayView<FSceneToken> Tokens, int32 Index, FVector& OutLocation)
+	{
+		if (Index + 4 >= Tokens.Num()
+			|| !Tokens[Index].IsNumber() || Tokens[Index + 1].Type != ESceneTokenType::Comma
+			|| !Tokens[Index + 2].IsNumber() || Tokens[Index + 3].Type != ESceneTokenType::Comma
+			|| !Tokens[Index + 4].IsNumber())
+		{
+			return false;
+		}
+
+		OutLocation = FVector(Tokens[Index].Number, Tokens[Index + 2].Number, Tokens[Index + 4].Number);
+		return true;
+	}
+
+	/** Unreal units per unit of the word after a number; meters are 100 */
+	double GetUnitScale(TConstArrayView<FWordInfo> Words, int32 Index)
+	{
+		return Words.IsValidIndex(Index) && Words[Index].Keyword == EKeyword::Meter ? 100.0 : 1.0;
+	}
+
+	/** Build the action for one clause; false if the clause has no verb or doesn't make sense */
+	bool ParseClause(TConstArrayView<FSceneToken> Tokens, TConstArrayView<FWordInfo> Words, FSceneEditAction& OutAction)
+	{
+		int32 VerbIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Words.Num(); ++Index)
+		{
+			if (IsVerb(Words[Index].Keyword))
+			{
+				VerbIndex = Index;
+				break;
+			}
+		}
+
+		if (VerbIndex == INDEX_NONE)
+			return false;
+
+		const EKeyword Verb = Words[VerbIndex].Keyword;
+
+		// What the number after a keyword means
+		enum class EPending : uint8
+		{
+			None,
+			Radius,
+			Distance,
+			Spacing
+		};
+		EPending Pending = EPending::None;
+
+		bool bLight = false;
+		bool bPoint = false;
+		bool bSpot = false;
+		bool bDirectional = false;
+		bool bCamera = false;
+		bool bTrigger = false;
+		bool bProp = false;
+		bool bStatic = false;
+		bool bMesh = false;
+		int32 ShapeIndex = INDEX_NONE;
+
+		bool bAt = false;
+		bool bProximity = false;
+		bool bExpectAnchor = false;
+		bool bPlayerStart = false;
+		bool bViewport = false;
+		bool bHasLocation = false;
+		FVector Location = FVector::ZeroVector;
+		double Radius = -1.0;
+
+		bool bHasCount = false;
+		int32 Count = 1;
+		FVector Direction = FVector::ZeroVector;
+		double Distance = -1.0;
+
+		bool bColorWord = false;
+		int32 ColorIndex = INDEX_NONE;
+		bool bInstance = false;
+		bool bAsActors = false;
+		FString KeyedPattern;
+		FStringView PropertyPath;
+		FStringView PropertyValue;
+
+		bool bHasPattern = false;
+		EScenePlacementPattern Pattern = EScenePlacementPattern::Row;
+		bool bGround = false;
+		double Spacing = -1.0;
+
+		for (int32 Index = VerbIndex + 1; Index < Tokens.Num(); ++Index)
+		{
+			const FSceneToken& Token = Tokens[Index];
+
+			if (Token.IsNumber())
+			{
+				if (ReadCoordinates(Tokens, Index, Location))
+				{
+					bHasLocation = true;
+					bExpectAnchor = false;
+					Index += 4;
+					continue;
+				}
+
+				const double Value = Token.Number * GetUnitScale(Words, Index + 1);
+				if (Pending == EPending::Radius)
+				{
+					Radius = FMath::Max(Value, 0.0);
+				}
+				else if (Pending == EPending::Spacing)
+				{
+					Spacing = FMath::Max(Value, 1.0);
+				}
+				else if (Pending == EPending::Distance || (Verb == EKeyword::Move && Distance < 0.0))
+				{
+					Distance = Value;
+				}
+				else if (!bHasCount)
+				{
+					// Spawns past the cap are clamped rather than rejected
+					bHasCount = true;
+					Count = static_cast<int32>(FMath::Clamp(Value, 1.0, static_cast<double>(FSceneCommandParser::MaxCount)));
+				}
+				Pending = EPending::None;
+				continue;
+			}
+
+			if (!Token.IsWord())
+				continue;
+
+			const FWordInfo& Word = Words[Index];
+			const EKeyword Previous = Index > 0 ? Words[Index - 1].Keyword : EKeyword::None;
+			const EKeyword Next = Index + 1 < Words.Num() ? Words[Index + 1].Keyword : EKeyword::None;
+
+			switch (Word.Keyword)
+			{
+				case EKeyword::Light: bLight = true; break;
+				case EKeyword::SpotLight: bLight = bSpot = true; break;
+				case EKeyword::Point: bPoint = true; break;
+				case EKeyword::Spot: bSpot = true; break;
+				case EKeyword::Directional: bDirectional = true; break;
+				case EKeyword::Trigger: bTrigger = true; break;
+				case EKeyword::Prop: bProp = true; break;
+				case EKeyword::Static: bStatic = true; break;
+				case EKeyword::Mesh: bMesh = true; break;
+				case EKeyword::Shape: ShapeIndex = Word.Data; break;
+
+				case EKeyword::Camera:
+					// "near the camera" is the viewport; otherwise camera actors
+					if (bExpectAnchor && Previous == EKeyword::The)
+					{
+						bViewport = true;
+						bExpectAnchor = false;
+					}
+					else
+					{
+						bCamera = true;
+					}
+					break;
+
+				case EKeyword::At:
+					bAt = true;
+					bExpectAnchor = true;
+					break;
+
+				case EKeyword::Near:
+					bProximity = true;
+					bExpectAnchor = true;
+					break;
+
+				case EKeyword::Within:
+					bProximity = true;
+					Pending = EPending::Radius;
+					break;
+
+				case EKeyword::Of:
+					bExpectAnchor = true;
+					break;
+
+				case EKeyword::Here:
+					bViewport = true;
+					break;
+
+				case EKeyword::Nearby:
+					bProximity = true;
+					bViewport = true;
+					break;
+
+				case EKeyword::This:
+					if (Next == EKeyword::Room)
+					{
+						bViewport = true;
+						++Index;
+					}
+					break;
+
+				case EKeyword::Me:
+					if (bExpectAnchor)
+					{
+						bViewport = true;
+						bExpectAnchor = false;
+					}
+					break;
+
+				case EKeyword::PlayerStart:
+					bPlayerStart = true;
+					bExpectAnchor = false;
+					break;
+
+				case EKeyword::Player:
+					if (Next == EKeyword::Start)
+					{
+						bPlayerStart = true;
+						bExpectAnchor = false;
+						++Index;
+					}
+					break;
+
+				case EKeyword::Direction:
+					Direction += Directions[Word.Data];
+					Pending = EPending::Distance;
+					break;
+
+				case EKeyword::By:
+					if (!Direction.IsZero())
+					{
+						Pending = EPending::Distance;
+					}
+					break;
+
+				case EKeyword::ColorWord: bColorWord = true; break;
+				case EKeyword::ColorName: ColorIndex = Word.Data; break;
+				case EKeyword::Instance: bInstance = true; break;
+
+				case EKeyword::Actor:
+					if (Previous == EKeyword::As || Previous == EKeyword::Separate)
+					{
+						bAsActors = true;
+					}
+					break;
+
+				case EKeyword::Pattern:
+					// "scattered on the surface" is a surface scatter, not a plain one
+					if (!bHasPattern || static_cast<EScenePlacementPattern>(Word.Data) == EScenePlacementPattern::SurfaceScatter)
+					{
+						Pattern = static_cast<EScenePlacementPattern>(Word.Data);
+					}
+					bHasPattern = true;
+					break;
+
+				case EKeyword::Ground: bGround = true; break;
+				case EKeyword::Spacing: Pending = EPending::Spacing; break;
+				case EKeyword::RadiusWord: Pending = EPending::Radius; break;
+
+				case EKeyword::To:
+					// "to <value>" only gives a value once a property path has been named
+					if (!PropertyPath.IsEmpty() && Index + 1 < Tokens.Num() && (Tokens[Index + 1].IsWord() || Tokens[Index + 1].IsNumber()))
+					{
+						PropertyValue = Tokens[Index + 1].Text;
+						++Index;
+					}
+					break;
+
+				case EKeyword::None:
+					// Dotted words are property paths ("LightComponent.Intensity")
+					if (Verb == EKeyword::Modify)
+					{
+						int32 DotIndex;
+						if (Token.Text.FindChar(TEXT('.'), DotIndex))
+						{
+							PropertyPath = Token.Text;
+						}
+					}
+					break;
+
+				case EKeyword::PatternKey:
+					// "tag:Tree"; the value may be a word or a number
+					if (Index + 2 < Tokens.Num() && Tokens[Index + 1].Type == ESceneTokenType::Colon
+						&& (Tokens[Index + 2].IsWord() || Tokens[Index + 2].IsNumber()))
+					{
+						const FStringView Value = Tokens[Index + 2].Text;
+						KeyedPattern = PatternKeys[Word.Data];
+						KeyedPattern += TEXT(":");
+						KeyedPattern.Append(Value.GetData(), Value.Len());
+						Index += 2;
+					}
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		// Most specific type wins, as in "spot light" over "light"
+		const TCHAR* ActorType = TEXT("actor");
+		if (bLight)
+		{
+			ActorType = bPoint ? TEXT("point light") : bSpot ? TEXT("spot light") : bDirectional ? TEXT("directional light") : TEXT("light");
+		}
+		else if (bCamera)
+		{
+			ActorType = TEXT("camera");
+		}
+		else if (bTrigger)
+		{
+			ActorType = TEXT("trigger");
+		}
+		else if (bProp)
+		{
+			ActorType = TEXT("prop");
+		}
+		else if (bStatic && bMesh)
+		{
+			ActorType = TEXT("static mesh");
+		}
+
+		FSceneEditRegion Region;
+		if (bPlayerStart && (bProximity || bAt))
+		{
+			Region.Anchor = ESceneLocationAnchor::PlayerStart;
+		}
+		else if (bViewport)
+		{
+			Region.Anchor = ESceneLocationAnchor::ViewportCamera;
+		}
+		else if (bHasLocation && (bProximity || bAt))
+		{
+			Region.Anchor = ESceneLocationAnchor::Explicit;
+			Region.Location = Location;
+		}
+		if (Region.IsSet())
+		{
+			Region.Radius = Radius >= 0.0 ? Radius : FSceneEditingManager::DefaultRegionRadius;
+		}
+
+		const FString SearchPattern = KeyedPattern.IsEmpty() ? FString(ActorType) : KeyedPattern;
+
+		switch (Verb)
+		{
+			case EKeyword::Spawn:
+			{
+				OutAction.Operation = ESceneEditOperation::SpawnActor;
+				OutAction.ActorClass = ShapeIndex != INDEX_NONE && !FCString::Strcmp(ActorType, TEXT("actor")) ? TEXT("static mesh") : ActorType;
+				OutAction.Count = Count;
+				OutAction.MeshPath = ShapeIndex != INDEX_NONE ? Shapes[ShapeIndex].MeshPath : TEXT("");
+				OutAction.SpawnMode = bInstance ? ESceneSpawnMode::Instanced : bAsActors ? ESceneSpawnMode::Actors : ESceneSpawnMode::Auto;
+				OutAction.Placement.Pattern = Pattern;
+				OutAction.Placement.bSnapToGround = bGround;
+				if (Spacing > 0.0)
+				{
+					OutAction.Placement.Spacing = Spacing;
+				}
+				if (Radius >= 0.0)
+				{
+					OutAction.Placement.Radius = Radius;
+				}
+				if (bPlayerStart)
+				{
+					OutAction.PropertyName = TEXT("AtPlayerStart");
+				}
+				else if (Region.Anchor == ESceneLocationAnchor::ViewportCamera)
+				{
+					OutAction.Region = Region;
+				}
+				else if (bHasLocation)
+				{
+					OutAction.Location = Location;
+				}
+				return true;
+			}
+
+			case EKeyword::Delete:
+				OutAction.Operation = ESceneEditOperation::DeleteActor;
+				OutAction.SearchPattern = SearchPattern;
+				OutAction.Region = Region;
+				return true;
+
+			case EKeyword::Move:
+				OutAction.Operation = ESceneEditOperation::MoveActor;
+				OutAction.SearchPattern = SearchPattern;
+				OutAction.Region = Region;
+				OutAction.Location = Direction * (Distance >= 0.0 ? Distance : FSceneCommandParser::DefaultMoveDistance);
+				return true;
+
+			case EKeyword::Modify:
+				OutAction.Operation = ESceneEditOperation::ModifyProperty;
+				OutAction.SearchPattern = SearchPattern;
+				OutAction.Region = Region;
+				if (!PropertyPath.IsEmpty())
+				{
+					OutAction.PropertyName = FString(PropertyPath);
+					OutAction.PropertyValue = FString(PropertyValue);
+				}
+				else if (bColorWord || ColorIndex != INDEX_NONE)
+				{
+					OutAction.PropertyName = TEXT("Color");
+					OutAction.PropertyValue = ColorIndex != INDEX_NONE ? Colors[ColorIndex].Name : TEXT("");
+				}
+				return true;
+
+			case EKeyword::Convert:
+				// "replace" and "merge" only mean something here when instances are asked for
+				if (!bInstance)
+					return false;
+
+				OutAction.Operation = ESceneEditOperation::ConvertToInstances;
+				OutAction.SearchPattern = KeyedPattern.IsEmpty() && !FCString::Strcmp(ActorType, TEXT("actor")) ? FString(TEXT("static mesh")) : SearchPattern;
+				OutAction.Region = Region;
+				return true;
+
+			default:
+				return false;
+		}
+	}
+}
+
+bool FSceneCommandLexer::IsPathDot(FStringView Command, int32 Position)
+{
+	// "LightComponent.Intensity" is one word; "lights. Then" is a sentence break
+	return Command[Position] == TEXT('.') && Position + 1 < Command.Len() && (FChar::IsAlpha(Command[Position + 1]) || Command[Position + 1] == TEXT('_'));
+}
+
+FSceneToken FSceneCommandLexer::Next()
+{
+	const int32 Length = Command.Len();
+	while (Position < Length)
+	{
+		const TCHAR Char = Command[Position];
+		const TCHAR NextChar = Position + 1 < Length ? Command[Position + 1] : TEXT('\0');
+		const int32 Start = Position;
+
+		if (FChar::IsWhitespace(Char))
+		{
+			++Position;
+			continue;
+		}
+
+		FSceneToken Token;
+
+		if (FChar::IsAlpha(Char) || Char == TEXT('_'))
+		{
+			while (Position < Length && (FChar::IsAlnum(Command[Position]) || Command[Position] == TEXT('_') || Command[Position] == TEXT('-') || Command[Position] == TEXT('/')
+				|| IsPathDot(Command, Position)))
+			{
+				++Position;
+			}
+			Token.Type = ESceneTokenType::Word;
+			Token.Text = Command.Mid(Start, Position - Start);
+			return Token;
+		}
+
+		const bool bSigned = (Char == TEXT('-') || Char == TEXT('+')) && (FChar::IsDigit(NextChar) || NextChar == TEXT('.'));
+		if (FChar::IsDigit(Char) || bSigned || (Char == TEXT('.') && FChar::IsDigit(NextChar)))
+		{
+			// Digits are accumulated in place; nothing is copied out for a string to number conversion
+			double Sign = 1.0;
+			if (bSigned)
+			{
+				Sign = Char == TEXT('-') ? -1.0 : 1.0;
+				++Position;
+			}
+
+			double Value = 0.0;
+			while (Position < Length && FChar::IsDigit(Command[Position]))
+			{
+				Value = Value * 10.0 + (Command[Position] - TEXT('0'));
+				++Position;
+			}
+
+			if (Position + 1 < Length && Command[Position] == TEXT('.') && FChar::IsDigit(Command[Position + 1]))
+			{
+				++Position;
+				double Scale = 0.1;
+				while (Position < Length && FChar::IsDigit(Command[Position]))
+				{
+					Value += (Command[Position] - TEXT('0')) * Scale;
+					Scale *= 0.1;
+					++Position;
+				}
+			}
+
+			Token.Type = ESceneTokenType::Number;
+			Token.Text = Command.Mid(Start, Position - Start);
+			Token.Number = Sign * Value;
+			return Token;
+		}
+
+		++Position;
+		switch (Char)
+		{
+			case TEXT(','): Token.Type = ESceneTokenType::Comma; break;
+			case TEXT(':'): Token.Type = ESceneTokenType::Colon; break;
+			case TEXT(';'):
+			case TEXT('.'):
+			case TEXT('!'):
+			case TEXT('?'): Token.Type = ESceneTokenType::Separator; break;
+			default: continue; // Brackets, quotes and other punctuation carry no meaning
+		}
+		Token.Text = Command.Mid(Start, 1);
+		return Token;
+	}
+
+	return FSceneToken();
+}
+
+int32 FSceneCommandParser::Parse(FStringView Command, TArray<FSceneEditAction>& OutActions)
+{
+	// Typical commands fit inline, so a parse allocates nothing until it builds actions
+	TArray<FSceneToken, TInlineAllocator<64>> Tokens;
+	TArray<FWordInfo, TInlineAllocator<64>> Words;
+
+	FSceneCommandLexer Lexer(Command);
+	for (FSceneToken Token = Lexer.Next(); Token.Type != ESceneTokenType::End; Token = Lexer.Next())
+	{
+		Tokens.Add(Token);
+		Words.Add(Token.IsWord() ? ClassifyWord(Token.Text) : FWordInfo());
+	}
+
+	// A clause ends at a joiner followed by a verb; "and then move" counts as one joiner
+	TArray<TPair<int32, int32>, TInlineAllocator<4>> Clauses;
+	int32 ClauseStart = 0;
+	for (int32 Index = 0; Index < Tokens.Num(); ++Index)
+	{
+		if (!IsJoiner(Tokens[Index], Words[Index]))
+			continue;
+
+		int32 Next = Index + 1;
+		while (Next < Tokens.Num() && IsJoiner(Tokens[Next], Words[Next]))
+		{
+			++Next;
+		}
+
+		if (Next < Tokens.Num() && IsVerb(Words[Next].Keyword))
+		{
+			Clauses.Emplace(ClauseStart, Index);
+			ClauseStart = Next;
+			Index = Next;
+		}
+	}
+	Clauses.Emplace(ClauseStart, Tokens.Num());
+
+	const TConstArrayView<FSceneToken> TokenView(Tokens);
+	const TConstArrayView<FWordInfo> WordView(Words);
+
+	int32 NumAdded = 0;
+	for (const TPair<int32, int32>& Clause : Clauses)
+	{
+		const int32 NumTokens = Clause.Value - Clause.Key;
+		if (NumTokens <= 0)
+			continue;
+
+		FSceneEditAction Action;
+		if (!ParseClause(TokenView.Slice(Clause.Key, NumTokens), WordView.Slice(Clause.Key, NumTokens), Action))
+			continue;
+
+		// Single clause commands keep their full text for the audit log
+		if (Clauses.Num() == 1)
+		{
+			Action.Description = FString(Command).TrimStartAndEnd();
+		}
+		else
+		{
+			const FStringView First = Tokens[Clause.Key].Text;
+			const FStringView Last = Tokens[Clause.Value - 1].Text;
+			Action.Description = FString(FStringView(First.GetData(), static_cast<int32>(Last.GetData() + Last.Len() - First.GetData())));
+		}
+
+		OutActions.Add(MoveTemp(Action));
+		++NumAdded;
+	}
+
+	return NumAdded;
+}
+
+bool FSceneCommandParser::FindNamedColor(FStringView Name, FLinearColor& OutColor)
+{
+	for (const FColorEntry& Entry : Colors)
+	{
+		if (Name.Equals(Entry.Name, ESearchCase::IgnoreCase))
+		{
+			OutColor = Entry.Color;
+			return true;
+		}
+	}
+	return false;
+}
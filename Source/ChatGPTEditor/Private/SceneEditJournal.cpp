@@ -0,0 +1,1202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SceneEditJournal.h"
+#include "ChatGPTEditor.h"
+#include "AuditLogger.h"
+#include "SceneEditingManager.h"
+#include "ScenePropertyAccessor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "EngineUtils.h"
+#include "Editor.h"
+#include "ScopedTransaction.h"
+#include "AI/NavigationSystemBase.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "HAL/FileManager.h"
+
+#define LOCTEXT_NAMESPACE "SceneEditJournal"
+
+struct FSceneEditJournal::FRecord
+{
+	ESceneJournalOp Op = ESceneJournalOp::Name;
+
+	/** Name and Actor definitions, and batch descriptions */
+	FString Text;
+	FGuid Guid;
+
+	/** Batch: length of the whole batch in bytes, patched in when it is committed */
+	uint32 BatchLength = 0;
+	int64 Ticks = 0;
+
+	int32 Actor = INDEX_NONE;
+
+	/** Spawn and Destroy */
+	int32 Class = INDEX_NONE;
+	int32 Mesh = INDEX_NONE;
+	int32 Folder = INDEX_NONE;
+	TArray<int32> Tags;
+	FString Label;
+
+	/** Destroy: a value that differs from the defaults, on the actor (Object is INDEX_NONE) or a component by name */
+	struct FStateValue
+	{
+		int32 Object = INDEX_NONE;
+		int32 Property = INDEX_NONE;
+		int32 ArrayIndex = 0;
+		FString Value;
+	};
+	TArray<FStateValue> State;
+
+	/** Transform changes the components in Mask; Spawn and Destroy place the actor at NewTransform */
+	uint8 Mask = 0;
+	FTransform OldTransform;
+	FTransform NewTransform;
+
+	/** Property */
+	int32 Path = INDEX_NONE;
+	FString OldValue;
+	FString NewValue;
+
+	/** AddInstances */
+	TArray<int32> Materials;
+	int32 FirstIndex = 0;
+	bool bCreatedHolder = false;
+	TArray<FTransform> Instances;
+};
+
+struct FSceneEditJournal::FApplyContext
+{
+	explicit FApplyContext(UWorld* InWorld)
+		: World(InWorld)
+	{
+	}
+
+	UWorld* World;
+
+	/** Actors by journal id in this world, found as records need them */
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	/** Every actor in the world by GUID and name, built the first time an actor isn't already known */
+	TMap<FGuid, AActor*> ActorsByGuid;
+	TMap<FName, AActor*> ActorsByName;
+	bool bScanned = false;
+
+	bool bLevelModified = false;
+};
+
+namespace
+{
+	/** Transform components stored by a record */
+	enum ETransformPart : uint8
+	{
+		TP_Location = 1 << 0,
+		TP_Rotation = 1 << 1,
+		TP_Scale = 1 << 2
+	};
+
+	/** Bytes at the start of a batch that say how long it is: the op and the length */
+	constexpr int32 BatchHeaderSize = sizeof(uint8) + sizeof(uint32);
+
+	bool IsChangeRecord(ESceneJournalOp Op)
+	{
+		return Op >= ESceneJournalOp::Spawn;
+	}
+
+	void SerializeCount(FArchive& Ar, int32& Value)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(Value, 0));
+		Ar.SerializeIntPacked(Packed);
+		Value = static_cast<int32>(FMath::Min<uint32>(Packed, MAX_int32));
+	}
+
+	/** Optional ids are stored one higher, so a missing id is a single zero byte */
+	void SerializeId(FArchive& Ar, int32& Id)
+	{
+		int32 Stored = Id + 1;
+		SerializeCount(Ar, Stored);
+		Id = Stored - 1;
+	}
+
+	void SerializeIds(FArchive& Ar, TArray<int32>& Ids)
+	{
+		int32 Num = Ids.Num();
+		SerializeCount(Ar, Num);
+		if (Ar.IsLoading())
+		{
+			if (Num > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+			Ids.SetNum(Num);
+		}
+		for (int32& Id : Ids)
+		{
+			SerializeId(Ar, Id);
+		}
+	}
+
+	/** Strings are stored as UTF-8 after their length in bytes */
+	void SerializeString(FArchive& Ar, FString& Value)
+	{
+		if (Ar.IsLoading())
+		{
+			int32 Length = 0;
+			SerializeCount(Ar, Length);
+			if (Length > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+
+			TArray<UTF8CHAR> Bytes;
+			Bytes.SetNumUninitialized(Length);
+			Ar.Serialize(Bytes.GetData(), Length);
+			const FUTF8ToTCHAR Converted(Bytes.GetData(), Length);
+			Value = FString(Converted.Length(), Converted.Get());
+		}
+		else
+		{
+			const FTCHARToUTF8 Converted(*Value);
+			int32 Length = Converted.Length();
+			SerializeCount(Ar, Length);
+			Ar.Serialize((void*)Converted.Get(), Length);
+		}
+	}
+
+	/** Location at full precision; rotation and scale as floats, which is all the editor shows of them */
+	void SerializeTransformParts(FArchive& Ar, uint8 Mask, FTransform& Transform)
+	{
+		if (Mask & TP_Location)
+		{
+			FVector Location = Transform.GetLocation();
+			Ar << Location.X << Location.Y << Location.Z;
+			Transform.SetLocation(Location);
+		}
+		if (Mask & TP_Rotation)
+		{
+			FQuat4f Rotation(Transform.GetRotation());
+			Ar << Rotation.X << Rotation.Y << Rotation.Z << Rotation.W;
+			Transform.SetRotation(FQuat(Rotation));
+		}
+		if (Mask & TP_Scale)
+		{
+			FVector3f Scale(Transform.GetScale3D());
+			Ar << Scale.X << Scale.Y << Scale.Z;
+			Transform.SetScale3D(FVector(Scale));
+		}
+	}
+
+	/** Whether a property holds components; the destroyed actor's are gone, and the respawned one makes its own */
+	bool RefersToComponents(const FProperty* Property)
+	{
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			return ObjectProperty->PropertyClass && ObjectProperty->PropertyClass->IsChildOf<UActorComponent>();
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			return RefersToComponents(ArrayProperty->Inner);
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			return RefersToComponents(SetProperty->ElementProp);
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			return RefersToComponents(MapProperty->KeyProp) || RefersToComponents(MapProperty->ValueProp);
+		return false;
+	}
+
+	/**
+	 * Whether a property is part of an actor's state that a destroy record keeps. Left out: what isn't saved with
+	 * the level, references into the actor itself, what the record holds in its own fields, the GUIDs spawning
+	 * assigns, and the root component's placement, which the record's transform already gives.
+	 */
+	bool IsStateProperty(const FProperty* Property, const UObject* Object, const AActor* Actor)
+	{
+		if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient | CPF_NonPIEDuplicateTransient | CPF_Deprecated
+			| CPF_InstancedReference | CPF_ContainsInstancedReference) || RefersToComponents(Property))
+		{
+			return false;
+		}
+
+		static const TSet<FName> ActorFields = { TEXT("ActorLabel"), TEXT("FolderPath"), TEXT("Tags"), TEXT("ActorGuid"), TEXT("ActorInstanceGuid") };
+		static const TSet<FName> RootFields = { TEXT("RelativeLocation"), TEXT("RelativeRotation"), TEXT("RelativeScale3D"), TEXT("AttachSocketName") };
+		if (Object == Actor ? ActorFields.Contains(Property->GetFName()) : Object == Actor->GetRootComponent() && RootFields.Contains(Property->GetFName()))
+			return false;
+
+		return true;
+	}
+
+	/** A whole transform; rotation and scale are left out when they are identity */
+	void SerializeTransform(FArchive& Ar, FTransform& Transform)
+	{
+		uint8 Mask = TP_Location;
+		if (Ar.IsSaving())
+		{
+			Mask |= Transform.GetRotation().IsIdentity(0.0) ? 0 : TP_Rotation;
+			Mask |= Transform.GetScale3D() == FVector::OneVector ? 0 : TP_Scale;
+		}
+		Ar << Mask;
+
+		if (Ar.IsLoading())
+		{
+			Transform = FTransform::Identity;
+		}
+		SerializeTransformParts(Ar, Mask, Transform);
+	}
+}
+
+FSceneEditJournal::FSceneEditJournal()
+	: SessionId(FGuid::NewGuid())
+{
+}
+
+FSceneEditJournal::~FSceneEditJournal() = default;
+
+void FSceneEditJournal::SetOutputDirectory(const FString& Directory)
+{
+	OutputDirectory = Directory;
+}
+
+void FSceneEditJournal::SerializeRecord(FArchive& Ar, FRecord& Record)
+{
+	uint8 Op = static_cast<uint8>(Record.Op);
+	Ar << Op;
+	Record.Op = static_cast<ESceneJournalOp>(Op);
+
+	switch (Record.Op)
+	{
+		case ESceneJournalOp::Name:
+			SerializeString(Ar, Record.Text);
+			break;
+
+		case ESceneJournalOp::Actor:
+			Ar << Record.Guid;
+			SerializeString(Ar, Record.Text);
+			break;
+
+		case ESceneJournalOp::Batch:
+			// Fixed size, so the length can be patched in once the batch is complete
+			Ar << Record.BatchLength;
+			Ar << Record.Ticks;
+			SerializeString(Ar, Record.Text);
+			break;
+
+		case ESceneJournalOp::Spawn:
+		case ESceneJournalOp::Destroy:
+		{
+			SerializeId(Ar, Record.Actor);
+			SerializeId(Ar, Record.Class);
+			SerializeId(Ar, Record.Mesh);
+			SerializeId(Ar, Record.Folder);
+			SerializeIds(Ar, Record.Tags);
+			SerializeString(Ar, Record.Label);
+			SerializeTransform(Ar, Record.NewTransform);
+
+			int32 NumValues = Record.State.Num();
+			SerializeCount(Ar, NumValues);
+			if (Ar.IsLoading())
+			{
+				// Every value takes at least its two ids, its index and its length
+				if (NumValues > (Ar.TotalSize() - Ar.Tell()) / 4)
+				{
+					Ar.SetError();
+					break;
+				}
+				Record.State.SetNum(NumValues);
+			}
+			for (FRecord::FStateValue& Value : Record.State)
+			{
+				SerializeId(Ar, Value.Object);
+				SerializeId(Ar, Value.Property);
+				SerializeCount(Ar, Value.ArrayIndex);
+				SerializeString(Ar, Value.Value);
+			}
+			break;
+		}
+
+		case ESceneJournalOp::Transform:
+			SerializeId(Ar, Record.Actor);
+			Ar << Record.Mask;
+			SerializeTransformParts(Ar, Record.Mask, Record.OldTransform);
+			SerializeTransformParts(Ar, Record.Mask, Record.NewTransform);
+			break;
+
+		case ESceneJournalOp::Property:
+			SerializeId(Ar, Record.Actor);
+			SerializeId(Ar, Record.Path);
+			SerializeString(Ar, Record.OldValue);
+			SerializeString(Ar, Record.NewValue);
+			break;
+
+		case ESceneJournalOp::AddInstances:
+		{
+			SerializeId(Ar, Record.Actor);
+			SerializeId(Ar, Record.Mesh);
+			SerializeIds(Ar, Record.Materials);
+			SerializeCount(Ar, Record.FirstIndex);
+			Ar << Record.bCreatedHolder;
+
+			int32 NumInstances = Record.Instances.Num();
+			SerializeCount(Ar, NumInstances);
+			if (Ar.IsLoading())
+			{
+				// Every instance takes at least a location
+				if (NumInstances > (Ar.TotalSize() - Ar.Tell()) / static_cast<int64>(3 * sizeof(double)))
+				{
+					Ar.SetError();
+					break;
+				}
+				Record.Instances.SetNum(NumInstances);
+			}
+			for (FTransform& Instance : Record.Instances)
+			{
+				SerializeTransform(Ar, Instance);
+			}
+			break;
+		}
+
+		default:
+			Ar.SetError();
+			break;
+	}
+}
+
+void FSceneEditJournal::WriteRecord(FRecord& Record)
+{
+	RecordOffsets.Add(Data.Num());
+	FMemoryWriter Writer(Data, false, true);
+	SerializeRecord(Writer, Record);
+}
+
+bool FSceneEditJournal::ReadRecord(int32 Offset, FRecord& OutRecord) const
+{
+	FMemoryReader Reader(Data);
+	Reader.Seek(Offset);
+	SerializeRecord(Reader, OutRecord);
+	return !Reader.IsError();
+}
+
+int32 FSceneEditJournal::InternName(const FString& Name)
+{
+	if (Name.IsEmpty())
+		return INDEX_NONE;
+
+	if (const int32* Id = NameIds.Find(Name))
+		return *Id;
+
+	const int32 Id = Names.Add(Name);
+	NameIds.Add(Name, Id);
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Name;
+	Record.Text = Name;
+	WriteRecord(Record);
+	return Id;
+}
+
+int32 FSceneEditJournal::InternActor(AActor* Actor)
+{
+	const FGuid Guid = Actor->GetActorGuid();
+	if (const int32* Id = ActorIds.Find(Guid))
+	{
+		// A respawned actor keeps its GUID but is a new object
+		Actors[*Id] = Actor;
+		return *Id;
+	}
+
+	const int32 Id = ActorGuids.Add(Guid);
+	ActorNames.Add(Actor->GetFName());
+	ActorIds.Add(Guid, Id);
+	Actors.Add(Actor);
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Actor;
+	Record.Guid = Guid;
+	Record.Text = Actor->GetName();
+	WriteRecord(Record);
+	return Id;
+}
+
+void FSceneEditJournal::TruncateTables(int32 NumNames, int32 NumActors)
+{
+	for (int32 Index = NumNames; Index < Names.Num(); ++Index)
+	{
+		NameIds.Remove(Names[Index]);
+	}
+	Names.SetNum(NumNames);
+
+	for (int32 Index = NumActors; Index < ActorGuids.Num(); ++Index)
+	{
+		ActorIds.Remove(ActorGuids[Index]);
+	}
+	ActorGuids.SetNum(NumActors);
+	ActorNames.SetNum(NumActors);
+	Actors.SetNum(NumActors);
+}
+
+void FSceneEditJournal::BeginBatch(const FString& Description)
+{
+	check(IsInGameThread());
+	check(!IsRecording());
+
+	BatchStart = Data.Num();
+	BatchFirstRecord = RecordOffsets.Num();
+	BatchFirstName = Names.Num();
+	BatchFirstActor = ActorGuids.Num();
+	bBatchHasChanges = false;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Batch;
+	Record.Ticks = FDateTime::UtcNow().GetTicks();
+	Record.Text = Description;
+	WriteRecord(Record);
+}
+
+void FSceneEditJournal::CommitBatch()
+{
+	if (!IsRecording())
+		return;
+
+	if (!bBatchHasChanges)
+	{
+		Data.SetNum(BatchStart);
+		RecordOffsets.SetNum(BatchFirstRecord);
+		TruncateTables(BatchFirstName, BatchFirstActor);
+	}
+	else
+	{
+		uint32 BatchLength = static_cast<uint32>(Data.Num() - BatchStart);
+		FMemoryWriter Writer(Data);
+		Writer.Seek(BatchStart + sizeof(uint8));
+		Writer << BatchLength;
+		++NumBatches;
+
+		if (!OutputDirectory.IsEmpty())
+		{
+			AppendToFile();
+		}
+	}
+
+	BatchStart = INDEX_NONE;
+}
+
+void FSceneEditJournal::DescribeActor(AActor* Actor, FRecord& OutRecord)
+{
+	OutRecord.Actor = InternActor(Actor);
+	OutRecord.Class = InternName(Actor->GetClass()->GetPathName());
+	OutRecord.Label = Actor->GetActorLabel();
+	OutRecord.NewTransform = Actor->GetActorTransform();
+
+	const AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+	const UStaticMesh* Mesh = MeshActor ? MeshActor->GetStaticMeshComponent()->GetStaticMesh() : nullptr;
+	OutRecord.Mesh = Mesh ? InternName(Mesh->GetPathName()) : INDEX_NONE;
+
+	const FName Folder = Actor->GetFolderPath();
+	OutRecord.Folder = Folder.IsNone() ? INDEX_NONE : InternName(Folder.ToString());
+
+	for (const FName& Tag : Actor->Tags)
+	{
+		OutRecord.Tags.Add(InternName(Tag.ToString()));
+	}
+}
+
+void FSceneEditJournal::DescribeState(AActor* Actor, FRecord& OutRecord)
+{
+	// Components the class or its Blueprint makes come back under the same names; the rest can't be found again
+	TInlineComponentArray<UActorComponent*> Components;
+	Actor->GetComponents(Components);
+
+	TArray<UObject*, TInlineAllocator<8>> Objects;
+	Objects.Add(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component && (Component->CreationMethod == EComponentCreationMethod::Native || Component->CreationMethod == EComponentCreationMethod::SimpleConstructionScript))
+		{
+			Objects.Add(Component);
+		}
+	}
+
+	for (UObject* Object : Objects)
+	{
+		const UObject* Archetype = Object->GetArchetype();
+		if (!Archetype || Archetype->GetClass() != Object->GetClass())
+			continue;
+
+		for (TFieldIterator<FProperty> It(Object->GetClass()); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (!IsStateProperty(Property, Object, Actor))
+				continue;
+
+			for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+			{
+				const void* Value = Property->ContainerPtrToValuePtr<void>(Object, ArrayIndex);
+				if (Property->Identical(Value, Property->ContainerPtrToValuePtr<void>(Archetype, ArrayIndex), PPF_None))
+					continue;
+
+				// A reference to something inside the actor would point at what is being destroyed
+				const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+				const UObject* Referenced = ObjectProperty ? ObjectProperty->GetObjectPropertyValue(Value) : nullptr;
+				if (Referenced && Referenced->IsIn(Actor))
+					continue;
+
+				FRecord::FStateValue& State = OutRecord.State.AddDefaulted_GetRef();
+				State.Object = Object == Actor ? INDEX_NONE : InternName(Object->GetName());
+				State.Property = InternName(Property->GetName());
+				State.ArrayIndex = ArrayIndex;
+				Property->ExportText_Direct(State.Value, Value, nullptr, Object, PPF_None);
+			}
+		}
+	}
+}
+
+void FSceneEditJournal::RestoreState(const FRecord& Record, AActor* Actor) const
+{
+	TInlineComponentArray<UActorComponent*> Components;
+	Actor->GetComponents(Components);
+
+	TArray<UObject*, TInlineAllocator<8>> Changed;
+	for (const FRecord::FStateValue& State : Record.State)
+	{
+		UObject* Object = Actor;
+		if (State.Object != INDEX_NONE)
+		{
+			const FName ComponentName = Names.IsValidIndex(State.Object) ? FName(*Names[State.Object]) : NAME_None;
+			UActorComponent* const* Found = Components.FindByPredicate([ComponentName](const UActorComponent* Component)
+			{
+				return Component && Component->GetFName() == ComponentName;
+			});
+			Object = Found ? *Found : nullptr;
+		}
+
+		FProperty* Property = Object && Names.IsValidIndex(State.Property) ? FindFProperty<FProperty>(Object->GetClass(), FName(*Names[State.Property])) : nullptr;
+		if (!Property || State.ArrayIndex >= Property->ArrayDim || !IsStateProperty(Property, Object, Actor))
+			continue;
+
+		if (Property->ImportText_Direct(*State.Value, Property->ContainerPtrToValuePtr<void>(Object, State.ArrayIndex), Object, PPF_None))
+		{
+			Changed.AddUnique(Object);
+		}
+	}
+
+	// Components first, so the actor's own PostEditChange, which may rerun its construction script, sees them restored
+	for (UObject* Object : Changed)
+	{
+		if (Object != Actor)
+		{
+			Object->PostEditChange();
+		}
+	}
+	if (Changed.Num() > 0)
+	{
+		Actor->PostEditChange();
+	}
+}
+
+void FSceneEditJournal::RecordSpawn(AActor* Actor)
+{
+	if (!IsRecording() || !Actor)
+		return;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Spawn;
+	DescribeActor(Actor, Record);
+	WriteRecord(Record);
+	bBatchHasChanges = true;
+}
+
+void FSceneEditJournal::RecordDestroy(AActor* Actor)
+{
+	if (!IsRecording() || !Actor)
+		return;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Destroy;
+	DescribeActor(Actor, Record);
+	DescribeState(Actor, Record);
+	WriteRecord(Record);
+	bBatchHasChanges = true;
+}
+
+void FSceneEditJournal::RecordTransform(AActor* Actor, const FTransform& OldTransform, const FTransform& NewTransform)
+{
+	if (!IsRecording() || !Actor)
+		return;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Transform;
+	Record.Mask |= OldTransform.GetLocation() == NewTransform.GetLocation() ? 0 : TP_Location;
+	Record.Mask |= OldTransform.GetRotation().Equals(NewTransform.GetRotation(), 0.0) ? 0 : TP_Rotation;
+	Record.Mask |= OldTransform.GetScale3D() == NewTransform.GetScale3D() ? 0 : TP_Scale;
+	if (Record.Mask == 0)
+		return;
+
+	Record.Actor = InternActor(Actor);
+	Record.OldTransform = OldTransform;
+	Record.NewTransform = NewTransform;
+	WriteRecord(Record);
+	bBatchHasChanges = true;
+}
+
+void FSceneEditJournal::RecordProperty(AActor* Actor, const FString& Path, const FString& OldValue, const FString& NewValue)
+{
+	if (!IsRecording() || !Actor || OldValue.Equals(NewValue, ESearchCase::CaseSensitive))
+		return;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::Property;
+	Record.Actor = InternActor(Actor);
+	Record.Path = InternName(Path);
+	Record.OldValue = OldValue;
+	Record.NewValue = NewValue;
+	WriteRecord(Record);
+	bBatchHasChanges = true;
+}
+
+void FSceneEditJournal::RecordAddInstances(AActor* Holder, const UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials, int32 FirstIndex, const TArray<FTransform>& Transforms, bool bCreatedHolder)
+{
+	if (!IsRecording() || !Holder || !Mesh || Transforms.Num() == 0)
+		return;
+
+	FRecord Record;
+	Record.Op = ESceneJournalOp::AddInstances;
+	Record.Actor = InternActor(Holder);
+	Record.Mesh = InternName(Mesh->GetPathName());
+	for (const UMaterialInterface* Material : Materials)
+	{
+		Record.Materials.Add(Material ? InternName(Material->GetPathName()) : INDEX_NONE);
+	}
+	Record.FirstIndex = FirstIndex;
+	Record.bCreatedHolder = bCreatedHolder;
+	Record.Instances = Transforms;
+	WriteRecord(Record);
+	bBatchHasChanges = true;
+}
+
+AActor* FSceneEditJournal::ResolveActor(int32 ActorId, FApplyContext& Context) const
+{
+	if (!Context.Actors.IsValidIndex(ActorId))
+		return nullptr;
+
+	AActor* Actor = Context.Actors[ActorId].Get();
+	if (IsValid(Actor) && Actor->GetWorld() == Context.World)
+		return Actor;
+
+	// Actors this session didn't touch, or a different world: look them up by GUID, then by name for level copies
+	if (!Context.bScanned)
+	{
+		for (TActorIterator<AActor> It(Context.World); It; ++It)
+		{
+			Context.ActorsByGuid.Add(It->GetActorGuid(), *It);
+			Context.ActorsByName.Add(It->GetFName(), *It);
+		}
+		Context.bScanned = true;
+	}
+
+	AActor** Found = Context.ActorsByGuid.Find(ActorGuids[ActorId]);
+	if (!Found || !IsValid(*Found))
+	{
+		Found = Context.ActorsByName.Find(ActorNames[ActorId]);
+	}
+
+	Actor = Found && IsValid(*Found) ? *Found : nullptr;
+	Context.Actors[ActorId] = Actor;
+	return Actor;
+}
+
+AActor* FSceneEditJournal::SpawnFromRecord(const FRecord& Record, FApplyContext& Context, bool bKeepGuid) const
+{
+	UClass* Class = Names.IsValidIndex(Record.Class) ? LoadObject<UClass>(nullptr, *Names[Record.Class]) : nullptr;
+	if (!Class || !Class->IsChildOf<AActor>())
+		return nullptr;
+
+	if (!Context.bLevelModified && Context.World->GetCurrentLevel())
+	{
+		Context.World->GetCurrentLevel()->Modify();
+		Context.bLevelModified = true;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = ActorNames[Record.Actor];
+	SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transactional;
+#if WITH_EDITOR
+	// The same GUID means later records, and journals recorded after this one, still find it
+	if (bKeepGuid)
+	{
+		SpawnParams.OverrideActorGuid = ActorGuids[Record.Actor];
+	}
+#endif
+
+	AActor* Actor = Context.World->SpawnActor<AActor>(Class, Record.NewTransform, SpawnParams);
+	if (!Actor)
+		return nullptr;
+
+	if (!Record.Label.IsEmpty())
+	{
+		Actor->SetActorLabel(Record.Label);
+	}
+	if (Names.IsValidIndex(Record.Folder))
+	{
+		Actor->SetFolderPath(FName(*Names[Record.Folder]));
+	}
+	for (int32 Tag : Record.Tags)
+	{
+		if (Names.IsValidIndex(Tag))
+		{
+			Actor->Tags.AddUnique(FName(*Names[Tag]));
+		}
+	}
+
+	AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+	if (MeshActor && Names.IsValidIndex(Record.Mesh))
+	{
+		if (UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, *Names[Record.Mesh]))
+		{
+			MeshActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+		}
+	}
+	RestoreState(Record, Actor);
+
+	Context.Actors[Record.Actor] = Actor;
+	return Actor;
+}
+
+bool FSceneEditJournal::ApplyRecord(const FRecord& Record, FApplyContext& Context, bool bReverse) const
+{
+	if (!Context.Actors.IsValidIndex(Record.Actor))
+		return false;
+
+	switch (Record.Op)
+	{
+		case ESceneJournalOp::Spawn:
+		case ESceneJournalOp::Destroy:
+		{
+			AActor* Actor = ResolveActor(Record.Actor, Context);
+			const bool bCreate = (Record.Op == ESceneJournalOp::Spawn) != bReverse;
+			if (bCreate)
+			{
+				// Undoing a delete that something else already brought back would duplicate it
+				if (Actor && bReverse)
+					return false;
+
+				return SpawnFromRecord(Record, Context, Actor == nullptr) != nullptr;
+			}
+
+			if (!Actor)
+				return false;
+
+			if (!Context.bLevelModified && Actor->GetLevel())
+			{
+				Actor->GetLevel()->Modify();
+				Context.bLevelModified = true;
+			}
+			Actor->Modify();
+			return Context.World->EditorDestroyActor(Actor, false);
+		}
+
+		case ESceneJournalOp::Transform:
+		{
+			AActor* Actor = ResolveActor(Record.Actor, Context);
+			if (!Actor)
+				return false;
+
+			// Components the record doesn't hold stay as they are now
+			const FTransform& Source = bReverse ? Record.OldTransform : Record.NewTransform;
+			FTransform Transform = Actor->GetActorTransform();
+			if (Record.Mask & TP_Location)
+			{
+				Transform.SetLocation(Source.GetLocation());
+			}
+			if (Record.Mask & TP_Rotation)
+			{
+				Transform.SetRotation(Source.GetRotation());
+			}
+			if (Record.Mask & TP_Scale)
+			{
+				Transform.SetScale3D(Source.GetScale3D());
+			}
+
+			Actor->Modify();
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			Actor->PostEditMove(true);
+			if (GEngine)
+			{
+				GEngine->BroadcastOnActorMoved(Actor);
+			}
+			return true;
+		}
+
+		case ESceneJournalOp::Property:
+		{
+			AActor* Actor = ResolveActor(Record.Actor, Context);
+			if (!Actor || !Names.IsValidIndex(Record.Path))
+				return false;
+
+			FString Error;
+			TSharedPtr<const FScenePropertyAccessor> Accessor = FScenePropertyAccessor::Find(Actor->GetClass(), Names[Record.Path], Error);
+			UObject* Owner = nullptr;
+			void* Value = nullptr;
+			if (!Accessor.IsValid() || !Accessor->Resolve(Actor, Owner, Value))
+				return false;
+
+			Owner->Modify();
+			Owner->PreEditChange(Accessor->GetMemberProperty());
+			const bool bImported = Accessor->GetProperty()->ImportText_Direct(bReverse ? *Record.OldValue : *Record.NewValue, Value, Owner, PPF_None) != nullptr;
+
+			FPropertyChangedEvent Event(Accessor->GetProperty(), EPropertyChangeType::ValueSet);
+			Event.SetActiveMemberProperty(Accessor->GetMemberProperty());
+			Owner->PostEditChangeProperty(Event);
+			return bImported;
+		}
+
+		case ESceneJournalOp::AddInstances:
+		{
+			if (bReverse)
+			{
+				AActor* Holder = ResolveActor(Record.Actor, Context);
+				UInstancedStaticMeshComponent* Component = Holder ? Holder->FindComponentByClass<UHierarchicalInstancedStaticMeshComponent>() : nullptr;
+
+				// Instances are only removed from the end, so they must still be the last ones
+				if (!Component || Component->GetInstanceCount() != Record.FirstIndex + Record.Instances.Num())
+					return false;
+
+				TArray<int32> Indices;
+				Indices.Reserve(Record.Instances.Num());
+				for (int32 Index = Component->GetInstanceCount() - 1; Index >= Record.FirstIndex; --Index)
+				{
+					Indices.Add(Index);
+				}
+
+				Component->Modify();
+				Component->RemoveInstances(Indices);
+
+				if (Record.bCreatedHolder && Component->GetInstanceCount() == 0)
+				{
+					Holder->Modify();
+					Context.World->EditorDestroyActor(Holder, false);
+				}
+				return true;
+			}
+
+			UStaticMesh* Mesh = Names.IsValidIndex(Record.Mesh) ? LoadObject<UStaticMesh>(nullptr, *Names[Record.Mesh]) : nullptr;
+			if (!Mesh)
+				return false;
+
+			TArray<UMaterialInterface*> Materials;
+			for (int32 Material : Record.Materials)
+			{
+				Materials.Add(Names.IsValidIndex(Material) ? LoadObject<UMaterialInterface>(nullptr, *Names[Material]) : nullptr);
+			}
+
+			// Replayed instances join whichever instanced actor the target world has for the mesh
+			UHierarchicalInstancedStaticMeshComponent* Component = FSceneEditingManager::Get().FindOrCreateInstanceComponent(Context.World, Mesh, Materials);
+			if (!Component)
+				return false;
+
+			Component->Modify();
+			Component->AddInstances(Record.Instances, false, true);
+			Context.Actors[Record.Actor] = Component->GetOwner();
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+int32 FSceneEditJournal::UndoSession(UWorld* World, FString& OutError)
+{
+	check(IsInGameThread());
+
+	if (!World)
+	{
+		OutError = TEXT("No world to undo the session in");
+		return 0;
+	}
+	if (IsRecording())
+	{
+		OutError = TEXT("A scene edit is still being recorded");
+		return 0;
+	}
+
+	FScopedTransaction Transaction(LOCTEXT("UndoSceneEditSession", "Undo Scene Edit Session"));
+	FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+
+	FApplyContext Context(World);
+	Context.Actors = Actors;
+
+	// Newest first, so every record sees the world as it was right after it was made
+	int32 NumReverted = 0;
+	int32 NumSkipped = 0;
+	for (int32 Index = RecordOffsets.Num() - 1; Index >= 0; --Index)
+	{
+		FRecord Record;
+		if (!ReadRecord(RecordOffsets[Index], Record) || !IsChangeRecord(Record.Op))
+			continue;
+
+		if (ApplyRecord(Record, Context, true))
+		{
+			++NumReverted;
+		}
+		else
+		{
+			++NumSkipped;
+		}
+	}
+
+	if (NumSkipped > 0)
+	{
+		OutError = FString::Printf(TEXT("%d edit(s) were not reverted because their actors have been changed or removed since"), NumSkipped);
+	}
+
+	FAuditLogger::Get().LogOperation(TEXT("Undo scene edit session"), TEXT("UndoSession"),
+		FString::Printf(TEXT("%d edits reverted from %d batches"), NumReverted, NumBatches), NumSkipped == 0, OutError);
+
+	if (NumReverted == 0)
+	{
+		Transaction.Cancel();
+	}
+	else if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	Reset();
+	return NumReverted;
+}
+
+int32 FSceneEditJournal::Replay(UWorld* World, FString& OutError) const
+{
+	check(IsInGameThread());
+
+	if (!World)
+	{
+		OutError = TEXT("No world to replay into");
+		return 0;
+	}
+
+	FScopedTransaction Transaction(LOCTEXT("ReplaySceneEditJournal", "Replay Scene Edits"));
+	FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+
+	FApplyContext Context(World);
+	Context.Actors.SetNum(ActorGuids.Num());
+
+	int32 NumApplied = 0;
+	int32 NumSkipped = 0;
+	for (int32 Offset : RecordOffsets)
+	{
+		FRecord Record;
+		if (!ReadRecord(Offset, Record) || !IsChangeRecord(Record.Op))
+			continue;
+
+		if (ApplyRecord(Record, Context, false))
+		{
+			++NumApplied;
+		}
+		else
+		{
+			++NumSkipped;
+		}
+	}
+
+	if (NumSkipped > 0)
+	{
+		OutError = FString::Printf(TEXT("%d edit(s) were skipped because their actors are not in %s"), NumSkipped, *World->GetName());
+	}
+
+	FAuditLogger::Get().LogOperation(FString::Printf(TEXT("Replay scene edit session %s"), *SessionId.ToString()), TEXT("Replay"),
+		FString::Printf(TEXT("%d edits applied to %s"), NumApplied, *World->GetName()), NumSkipped == 0, OutError);
+
+	if (NumApplied == 0)
+	{
+		Transaction.Cancel();
+	}
+	else if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	return NumApplied;
+}
+
+bool FSceneEditJournal::AppendToFile()
+{
+	if (FilePath.IsEmpty())
+	{
+		FilePath = FPaths::Combine(OutputDirectory, FString::Printf(TEXT("Session-%s-%s.scej"),
+			*FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *SessionId.ToString(EGuidFormats::Digits).Left(8)));
+		WrittenSize = 0;
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append));
+	if (!Writer)
+	{
+		UE_LOG(LogChatGPTEditor, Error, TEXT("Failed to open scene edit journal for writing: %s"), *FilePath);
+		return false;
+	}
+
+	if (WrittenSize == 0)
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		FGuid Session = SessionId;
+		*Writer << Magic << Version << Session;
+	}
+
+	Writer->Serialize(Data.GetData() + WrittenSize, Data.Num() - WrittenSize);
+	WrittenSize = Data.Num();
+	return Writer->Close();
+}
+
+bool FSceneEditJournal::SaveToFile(const FString& Path, FString& OutError) const
+{
+	TArray<uint8> Bytes;
+	Bytes.Reserve(Data.Num() + 64);
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	FGuid Session = SessionId;
+	Writer << Magic << Version << Session;
+
+	// Only complete batches; an open one is still changing
+	const int32 Length = IsRecording() ? BatchStart : Data.Num();
+	Writer.Serialize(const_cast<uint8*>(Data.GetData()), Length);
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		OutError = FString::Printf(TEXT("Could not write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FSceneEditJournal::LoadFromFile(const FString& Path, FString& OutError)
+{
+	check(!IsRecording());
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *Path);
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FGuid Session;
+	if (Bytes.Num() >= static_cast<int32>(sizeof(uint32) * 2 + sizeof(FGuid)))
+	{
+		Reader << Magic << Version << Session;
+	}
+	if (Magic != FileMagic)
+	{
+		OutError = FString::Printf(TEXT("%s is not a scene edit journal"), *Path);
+		return false;
+	}
+	if (Version != FileVersion)
+	{
+		// Version 1 spawn and destroy records have no state, so they can't be read as this version's
+		OutError = FString::Printf(TEXT("%s was written by %s version (%u)"), *Path, Version > FileVersion ? TEXT("a newer") : TEXT("an older"), Version);
+		return false;
+	}
+
+	Reset();
+	SessionId = Session;
+	Data.Append(Bytes.GetData() + Reader.Tell(), Bytes.Num() - Reader.Tell());
+
+	const int32 ValidSize = IndexRecords();
+	if (ValidSize < Data.Num())
+	{
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Scene edit journal %s ends in an incomplete batch; ignoring its last %d bytes"), *Path, Data.Num() - ValidSize);
+		Data.SetNum(ValidSize);
+	}
+
+	return true;
+}
+
+int32 FSceneEditJournal::IndexRecords()
+{
+	RecordOffsets.Reset();
+	NumBatches = 0;
+	TruncateTables(0, 0);
+
+	// Batches are appended whole and carry their length, so anything after the last complete one was cut short
+	int32 Offset = 0;
+	while (Data.Num() - Offset >= BatchHeaderSize && Data[Offset] == static_cast<uint8>(ESceneJournalOp::Batch))
+	{
+		uint32 BatchLength = 0;
+		FMemory::Memcpy(&BatchLength, Data.GetData() + Offset + sizeof(uint8), sizeof(uint32));
+		if (BatchLength < BatchHeaderSize || BatchLength > static_cast<uint32>(Data.Num() - Offset))
+			break;
+
+		const int32 BatchEnd = Offset + static_cast<int32>(BatchLength);
+		const int32 FirstRecord = RecordOffsets.Num();
+		const int32 FirstName = Names.Num();
+		const int32 FirstActor = ActorGuids.Num();
+
+		FMemoryReader Reader(Data);
+		Reader.Seek(Offset);
+		bool bValid = true;
+		while (Reader.Tell() < BatchEnd)
+		{
+			RecordOffsets.Add(static_cast<int32>(Reader.Tell()));
+
+			FRecord Record;
+			SerializeRecord(Reader, Record);
+			if (Reader.IsError() || Reader.Tell() > BatchEnd)
+			{
+				bValid = false;
+				break;
+			}
+
+			if (Record.Op == ESceneJournalOp::Name)
+			{
+				NameIds.Add(Record.Text, Names.Add(Record.Text));
+			}
+			else if (Record.Op == ESceneJournalOp::Actor)
+			{
+				ActorIds.Add(Record.Guid, ActorGuids.Add(Record.Guid));
+				ActorNames.Add(FName(*Record.Text));
+				Actors.AddDefaulted();
+			}
+		}
+
+		if (!bValid)
+		{
+			RecordOffsets.SetNum(FirstRecord);
+			TruncateTables(FirstName, FirstActor);
+			break;
+		}
+
+		++NumBatches;
+		Offset = BatchEnd;
+	}
+
+	return Offset;
+}
+
+void FSceneEditJournal::Reset()
+{
+	check(!IsRecording());
+
+	SessionId = FGuid::NewGuid();
+	FilePath.Reset();
+	WrittenSize = 0;
+	Data.Reset();
+	RecordOffsets.Reset();
+	NumBatches = 0;
+	TruncateTables(0, 0);
+}
+
+#undef LOCTEXT_NAMESPACE
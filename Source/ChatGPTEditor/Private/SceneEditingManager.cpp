@@ -3,8 +3,16 @@
 #include "SceneEditingManager.h"
 #include "ChatGPTEditor.h"
 #include "AuditLogger.h"
+#include "SceneActorIndex.h"
+#include "SceneCommandParser.h"
+#include "SceneEditJournal.h"
+#include "ScenePlacement.h"
+#include "ScenePropertyAccessor.h"
 #include "Engine/World.h"
 #include "Engine/StaticMeshActor.h"
+#include "Engine/StaticMesh.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Materials/MaterialInterface.h"
 #include "Engine/Light.h"
 #include "Engine/PointLight.h"
 #include "Engine/SpotLight.h"
@@ -12,8 +20,81 @@
 #include "Camera/CameraActor.h"
 #include "GameFramework/PlayerStart.h"
 #include "Engine/TriggerVolume.h"
+#include "Engine/Brush.h"
+#include "GameFramework/Volume.h"
 #include "EngineUtils.h"
 #include "Misc/MessageDialog.h"
+#include "LevelEditorViewport.h"
+#include "ScopedTransaction.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "AI/NavigationSystemBase.h"
+#include "Misc/Paths.h"
+
+#define LOCTEXT_NAMESPACE "SceneEditingManager"
+
+const FName FSceneEditingManager::InstancedActorTag(TEXT("ChatGPTEditor.Instances"));
+
+namespace
+{
+	/** Materials a component renders with, one per mesh slot */
+	TArray<UMaterialInterface*> GetComponentMaterials(const UStaticMeshComponent* Component)
+	{
+		TArray<UMaterialInterface*> Materials;
+		const int32 NumMaterials = Component->GetNumMaterials();
+		Materials.Reserve(NumMaterials);
+		for (int32 Index = 0; Index < NumMaterials; ++Index)
+		{
+			Materials.Add(Component->GetMaterial(Index));
+		}
+		return Materials;
+	}
+
+	/** Split "tag:Tree" style patterns into a lower-case key and a value */
+	bool SplitKeyedPattern(const FString& Pattern, FString& OutKey, FString& OutValue)
+	{
+		if (!Pattern.Split(TEXT(":"), &OutKey, &OutValue) || OutKey.Contains(TEXT(" ")))
+			return false;
+
+		OutKey = OutKey.ToLower();
+		OutValue.TrimStartAndEndInline();
+		return OutKey == TEXT("tag") || OutKey == TEXT("label") || OutKey == TEXT("folder");
+	}
+
+	/** Class selected by an actor type pattern; AActor for "all", null if the pattern names no type */
+	const UClass* GetPatternClass(const FString& LowerPattern)
+	{
+		if (LowerPattern.Contains(TEXT("light")))
+			return ALight::StaticClass();
+		else if (LowerPattern.Contains(TEXT("camera")))
+			return ACameraActor::StaticClass();
+		else if (LowerPattern.Contains(TEXT("trigger")))
+			return ATriggerVolume::StaticClass();
+		else if (LowerPattern.Contains(TEXT("prop")) || LowerPattern.Contains(TEXT("static mesh")))
+			return AStaticMeshActor::StaticClass();
+		else if (LowerPattern.Contains(TEXT("all")))
+			return AActor::StaticClass();
+
+		return nullptr;
+	}
+
+	/** Actors "all" never selects: PlayerStart and level geometry brushes. Volumes are brushes too, but stay selectable */
+	bool IsProtectedActor(const AActor* Actor)
+	{
+		return Actor->IsA<APlayerStart>() || (Actor->IsA<ABrush>() && !Actor->IsA<AVolume>());
+	}
+
+	/** Materials a mesh renders with when nothing is overridden */
+	TArray<UMaterialInterface*> GetMeshMaterials(const UStaticMesh* Mesh)
+	{
+		TArray<UMaterialInterface*> Materials;
+		for (const FStaticMaterial& StaticMaterial : Mesh->GetStaticMaterials())
+		{
+			Materials.Add(StaticMaterial.MaterialInterface);
+		}
+		return Materials;
+	}
+}
 
 FSceneEditingManager& FSceneEditingManager::Get()
 {
@@ -21,6 +102,10 @@ FSceneEditingManager& FSceneEditingManager::Get()
 	return Instance;
 }
 
+FSceneEditingManager::FSceneEditingManager() = default;
+
+FSceneEditingManager::~FSceneEditingManager() = default;
+
 TArray<FSceneEditAction> FSceneEditingManager::ParseCommand(const FString& Command)
 {
 	TArray<FSceneEditAction> Actions;
@@ -33,8 +118,6 @@ TArray<FSceneEditAction> FSceneEditingManager::ParseCommand(const FString& Comma
 		return Actions;
 	}
 	
-	FString LowerCommand = TrimmedCommand.ToLower();
-	
 	// Log command (truncate if too long to avoid log spam)
 	const int32 MaxLogLength = 100;
 	FString LogCommand = TrimmedCommand.Len() > MaxLogLength 
@@ -42,67 +125,12 @@ TArray<FSceneEditAction> FSceneEditingManager::ParseCommand(const FString& Comma
 		: TrimmedCommand;
 	UE_LOG(LogChatGPTEditor, Verbose, TEXT("Parsing scene edit command: %s"), *LogCommand);
 
-	// Parse spawn commands (add, spawn, place)
-	if (LowerCommand.Contains(TEXT("add")) || LowerCommand.Contains(TEXT("spawn")) || LowerCommand.Contains(TEXT("place")))
-	{
-		FSceneEditAction Action;
-		Action.Operation = ESceneEditOperation::SpawnActor;
-		Action.ActorClass = ParseActorType(Command);
-		Action.Count = ParseCount(Command);
-		Action.Description = Command;
-		
-		// Check for location-based placement
-		if (LowerCommand.Contains(TEXT("at playerstart")) || LowerCommand.Contains(TEXT("at player start")))
-		{
-			Action.Location = FVector::ZeroVector; // Will be resolved to PlayerStart location
-			Action.PropertyName = TEXT("AtPlayerStart");
-		}
-		
-		Actions.Add(Action);
-		UE_LOG(LogChatGPTEditor, Log, TEXT("Parsed spawn action: %s (count: %d)"), *Action.ActorClass, Action.Count);
-	}
-	// Parse delete commands (delete, remove)
-	else if (LowerCommand.Contains(TEXT("delete")) || LowerCommand.Contains(TEXT("remove")))
-	{
-		FSceneEditAction Action;
-		Action.Operation = ESceneEditOperation::DeleteActor;
-		Action.SearchPattern = ParseActorType(Command);
-		Action.Description = Command;
-		Actions.Add(Action);
-		UE_LOG(LogChatGPTEditor, Log, TEXT("Parsed delete action: %s"), *Action.SearchPattern);
-	}
-	// Parse move commands
-	else if (LowerCommand.Contains(TEXT("move")))
-	{
-		FSceneEditAction Action;
-		Action.Operation = ESceneEditOperation::MoveActor;
-		Action.SearchPattern = ParseActorType(Command);
-		Action.Location = ParseMovementOffset(Command);
-		Action.Description = Command;
-		Actions.Add(Action);
-		UE_LOG(LogChatGPTEditor, Log, TEXT("Parsed move action: %s to %s"), *Action.SearchPattern, *Action.Location.ToString());
-	}
-	// Parse property modification commands (change, set, modify)
-	else if (LowerCommand.Contains(TEXT("change")) || LowerCommand.Contains(TEXT("set")) || LowerCommand.Contains(TEXT("modify")))
-	{
-		FSceneEditAction Action;
-		Action.Operation = ESceneEditOperation::ModifyProperty;
-		Action.SearchPattern = ParseActorType(Command);
-		Action.Description = Command;
-		
-		// Parse property changes (e.g., "change light color to red")
-		if (LowerCommand.Contains(TEXT("color")))
-		{
-			Action.PropertyName = TEXT("Color");
-			if (LowerCommand.Contains(TEXT("red")))
-				Action.PropertyValue = TEXT("Red");
-			else if (LowerCommand.Contains(TEXT("blue")))
-				Action.PropertyValue = TEXT("Blue");
-			else if (LowerCommand.Contains(TEXT("green")))
-				Action.PropertyValue = TEXT("Green");
-		}
-		
-		Actions.Add(Action);
+	// One action per clause: "add 3 spot lights and move cameras up 200" gives a spawn and a move
+	FSceneCommandParser::Parse(TrimmedCommand, Actions);
+
+	for (const FSceneEditAction& Action : Actions)
+	{
+		UE_LOG(LogChatGPTEditor, Log, TEXT("Parsed scene edit action: %s"), *Action.Description);
 	}
 
 	return Actions;
@@ -116,50 +144,169 @@ bool FSceneEditingManager::ExecuteActions(const TArray<FSceneEditAction>& Action
 		return false;
 	}
 
-	// For each action, execute it
+	const FSceneEditPlan Plan = PlanActions(Actions, World);
+
+	// A dry run resolves everything but leaves the world untouched
+	if (bPreviewOnly)
+	{
+		for (const FSceneEditActionPlan& ActionPlan : Plan.Actions)
+		{
+			FAuditLogger::Get().LogOperation(ActionPlan.Action.Description, TEXT("Preview"),
+				FString::Printf(TEXT("%d actors affected"), ActionPlan.NumAffected()), true, ActionPlan.Warning);
+		}
+		return true;
+	}
+
+	return ExecutePlan(Plan);
+}
+
+FSceneEditPlan FSceneEditingManager::PlanActions(const TArray<FSceneEditAction>& Actions, UWorld* World)
+{
+	FSceneEditPlan Plan;
+	Plan.World = World;
+	Plan.Actions.Reserve(Actions.Num());
+
 	for (const FSceneEditAction& Action : Actions)
 	{
+		Plan.Actions.Add(PlanAction(Action, World));
+	}
+
+	return Plan;
+}
+
+FSceneEditActionPlan FSceneEditingManager::PlanAction(const FSceneEditAction& Action, UWorld* World)
+{
+	FSceneEditActionPlan Plan;
+	Plan.Action = Action;
+
+	if (!World)
+	{
+		Plan.Warning = TEXT("Invalid world");
+		return Plan;
+	}
+
+	switch (Action.Operation)
+	{
+		case ESceneEditOperation::SpawnActor:
+			PlanSpawn(Plan, World);
+			break;
+
+		case ESceneEditOperation::ConvertToInstances:
+			PlanConvert(Plan, World);
+			break;
+
+		default:
+			PlanTargets(Plan, World);
+			break;
+	}
+
+	return Plan;
+}
+
+bool FSceneEditingManager::ExecutePlan(const FSceneEditPlan& Plan)
+{
+	UWorld* World = Plan.World.Get();
+	if (!World)
+	{
+		FAuditLogger::Get().LogOperation(TEXT("Execute Actions"), TEXT("Error"), TEXT("None"), false, TEXT("Invalid world"));
+		return false;
+	}
+
+	// The whole batch is one undo step
+	const FText Description = Plan.Actions.Num() == 1
+		? FText::Format(LOCTEXT("SceneEditTransaction", "Scene Edit: {0}"), FText::FromString(Plan.Actions[0].Action.Description))
+		: FText::Format(LOCTEXT("SceneEditBatchTransaction", "Scene Edit: {0} Actions"), FText::AsNumber(Plan.Actions.Num()));
+	FScopedTransaction Transaction(Description);
+
+	// Navigation updates queue up while locked and are applied once when the lock goes out of scope
+	FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+
+	// The apply helpers record their deltas into the journal while the batch is open
+	FSceneEditJournal& EditJournal = GetJournal();
+	EditJournal.BeginBatch(Description.ToString());
+
+	int32 NumChanged = 0;
+
+	// For each planned action, apply what the preview showed
+	for (const FSceneEditActionPlan& ActionPlan : Plan.Actions)
+	{
+		const FSceneEditAction& Action = ActionPlan.Action;
 		FString AffectedActors;
+		FString OperationType;
 		bool bSuccess = false;
 
 		switch (Action.Operation)
 		{
 			case ESceneEditOperation::SpawnActor:
 			{
-				TArray<AActor*> SpawnedActors = SpawnActors(Action, World);
-				bSuccess = SpawnedActors.Num() > 0;
-				AffectedActors = FString::Printf(TEXT("%d actors spawned"), SpawnedActors.Num());
-				FAuditLogger::Get().LogOperation(Action.Description, TEXT("Spawn"), AffectedActors, bSuccess);
+				if (ActionPlan.bSpawnInstanced)
+				{
+					int32 NumInstances = 0;
+					AActor* InstancedActor = ApplySpawnInstances(ActionPlan, World, NumInstances);
+					bSuccess = InstancedActor && NumInstances > 0;
+					AffectedActors = FString::Printf(TEXT("%d instances added to %s"), NumInstances, InstancedActor ? *InstancedActor->GetName() : TEXT("None"));
+				}
+				else
+				{
+					TArray<AActor*> SpawnedActors = ApplySpawnActors(ActionPlan, World);
+					bSuccess = SpawnedActors.Num() > 0;
+					AffectedActors = FString::Printf(TEXT("%d actors spawned"), SpawnedActors.Num());
+				}
+				OperationType = TEXT("Spawn");
 				break;
 			}
 			
 			case ESceneEditOperation::DeleteActor:
 			{
-				TArray<FString> DeletedActors = DeleteActors(Action, World);
+				TArray<FString> DeletedActors = ApplyDelete(ActionPlan, World);
 				bSuccess = DeletedActors.Num() > 0;
 				AffectedActors = FString::Join(DeletedActors, TEXT(", "));
-				FAuditLogger::Get().LogOperation(Action.Description, TEXT("Delete"), AffectedActors, bSuccess);
+				OperationType = TEXT("Delete");
 				break;
 			}
 			
 			case ESceneEditOperation::MoveActor:
 			{
-				TArray<FString> MovedActors = MoveActors(Action, World);
+				TArray<FString> MovedActors = ApplyMove(ActionPlan, World);
 				bSuccess = MovedActors.Num() > 0;
 				AffectedActors = FString::Join(MovedActors, TEXT(", "));
-				FAuditLogger::Get().LogOperation(Action.Description, TEXT("Move"), AffectedActors, bSuccess);
+				OperationType = TEXT("Move");
 				break;
 			}
 			
 			case ESceneEditOperation::ModifyProperty:
 			{
-				TArray<FString> ModifiedActors = ModifyActorProperties(Action, World);
+				TArray<FString> ModifiedActors = ApplyModify(ActionPlan, World);
 				bSuccess = ModifiedActors.Num() > 0;
 				AffectedActors = FString::Join(ModifiedActors, TEXT(", "));
-				FAuditLogger::Get().LogOperation(Action.Description, TEXT("Modify"), AffectedActors, bSuccess);
+				OperationType = TEXT("Modify");
+				break;
+			}
+			
+			case ESceneEditOperation::ConvertToInstances:
+			{
+				TArray<FString> ConvertedActors = ApplyConvert(ActionPlan, World);
+				bSuccess = ConvertedActors.Num() > 0;
+				AffectedActors = FString::Join(ConvertedActors, TEXT(", "));
+				OperationType = TEXT("ConvertToInstances");
 				break;
 			}
 		}
+
+		FAuditLogger::Get().LogOperation(Action.Description, OperationType, AffectedActors, bSuccess, bSuccess ? FString() : ActionPlan.Warning);
+		NumChanged += bSuccess ? 1 : 0;
+	}
+
+	EditJournal.CommitBatch();
+
+	if (NumChanged == 0)
+	{
+		Transaction.Cancel();
+	}
+	else if (GEditor)
+	{
+		// One redraw for the batch; render state changes were already collected for the end of the frame
+		GEditor->RedrawLevelEditingViewports();
 	}
 
 	return true;
@@ -167,292 +314,815 @@ bool FSceneEditingManager::ExecuteActions(const TArray<FSceneEditAction>& Action
 
 TArray<AActor*> FSceneEditingManager::SpawnActors(const FSceneEditAction& Action, UWorld* World)
 {
-	TArray<AActor*> SpawnedActors;
+	if (!World)
+		return TArray<AActor*>();
+
+	return ApplySpawnActors(PlanAction(Action, World), World);
+}
+
+bool FSceneEditingManager::ShouldSpawnInstanced(const FSceneEditAction& Action) const
+{
+	if (Action.Operation != ESceneEditOperation::SpawnActor || Action.SpawnMode == ESceneSpawnMode::Actors)
+		return false;
+
+	// Only static meshes can be instanced
+	if (ResolveSpawnClass(Action.ActorClass) != AStaticMeshActor::StaticClass())
+		return false;
+
+	if (Action.SpawnMode == ESceneSpawnMode::Instanced)
+		return true;
+
+	// Without a named shape ordinary spawns get no mesh, so large ones mustn't quietly become cubes
+	return !Action.MeshPath.IsEmpty() && Action.Count >= AutoInstancingThreshold;
+}
+
+AActor* FSceneEditingManager::SpawnInstances(const FSceneEditAction& Action, UWorld* World, int32& OutNumInstances)
+{
+	OutNumInstances = 0;
 
 	if (!World)
-		return SpawnedActors;
+		return nullptr;
 
-	// Determine actor class to spawn
-	UClass* ActorClass = nullptr;
-	
-	if (Action.ActorClass.Contains(TEXT("light")))
-	{
-		if (Action.ActorClass.Contains(TEXT("point")))
-			ActorClass = APointLight::StaticClass();
-		else if (Action.ActorClass.Contains(TEXT("spot")))
-			ActorClass = ASpotLight::StaticClass();
-		else if (Action.ActorClass.Contains(TEXT("directional")))
-			ActorClass = ADirectionalLight::StaticClass();
-		else
-			ActorClass = APointLight::StaticClass(); // Default to point light
-	}
-	else if (Action.ActorClass.Contains(TEXT("camera")))
-	{
-		ActorClass = ACameraActor::StaticClass();
-	}
-	else
+	return ApplySpawnInstances(PlanAction(Action, World), World, OutNumInstances);
+}
+
+TArray<FString> FSceneEditingManager::ConvertActorsToInstances(const FSceneEditAction& Action, UWorld* World)
+{
+	if (!World)
+		return TArray<FString>();
+
+	return ApplyConvert(PlanAction(Action, World), World);
+}
+
+UHierarchicalInstancedStaticMeshComponent* FSceneEditingManager::FindOrCreateInstanceComponent(UWorld* World, UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials, bool* bOutCreated)
+{
+	if (bOutCreated)
 	{
-		// Default to static mesh actor
-		ActorClass = AStaticMeshActor::StaticClass();
+		*bOutCreated = false;
 	}
 
-	// Determine spawn location
-	FVector SpawnLocation = Action.Location;
-	if (Action.PropertyName == TEXT("AtPlayerStart"))
+	// Reuse an existing instanced actor so repeated spawns of one mesh stay a single draw batch
+	TArray<AActor*> InstancedActors;
+	GetActorIndex(World).FindByTag(InstancedActorTag, InstancedActors);
+	for (AActor* Actor : InstancedActors)
 	{
-		SpawnLocation = FindPlayerStartLocation(World);
+		UHierarchicalInstancedStaticMeshComponent* Component = Actor->FindComponentByClass<UHierarchicalInstancedStaticMeshComponent>();
+		if (Component && Component->GetStaticMesh() == Mesh && GetComponentMaterials(Component) == Materials)
+		{
+			return Component;
+		}
 	}
 
-	// Spawn the requested number of actors with spacing between them
-	static const float ActorSpacingDistance = 100.0f; // Units between spawned actors
-	for (int32 i = 0; i < Action.Count; ++i)
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = MakeUniqueObjectName(World->GetCurrentLevel(), AActor::StaticClass(), *FString::Printf(TEXT("%s_Instances"), *Mesh->GetName()));
+	SpawnParams.ObjectFlags |= RF_Transactional;
+
+	// Tagged before the spawn is broadcast, so the actor index files it under the tag straight away
+	SpawnParams.CustomPreSpawnInitalization = [](AActor* Actor)
 	{
-		FVector OffsetLocation = SpawnLocation + FVector(i * ActorSpacingDistance, 0.0f, 0.0f);
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Actor->Tags.Add(InstancedActorTag);
+	};
 
-		AActor* SpawnedActor = World->SpawnActor<AActor>(ActorClass, OffsetLocation, Action.Rotation, SpawnParams);
-		if (SpawnedActor)
+	AActor* InstancedActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!InstancedActor)
+		return nullptr;
+
+	InstancedActor->SetActorLabel(SpawnParams.Name.ToString());
+
+	// Hierarchical instancing so large sets get per-cluster culling and LOD
+	UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancedActor, TEXT("Instances"), RF_Transactional);
+	Component->SetMobility(EComponentMobility::Static);
+	Component->SetStaticMesh(Mesh);
+
+	const TArray<UMaterialInterface*> MeshMaterials = GetMeshMaterials(Mesh);
+	for (int32 Index = 0; Index < Materials.Num(); ++Index)
+	{
+		if (!MeshMaterials.IsValidIndex(Index) || MeshMaterials[Index] != Materials[Index])
 		{
-			SpawnedActors.Add(SpawnedActor);
+			Component->SetMaterial(Index, Materials[Index]);
 		}
 	}
 
-	return SpawnedActors;
+	InstancedActor->SetRootComponent(Component);
+	InstancedActor->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+
+	if (bOutCreated)
+	{
+		*bOutCreated = true;
+	}
+
+	return Component;
+}
+
+FVector FSceneEditingManager::ResolveSpawnLocation(const FSceneEditAction& Action, UWorld* World)
+{
+	if (Action.PropertyName == TEXT("AtPlayerStart"))
+		return FindPlayerStartLocation(World);
+
+	// "Add 5 lights here" places them in front of the viewport camera
+	FVector Center;
+	if (Action.Region.IsSet() && ResolveRegionCenter(Action.Region, World, Center))
+		return Center;
+
+	return Action.Location;
+}
+
+UClass* FSceneEditingManager::ResolveSpawnClass(const FString& ActorType) const
+{
+	if (ActorType.Contains(TEXT("light")))
+	{
+		if (ActorType.Contains(TEXT("point")))
+			return APointLight::StaticClass();
+		else if (ActorType.Contains(TEXT("spot")))
+			return ASpotLight::StaticClass();
+		else if (ActorType.Contains(TEXT("directional")))
+			return ADirectionalLight::StaticClass();
+		else
+			return APointLight::StaticClass(); // Default to point light
+	}
+	else if (ActorType.Contains(TEXT("camera")))
+	{
+		return ACameraActor::StaticClass();
+	}
+
+	// Default to static mesh actor
+	return AStaticMeshActor::StaticClass();
+}
+
+UStaticMesh* FSceneEditingManager::ResolveSpawnMesh(const FSceneEditAction& Action) const
+{
+	return Action.MeshPath.IsEmpty() ? nullptr : LoadObject<UStaticMesh>(nullptr, *Action.MeshPath);
 }
 
 TArray<FString> FSceneEditingManager::DeleteActors(const FSceneEditAction& Action, UWorld* World)
 {
-	TArray<FString> DeletedActorNames;
+	if (!World)
+		return TArray<FString>();
+
+	return ApplyDelete(PlanAction(Action, World), World);
+}
+
+TArray<FString> FSceneEditingManager::MoveActors(const FSceneEditAction& Action, UWorld* World)
+{
+	if (!World)
+		return TArray<FString>();
+
+	return ApplyMove(PlanAction(Action, World), World);
+}
+
+TArray<FString> FSceneEditingManager::ModifyActorProperties(const FSceneEditAction& Action, UWorld* World)
+{
+	if (!World)
+		return TArray<FString>();
+
+	return ApplyModify(PlanAction(Action, World), World);
+}
+
+TArray<AActor*> FSceneEditingManager::FindActorsByPattern(const FString& Pattern, UWorld* World)
+{
+	TArray<AActor*> MatchingActors;
 
 	if (!World)
-		return DeletedActorNames;
+		return MatchingActors;
 
-	TArray<AActor*> ActorsToDelete = FindActorsByPattern(Action.SearchPattern, World);
+	FSceneActorIndex& Index = GetActorIndex(World);
 
-	for (AActor* Actor : ActorsToDelete)
+	// Search by tag, label or outliner folder
+	FString Key;
+	FString Value;
+	if (SplitKeyedPattern(Pattern, Key, Value))
 	{
-		if (IsValid(Actor))
+		if (Key == TEXT("tag"))
+			Index.FindByTag(FName(*Value), MatchingActors);
+		else if (Key == TEXT("label"))
+			Index.FindByLabel(Value, MatchingActors);
+		else if (Key == TEXT("folder"))
+			Index.FindByFolder(FName(*Value), MatchingActors);
+
+		return MatchingActors;
+	}
+
+	// Search by actor type
+	const UClass* PatternClass = GetPatternClass(Pattern.ToLower());
+	if (PatternClass == AActor::StaticClass())
+	{
+		// Return all actors except critical ones
+		Index.GetAllActors(MatchingActors);
+		MatchingActors.RemoveAllSwap([](const AActor* Actor) { return IsProtectedActor(Actor); });
+	}
+	else if (PatternClass)
+	{
+		Index.FindByClass(PatternClass, MatchingActors);
+	}
+
+	return MatchingActors;
+}
+
+bool FSceneEditingManager::MatchesPattern(const AActor* Actor, const FString& Pattern) const
+{
+	if (!IsValid(Actor))
+		return false;
+
+	FString Key;
+	FString Value;
+	if (SplitKeyedPattern(Pattern, Key, Value))
+	{
+		if (Key == TEXT("tag"))
+			return Actor->ActorHasTag(FName(*Value));
+		else if (Key == TEXT("label"))
+			return Actor->GetActorLabel().Equals(Value, ESearchCase::IgnoreCase);
+		else if (Key == TEXT("folder"))
 		{
-			FString ActorName = Actor->GetName();
-			World->DestroyActor(Actor);
-			DeletedActorNames.Add(ActorName);
+			const FString Folder = Actor->GetFolderPath().ToString();
+			return Folder.Equals(Value, ESearchCase::IgnoreCase) || Folder.StartsWith(Value + TEXT("/"), ESearchCase::IgnoreCase);
 		}
+		return false;
 	}
 
-	return DeletedActorNames;
+	const UClass* PatternClass = GetPatternClass(Pattern.ToLower());
+	if (PatternClass == AActor::StaticClass())
+		return !IsProtectedActor(Actor);
+
+	return PatternClass && Actor->IsA(PatternClass);
 }
 
-TArray<FString> FSceneEditingManager::MoveActors(const FSceneEditAction& Action, UWorld* World)
+TArray<AActor*> FSceneEditingManager::FindActorsForAction(const FSceneEditAction& Action, UWorld* World)
 {
-	TArray<FString> MovedActorNames;
+	if (!Action.Region.IsSet())
+		return FindActorsByPattern(Action.SearchPattern, World);
 
+	TArray<AActor*> MatchingActors;
+
+	FVector Center;
+	if (!World || !ResolveRegionCenter(Action.Region, World, Center))
+		return MatchingActors;
+
+	// Spatial query first: a region holds far fewer actors than a type does on a large level
+	GetActorIndex(World).FindInSphere(Center, Action.Region.Radius, MatchingActors);
+	MatchingActors.RemoveAllSwap([this, &Action](const AActor* Actor) { return !MatchesPattern(Actor, Action.SearchPattern); });
+
+	return MatchingActors;
+}
+
+bool FSceneEditingManager::ResolveRegionCenter(const FSceneEditRegion& Region, UWorld* World, FVector& OutCenter)
+{
+	switch (Region.Anchor)
+	{
+		case ESceneLocationAnchor::Explicit:
+			OutCenter = Region.Location;
+			return true;
+
+		case ESceneLocationAnchor::PlayerStart:
+			OutCenter = FindPlayerStartLocation(World);
+			return true;
+
+		case ESceneLocationAnchor::ViewportCamera:
+			if (GCurrentLevelEditingViewportClient)
+			{
+				OutCenter = GCurrentLevelEditingViewportClient->GetViewLocation();
+				return true;
+			}
+			UE_LOG(LogChatGPTEditor, Warning, TEXT("No active level viewport to resolve a camera-relative region"));
+			return false;
+
+		default:
+			return false;
+	}
+}
+
+FSceneActorIndex& FSceneEditingManager::GetActorIndex(UWorld* World)
+{
+	check(IsInGameThread());
+
+	// The index follows whichever world scene edits target; a destroyed world reads back as null
+	if (!ActorIndex.IsValid() || ActorIndex->GetWorld() != World)
+	{
+		ActorIndex = MakeUnique<FSceneActorIndex>(World);
+	}
+
+	return *ActorIndex;
+}
+
+FSceneEditJournal& FSceneEditingManager::GetJournal()
+{
+	check(IsInGameThread());
+
+	if (!Journal.IsValid())
+	{
+		Journal = MakeUnique<FSceneEditJournal>();
+		Journal->SetOutputDirectory(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ChatGPTEditor"), TEXT("Journal")));
+	}
+
+	return *Journal;
+}
+
+void FSceneEditingManager::Shutdown()
+{
+	ActorIndex.Reset();
+	Journal.Reset();
+}
+
+FVector FSceneEditingManager::FindPlayerStartLocation(UWorld* World)
+{
 	if (!World)
-		return MovedActorNames;
+		return FVector::ZeroVector;
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		return It->GetActorLocation();
+	}
+
+	// If no PlayerStart found, return origin
+	return FVector::ZeroVector;
+}
+
+void FSceneEditingManager::PlanSpawn(FSceneEditActionPlan& Plan, UWorld* World)
+{
+	const FSceneEditAction& Action = Plan.Action;
 
-	TArray<AActor*> ActorsToMove = FindActorsByPattern(Action.SearchPattern, World);
-	FVector Offset = Action.Location;
+	Plan.SpawnClass = ResolveSpawnClass(Action.ActorClass);
+	Plan.bSpawnInstanced = ShouldSpawnInstanced(Action);
 
-	for (AActor* Actor : ActorsToMove)
+	// Instances always need a mesh; actors only take one when a shape was named
+	if (Plan.bSpawnInstanced && Action.MeshPath.IsEmpty())
 	{
-		if (Actor)
+		Plan.Warning = TEXT("Instanced spawns need a mesh; name a shape such as cube or sphere");
+		return;
+	}
+	if (!Action.MeshPath.IsEmpty())
+	{
+		Plan.SpawnMesh = ResolveSpawnMesh(Action);
+		if (!Plan.SpawnMesh.IsValid())
 		{
-			FVector NewLocation = Actor->GetActorLocation() + Offset;
-			Actor->SetActorLocation(NewLocation);
-			MovedActorNames.Add(Actor->GetName());
+			Plan.Warning = FString::Printf(TEXT("Could not load mesh '%s'"), *Action.MeshPath);
 		}
 	}
 
-	return MovedActorNames;
+	// Items are laid out by the action's pattern, the same for actors and instances
+	FScenePlacement::MakeTransforms(World, Action.Placement, ResolveSpawnLocation(Action, World), Action.Rotation, Action.Count, Plan.SpawnTransforms);
+	if (Plan.SpawnTransforms.Num() < Action.Count && Plan.Warning.IsEmpty())
+	{
+		Plan.Warning = FString::Printf(TEXT("Only %d of %d items fit at this spacing"), Plan.SpawnTransforms.Num(), Action.Count);
+	}
 }
 
-TArray<FString> FSceneEditingManager::ModifyActorProperties(const FSceneEditAction& Action, UWorld* World)
+void FSceneEditingManager::PlanTargets(FSceneEditActionPlan& Plan, UWorld* World)
 {
-	TArray<FString> ModifiedActorNames;
+	const FSceneEditAction& Action = Plan.Action;
 
-	if (!World)
-		return ModifiedActorNames;
+	FVector Center;
+	if (Action.Region.IsSet() && !ResolveRegionCenter(Action.Region, World, Center))
+	{
+		Plan.Warning = TEXT("The region's anchor is not available, so no actors were selected");
+		return;
+	}
+
+	// Property changes name a path and a value in Unreal text format; "Color" is shorthand for a light's color
+	const bool bModify = Action.Operation == ESceneEditOperation::ModifyProperty;
+	FString PropertyPath = Action.PropertyName;
+	FString ValueText = Action.PropertyValue;
+	if (bModify && Action.PropertyName == TEXT("Color"))
+	{
+		// Unknown or missing colors reset to white
+		FSceneCommandParser::FindNamedColor(Action.PropertyValue, Plan.Color);
+		PropertyPath = TEXT("LightComponent.LightColor");
+		ValueText = Plan.Color.ToFColor(true).ToString();
+	}
 
-	TArray<AActor*> ActorsToModify = FindActorsByPattern(Action.SearchPattern, World);
+	// The value is parsed once per distinct property, not once per actor
+	const FProperty* NormalizedProperty = nullptr;
+	FString NewValue;
+	FString PropertyError;
+	int32 NumWithoutProperty = 0;
 
-	for (AActor* Actor : ActorsToModify)
+	for (AActor* Actor : FindActorsForAction(Action, World))
 	{
-		if (Actor)
+		if (!IsValid(Actor))
+			continue;
+
+		FSceneEditActorChange Change;
+		Change.Actor = Actor;
+		Change.ActorName = Actor->GetName();
+		Change.OldTransform = Actor->GetActorTransform();
+		Change.NewTransform = Change.OldTransform;
+
+		if (Action.Operation == ESceneEditOperation::MoveActor)
 		{
-			// Handle color changes for lights
-			if (Action.PropertyName == TEXT("Color"))
+			Change.NewTransform.AddToTranslation(Action.Location);
+		}
+		else if (bModify)
+		{
+			// Actors without the property are left out of the plan
+			TSharedPtr<const FScenePropertyAccessor> Accessor = FScenePropertyAccessor::Find(Actor->GetClass(), PropertyPath, PropertyError);
+			if (!Accessor.IsValid() || !Accessor->GetValueText(Actor, Change.OldValue))
+			{
+				++NumWithoutProperty;
+				continue;
+			}
+
+			if (Accessor->GetProperty() != NormalizedProperty)
 			{
-				if (ALight* Light = Cast<ALight>(Actor))
+				if (!Accessor->NormalizeValueText(ValueText, NewValue))
 				{
-					FLinearColor NewColor = FLinearColor::White;
-					
-					if (Action.PropertyValue == TEXT("Red"))
-						NewColor = FLinearColor::Red;
-					else if (Action.PropertyValue == TEXT("Blue"))
-						NewColor = FLinearColor::Blue;
-					else if (Action.PropertyValue == TEXT("Green"))
-						NewColor = FLinearColor::Green;
-					
-					Light->SetLightColor(NewColor);
-					ModifiedActorNames.Add(Actor->GetName());
+					Plan.Changes.Reset();
+					Plan.Warning = FString::Printf(TEXT("'%s' is not a valid value for %s"), *ValueText, *PropertyPath);
+					return;
 				}
+				NormalizedProperty = Accessor->GetProperty();
 			}
+
+			// Writing the same value again would only cost a component re-register; FString == ignores case, which would skip renames like "lamp" to "Lamp"
+			if (Change.OldValue.Equals(NewValue, ESearchCase::CaseSensitive))
+				continue;
+
+			Change.NewValue = NewValue;
 		}
+
+		Plan.Changes.Add(MoveTemp(Change));
 	}
 
-	return ModifiedActorNames;
+	if (NumWithoutProperty > 0)
+	{
+		Plan.Warning = Plan.Changes.Num() > 0
+			? FString::Printf(TEXT("%d matching actor(s) have no editable %s"), NumWithoutProperty, *PropertyPath)
+			: PropertyError;
+	}
 }
 
-TArray<AActor*> FSceneEditingManager::FindActorsByPattern(const FString& Pattern, UWorld* World)
+void FSceneEditingManager::PlanConvert(FSceneEditActionPlan& Plan, UWorld* World)
 {
-	TArray<AActor*> MatchingActors;
+	// Group convertible actors by what they render; each group becomes one set of instances
+	struct FInstanceGroup
+	{
+		UStaticMesh* Mesh = nullptr;
+		TArray<UMaterialInterface*> Materials;
+		TArray<AStaticMeshActor*> Actors;
+	};
+	TMap<FString, FInstanceGroup> Groups;
 
-	if (!World)
-		return MatchingActors;
+	for (AActor* Actor : FindActorsForAction(Plan.Action, World))
+	{
+		AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+		if (!IsValid(MeshActor) || MeshActor->ActorHasTag(InstancedActorTag))
+			continue;
 
-	FString LowerPattern = Pattern.ToLower();
+		// Actors that are attached or carry extra components would lose something as instances
+		UStaticMeshComponent* MeshComponent = MeshActor->GetStaticMeshComponent();
+		if (!MeshComponent || !MeshComponent->GetStaticMesh() || MeshActor->GetAttachParentActor() || MeshActor->GetInstanceComponents().Num() > 0)
+			continue;
 
-	// Search by actor type
-	if (LowerPattern.Contains(TEXT("light")))
-	{
-		for (TActorIterator<ALight> It(World); It; ++It)
+		TArray<AActor*> AttachedActors;
+		MeshActor->GetAttachedActors(AttachedActors);
+		if (AttachedActors.Num() > 0)
+			continue;
+
+		TArray<UMaterialInterface*> Materials = GetComponentMaterials(MeshComponent);
+		FString GroupKey = MeshComponent->GetStaticMesh()->GetPathName();
+		for (const UMaterialInterface* Material : Materials)
 		{
-			MatchingActors.Add(*It);
+			GroupKey += TEXT("|");
+			GroupKey += Material ? Material->GetPathName() : TEXT("None");
 		}
-	}
-	else if (LowerPattern.Contains(TEXT("camera")))
-	{
-		for (TActorIterator<ACameraActor> It(World); It; ++It)
+
+		FInstanceGroup& Group = Groups.FindOrAdd(GroupKey);
+		if (!Group.Mesh)
 		{
-			MatchingActors.Add(*It);
+			Group.Mesh = MeshComponent->GetStaticMesh();
+			Group.Materials = MoveTemp(Materials);
 		}
+		Group.Actors.Add(MeshActor);
 	}
-	else if (LowerPattern.Contains(TEXT("trigger")))
+
+	for (const TPair<FString, FInstanceGroup>& Pair : Groups)
 	{
-		for (TActorIterator<ATriggerVolume> It(World); It; ++It)
+		const FInstanceGroup& Group = Pair.Value;
+		if (Group.Actors.Num() < MinActorsToConvert)
+			continue;
+
+		FSceneEditInstanceGroup& PlannedGroup = Plan.InstanceGroups.AddDefaulted_GetRef();
+		PlannedGroup.Mesh = Group.Mesh;
+		PlannedGroup.Materials.Append(Group.Materials);
+
+		// Instances take the transform the mesh renders at, which includes the component's offset
+		for (AStaticMeshActor* MeshActor : Group.Actors)
 		{
-			MatchingActors.Add(*It);
+			FSceneEditActorChange Change;
+			Change.Actor = MeshActor;
+			Change.ActorName = MeshActor->GetName();
+			Change.OldTransform = MeshActor->GetStaticMeshComponent()->GetComponentTransform();
+			Change.NewTransform = Change.OldTransform;
+			PlannedGroup.ChangeIndices.Add(Plan.Changes.Add(MoveTemp(Change)));
 		}
 	}
-	else if (LowerPattern.Contains(TEXT("prop")) || LowerPattern.Contains(TEXT("static mesh")))
+}
+
+TArray<AActor*> FSceneEditingManager::ApplySpawnActors(const FSceneEditActionPlan& Plan, UWorld* World)
+{
+	TArray<AActor*> SpawnedActors;
+
+	// The plan's class and mesh are weak; look them up again if they were collected since
+	UClass* ActorClass = Plan.SpawnClass.IsValid() ? Plan.SpawnClass.Get() : ResolveSpawnClass(Plan.Action.ActorClass);
+	UStaticMesh* Mesh = Plan.SpawnMesh.Get();
+	if (!Mesh && !Plan.Action.MeshPath.IsEmpty())
 	{
-		for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
-		{
-			MatchingActors.Add(*It);
-		}
+		Mesh = ResolveSpawnMesh(Plan.Action);
 	}
-	else if (LowerPattern.Contains(TEXT("all")))
+
+	if (Plan.SpawnTransforms.Num() > 0 && World->GetCurrentLevel())
 	{
-		// Return all actors except critical ones
-		for (TActorIterator<AActor> It(World); It; ++It)
+		World->GetCurrentLevel()->Modify();
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transactional;
+
+	for (const FTransform& Transform : Plan.SpawnTransforms)
+	{
+		AActor* SpawnedActor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+		if (SpawnedActor)
 		{
-			AActor* Actor = *It;
-			// Skip PlayerStart and other critical actors
-			if (!Actor->IsA<APlayerStart>() && !Actor->GetName().Contains(TEXT("Brush")))
+			AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(SpawnedActor);
+			if (MeshActor && Mesh)
 			{
-				MatchingActors.Add(Actor);
+				MeshActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
 			}
+			GetJournal().RecordSpawn(SpawnedActor);
+			SpawnedActors.Add(SpawnedActor);
 		}
 	}
 
-	return MatchingActors;
+	return SpawnedActors;
 }
 
-FVector FSceneEditingManager::FindPlayerStartLocation(UWorld* World)
+AActor* FSceneEditingManager::ApplySpawnInstances(const FSceneEditActionPlan& Plan, UWorld* World, int32& OutNumInstances)
 {
-	if (!World)
-		return FVector::ZeroVector;
+	OutNumInstances = 0;
 
-	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	if (Plan.SpawnTransforms.Num() == 0)
+		return nullptr;
+
+	UStaticMesh* Mesh = Plan.SpawnMesh.IsValid() ? Plan.SpawnMesh.Get() : ResolveSpawnMesh(Plan.Action);
+	if (!Mesh)
 	{
-		return It->GetActorLocation();
+		UE_LOG(LogChatGPTEditor, Warning, TEXT("Could not load mesh '%s' for instanced spawn"), *Plan.Action.MeshPath);
+		return nullptr;
 	}
 
-	// If no PlayerStart found, return origin
-	return FVector::ZeroVector;
+	const TArray<UMaterialInterface*> Materials = GetMeshMaterials(Mesh);
+	bool bCreatedHolder = false;
+	UHierarchicalInstancedStaticMeshComponent* Component = FindOrCreateInstanceComponent(World, Mesh, Materials, &bCreatedHolder);
+	if (!Component)
+		return nullptr;
+
+	GetJournal().RecordAddInstances(Component->GetOwner(), Mesh, Materials, Component->GetInstanceCount(), Plan.SpawnTransforms, bCreatedHolder);
+	Component->Modify();
+	Component->AddInstances(Plan.SpawnTransforms, false, true);
+	OutNumInstances = Plan.SpawnTransforms.Num();
+
+	return Component->GetOwner();
 }
 
-FString FSceneEditingManager::ParseActorType(const FString& Command)
+TArray<FString> FSceneEditingManager::ApplyDelete(const FSceneEditActionPlan& Plan, UWorld* World)
 {
-	FString LowerCommand = Command.ToLower();
+	TArray<FString> DeletedActorNames;
+	TArray<AActor*> ActorsToDelete;
+	ActorsToDelete.Reserve(Plan.Changes.Num());
 
-	if (LowerCommand.Contains(TEXT("point light")))
-		return TEXT("point light");
-	else if (LowerCommand.Contains(TEXT("spot light")))
-		return TEXT("spot light");
-	else if (LowerCommand.Contains(TEXT("directional light")))
-		return TEXT("directional light");
-	else if (LowerCommand.Contains(TEXT("light")))
-		return TEXT("light");
-	else if (LowerCommand.Contains(TEXT("camera")))
-		return TEXT("camera");
-	else if (LowerCommand.Contains(TEXT("trigger")))
-		return TEXT("trigger");
-	else if (LowerCommand.Contains(TEXT("prop")))
-		return TEXT("prop");
-	else if (LowerCommand.Contains(TEXT("static mesh")))
-		return TEXT("static mesh");
+	for (const FSceneEditActorChange& Change : Plan.Changes)
+	{
+		AActor* Actor = Change.Actor.Get();
+		if (IsValid(Actor))
+		{
+			ActorsToDelete.Add(Actor);
+			DeletedActorNames.Add(Change.ActorName);
+		}
+	}
 
-	return TEXT("actor");
+	DestroyActorsInBulk(World, ActorsToDelete);
+	return DeletedActorNames;
 }
 
-int32 FSceneEditingManager::ParseCount(const FString& Command)
+int32 FSceneEditingManager::DestroyActorsInBulk(UWorld* World, const TArray<AActor*>& Actors)
 {
-	// Look for numbers in the command
-	static const int32 MaxParsableCount = 100; // Maximum count we'll try to parse
-	
-	for (int32 i = 1; i <= MaxParsableCount; ++i)
+	// Deselect in one batch, so the editor sees one selection change rather than one per actor
+	USelection* Selection = GEditor ? GEditor->GetSelectedActors() : nullptr;
+	if (Selection)
+	{
+		bool bSelectionChanged = false;
+		Selection->BeginBatchSelectOperation();
+		for (AActor* Actor : Actors)
+		{
+			if (Selection->IsSelected(Actor))
+			{
+				Selection->Deselect(Actor);
+				bSelectionChanged = true;
+			}
+		}
+		Selection->EndBatchSelectOperation(false);
+
+		if (bSelectionChanged)
+		{
+			GEditor->NoteSelectionChange();
+		}
+	}
+
+	// Each level goes into the transaction once instead of once per actor
+	TSet<ULevel*> ModifiedLevels;
+	int32 NumDestroyed = 0;
+	for (AActor* Actor : Actors)
 	{
-		if (Command.Contains(FString::FromInt(i)))
-			return i;
+		if (!IsValid(Actor))
+			continue;
+
+		ULevel* Level = Actor->GetLevel();
+		if (Level && !ModifiedLevels.Contains(Level))
+		{
+			Level->Modify();
+			ModifiedLevels.Add(Level);
+		}
+
+		GetJournal().RecordDestroy(Actor);
+		Actor->Modify();
+		if (World->EditorDestroyActor(Actor, false))
+		{
+			++NumDestroyed;
+		}
 	}
 
-	return 1; // Default to 1 if no count specified
+	return NumDestroyed;
 }
 
-FVector FSceneEditingManager::ParseLocation(const FString& Command, UWorld* World)
+TArray<FString> FSceneEditingManager::ApplyMove(const FSceneEditActionPlan& Plan, UWorld* World)
 {
-	// For now, return zero vector - could be extended to parse coordinates
-	return FVector::ZeroVector;
+	TArray<FString> MovedActorNames;
+	TArray<AActor*> MovedActors;
+	MovedActors.Reserve(Plan.Changes.Num());
+	FSceneActorIndex& Index = GetActorIndex(World);
+	FSceneEditJournal& EditJournal = GetJournal();
+
+	// Teleport to the planned locations; no sweeps, since the preview already showed where things go
+	for (const FSceneEditActorChange& Change : Plan.Changes)
+	{
+		AActor* Actor = Change.Actor.Get();
+		if (IsValid(Actor))
+		{
+			const FTransform OldTransform = Actor->GetActorTransform();
+			Actor->Modify();
+			Actor->SetActorLocation(Change.NewTransform.GetLocation(), false, nullptr, ETeleportType::TeleportPhysics);
+			EditJournal.RecordTransform(Actor, OldTransform, Actor->GetActorTransform());
+			Index.UpdateBounds(Actor);
+			MovedActors.Add(Actor);
+			MovedActorNames.Add(Change.ActorName);
+		}
+	}
+
+	// Finish the moves once every transform is final; lighting is invalidated per actor, navigation once under the batch's lock
+	for (AActor* Actor : MovedActors)
+	{
+		Actor->PostEditMove(true);
+	}
+
+	return MovedActorNames;
 }
 
-FVector FSceneEditingManager::ParseMovementOffset(const FString& Command)
+TArray<FString> FSceneEditingManager::ApplyModify(const FSceneEditActionPlan& Plan, UWorld* World)
 {
-	FString LowerCommand = Command.ToLower();
-	FVector Offset = FVector::ZeroVector;
+	TArray<FString> ModifiedActorNames;
+	const FString PropertyPath = Plan.Action.PropertyName == TEXT("Color") ? FString(TEXT("LightComponent.LightColor")) : Plan.Action.PropertyName;
+
+	struct FPropertyWrite
+	{
+		TSharedPtr<const FScenePropertyAccessor> Accessor;
+		UObject* Owner = nullptr;
+		void* Value = nullptr;
+		const FSceneEditActorChange* Change = nullptr;
+	};
 
-	// Maximum units we'll try to parse from natural language
-	static const int32 MaxParsableUnits = 1000;
-	static const float DefaultMovementOffset = 100.0f; // Default units when no number specified
+	// Resolve every target first; accessors come from the cache, one per class
+	TArray<FPropertyWrite> Writes;
+	Writes.Reserve(Plan.Changes.Num());
+	for (const FSceneEditActorChange& Change : Plan.Changes)
+	{
+		AActor* Actor = Change.Actor.Get();
+		if (!IsValid(Actor))
+			continue;
+
+		FString Error;
+		FPropertyWrite Write;
+		Write.Accessor = FScenePropertyAccessor::Find(Actor->GetClass(), PropertyPath, Error);
+		if (Write.Accessor.IsValid() && Write.Accessor->Resolve(Actor, Write.Owner, Write.Value))
+		{
+			Write.Change = &Change;
+			Writes.Add(MoveTemp(Write));
+		}
+	}
+
+	// One PreEditChange per object, then every write, then one PostEditChangeProperty per object that sees the whole batch
+	for (const FPropertyWrite& Write : Writes)
+	{
+		Write.Owner->Modify();
+		Write.Owner->PreEditChange(Write.Accessor->GetMemberProperty());
+	}
+
+	// The journal keeps the exact text before and after, which only costs the exports while a batch is recording
+	FSceneEditJournal& EditJournal = GetJournal();
+	const bool bRecording = EditJournal.IsRecording();
+	FString OldText;
+	FString NewText;
 
-	// Parse movement directions
-	if (LowerCommand.Contains(TEXT("up")))
+	TArray<const UObject*> ChangedObjects;
+	ChangedObjects.Reserve(Writes.Num());
+	for (const FPropertyWrite& Write : Writes)
 	{
-		// Look for units
-		for (int32 i = 1; i <= MaxParsableUnits; ++i)
+		const FProperty* Property = Write.Accessor->GetProperty();
+		if (bRecording)
+		{
+			OldText.Reset();
+			Property->ExportTextItem_Direct(OldText, Write.Value, nullptr, Write.Owner, PPF_None);
+		}
+
+		if (Property->ImportText_Direct(*Write.Change->NewValue, Write.Value, Write.Owner, PPF_None))
 		{
-			if (Command.Contains(FString::FromInt(i)))
+			ModifiedActorNames.Add(Write.Change->ActorName);
+
+			if (bRecording)
 			{
-				Offset.Z = i;
-				break;
+				NewText.Reset();
+				Property->ExportTextItem_Direct(NewText, Write.Value, nullptr, Write.Owner, PPF_None);
+				EditJournal.RecordProperty(Write.Change->Actor.Get(), Write.Accessor->GetPath(), OldText, NewText);
 			}
 		}
-		if (Offset.Z == 0)
-			Offset.Z = DefaultMovementOffset;
+		ChangedObjects.Add(Write.Owner);
+	}
+
+	for (int32 Index = 0; Index < Writes.Num(); ++Index)
+	{
+		const FPropertyWrite& Write = Writes[Index];
+		FPropertyChangedEvent Event(Write.Accessor->GetProperty(), EPropertyChangeType::ValueSet, ChangedObjects);
+		Event.SetActiveMemberProperty(Write.Accessor->GetMemberProperty());
+		Event.ObjectIteratorIndex = Index;
+		Write.Owner->PostEditChangeProperty(Event);
 	}
-	else if (LowerCommand.Contains(TEXT("down")))
+
+	return ModifiedActorNames;
+}
+
+TArray<FString> FSceneEditingManager::ApplyConvert(const FSceneEditActionPlan& Plan, UWorld* World)
+{
+	TArray<FString> ConvertedActorNames;
+
+	for (const FSceneEditInstanceGroup& Group : Plan.InstanceGroups)
 	{
-		for (int32 i = 1; i <= MaxParsableUnits; ++i)
+		UStaticMesh* Mesh = Group.Mesh.Get();
+		if (!Mesh)
+			continue;
+
+		TArray<UMaterialInterface*> Materials;
+		Materials.Reserve(Group.Materials.Num());
+		for (const TWeakObjectPtr<UMaterialInterface>& Material : Group.Materials)
 		{
-			if (Command.Contains(FString::FromInt(i)))
+			Materials.Add(Material.Get());
+		}
+
+		// Actors deleted since the preview are left out; the rest still have to make a group
+		TArray<AActor*> Actors;
+		TArray<FTransform> Transforms;
+		for (int32 ChangeIndex : Group.ChangeIndices)
+		{
+			const FSceneEditActorChange& Change = Plan.Changes[ChangeIndex];
+			AActor* Actor = Change.Actor.Get();
+			if (IsValid(Actor))
 			{
-				Offset.Z = -i;
-				break;
+				Actors.Add(Actor);
+				Transforms.Add(Change.OldTransform);
 			}
 		}
-		if (Offset.Z == 0)
-			Offset.Z = -DefaultMovementOffset;
+
+		if (Actors.Num() < MinActorsToConvert)
+			continue;
+
+		bool bCreatedHolder = false;
+		UHierarchicalInstancedStaticMeshComponent* Component = FindOrCreateInstanceComponent(World, Mesh, Materials, &bCreatedHolder);
+		if (!Component)
+			continue;
+
+		GetJournal().RecordAddInstances(Component->GetOwner(), Mesh, Materials, Component->GetInstanceCount(), Transforms, bCreatedHolder);
+		Component->Modify();
+		Component->AddInstances(Transforms, false, true);
+
+		for (AActor* Actor : Actors)
+		{
+			ConvertedActorNames.Add(Actor->GetName());
+		}
+		DestroyActorsInBulk(World, Actors);
+
+		UE_LOG(LogChatGPTEditor, Log, TEXT("Converted %d actors using %s to instances on %s"),
+			Actors.Num(), *Mesh->GetName(), *Component->GetOwner()->GetName());
 	}
 
-	return Offset;
+	return ConvertedActorNames;
 }
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,398 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ScenePlacement.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	struct FPatternName
+	{
+		const TCHAR* Name;
+		EScenePlacementPattern Pattern;
+	};
+
+	const FPatternName PatternNames[] =
+	{
+		{ TEXT("row"), EScenePlacementPattern::Row },
+		{ TEXT("grid"), EScenePlacementPattern::Grid },
+		{ TEXT("ring"), EScenePlacementPattern::Ring },
+		{ TEXT("spline"), EScenePlacementPattern::Spline },
+		{ TEXT("scatter"), EScenePlacementPattern::Scatter },
+		{ TEXT("surface"), EScenePlacementPattern::SurfaceScatter }
+	};
+
+	/** Curve samples per spline segment when measuring arc length */
+	const int32 SplineSamplesPerSegment = 16;
+
+	/** Candidates tried around each active scatter point before it is retired */
+	const int32 ScatterAttempts = 30;
+
+	void FillConstant(TArray<double>& Values, double Value)
+	{
+		for (double& Element : Values)
+		{
+			Element = Value;
+		}
+	}
+
+	void GenerateRow(const FScenePlacementSettings& Settings, const FVector& Origin, FScenePlacementBatch& Batch)
+	{
+		const int32 Count = Batch.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Batch.X[Index] = Origin.X + Index * Settings.Spacing;
+		}
+		FillConstant(Batch.Y, Origin.Y);
+		FillConstant(Batch.Z, Origin.Z);
+	}
+
+	void GenerateGrid(const FScenePlacementSettings& Settings, const FVector& Origin, FScenePlacementBatch& Batch)
+	{
+		const int32 Count = Batch.Num();
+		const int32 Columns = Settings.Columns > 0 ? Settings.Columns : FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<double>(Count))));
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Batch.X[Index] = Origin.X + (Index % Columns) * Settings.Spacing;
+		}
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Batch.Y[Index] = Origin.Y + (Index / Columns) * Settings.Spacing;
+		}
+		FillConstant(Batch.Z, Origin.Z);
+	}
+
+	void GenerateRing(const FScenePlacementSettings& Settings, const FVector& Origin, FScenePlacementBatch& Batch)
+	{
+		const int32 Count = Batch.Num();
+		const double Step = UE_TWO_PI / FMath::Max(Count, 1);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			double Sin;
+			double Cos;
+			FMath::SinCos(&Sin, &Cos, Index * Step);
+			Batch.X[Index] = Origin.X + Cos * Settings.Radius;
+			Batch.Y[Index] = Origin.Y + Sin * Settings.Radius;
+			Batch.Yaw[Index] = static_cast<float>(FMath::RadiansToDegrees(Index * Step));
+		}
+		FillConstant(Batch.Z, Origin.Z);
+	}
+
+	FVector EvaluateCatmullRom(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, double T)
+	{
+		const double T2 = T * T;
+		const double T3 = T2 * T;
+		return 0.5 * ((2.0 * P1) + (P2 - P0) * T + (2.0 * P0 - 5.0 * P1 + 4.0 * P2 - P3) * T2 + (3.0 * P1 - P0 - 3.0 * P2 + P3) * T3);
+	}
+
+	void GenerateSpline(const FScenePlacementSettings& Settings, const FVector& Origin, FScenePlacementBatch& Batch)
+	{
+		const TArray<FVector>& Points = Settings.SplinePoints;
+		if (Points.Num() < 2)
+		{
+			GenerateRow(Settings, Origin, Batch);
+			return;
+		}
+
+		// Sample the curve once into a polyline with running lengths, then walk it at even distances
+		const int32 NumSegments = Points.Num() - 1;
+		TArray<FVector> Samples;
+		TArray<double> Lengths;
+		Samples.Reserve(NumSegments * SplineSamplesPerSegment + 1);
+		Lengths.Reserve(NumSegments * SplineSamplesPerSegment + 1);
+		Samples.Add(Points[0]);
+		Lengths.Add(0.0);
+
+		for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+		{
+			const FVector& P0 = Points[FMath::Max(Segment - 1, 0)];
+			const FVector& P1 = Points[Segment];
+			const FVector& P2 = Points[Segment + 1];
+			const FVector& P3 = Points[FMath::Min(Segment + 2, Points.Num() - 1)];
+			for (int32 Step = 1; Step <= SplineSamplesPerSegment; ++Step)
+			{
+				const FVector Sample = EvaluateCatmullRom(P0, P1, P2, P3, static_cast<double>(Step) / SplineSamplesPerSegment);
+				Lengths.Add(Lengths.Last() + FVector::Dist(Samples.Last(), Sample));
+				Samples.Add(Sample);
+			}
+		}
+
+		const int32 Count = Batch.Num();
+		const double TotalLength = Lengths.Last();
+		int32 SampleIndex = 1;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const double Distance = Count > 1 ? TotalLength * Index / (Count - 1) : 0.0;
+			while (SampleIndex < Lengths.Num() - 1 && Lengths[SampleIndex] < Distance)
+			{
+				++SampleIndex;
+			}
+
+			const double SpanLength = Lengths[SampleIndex] - Lengths[SampleIndex - 1];
+			const double Alpha = SpanLength > UE_KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - Lengths[SampleIndex - 1]) / SpanLength, 0.0, 1.0) : 0.0;
+			const FVector& From = Samples[SampleIndex - 1];
+			const FVector& To = Samples[SampleIndex];
+			const FVector Location = FMath::Lerp(From, To, Alpha);
+
+			Batch.X[Index] = Location.X;
+			Batch.Y[Index] = Location.Y;
+			Batch.Z[Index] = Location.Z;
+			Batch.Yaw[Index] = static_cast<float>(FMath::RadiansToDegrees(FMath::Atan2(To.Y - From.Y, To.X - From.X)));
+		}
+	}
+
+	/** Bridson's Poisson-disk sampling in a disk, with a background grid so each candidate checks a few cells */
+	void GenerateScatter(const FScenePlacementSettings& Settings, const FVector& Origin, int32 Count, FScenePlacementBatch& Batch)
+	{
+		const double Radius = FMath::Max(Settings.Radius, 1.0);
+		double MinDistance = FMath::Max(Settings.Spacing, 1.0);
+		double CellSize = MinDistance / UE_SQRT_2;
+		int32 GridSize = FMath::CeilToInt(2.0 * Radius / CellSize) + 1;
+		if (GridSize > FScenePlacement::MaxScatterGridSize)
+		{
+			GridSize = FScenePlacement::MaxScatterGridSize;
+			CellSize = 2.0 * Radius / (GridSize - 1);
+			MinDistance = CellSize * UE_SQRT_2;
+		}
+
+		TArray<int32> Grid;
+		Grid.Init(INDEX_NONE, GridSize * GridSize);
+		auto CellOf = [Radius, CellSize, GridSize](double LocalX, double LocalY, int32& OutCellX, int32& OutCellY)
+		{
+			OutCellX = FMath::Clamp(FMath::FloorToInt((LocalX + Radius) / CellSize), 0, GridSize - 1);
+			OutCellY = FMath::Clamp(FMath::FloorToInt((LocalY + Radius) / CellSize), 0, GridSize - 1);
+		};
+
+		// Points are kept relative to the origin until the end
+		TArray<double> LocalX;
+		TArray<double> LocalY;
+		TArray<int32> Active;
+		LocalX.Reserve(Count);
+		LocalY.Reserve(Count);
+
+		auto AddPoint = [&](double PointX, double PointY)
+		{
+			int32 CellX;
+			int32 CellY;
+			CellOf(PointX, PointY, CellX, CellY);
+			Grid[CellY * GridSize + CellX] = LocalX.Num();
+			Active.Add(LocalX.Num());
+			LocalX.Add(PointX);
+			LocalY.Add(PointY);
+		};
+
+		auto IsFree = [&](double PointX, double PointY)
+		{
+			int32 CellX;
+			int32 CellY;
+			CellOf(PointX, PointY, CellX, CellY);
+			const double MinDistanceSquared = MinDistance * MinDistance;
+			for (int32 Y = FMath::Max(CellY - 2, 0); Y <= FMath::Min(CellY + 2, GridSize - 1); ++Y)
+			{
+				for (int32 X = FMath::Max(CellX - 2, 0); X <= FMath::Min(CellX + 2, GridSize - 1); ++X)
+				{
+					const int32 Neighbour = Grid[Y * GridSize + X];
+					if (Neighbour != INDEX_NONE && FMath::Square(LocalX[Neighbour] - PointX) + FMath::Square(LocalY[Neighbour] - PointY) < MinDistanceSquared)
+						return false;
+				}
+			}
+			return true;
+		};
+
+		FRandomStream Stream(Settings.Seed);
+		if (Count > 0)
+		{
+			AddPoint(0.0, 0.0);
+		}
+
+		while (Active.Num() > 0 && LocalX.Num() < Count)
+		{
+			const int32 ActiveIndex = Stream.RandHelper(Active.Num());
+			const int32 Parent = Active[ActiveIndex];
+
+			bool bPlaced = false;
+			for (int32 Attempt = 0; Attempt < ScatterAttempts && !bPlaced; ++Attempt)
+			{
+				const double Angle = Stream.FRand() * UE_TWO_PI;
+				const double Distance = MinDistance * (1.0 + Stream.FRand());
+				const double CandidateX = LocalX[Parent] + FMath::Cos(Angle) * Distance;
+				const double CandidateY = LocalY[Parent] + FMath::Sin(Angle) * Distance;
+				if (CandidateX * CandidateX + CandidateY * CandidateY <= Radius * Radius && IsFree(CandidateX, CandidateY))
+				{
+					AddPoint(CandidateX, CandidateY);
+					bPlaced = true;
+				}
+			}
+
+			if (!bPlaced)
+			{
+				Active.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+			}
+		}
+
+		const int32 NumPlaced = LocalX.Num();
+		Batch.SetNum(NumPlaced);
+		for (int32 Index = 0; Index < NumPlaced; ++Index)
+		{
+			Batch.X[Index] = Origin.X + LocalX[Index];
+		}
+		for (int32 Index = 0; Index < NumPlaced; ++Index)
+		{
+			Batch.Y[Index] = Origin.Y + LocalY[Index];
+		}
+		FillConstant(Batch.Z, Origin.Z);
+
+		// Scattered items shouldn't all face the same way
+		for (int32 Index = 0; Index < NumPlaced; ++Index)
+		{
+			Batch.Yaw[Index] = Stream.FRandRange(0.0f, 360.0f);
+		}
+	}
+}
+
+void FScenePlacementBatch::SetNum(int32 Count)
+{
+	X.SetNumUninitialized(Count);
+	Y.SetNumUninitialized(Count);
+	Z.SetNumUninitialized(Count);
+	Yaw.SetNumZeroed(Count);
+	Normals.Reset();
+}
+
+void FScenePlacementBatch::ToTransforms(const FRotator& BaseRotation, TArray<FTransform>& OutTransforms) const
+{
+	const int32 Count = Num();
+	OutTransforms.Reset(Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Location(X[Index], Y[Index], Z[Index]);
+		FRotator Rotation = BaseRotation;
+		Rotation.Yaw += Yaw[Index];
+
+		// Keep the heading but stand on the surface
+		if (Normals.IsValidIndex(Index))
+		{
+			const FVector Forward = Rotation.Vector();
+			Rotation = FRotationMatrix::MakeFromZX(Normals[Index], Forward).Rotator();
+		}
+
+		OutTransforms.Emplace(Rotation, Location);
+	}
+}
+
+void FScenePlacement::Generate(const FScenePlacementSettings& Settings, const FVector& Origin, int32 Count, FScenePlacementBatch& OutBatch)
+{
+	Count = FMath::Max(Count, 0);
+	OutBatch.SetNum(Count);
+
+	switch (Settings.Pattern)
+	{
+		case EScenePlacementPattern::Grid:
+			GenerateGrid(Settings, Origin, OutBatch);
+			break;
+
+		case EScenePlacementPattern::Ring:
+			GenerateRing(Settings, Origin, OutBatch);
+			break;
+
+		case EScenePlacementPattern::Spline:
+			GenerateSpline(Settings, Origin, OutBatch);
+			break;
+
+		case EScenePlacementPattern::Scatter:
+		case EScenePlacementPattern::SurfaceScatter:
+			GenerateScatter(Settings, Origin, Count, OutBatch);
+			break;
+
+		default:
+			GenerateRow(Settings, Origin, OutBatch);
+			break;
+	}
+}
+
+int32 FScenePlacement::SnapToGround(UWorld* World, FScenePlacementBatch& Batch, bool bRecordNormals)
+{
+	check(IsInGameThread());
+
+	const int32 Count = Batch.Num();
+	if (!World || Count == 0)
+		return 0;
+
+	if (bRecordNormals)
+	{
+		Batch.Normals.Init(FVector::UpVector, Count);
+	}
+
+	// Scene queries are read-only and safe from task threads while the game thread waits here
+	TArray<uint8> Hits;
+	Hits.SetNumZeroed(Count);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ScenePlacementGroundTrace), false);
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(Count, TraceBatchSize);
+	ParallelFor(NumBatches, [World, &Batch, &Hits, &QueryParams, Count, bRecordNormals](int32 BatchIndex)
+	{
+		const int32 Start = BatchIndex * TraceBatchSize;
+		const int32 End = FMath::Min(Start + TraceBatchSize, Count);
+		for (int32 Index = Start; Index < End; ++Index)
+		{
+			FHitResult Hit;
+			const FVector TraceStart(Batch.X[Index], Batch.Y[Index], Batch.Z[Index] + TraceUpDistance);
+			const FVector TraceEnd(Batch.X[Index], Batch.Y[Index], Batch.Z[Index] - TraceDownDistance);
+			if (World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
+			{
+				Batch.Z[Index] = Hit.ImpactPoint.Z;
+				if (bRecordNormals)
+				{
+					Batch.Normals[Index] = Hit.ImpactNormal;
+				}
+				Hits[Index] = 1;
+			}
+		}
+	});
+
+	int32 NumHits = 0;
+	for (uint8 bHit : Hits)
+	{
+		NumHits += bHit;
+	}
+	return NumHits;
+}
+
+void FScenePlacement::MakeTransforms(UWorld* World, const FScenePlacementSettings& Settings, const FVector& Origin, const FRotator& Rotation, int32 Count, TArray<FTransform>& OutTransforms)
+{
+	FScenePlacementBatch Batch;
+	Generate(Settings, Origin, Count, Batch);
+
+	const bool bSurface = Settings.Pattern == EScenePlacementPattern::SurfaceScatter;
+	if (World && (Settings.bSnapToGround || bSurface))
+	{
+		SnapToGround(World, Batch, bSurface);
+	}
+
+	Batch.ToTransforms(Rotation, OutTransforms);
+}
+
+bool FScenePlacement::ParsePattern(FStringView Name, EScenePlacementPattern& OutPattern)
+{
+	for (const FPatternName& Entry : PatternNames)
+	{
+		if (Name.Equals(Entry.Name, ESearchCase::IgnoreCase))
+		{
+			OutPattern = Entry.Pattern;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* FScenePlacement::GetPatternName(EScenePlacementPattern Pattern)
+{
+	for (const FPatternName& Entry : PatternNames)
+	{
+		if (Entry.Pattern == Pattern)
+			return Entry.Name;
+	}
+	return TEXT("row");
+}
@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ScenePropertyAccessor.h"
+#include "UObject/UnrealType.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	struct FCachedAccessor
+	{
+		TSharedPtr<const FScenePropertyAccessor> Accessor;
+
+		/** Why the path didn't resolve, with the class's first field at the time so a recompile retries */
+		FString Error;
+		const FField* ClassFirstField = nullptr;
+	};
+
+	/** Keyed by class and path; FString keys compare case-insensitively, as FNames do */
+	TMap<TPair<FObjectKey, FString>, FCachedAccessor>& GetAccessorCache()
+	{
+		static TMap<TPair<FObjectKey, FString>, FCachedAccessor> Cache;
+		return Cache;
+	}
+
+	bool IsEditableOnInstances(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_Edit) && !Property->HasAnyPropertyFlags(CPF_DisableEditOnInstance);
+	}
+}
+
+TSharedPtr<const FScenePropertyAccessor> FScenePropertyAccessor::Find(const UClass* Class, const FString& Path, FString& OutError)
+{
+	check(IsInGameThread());
+
+	if (!Class)
+	{
+		OutError = TEXT("No class");
+		return nullptr;
+	}
+
+	FCachedAccessor& Cached = GetAccessorCache().FindOrAdd(TPair<FObjectKey, FString>(Class, Path));
+	if (Cached.Accessor.IsValid() && Cached.Accessor->IsCurrent())
+		return Cached.Accessor;
+	if (!Cached.Error.IsEmpty() && Cached.ClassFirstField == Class->ChildProperties)
+	{
+		OutError = Cached.Error;
+		return nullptr;
+	}
+
+	Cached = FCachedAccessor();
+	Cached.ClassFirstField = Class->ChildProperties;
+
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("."));
+	if (Segments.Num() == 0)
+	{
+		OutError = Cached.Error = TEXT("No property path given");
+		return nullptr;
+	}
+
+	TSharedRef<FScenePropertyAccessor> Accessor = MakeShareable(new FScenePropertyAccessor());
+	Accessor->Path = Path;
+
+	// Subobject classes come from the class defaults, so "LightComponent" on a point light finds point light properties
+	const UStruct* Struct = Class;
+	const void* Defaults = Class->GetDefaultObject();
+
+	for (int32 Index = 0; Index < Segments.Num(); ++Index)
+	{
+		const FString& Segment = Segments[Index];
+		FProperty* Property = FindFProperty<FProperty>(Struct, FName(*Segment));
+		if (!Property)
+		{
+			OutError = Cached.Error = FString::Printf(TEXT("%s has no property '%s'"), *Struct->GetName(), *Segment);
+			return nullptr;
+		}
+
+		if (!IsEditableOnInstances(Property))
+		{
+			OutError = Cached.Error = FString::Printf(TEXT("%s.%s can't be edited on placed actors"), *Struct->GetName(), *Segment);
+			return nullptr;
+		}
+
+		FStep& Step = Accessor->Steps.AddDefaulted_GetRef();
+		Step.Property = Property;
+		Step.Owner = Struct;
+		Step.OwnerFirstField = Struct->ChildProperties;
+
+		if (Index == Segments.Num() - 1)
+		{
+			if (Property->HasAnyPropertyFlags(CPF_EditConst))
+			{
+				OutError = Cached.Error = FString::Printf(TEXT("%s.%s is read-only"), *Struct->GetName(), *Segment);
+				return nullptr;
+			}
+			Step.Kind = EStepKind::Value;
+		}
+		else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			// Visible-only components are fine to step through; their own properties decide what can change
+			const UObject* Subobject = Defaults ? ObjectProperty->GetObjectPropertyValue_InContainer(Defaults) : nullptr;
+			Step.Kind = EStepKind::Object;
+			Struct = Subobject ? Subobject->GetClass() : ObjectProperty->PropertyClass.Get();
+			Defaults = Subobject;
+			Accessor->MemberStep = Index + 1;
+		}
+		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (Property->HasAnyPropertyFlags(CPF_EditConst))
+			{
+				OutError = Cached.Error = FString::Printf(TEXT("%s.%s is read-only"), *Struct->GetName(), *Segment);
+				return nullptr;
+			}
+			Step.Kind = EStepKind::Struct;
+			Struct = StructProperty->Struct;
+			Defaults = Defaults ? StructProperty->ContainerPtrToValuePtr<void>(Defaults) : nullptr;
+		}
+		else
+		{
+			OutError = Cached.Error = FString::Printf(TEXT("%s.%s is not an object or struct, so '%s' can't be found inside it"),
+				*Struct->GetName(), *Segment, *Segments[Index + 1]);
+			return nullptr;
+		}
+	}
+
+	Cached.Accessor = Accessor;
+	return Accessor;
+}
+
+void FScenePropertyAccessor::ResetCache()
+{
+	GetAccessorCache().Reset();
+}
+
+bool FScenePropertyAccessor::IsCurrent() const
+{
+	for (const FStep& Step : Steps)
+	{
+		const UStruct* Owner = Step.Owner.Get();
+		if (!Owner || Owner->ChildProperties != Step.OwnerFirstField)
+			return false;
+	}
+	return true;
+}
+
+bool FScenePropertyAccessor::Resolve(UObject* Root, UObject*& OutOwner, void*& OutValue) const
+{
+	if (!Root)
+		return false;
+
+	UObject* Owner = Root;
+	void* Container = Root;
+
+	for (int32 Index = 0; Index < Steps.Num(); ++Index)
+	{
+		const FStep& Step = Steps[Index];
+		switch (Step.Kind)
+		{
+			case EStepKind::Object:
+			{
+				// Only the root's own subobjects; a path through an asset reference would change the asset for everyone
+				UObject* Subobject = CastFieldChecked<FObjectPropertyBase>(Step.Property)->GetObjectPropertyValue_InContainer(Container);
+				const UStruct* Expected = Steps[Index + 1].Owner.Get();
+				if (!Subobject || !Subobject->IsIn(Root) || !Expected || !Subobject->GetClass()->IsChildOf(Expected))
+					return false;
+
+				Owner = Subobject;
+				Container = Subobject;
+				break;
+			}
+
+			case EStepKind::Struct:
+				Container = Step.Property->ContainerPtrToValuePtr<void>(Container);
+				break;
+
+			default:
+				OutOwner = Owner;
+				OutValue = Step.Property->ContainerPtrToValuePtr<void>(Container);
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool FScenePropertyAccessor::GetValueText(UObject* Root, FString& OutText) const
+{
+	UObject* Owner = nullptr;
+	void* Value = nullptr;
+	if (!Resolve(Root, Owner, Value))
+		return false;
+
+	OutText.Reset();
+	GetProperty()->ExportTextItem_Direct(OutText, Value, nullptr, Owner, PPF_None);
+	return true;
+}
+
+bool FScenePropertyAccessor::NormalizeValueText(const FString& Text, FString& OutText) const
+{
+	const FProperty* Property = GetProperty();
+	void* Value = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+	Property->InitializeValue(Value);
+
+	const bool bImported = Property->ImportText_Direct(*Text, Value, nullptr, PPF_None) != nullptr;
+	if (bImported)
+	{
+		OutText.Reset();
+		Property->ExportTextItem_Direct(OutText, Value, nullptr, nullptr, PPF_None);
+	}
+
+	Property->DestroyValue(Value);
+	FMemory::Free(Value);
+	return bImported;
+}
@@ -1,82 +1,44 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TestAutomationHelper.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
-#include "HAL/PlatformFileManager.h"
-#include "GenericPlatform/GenericPlatformFile.h"
-#include "Misc/DateTime.h"
-
-FString FTestAutomationHelper::AuditLogPath;
-FCriticalSection FTestAutomationHelper::LogMutex;
+#include "AuditLogger.h"
 
 void FTestAutomationHelper::InitializeAuditLog()
 {
-	// Get the Saved/ChatGPTEditor directory path
-	FString PluginSavedDir = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor");
-	
-	// Create directory if it doesn't exist
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*PluginSavedDir))
-	{
-		PlatformFile.CreateDirectory(*PluginSavedDir);
-	}
-	
-	// Set audit log path
-	AuditLogPath = PluginSavedDir / TEXT("audit.log");
-	
-	// Write initialization message
+	// The file and its directory belong to FAuditLogger; this only marks where test automation starts
 	LogAuditMessage(TEXT("SYSTEM"), TEXT("Test Automation audit log initialized"));
 }
 
 void FTestAutomationHelper::LogTestGenerationRequest(const FString& UserPrompt, const FString& TestType)
 {
-	FString Message = FString::Printf(
-		TEXT("TEST_GENERATION_REQUEST | Type: %s | Prompt: %s"),
-		*TestType,
-		*UserPrompt
-	);
-	WriteToAuditLog(Message);
+	FAuditLogger::Get().Submit(FAuditEvent(EAuditSource::Test, TEXT("TEST_GENERATION_REQUEST"))
+		.Add(TEXT("Type"), TestType)
+		.Add(TEXT("Prompt"), UserPrompt));
 }
 
 void FTestAutomationHelper::LogTestExecutionRequest(const FString& TestName, const FString& TestPath)
 {
-	FString Message = FString::Printf(
-		TEXT("TEST_EXECUTION_REQUEST | Test: %s | Path: %s"),
-		*TestName,
-		*TestPath
-	);
-	WriteToAuditLog(Message);
+	FAuditLogger::Get().Submit(FAuditEvent(EAuditSource::Test, TEXT("TEST_EXECUTION_REQUEST"))
+		.Add(TEXT("Test"), TestName)
+		.Add(TEXT("Path"), TestPath));
 }
 
 void FTestAutomationHelper::LogTestExecutionResult(const FString& TestName, bool bSuccess, const FString& ResultMessage)
 {
-	FString Message = FString::Printf(
-		TEXT("TEST_EXECUTION_RESULT | Test: %s | Success: %s | Result: %s"),
-		*TestName,
-		bSuccess ? TEXT("TRUE") : TEXT("FALSE"),
-		*ResultMessage
-	);
-	WriteToAuditLog(Message);
+	FAuditLogger::Get().Submit(FAuditEvent(EAuditSource::Test, TEXT("TEST_EXECUTION_RESULT"))
+		.Add(TEXT("Test"), TestName)
+		.AddBool(TEXT("Success"), bSuccess)
+		.Add(TEXT("Result"), ResultMessage));
 }
 
 void FTestAutomationHelper::LogAuditMessage(const FString& Category, const FString& Message)
 {
-	FString FormattedMessage = FString::Printf(
-		TEXT("%s | %s"),
-		*Category,
-		*Message
-	);
-	WriteToAuditLog(FormattedMessage);
+	FAuditLogger::Get().Submit(FAuditEvent(EAuditSource::Test, FName(*Category)).AddMessage(Message));
 }
 
 FString FTestAutomationHelper::GetAuditLogPath()
 {
-	if (AuditLogPath.IsEmpty())
-	{
-		InitializeAuditLog();
-	}
-	return AuditLogPath;
+	return FAuditLogger::Get().GetAuditLogPath();
 }
 
 bool FTestAutomationHelper::ParseTestCodeFromResponse(const FString& Response, FString& OutTestCode, FString& OutTestName)
@@ -210,30 +172,3 @@ bool FTestAutomationHelper::ValidateTestCode(const FString& TestCode, TArray<FSt
 	
 	return !bHasCriticalIssues;
 }
-
-void FTestAutomationHelper::WriteToAuditLog(const FString& Message)
-{
-	FScopeLock Lock(&LogMutex);
-	
-	if (AuditLogPath.IsEmpty())
-	{
-		InitializeAuditLog();
-	}
-	
-	FString TimestampedMessage = FString::Printf(TEXT("[%s] %s\n"), *GetTimestamp(), *Message);
-	
-	// Append to log file
-	FFileHelper::SaveStringToFile(
-		TimestampedMessage,
-		*AuditLogPath,
-		FFileHelper::EEncodingOptions::AutoDetect,
-		&IFileManager::Get(),
-		FILEWRITE_Append
-	);
-}
-
-FString FTestAutomationHelper::GetTimestamp()
-{
-	FDateTime Now = FDateTime::Now();
-	return Now.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
-}
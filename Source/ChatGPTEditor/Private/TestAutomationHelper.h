@@ -12,8 +12,8 @@ class FTestAutomationHelper
 {
 public:
 	/**
-	 * Initialize the audit log file
-	 * Creates the log directory if it doesn't exist
+	 * Mark the start of test automation in the audit log
+	 * The log itself is FAuditLogger's; every Log function here submits to it
 	 */
 	static void InitializeAuditLog();
 	
@@ -47,8 +47,8 @@ public:
 	static void LogAuditMessage(const FString& Category, const FString& Message);
 	
 	/**
-	 * Get the path to the audit log file
-	 * @return Full path to audit.log
+	 * Get the path to the audit log file, shared with FAuditLogger
+	 * @return Full path to the audit log segment being written
 	 */
 	static FString GetAuditLogPath();
 
@@ -70,19 +70,4 @@ public:
 	 * @return True if code passes basic security checks
 	 */
 	static bool ValidateTestCode(const FString& TestCode, TArray<FString>& OutWarnings);
-
-private:
-	static FString AuditLogPath;
-	static FCriticalSection LogMutex;
-	
-	/**
-	 * Write a timestamped entry to the audit log
-	 * Thread-safe implementation
-	 */
-	static void WriteToAuditLog(const FString& Message);
-	
-	/**
-	 * Get current timestamp in ISO 8601 format
-	 */
-	static FString GetTimestamp();
 };
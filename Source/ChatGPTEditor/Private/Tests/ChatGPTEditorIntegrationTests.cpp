@@ -251,7 +251,7 @@ bool FAuditLogMultiSystemTest::RunTest(const FString& Parameters)
 	FTestAutomationHelper::LogAuditMessage(TEXT("SYSTEM_B"), TEXT("Message from system B"));
 	
 	// Verify both logs exist and are accessible
-	FString MainAuditLog = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
+	FString MainAuditLog = FAuditLogger::Get().GetAuditLogPath();
 	FString TestAuditLog = FTestAutomationHelper::GetAuditLogPath();
 	
 	TestFalse(TEXT("Main audit log path should not be empty"), MainAuditLog.IsEmpty());
@@ -8,6 +8,7 @@
  * - API key validation
  * - Audit logging functionality
  * - Permission system
+ * - Scene edit command parsing
  * 
  * Run these tests via:
  * Session Frontend -> Automation tab
@@ -17,14 +18,52 @@
 
 #include "Misc/AutomationTest.h"
 #include "AuditLogger.h"
+#include "AuditLogFormat.h"
+#include "AuditLogQuery.h"
+#include "AuditSegmentWriter.h"
+#include "AssetAutomation.h"
+#include "TestAutomationHelper.h"
+#include "BlueprintAuditLog.h"
 #include "ChatGPTEditor.h"
+#include "SceneEditingManager.h"
+#include "SceneActorIndex.h"
+#include "SceneCommandParser.h"
+#include "ScenePlacement.h"
+#include "ScenePropertyAccessor.h"
+#include "SceneEditJournal.h"
+#include "Engine/World.h"
+#include "Engine/PointLight.h"
+#include "Components/PointLightComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 // Test flags: Combines ATF for automation test framework
 #define CHATGPT_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
+/** Every event in the audit log, oldest first, as text lines */
+static FString LoadAuditLogText()
+{
+	FString Text;
+	FAuditLogReader Reader;
+	Reader.ReadDirectory(FAuditLogger::Get().GetAuditLogDirectory(), [&Text](const FAuditEvent& Event)
+	{
+		Event.AppendLine(Text);
+		return true;
+	});
+	return Text;
+}
+
 /**
  * Test: Audit Logger Initialization
  * Verifies that the audit logger can be initialized and creates necessary directories
@@ -37,16 +76,18 @@ bool FAuditLoggerInitTest::RunTest(const FString& Parameters)
 	FAuditLogger::Get().Initialize();
 	
 	// Verify the log directory exists
-	FString LogDir = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor");
+	FString LogDir = FAuditLogger::Get().GetAuditLogDirectory();
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	
 	TestTrue(TEXT("Audit log directory should exist"), PlatformFile.DirectoryExists(*LogDir));
 	
 	// Verify we can write to the log
 	FAuditLogger::Get().LogEvent(TEXT("TEST"), TEXT("Unit test log entry"));
+	TestTrue(TEXT("Queued lines should be flushed"), FAuditLogger::Get().Flush());
 	
-	// Verify the log file exists
-	FString LogFilePath = LogDir / TEXT("audit.log");
+	// Verify the log segment exists
+	FString LogFilePath = FAuditLogger::Get().GetAuditLogPath();
+	TestTrue(TEXT("Audit log segment should be in the log directory"), LogFilePath.StartsWith(LogDir));
 	TestTrue(TEXT("Audit log file should exist"), PlatformFile.FileExists(*LogFilePath));
 	
 	return true;
@@ -92,20 +133,95 @@ bool FAuditLoggerEventTest::RunTest(const FString& Parameters)
 	const FString TestEventData = TEXT("This is test event data");
 	
 	FAuditLogger::Get().LogEvent(TestEventName, TestEventData);
+	TestTrue(TEXT("Queued lines should be flushed"), FAuditLogger::Get().Flush());
 	
-	// Read the log file and verify the event was logged
-	FString LogFilePath = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
+	// Read the segment back and verify the event was logged
+	FAuditLogReader Reader;
 	FString LogContents;
-	
-	if (FFileHelper::LoadFileToString(LogContents, *LogFilePath))
+	FString Error;
+	if (Reader.ReadSegment(FAuditLogger::Get().GetAuditLogPath(), [&LogContents](const FAuditEvent& Event) { Event.AppendLine(LogContents); return true; }, Error))
 	{
 		TestTrue(TEXT("Log should contain event name"), LogContents.Contains(TestEventName));
 		TestTrue(TEXT("Log should contain event data"), LogContents.Contains(TestEventData));
 	}
 	else
 	{
-		AddError(TEXT("Failed to read audit log file"));
+		AddError(FString::Printf(TEXT("Failed to read audit log segment: %s"), *Error));
+	}
+	
+	return true;
+}
+
+/**
+ * Test: Audit Logger Writer Thread
+ * Verifies that lines logged from many threads at once all reach the file through the writer thread
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLoggerWriterTest, "ChatGPTEditor.AuditLogger.WriterThread", CHATGPT_TEST_FLAGS)
+
+bool FAuditLoggerWriterTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	TestTrue(TEXT("Writer thread should be running"), Logger.IsWriterRunning());
+	
+	const FString Marker = FGuid::NewGuid().ToString();
+	const int32 NumThreads = 8;
+	const int32 NumPerThread = 50;
+	ParallelFor(NumThreads, [&Logger, &Marker](int32 Thread)
+	{
+		for (int32 Index = 0; Index < NumPerThread; ++Index)
+		{
+			Logger.LogEvent(TEXT("WRITER_TEST"), FString::Printf(TEXT("%s %d/%d"), *Marker, Thread, Index));
+		}
+	});
+	TestTrue(TEXT("Flush should finish within its timeout"), Logger.Flush());
+	
+	const FString LogContents = LoadAuditLogText();
+	int32 NumFound = 0;
+	for (int32 SearchFrom = LogContents.Find(Marker); SearchFrom != INDEX_NONE; SearchFrom = LogContents.Find(Marker, ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchFrom + 1))
+	{
+		++NumFound;
 	}
+	TestEqual(TEXT("Every line should be written once"), NumFound, NumThreads * NumPerThread);
+	
+	return true;
+}
+
+/**
+ * Test: Unified Audit Sink
+ * Verifies that every subsystem's events reach the one audit log, whole and in the order they were submitted
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditSinkTest, "ChatGPTEditor.AuditLogger.UnifiedSink", CHATGPT_TEST_FLAGS)
+
+bool FAuditSinkTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	
+	const FString Marker = FGuid::NewGuid().ToString();
+	Logger.LogEvent(TEXT("SINK_TEST"), Marker + TEXT(" logger"));
+	
+	FAssetAuditLogEntry AssetEntry;
+	AssetEntry.Operation = TEXT("CreateMaterial");
+	AssetEntry.AssetName = Marker + TEXT(" asset");
+	AssetEntry.bSucceeded = true;
+	FAssetAutomation::WriteAuditLog(AssetEntry);
+	
+	FTestAutomationHelper::LogTestExecutionResult(Marker + TEXT(" test"), false, TEXT("Failed"));
+	FBlueprintAuditLog::Get().LogUserRejection(Marker + TEXT(" blueprint"));
+	TestTrue(TEXT("Flush should finish within its timeout"), Logger.Flush());
+	
+	TestEqual(TEXT("Asset automation should share the audit log"), FAssetAutomation::GetAuditLogPath(), Logger.GetAuditLogPath());
+	TestEqual(TEXT("Test automation should share the audit log"), FTestAutomationHelper::GetAuditLogPath(), Logger.GetAuditLogPath());
+	
+	const FString LogContents = LoadAuditLogText();
+	const int32 LoggerAt = LogContents.Find(Marker + TEXT(" logger"));
+	const int32 AssetAt = LogContents.Find(Marker + TEXT(" asset"));
+	const int32 TestAt = LogContents.Find(Marker + TEXT(" test"));
+	const int32 BlueprintAt = LogContents.Find(Marker + TEXT(" blueprint"));
+	TestTrue(TEXT("Every subsystem's event should be written"), LoggerAt != INDEX_NONE && AssetAt != INDEX_NONE && TestAt != INDEX_NONE && BlueprintAt != INDEX_NONE);
+	TestTrue(TEXT("Events should be written in the order they were submitted"), LoggerAt < AssetAt && AssetAt < TestAt && TestAt < BlueprintAt);
+	TestTrue(TEXT("Typed fields should be written by name"), LogContents.Contains(FString::Printf(TEXT("TEST_EXECUTION_RESULT | Test: %s test | Success: NO"), *Marker)));
 	
 	return true;
 }
@@ -168,9 +284,10 @@ bool FAuditLogExportTest::RunTest(const FString& Parameters)
 	// Log some test events
 	FAuditLogger::Get().LogEvent(TEXT("EXPORT_TEST_1"), TEXT("First test event"));
 	FAuditLogger::Get().LogEvent(TEXT("EXPORT_TEST_2"), TEXT("Second test event"));
+	TestTrue(TEXT("Queued lines should be flushed"), FAuditLogger::Get().Flush());
 	
 	// Verify audit log file exists and has content
-	FString LogFilePath = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("audit.log");
+	FString LogFilePath = FAuditLogger::Get().GetAuditLogPath();
 	
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	TestTrue(TEXT("Audit log file should exist"), PlatformFile.FileExists(*LogFilePath));
@@ -181,6 +298,358 @@ bool FAuditLogExportTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+/**
+ * Test: Audit Log Rotation
+ * Verifies that the log rotates at its size limit, compresses closed segments, and reads back whole and in order
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogRotationTest, "ChatGPTEditor.AuditLogger.Rotation", CHATGPT_TEST_FLAGS)
+
+bool FAuditLogRotationTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	const FString FirstSegment = Logger.GetAuditLogPath();
+	
+	Logger.SetRotationLimits(4 * 1024, FAuditSegmentWriter::DefaultMaxSegmentSeconds);
+	const FString Marker = FGuid::NewGuid().ToString();
+	const int32 NumEvents = 500;
+	for (int32 Index = 0; Index < NumEvents; ++Index)
+	{
+		Logger.Submit(FAuditEvent(EAuditSource::Editor, TEXT("ROTATION_TEST")).AddMessage(Marker).Add(TEXT("Index"), FString::FromInt(Index)));
+	}
+	TestTrue(TEXT("Flush should finish within its timeout"), Logger.Flush());
+	Logger.SetRotationLimits(FAuditSegmentWriter::DefaultMaxSegmentBytes, FAuditSegmentWriter::DefaultMaxSegmentSeconds);
+	TestTrue(TEXT("Closed segments should be compressed within the timeout"), Logger.WaitForCompression());
+	
+	TestNotEqual(TEXT("The log should have rotated"), Logger.GetAuditLogPath(), FirstSegment);
+	const TArray<FString> Segments = FAuditLogReader::FindSegments(Logger.GetAuditLogDirectory());
+	TestTrue(TEXT("Closed segments should be compressed"), Segments.ContainsByPredicate([](const FString& Path) { return Path.EndsWith(AuditLogFormat::CompressedExtension); }));
+	
+	int32 NextIndex = 0;
+	bool bInOrder = true;
+	FAuditLogReader Reader;
+	Reader.ReadDirectory(Logger.GetAuditLogDirectory(), [&](const FAuditEvent& Event)
+	{
+		if (Event.Type == TEXT("ROTATION_TEST") && Event.Fields.Num() == 2 && Event.Fields[0].Value == Marker)
+		{
+			bInOrder &= Event.Fields[1].Value == FString::FromInt(NextIndex) && FCString::Strcmp(Event.Fields[1].Key, TEXT("Index")) == 0;
+			++NextIndex;
+		}
+		return true;
+	});
+	TestEqual(TEXT("Every event should be read back across segments"), NextIndex, NumEvents);
+	TestTrue(TEXT("Events should read back in order with their fields"), bInOrder);
+	
+	return true;
+}
+
+/**
+ * Test: Audit Log Shared Directory
+ * Verifies that a session's startup compression leaves alone the segment another live session is writing,
+ * and compresses it once that session has closed it and gone
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogSharedDirectoryTest, "ChatGPTEditor.AuditLogger.SharedDirectory", CHATGPT_TEST_FLAGS)
+
+bool FAuditLogSharedDirectoryTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AuditLogSharedDirectoryTest"), FGuid::NewGuid().ToString());
+	const FString SessionMarkerFilter = FPaths::Combine(Directory, FString(TEXT("*")) + AuditLogFormat::SessionExtension);
+	FString LivePath;
+	{
+		// Another process's writer, as far as the directory can tell
+		FAuditSegmentWriter Live(Directory);
+		Live.Add(FAuditEvent(EAuditSource::Editor, TEXT("SHARED_TEST")).AddMessage(TEXT("Live")));
+		TestTrue(TEXT("The live segment should be written"), Live.Write(EAuditLogFlushPolicy::Batch, false));
+		LivePath = Live.GetSegmentPath();
+		
+		TArray<FString> Markers;
+		IFileManager::Get().FindFiles(Markers, *SessionMarkerFilter, true, false);
+		TestEqual(TEXT("The writing session should leave a marker"), Markers.Num(), 1);
+		
+		FAuditSegmentWriter Starting(Directory);
+		Starting.CompressClosedSegments();
+		TestTrue(TEXT("Compression should finish within the timeout"), FAuditSegmentWriter::WaitForCompression(FAuditLogger::DefaultFlushTimeoutSeconds));
+		TestTrue(TEXT("A segment another session is writing should be left uncompressed"), IFileManager::Get().FileExists(*LivePath));
+		TestFalse(TEXT("A segment another session is writing should have no compressed copy"),
+			IFileManager::Get().FileExists(*FPaths::ChangeExtension(LivePath, AuditLogFormat::CompressedExtension)));
+	}
+	
+	TArray<FString> Markers;
+	IFileManager::Get().FindFiles(Markers, *SessionMarkerFilter, true, false);
+	TestEqual(TEXT("A writer should remove its marker when it goes"), Markers.Num(), 0);
+	
+	FAuditSegmentWriter Later(Directory);
+	Later.CompressClosedSegments();
+	TestTrue(TEXT("Compression should finish within the timeout"), FAuditSegmentWriter::WaitForCompression(FAuditLogger::DefaultFlushTimeoutSeconds));
+	TestTrue(TEXT("A segment whose session has gone should be compressed"),
+		IFileManager::Get().FileExists(*FPaths::ChangeExtension(LivePath, AuditLogFormat::CompressedExtension)) && !IFileManager::Get().FileExists(*LivePath));
+	
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+/**
+ * Test: Audit Log Export To File
+ * Verifies that the binary log exports as text lines and as JSON Lines that parse back with their fields
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogExportToFileTest, "ChatGPTEditor.AuditLogger.ExportToFile", CHATGPT_TEST_FLAGS)
+
+bool FAuditLogExportToFileTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	
+	const FString Marker = FGuid::NewGuid().ToString();
+	Logger.Submit(FAuditEvent(EAuditSource::Asset, TEXT("EXPORT_TEST")).AddMessage(Marker).Add(TEXT("Path"), TEXT("/Game/\"Quoted\"")));
+	
+	const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AuditLogExportTest"), FGuid::NewGuid().ToString());
+	const FString TextPath = FPaths::Combine(Directory, TEXT("AuditLog.txt"));
+	const FString JsonPath = FPaths::Combine(Directory, TEXT("AuditLog.jsonl"));
+	FString Error;
+	TestTrue(TEXT("Text export should succeed"), Logger.ExportToFile(TextPath, EAuditLogExportFormat::Text, Error));
+	TestTrue(TEXT("JSON Lines export should succeed"), Logger.ExportToFile(JsonPath, EAuditLogExportFormat::JsonLines, Error));
+	
+	// Export flushes first, so the event just submitted is in both files
+	TArray<FString> TextLines;
+	FFileHelper::LoadFileToStringArray(TextLines, *TextPath);
+	TestTrue(TEXT("Text export should hold the event as a line"), TextLines.ContainsByPredicate([&Marker](const FString& Line)
+	{
+		return Line.Contains(TEXT("EXPORT_TEST | ") + Marker);
+	}));
+	
+	TArray<FString> JsonLines;
+	FFileHelper::LoadFileToStringArray(JsonLines, *JsonPath);
+	bool bFound = false;
+	for (const FString& Line : JsonLines)
+	{
+		TSharedPtr<FJsonObject> Object;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Object) || !Object.IsValid())
+		{
+			AddError(FString::Printf(TEXT("Exported line is not JSON: %s"), *Line));
+			break;
+		}
+		
+		FString Message;
+		if (Object->TryGetStringField(TEXT("message"), Message) && Message == Marker)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Fields = Object->GetArrayField(TEXT("fields"));
+			bFound = Object->GetStringField(TEXT("source")) == TEXT("Asset") && Object->GetStringField(TEXT("type")) == TEXT("EXPORT_TEST")
+				&& Fields.Num() == 1 && Fields[0]->AsObject()->GetStringField(TEXT("value")) == TEXT("/Game/\"Quoted\"");
+		}
+	}
+	TestTrue(TEXT("JSON Lines export should hold the event with its fields"), bFound);
+	
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+/**
+ * Test: Audit Log Query
+ * Verifies that indexed queries filter by time, type, actor, asset and tool, skip segments that can't match,
+ * page with cursors, and give the same answers from saved indexes
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogQueryTest, "ChatGPTEditor.AuditLogger.Query", CHATGPT_TEST_FLAGS)
+
+bool FAuditLogQueryTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("AuditLogQueryTest");
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	
+	// A segment per day; the last is left uncompressed, as the active one would be
+	const FDateTime Base(2024, 1, 1);
+	const int32 NumSegments = 4;
+	const int32 EventsPerSegment = 100;
+	{
+		FAuditSegmentWriter Writer(Directory);
+		for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+		{
+			for (int32 Index = 0; Index < EventsPerSegment; ++Index)
+			{
+				const bool bSceneEdit = Index % 2 == 1;
+				FAuditEvent Event(bSceneEdit ? EAuditSource::SceneEdit : EAuditSource::Asset, bSceneEdit ? TEXT("SCENE_EDIT") : TEXT("ASSET_OPERATION"));
+				Event.Timestamp = Base + FTimespan::FromDays(Segment) + FTimespan::FromSeconds(Index);
+				if (bSceneEdit)
+				{
+					Event.Add(TEXT("Affected"), FString::Printf(TEXT("Actor_%d_%d, Shared_Actor"), Segment, Index));
+				}
+				else
+				{
+					Event.Add(TEXT("Asset"), FString::Printf(TEXT("M_Asset_%d_%d"), Segment, Index));
+				}
+				Writer.Add(Event);
+			}
+			if (Segment == NumSegments - 1)
+			{
+				FAuditEvent Event(EAuditSource::MCP, TEXT("MCP_TOOL_CALL"));
+				Event.Timestamp = Base + FTimespan::FromDays(Segment) + FTimespan::FromSeconds(EventsPerSegment);
+				Writer.Add(Event.Add(TEXT("Tool"), TEXT("spawn_actor")));
+			}
+			Writer.Write(EAuditLogFlushPolicy::Batch, false);
+			if (Segment < NumSegments - 1)
+			{
+				Writer.Rotate();
+			}
+		}
+	}
+	TestTrue(TEXT("Closed segments should be compressed within the timeout"), FAuditSegmentWriter::WaitForCompression(FAuditLogger::DefaultFlushTimeoutSeconds));
+	
+	auto RunQuery = [](FAuditLogQueryEngine& Engine, const FAuditQuery& Query, TArray<FString>& OutFirstValues, FAuditQueryStats* OutStats = nullptr)
+	{
+		OutFirstValues.Reset();
+		return Engine.Query(Query, [&OutFirstValues](const FAuditEvent& Event)
+		{
+			OutFirstValues.Add(Event.Fields.Num() > 0 ? Event.Fields[0].Value : FString());
+			return true;
+		}, OutStats);
+	};
+	
+	FAuditLogQueryEngine Engine(Directory);
+	TArray<FString> Values;
+	FAuditQueryStats Stats;
+	
+	FAuditQuery ActorQuery;
+	ActorQuery.Actor = TEXT("actor_2_5");
+	TestTrue(TEXT("An actor query that finds everything should return no cursor"), RunQuery(Engine, ActorQuery, Values, &Stats).IsEmpty());
+	TestEqual(TEXT("Actor names should match whole and ignoring case"), Values.Num(), 1);
+	TestEqual(TEXT("Every segment should be considered"), Stats.NumSegments, NumSegments);
+	TestTrue(TEXT("Bloom filters should rule out segments without the actor"), Stats.NumSegmentsSkipped > 0);
+	
+	FAuditQuery AssetQuery;
+	AssetQuery.Asset = TEXT("M_Asset_1_4");
+	RunQuery(Engine, AssetQuery, Values);
+	TestTrue(TEXT("Asset queries should find the asset's event"), Values.Num() == 1 && Values[0] == TEXT("M_Asset_1_4"));
+	
+	FAuditQuery ToolQuery;
+	ToolQuery.Tool = TEXT("SPAWN_ACTOR");
+	RunQuery(Engine, ToolQuery, Values);
+	TestTrue(TEXT("Tool queries should find the tool call"), Values.Num() == 1 && Values[0] == TEXT("spawn_actor"));
+	
+	FAuditQuery TimeQuery;
+	TimeQuery.Types.Add(TEXT("SCENE_EDIT"));
+	TimeQuery.From = Base + FTimespan::FromDays(1);
+	TimeQuery.To = Base + FTimespan::FromDays(2);
+	RunQuery(Engine, TimeQuery, Values, &Stats);
+	TestEqual(TEXT("Type and time filters should find one day's scene edits"), Values.Num(), EventsPerSegment / 2);
+	TestEqual(TEXT("Segments outside the time range should be skipped"), Stats.NumSegmentsSkipped, NumSegments - 1);
+	
+	// Page through every scene edit a few at a time
+	FAuditQuery PageQuery;
+	PageQuery.Actor = TEXT("Shared_Actor");
+	PageQuery.MaxResults = 30;
+	TArray<FString> Paged;
+	int32 NumPages = 0;
+	do
+	{
+		PageQuery.Cursor = RunQuery(Engine, PageQuery, Values);
+		Paged.Append(Values);
+		++NumPages;
+	}
+	while (!PageQuery.Cursor.IsEmpty() && NumPages < 100);
+	TestEqual(TEXT("Paging should visit every match once"), Paged.Num(), NumSegments * EventsPerSegment / 2);
+	TestTrue(TEXT("Pages should carry on in order"), Paged.Num() > 1 && Paged[0].StartsWith(TEXT("Actor_0_1,")) && Paged.Last().StartsWith(FString::Printf(TEXT("Actor_%d_%d,"), NumSegments - 1, EventsPerSegment - 1)));
+	
+	TArray<FString> IndexFiles;
+	IFileManager::Get().FindFiles(IndexFiles, *(Directory / (FString(TEXT("*")) + FAuditLogQueryEngine::IndexExtension)), true, false);
+	TestEqual(TEXT("Compressed segments should have their index saved"), IndexFiles.Num(), NumSegments - 1);
+	
+	FAuditLogQueryEngine Reloaded(Directory);
+	FAuditQuery AllQuery = PageQuery;
+	AllQuery.Cursor.Reset();
+	AllQuery.MaxResults = 1000;
+	RunQuery(Reloaded, AllQuery, Values);
+	TestTrue(TEXT("Saved indexes should give the same answers"), Values == Paged);
+	
+	FAuditQuery Parsed;
+	FString Error;
+	TestTrue(TEXT("Search text should parse"), FAuditQuery::Parse(TEXT("type:SCENE_EDIT,ASSET_OPERATION actor:\"Cube 1\" since:24h limit:10"), Parsed, Error));
+	TestEqual(TEXT("Types should be split on commas"), Parsed.Types.Num(), 2);
+	TestEqual(TEXT("Quoted values should keep their spaces"), Parsed.Actor, FString(TEXT("Cube 1")));
+	TestEqual(TEXT("Limit should be parsed"), Parsed.MaxResults, 10);
+	TestTrue(TEXT("Since should set the start time"), Parsed.From > FDateTime::Now() - FTimespan::FromHours(25));
+	TestFalse(TEXT("Bad durations should be rejected"), FAuditQuery::Parse(TEXT("since:soon"), Parsed, Error));
+	TestFalse(TEXT("Unknown terms should be rejected"), FAuditQuery::Parse(TEXT("colour:red"), Parsed, Error));
+	TestFalse(TEXT("Terms without values should be rejected"), FAuditQuery::Parse(TEXT("actor"), Parsed, Error));
+	TestTrue(TEXT("Local dates should parse"), FAuditQuery::Parse(TEXT("from:2024-10-27T10:30:00 to:2024-10-28"), Parsed, Error));
+	TestFalse(TEXT("UTC dates should be rejected"), FAuditQuery::Parse(TEXT("from:2024-10-27T10:30:00Z"), Parsed, Error));
+	TestFalse(TEXT("Dates with an offset should be rejected"), FAuditQuery::Parse(TEXT("to:2024-10-27T10:30:00-05:00"), Parsed, Error));
+	TestFalse(TEXT("Cursors without an offset should be rejected"), FAuditQuery::Parse(TEXT("cursor:Audit-1"), Parsed, Error));
+	TestFalse(TEXT("Cursors with a non-numeric offset should be rejected"), FAuditQuery::Parse(TEXT("cursor:Audit-1@12x"), Parsed, Error));
+	
+	// A cursor the engine returned is valid until its segment is deleted
+	PageQuery.Cursor.Reset();
+	PageQuery.MaxResults = 1;
+	const FString Cursor = RunQuery(Engine, PageQuery, Values);
+	TestTrue(TEXT("Returned cursors should be valid"), Engine.IsValidCursor(Cursor, Error));
+	TestTrue(TEXT("Returned cursors should parse as search terms"), FAuditQuery::Parse(TEXT("cursor:") + Cursor, Parsed, Error) && Parsed.Cursor == Cursor);
+	TestFalse(TEXT("Cursors naming an unknown segment should be rejected"), Engine.IsValidCursor(TEXT("Audit-Missing@64"), Error));
+	TestFalse(TEXT("Cursors naming a path should be rejected"), Engine.IsValidCursor(TEXT("../Audit-Missing@64"), Error));
+	
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+/**
+ * Test: Audit Entry Ring Buffer
+ * Verifies that entries past the ring capacity spill to disk and page back in order
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogRingBufferTest, "ChatGPTEditor.AuditLogger.RingBuffer", CHATGPT_TEST_FLAGS)
+
+bool FAuditLogRingBufferTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	Logger.ClearLog();
+	
+	const int64 First = Logger.GetFirstSequence();
+	const int32 NumLogged = FAuditLogger::RingCapacity + FAuditLogger::SpillBlockSize * 2 + 7;
+	for (int32 Index = 0; Index < NumLogged; ++Index)
+	{
+		Logger.LogOperation(FString::Printf(TEXT("Command %d"), Index), TEXT("RING_TEST"), TEXT("Cube_1"), Index % 2 == 0);
+	}
+	
+	TestEqual(TEXT("Every entry should get a sequence"), Logger.GetNextSequence() - First, static_cast<int64>(NumLogged));
+	TestEqual(TEXT("Spilled entries should still be kept"), Logger.GetFirstSequence(), First);
+	TestTrue(TEXT("Memory should hold at most the ring capacity"), Logger.GetNumEntriesInMemory() <= FAuditLogger::RingCapacity);
+	TestEqual(TEXT("GetLogEntries should copy only what is in memory"), Logger.GetLogEntries().Num(), Logger.GetNumEntriesInMemory());
+	
+	// Page through everything, across the disk segments and into the ring
+	int64 Cursor = First;
+	int64 Expected = First;
+	bool bInOrder = true;
+	int32 NumPages = 0;
+	while (Cursor < Logger.GetNextSequence())
+	{
+		Cursor = Logger.VisitEntries(Cursor, 1000, [&](const FAuditLogEntry& Entry)
+		{
+			const int32 Index = static_cast<int32>(Expected - First);
+			bInOrder &= Entry.Sequence == Expected && Entry.UserCommand == FString::Printf(TEXT("Command %d"), Index) && Entry.bWasSuccessful == (Index % 2 == 0);
+			++Expected;
+		});
+		++NumPages;
+	}
+	TestTrue(TEXT("Pages should visit every entry in order"), bInOrder);
+	TestEqual(TEXT("Pages should visit every entry"), Expected - First, static_cast<int64>(NumLogged));
+	TestEqual(TEXT("Pages should hold the requested size"), NumPages, FMath::DivideAndRoundUp(NumLogged, 1000));
+	
+	// The tail comes from memory
+	TArray<FAuditLogEntry> Recent = Logger.GetRecentEntries(3);
+	TestEqual(TEXT("Should return the last 3 entries"), Recent.Num(), 3);
+	if (Recent.Num() == 3)
+	{
+		TestEqual(TEXT("Recent entries should end with the newest"), Recent[2].UserCommand, FString::Printf(TEXT("Command %d"), NumLogged - 1));
+	}
+	
+	// A cursor from before a clear finds nothing older than the clear
+	Logger.ClearLog();
+	TestEqual(TEXT("Clear should drop every entry"), Logger.GetNextSequence() - Logger.GetFirstSequence(), static_cast<int64>(0));
+	int32 NumAfterClear = 0;
+	Logger.VisitEntries(First, 10, [&NumAfterClear](const FAuditLogEntry&) { ++NumAfterClear; });
+	TestEqual(TEXT("An old cursor should find no entries after a clear"), NumAfterClear, 0);
+	
+	return true;
+}
+
 /**
  * Test: Code Block Extraction
  * Verifies that code blocks can be extracted from ChatGPT responses
@@ -237,7 +706,7 @@ bool FPathValidationTest::RunTest(const FString& Parameters)
 	FString ValidPath1 = FPaths::ProjectDir() / TEXT("Config/DefaultEngine.ini");
 	TestTrue(TEXT("Project config path should be valid"), ValidPath1.StartsWith(FPaths::ProjectDir()));
 	
-	FString ValidPath2 = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor/audit.log");
+	FString ValidPath2 = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor/AuditLog");
 	TestTrue(TEXT("Saved directory path should be valid"), ValidPath2.StartsWith(FPaths::ProjectSavedDir()));
 	
 	// Test invalid paths (outside project)
@@ -251,4 +720,954 @@ bool FPathValidationTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+/**
+ * Test: Scene Edit Instancing
+ * Verifies that large mesh spawns and conversion commands are parsed for instancing
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneEditInstancingTest, "ChatGPTEditor.SceneEditing.Instancing", CHATGPT_TEST_FLAGS)
+
+bool FSceneEditInstancingTest::RunTest(const FString& Parameters)
+{
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	
+	// Counts above 100 used to be truncated to their first digits
+	TArray<FSceneEditAction> Actions = Manager.ParseCommand(TEXT("Add 500 cube props"));
+	if (!TestEqual(TEXT("Spawn command should produce one action"), Actions.Num(), 1))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Count should be parsed in full"), Actions[0].Count, 500);
+	TestEqual(TEXT("Mesh should come from the shape name"), Actions[0].MeshPath, FString(TEXT("/Engine/BasicShapes/Cube.Cube")));
+	TestTrue(TEXT("Large mesh spawns should be instanced"), Manager.ShouldSpawnInstanced(Actions[0]));
+	
+	// Small spawns stay actors unless instancing is asked for
+	Actions = Manager.ParseCommand(TEXT("Add 3 props"));
+	TestFalse(TEXT("Small spawns should be actors"), Actions.Num() == 1 && Manager.ShouldSpawnInstanced(Actions[0]));
+	Actions = Manager.ParseCommand(TEXT("Add 3 sphere instances"));
+	TestTrue(TEXT("Explicit instancing should be honoured"), Actions.Num() == 1 && Manager.ShouldSpawnInstanced(Actions[0]));
+	Actions = Manager.ParseCommand(TEXT("Add 500 props as actors"));
+	TestFalse(TEXT("Explicit actors should be honoured"), Actions.Num() == 1 && Manager.ShouldSpawnInstanced(Actions[0]));
+	
+	// Spawns without a shape get no mesh as actors, so they aren't instanced as cubes either
+	Actions = Manager.ParseCommand(TEXT("Add 500 props"));
+	TestFalse(TEXT("Large spawns without a shape should be actors"), Actions.Num() == 1 && Manager.ShouldSpawnInstanced(Actions[0]));
+	
+	// Lights can't be instanced whatever the count
+	Actions = Manager.ParseCommand(TEXT("Add 50 point lights"));
+	TestFalse(TEXT("Lights should never be instanced"), Actions.Num() == 1 && Manager.ShouldSpawnInstanced(Actions[0]));
+	
+	// "replace" contains "place", but this is a conversion, not a spawn
+	Actions = Manager.ParseCommand(TEXT("Replace all props with instances"));
+	TestTrue(TEXT("Conversion command should be parsed"), Actions.Num() == 1 && Actions[0].Operation == ESceneEditOperation::ConvertToInstances);
+	
+	return true;
+}
+
+/**
+ * Test: Scene Edit Locations
+ * Verifies that coordinates and spatial regions are parsed from scene edit commands
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneEditLocationTest, "ChatGPTEditor.SceneEditing.Locations", CHATGPT_TEST_FLAGS)
+
+bool FSceneEditLocationTest::RunTest(const FString& Parameters)
+{
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	TArray<FSceneEditAction> Actions;
+	
+	// Coordinates are a location, not a count
+	Actions = Manager.ParseCommand(TEXT("Add 2 cubes at 100, 200, -50"));
+	if (TestEqual(TEXT("Spawn with location should produce one action"), Actions.Num(), 1))
+	{
+		TestEqual(TEXT("Count should ignore coordinates"), Actions[0].Count, 2);
+		TestEqual(TEXT("Location should be parsed"), Actions[0].Location, FVector(100.0, 200.0, -50.0));
+	}
+	
+	// Regions limit targeted commands
+	Actions = Manager.ParseCommand(TEXT("Delete all lights within 500 units of 100,200,0"));
+	if (TestEqual(TEXT("Delete with region should produce one action"), Actions.Num(), 1))
+	{
+		TestTrue(TEXT("Explicit region should be parsed"), Actions[0].Region.Anchor == ESceneLocationAnchor::Explicit);
+		TestEqual(TEXT("Region radius should be parsed"), Actions[0].Region.Radius, 500.0);
+		TestEqual(TEXT("Region center should be parsed"), Actions[0].Region.Location, FVector(100.0, 200.0, 0.0));
+	}
+	Actions = Manager.ParseCommand(TEXT("Move props near PlayerStart up by 100"));
+	TestTrue(TEXT("PlayerStart region should be parsed"), Actions.Num() == 1 && Actions[0].Region.Anchor == ESceneLocationAnchor::PlayerStart);
+	Actions = Manager.ParseCommand(TEXT("Delete all lights"));
+	TestTrue(TEXT("Commands without a region should not get one"), Actions.Num() == 1 && !Actions[0].Region.IsSet());
+	
+	return true;
+}
+
+/**
+ * Test: Scene Actor Index
+ * Verifies that the actor index follows spawns, tag and label changes and deletions
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneActorIndexTest, "ChatGPTEditor.SceneEditing.ActorIndex", CHATGPT_TEST_FLAGS)
+
+bool FSceneActorIndexTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("SceneActorIndexTestWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World))
+	{
+		return false;
+	}
+	
+	{
+		FSceneActorIndex Index(World);
+		const int32 InitialCount = Index.Num();
+		
+		APointLight* Light = World->SpawnActor<APointLight>();
+		AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>();
+		Prop->Tags.Add(TEXT("Tree"));
+		Prop->SetActorLabel(TEXT("Oak"));
+		Prop->SetFolderPath(TEXT("Foliage/Trees"));
+		
+		TArray<AActor*> Found;
+		Index.FindByClass(ALight::StaticClass(), Found);
+		TestTrue(TEXT("Spawned light should be found through its base class"), Found.Contains(Light));
+		TestEqual(TEXT("Index should track spawned actors"), Index.Num(), InitialCount + 2);
+		
+		// Tags change without a delegate outside the Details panel; a rebuild picks them up
+		Index.Rebuild();
+		Found.Reset();
+		Index.FindByTag(TEXT("Tree"), Found);
+		TestTrue(TEXT("Tagged actor should be found"), Found.Num() == 1 && Found[0] == Prop);
+		
+		Found.Reset();
+		Index.FindByLabel(TEXT("oak"), Found);
+		TestTrue(TEXT("Label lookup should ignore case"), Found.Num() == 1 && Found[0] == Prop);
+		
+		Found.Reset();
+		Index.FindByFolder(TEXT("Foliage"), Found);
+		TestTrue(TEXT("Folder lookup should include subfolders"), Found.Num() == 1 && Found[0] == Prop);
+		
+		// Spatial queries, including after a move made from code
+		Light->SetActorLocation(FVector(5000.0, 0.0, 0.0));
+		Index.UpdateBounds(Light);
+		Found.Reset();
+		Index.FindInSphere(FVector(5000.0, 0.0, 100.0), 200.0, Found);
+		TestTrue(TEXT("Moved actor should be found at its new location"), Found.Contains(Light));
+		Found.Reset();
+		Index.FindInSphere(FVector::ZeroVector, 200.0, Found);
+		TestFalse(TEXT("Moved actor should not be found at its old location"), Found.Contains(Light));
+		Found.Reset();
+		Index.FindInBox(FBox(FVector(4900.0, -100.0, -100.0), FVector(5100.0, 100.0, 100.0)), Found);
+		TestTrue(TEXT("Box query should find the moved actor"), Found.Contains(Light));
+		
+		World->DestroyActor(Prop);
+		Found.Reset();
+		Index.FindByTag(TEXT("Tree"), Found);
+		TestEqual(TEXT("Destroyed actors should not be returned"), Found.Num(), 0);
+	}
+	
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Scene Edit Dry Run
+ * Verifies that planning resolves affected actors without changing the world, and that executing the plan applies it
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneEditDryRunTest, "ChatGPTEditor.SceneEditing.DryRun", CHATGPT_TEST_FLAGS)
+
+bool FSceneEditDryRunTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("SceneEditDryRunTestWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World))
+	{
+		return false;
+	}
+	
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	APointLight* Light = World->SpawnActor<APointLight>(FVector(0.0, 0.0, 50.0), FRotator::ZeroRotator);
+	AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>();
+	
+	// Planning resolves targets and results but leaves everything in place
+	const FSceneEditPlan Plan = Manager.PlanActions(Manager.ParseCommand(TEXT("Move all lights up by 100 and change light color to red")), World);
+	if (TestEqual(TEXT("Plan should have one entry per action"), Plan.Actions.Num(), 2))
+	{
+		const FSceneEditActionPlan& MovePlan = Plan.Actions[0];
+		if (TestEqual(TEXT("Move should affect the light only"), MovePlan.Changes.Num(), 1))
+		{
+			TestTrue(TEXT("Planned change should name the light"), MovePlan.Changes[0].Actor == Light);
+			TestEqual(TEXT("Planned transform should include the offset"), MovePlan.Changes[0].NewTransform.GetLocation(), FVector(0.0, 0.0, 150.0));
+		}
+		TestTrue(TEXT("Color change should record the new value"), Plan.Actions[1].Changes.Num() == 1 && Plan.Actions[1].Color == FLinearColor::Red);
+	}
+	TestEqual(TEXT("Planning should not move actors"), Light->GetActorLocation(), FVector(0.0, 0.0, 50.0));
+	
+	// A preview-only execution doesn't delete
+	Manager.ExecuteActions(Manager.ParseCommand(TEXT("Delete all props")), World, true);
+	TestTrue(TEXT("Preview should not delete actors"), IsValid(Prop));
+	
+	// Executing the plan applies what was resolved
+	TestTrue(TEXT("Plan should execute"), Manager.ExecutePlan(Plan));
+	TestEqual(TEXT("Executed plan should move the light"), Light->GetActorLocation(), FVector(0.0, 0.0, 150.0));
+	TestEqual(TEXT("Executed plan should color the light"), Light->GetLightColor(), FLinearColor::Red);
+	
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Scene Edit Batched Execution
+ * Verifies that a plan with several actions applies as a single undoable transaction
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneEditBatchTest, "ChatGPTEditor.SceneEditing.BatchedExecution", CHATGPT_TEST_FLAGS)
+
+bool FSceneEditBatchTest::RunTest(const FString& Parameters)
+{
+	if (!GEditor || !GEditor->Trans)
+	{
+		AddInfo(TEXT("No editor transaction buffer; skipping"));
+		return true;
+	}
+	
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("SceneEditBatchTestWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World))
+	{
+		return false;
+	}
+	
+	const int32 NumProps = 50;
+	TArray<AStaticMeshActor*> Props;
+	for (int32 Index = 0; Index < NumProps; ++Index)
+	{
+		Props.Add(World->SpawnActor<AStaticMeshActor>(FVector(Index * 100.0, 0.0, 0.0), FRotator::ZeroRotator));
+	}
+	APointLight* Light = World->SpawnActor<APointLight>(FVector::ZeroVector, FRotator::ZeroRotator);
+	
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	const FSceneEditPlan Plan = Manager.PlanActions(Manager.ParseCommand(TEXT("Delete all props and move lights up by 10")), World);
+	
+	const int32 QueueLength = GEditor->Trans->GetQueueLength();
+	TestTrue(TEXT("Plan should execute"), Manager.ExecutePlan(Plan));
+	TestEqual(TEXT("The batch should be one undo entry"), GEditor->Trans->GetQueueLength(), QueueLength + 1);
+	TestFalse(TEXT("Props should be deleted"), Props.ContainsByPredicate([](const AStaticMeshActor* Prop) { return IsValid(Prop); }));
+	TestEqual(TEXT("Light should be moved"), Light->GetActorLocation(), FVector(0.0, 0.0, 10.0));
+	
+	// One undo restores the whole batch
+	GEditor->UndoTransaction();
+	TestTrue(TEXT("Undo should restore deleted props"), Props.ContainsByPredicate([](const AStaticMeshActor* Prop) { return IsValid(Prop); }));
+	TestEqual(TEXT("Undo should restore the light's location"), Light->GetActorLocation(), FVector::ZeroVector);
+	
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Scene Command Grammar
+ * Verifies tokenizing and multi-clause parsing of scene edit commands
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneCommandGrammarTest, "ChatGPTEditor.SceneEditing.CommandGrammar", CHATGPT_TEST_FLAGS)
+
+bool FSceneCommandGrammarTest::RunTest(const FString& Parameters)
+{
+	// Tokens are views into the command; numbers keep their sign and fraction
+	FSceneCommandLexer Lexer(TEXT("Move tag:Tree -12.5, (3)"));
+	const ESceneTokenType ExpectedTypes[] = { ESceneTokenType::Word, ESceneTokenType::Word, ESceneTokenType::Colon, ESceneTokenType::Word,
+		ESceneTokenType::Number, ESceneTokenType::Comma, ESceneTokenType::Number, ESceneTokenType::End };
+	for (ESceneTokenType ExpectedType : ExpectedTypes)
+	{
+		const FSceneToken Token = Lexer.Next();
+		TestTrue(TEXT("Token type should match"), Token.Type == ExpectedType);
+		if (Token.IsNumber() && Token.Text.StartsWith(TEXT("-")))
+		{
+			TestEqual(TEXT("Signed fraction should be parsed"), Token.Number, -12.5);
+		}
+	}
+	
+	// Clauses split before verbs, not inside coordinates
+	TArray<FSceneEditAction> Actions;
+	FSceneCommandParser::Parse(TEXT("add 3 spot lights and move cameras up 200"), Actions);
+	if (TestEqual(TEXT("Two clauses should give two actions"), Actions.Num(), 2))
+	{
+		TestTrue(TEXT("First clause should spawn"), Actions[0].Operation == ESceneEditOperation::SpawnActor);
+		TestEqual(TEXT("Spawn count"), Actions[0].Count, 3);
+		TestEqual(TEXT("Spawn class"), Actions[0].ActorClass, FString(TEXT("spot light")));
+		TestTrue(TEXT("Second clause should move"), Actions[1].Operation == ESceneEditOperation::MoveActor);
+		TestEqual(TEXT("Move pattern"), Actions[1].SearchPattern, FString(TEXT("camera")));
+		TestEqual(TEXT("Move offset"), Actions[1].Location, FVector(0.0, 0.0, 200.0));
+		TestEqual(TEXT("Clause text should be the description"), Actions[1].Description, FString(TEXT("move cameras up 200")));
+	}
+	
+	// Units and directions
+	Actions.Reset();
+	FSceneCommandParser::Parse(TEXT("Shift the props left 2 m, then delete tag:Old"), Actions);
+	if (TestEqual(TEXT("Comma and then should join clauses"), Actions.Num(), 2))
+	{
+		TestEqual(TEXT("Meters should convert to units"), Actions[0].Location, FVector(0.0, -200.0, 0.0));
+		TestEqual(TEXT("Keyed pattern should be kept"), Actions[1].SearchPattern, FString(TEXT("tag:Old")));
+	}
+	
+	// Colors beyond the original three
+	Actions.Reset();
+	FSceneCommandParser::Parse(TEXT("Set the light color to Cyan"), Actions);
+	FLinearColor Color;
+	TestTrue(TEXT("Color should be parsed"), Actions.Num() == 1 && Actions[0].PropertyValue == TEXT("Cyan")
+		&& FSceneCommandParser::FindNamedColor(Actions[0].PropertyValue, Color) && Color == FLinearColor(0.0f, 1.0f, 1.0f));
+	
+	// Numbers are read in full, not matched against every integer
+	Actions.Reset();
+	FSceneCommandParser::Parse(TEXT("Move all props down by 750"), Actions);
+	TestTrue(TEXT("Large offsets should be parsed"), Actions.Num() == 1 && Actions[0].Location == FVector(0.0, 0.0, -750.0));
+	
+	// Words without a verb are not actions
+	Actions.Reset();
+	TestEqual(TEXT("Commands without a verb should give nothing"), FSceneCommandParser::Parse(TEXT("three red lights"), Actions), 0);
+	
+	return true;
+}
+
+/**
+ * Test: Scene Command Parse Throughput
+ * Measures commands parsed per second over a corpus of typical commands and reports it via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneCommandParsePerfTest, "ChatGPTEditor.Perf.SceneCommandParse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSceneCommandParsePerfTest::RunTest(const FString& Parameters)
+{
+	const TCHAR* Corpus[] =
+	{
+		TEXT("Add 5 lights to this room"),
+		TEXT("Place a camera at PlayerStart"),
+		TEXT("Move all props up by 100 units"),
+		TEXT("Add 500 instanced cubes"),
+		TEXT("Convert all props to instances"),
+		TEXT("Delete all trigger volumes"),
+		TEXT("add 3 spot lights and move cameras up 200"),
+		TEXT("Delete all lights within 500 units of 100,200,0"),
+		TEXT("Move props near PlayerStart up by 750"),
+		TEXT("Change light color to red"),
+		TEXT("Add 2 cubes at 100, 200, -50"),
+		TEXT("Spawn 40 spheres here, then set the lights near me to orange"),
+		TEXT("Remove folder:Foliage/Trees and delete tag:Old"),
+		TEXT("Shift the props left 2 m, then move cameras forward 3.5 meters")
+	};
+	const int32 NumActionsPerPass = 18; // Four of the commands have two clauses
+	const int32 NumIterations = 20000;
+	
+	TArray<FSceneEditAction> Actions;
+	int32 NumActions = 0;
+	int32 NumTokens = 0;
+	for (const TCHAR* Command : Corpus)
+	{
+		FSceneCommandLexer Lexer(Command);
+		while (Lexer.Next().Type != ESceneTokenType::End)
+		{
+			++NumTokens;
+		}
+	}
+	
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const TCHAR* Command : Corpus)
+		{
+			Actions.Reset();
+			NumActions += FSceneCommandParser::Parse(Command, Actions);
+		}
+	}
+	const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, KINDA_SMALL_NUMBER);
+	
+	const int32 NumCommands = NumIterations * UE_ARRAY_COUNT(Corpus);
+	AddInfo(FString::Printf(TEXT("Scene command parse: %d commands in %.1f ms (%.0f commands/s, %.0f tokens/s, %.2f us/command)"),
+		NumCommands, Seconds * 1000.0, NumCommands / Seconds, double(NumTokens) * NumIterations / Seconds, Seconds * 1.0e6 / NumCommands));
+	
+	TestEqual(TEXT("Every corpus command should parse"), NumActions, NumIterations * NumActionsPerPass);
+	
+	return true;
+}
+
+/**
+ * Test: Scene Placement Patterns
+ * Verifies grid, ring, scatter and spline layouts and the pattern words of the command grammar
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScenePlacementTest, "ChatGPTEditor.SceneEditing.Placement", CHATGPT_TEST_FLAGS)
+
+bool FScenePlacementTest::RunTest(const FString& Parameters)
+{
+	const FVector Origin(100.0, 200.0, 50.0);
+	FScenePlacementSettings Settings;
+	FScenePlacementBatch Batch;
+	
+	// Grids fill rows of Columns items
+	Settings.Pattern = EScenePlacementPattern::Grid;
+	Settings.Spacing = 50.0;
+	Settings.Columns = 4;
+	FScenePlacement::Generate(Settings, Origin, 10, Batch);
+	if (TestEqual(TEXT("Grid should place every item"), Batch.Num(), 10))
+	{
+		TestEqual(TEXT("Grid wraps after a row"), FVector(Batch.X[5], Batch.Y[5], Batch.Z[5]), Origin + FVector(50.0, 50.0, 0.0));
+	}
+	
+	// Rings keep every item on the radius
+	Settings.Pattern = EScenePlacementPattern::Ring;
+	Settings.Radius = 300.0;
+	FScenePlacement::Generate(Settings, Origin, 12, Batch);
+	bool bOnRadius = Batch.Num() == 12;
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		bOnRadius &= FMath::IsNearlyEqual(FVector2D(Batch.X[Index] - Origin.X, Batch.Y[Index] - Origin.Y).Size(), 300.0, 0.01);
+	}
+	TestTrue(TEXT("Ring items should lie on the radius"), bOnRadius);
+	
+	// Scatters keep the minimum distance and repeat for a seed
+	Settings.Pattern = EScenePlacementPattern::Scatter;
+	Settings.Spacing = 80.0;
+	Settings.Radius = 1000.0;
+	Settings.Seed = 7;
+	FScenePlacementBatch Again;
+	FScenePlacement::Generate(Settings, Origin, 200, Batch);
+	FScenePlacement::Generate(Settings, Origin, 200, Again);
+	TestEqual(TEXT("Scatter should fit 200 items"), Batch.Num(), 200);
+	TestTrue(TEXT("Same seed should give the same scatter"), Batch.X == Again.X && Batch.Y == Again.Y);
+	double MinDistanceSquared = TNumericLimits<double>::Max();
+	for (int32 First = 0; First < Batch.Num(); ++First)
+	{
+		for (int32 Second = First + 1; Second < Batch.Num(); ++Second)
+		{
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, FMath::Square(Batch.X[First] - Batch.X[Second]) + FMath::Square(Batch.Y[First] - Batch.Y[Second]));
+		}
+	}
+	TestTrue(TEXT("Scatter items should keep the spacing"), MinDistanceSquared >= FMath::Square(80.0) - 0.01);
+	
+	// Scatters stop once the disk is full rather than overlapping
+	Settings.Radius = 100.0;
+	FScenePlacement::Generate(Settings, Origin, 500, Batch);
+	TestTrue(TEXT("Full scatters should stop early"), Batch.Num() > 0 && Batch.Num() < 500);
+	
+	// Splines run from the first control point to the last
+	Settings = FScenePlacementSettings();
+	Settings.Pattern = EScenePlacementPattern::Spline;
+	Settings.SplinePoints = { FVector(0.0, 0.0, 0.0), FVector(500.0, 500.0, 0.0), FVector(1000.0, 0.0, 0.0) };
+	TArray<FTransform> Transforms;
+	FScenePlacement::MakeTransforms(nullptr, Settings, Origin, FRotator::ZeroRotator, 9, Transforms);
+	if (TestEqual(TEXT("Spline should place every item"), Transforms.Num(), 9))
+	{
+		TestTrue(TEXT("Spline should start at the first point"), Transforms[0].GetLocation().Equals(FVector::ZeroVector, 0.01));
+		TestTrue(TEXT("Spline should end at the last point"), Transforms.Last().GetLocation().Equals(FVector(1000.0, 0.0, 0.0), 0.01));
+		TestTrue(TEXT("Spline items should face along the curve"), FMath::IsNearlyEqual(Transforms[0].Rotator().Yaw, 45.0, 10.0));
+	}
+	
+	// The grammar picks the pattern and its numbers
+	TArray<FSceneEditAction> Actions;
+	FSceneCommandParser::Parse(TEXT("Add 50 cubes in a grid spaced 2 m"), Actions);
+	TestTrue(TEXT("Grid command should set the pattern"), Actions.Num() == 1 && Actions[0].Placement.Pattern == EScenePlacementPattern::Grid
+		&& Actions[0].Placement.Spacing == 200.0);
+	Actions.Reset();
+	FSceneCommandParser::Parse(TEXT("Place 200 scattered spheres on the ground with radius 5000"), Actions);
+	TestTrue(TEXT("Scatter command should set the pattern"), Actions.Num() == 1 && Actions[0].Placement.Pattern == EScenePlacementPattern::Scatter
+		&& Actions[0].Placement.bSnapToGround && Actions[0].Placement.Radius == 5000.0 && Actions[0].Count == 200);
+	
+	return true;
+}
+
+/**
+ * Test: Scene Placement Throughput
+ * Times generating 10,000 placements for each pattern and reports it via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScenePlacementPerfTest, "ChatGPTEditor.Perf.ScenePlacement", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FScenePlacementPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumItems = 10000;
+	const EScenePlacementPattern Patterns[] = { EScenePlacementPattern::Row, EScenePlacementPattern::Grid, EScenePlacementPattern::Ring,
+		EScenePlacementPattern::Spline, EScenePlacementPattern::Scatter };
+	
+	FScenePlacementSettings Settings;
+	Settings.Radius = 20000.0;
+	Settings.SplinePoints = { FVector(0.0, 0.0, 0.0), FVector(5000.0, 3000.0, 0.0), FVector(10000.0, -2000.0, 500.0), FVector(20000.0, 0.0, 0.0) };
+	
+	TArray<FTransform> Transforms;
+	for (EScenePlacementPattern Pattern : Patterns)
+	{
+		Settings.Pattern = Pattern;
+		const double StartTime = FPlatformTime::Seconds();
+		FScenePlacement::MakeTransforms(nullptr, Settings, FVector::ZeroVector, FRotator::ZeroRotator, NumItems, Transforms);
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		
+		AddInfo(FString::Printf(TEXT("Scene placement (%s): %d items in %.2f ms"), FScenePlacement::GetPatternName(Pattern), Transforms.Num(), Seconds * 1000.0));
+		TestEqual(TEXT("Every item should be placed"), Transforms.Num(), NumItems);
+	}
+	
+	return true;
+}
+
+/**
+ * Test: Scene Property Paths
+ * Verifies resolving dotted property paths, the accessor cache, and generic property changes through a plan
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScenePropertyPathTest, "ChatGPTEditor.SceneEditing.PropertyPaths", CHATGPT_TEST_FLAGS)
+
+bool FScenePropertyPathTest::RunTest(const FString& Parameters)
+{
+	// Paths resolve through components using the subobject classes of the class defaults
+	FString Error;
+	TSharedPtr<const FScenePropertyAccessor> Intensity = FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.Intensity"), Error);
+	TestTrue(TEXT("Component property should resolve"), Intensity.IsValid());
+	TestTrue(TEXT("Accessors should be cached per class and path"), Intensity == FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.Intensity"), Error));
+	TestTrue(TEXT("Subclass properties should resolve through the default subobject"),
+		FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.AttenuationRadius"), Error).IsValid());
+	TestTrue(TEXT("Struct members should resolve"), FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.LightColor.R"), Error).IsValid());
+	
+	TestFalse(TEXT("Unknown properties should not resolve"), FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.NoSuchProperty"), Error).IsValid());
+	TestTrue(TEXT("Errors should name the missing property"), Error.Contains(TEXT("NoSuchProperty")));
+	TestFalse(TEXT("Paths can't continue past a plain value"), FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.Intensity.X"), Error).IsValid());
+	
+	FString Normalized;
+	TestTrue(TEXT("Numbers should import"), Intensity.IsValid() && Intensity->NormalizeValueText(TEXT("2500"), Normalized));
+	TestFalse(TEXT("Bad values should be rejected"), Intensity.IsValid() && Intensity->NormalizeValueText(TEXT("bright"), Normalized));
+	
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("ScenePropertyPathTestWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World))
+	{
+		return false;
+	}
+	
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	APointLight* First = World->SpawnActor<APointLight>(FVector(0.0, 0.0, 0.0), FRotator::ZeroRotator);
+	APointLight* Second = World->SpawnActor<APointLight>(FVector(500.0, 0.0, 0.0), FRotator::ZeroRotator);
+	World->SpawnActor<AStaticMeshActor>();
+	
+	// The grammar takes a dotted path and a value
+	const TArray<FSceneEditAction> Actions = Manager.ParseCommand(TEXT("Set the lights LightComponent.Intensity to 2500"));
+	if (TestEqual(TEXT("Command should give one action"), Actions.Num(), 1))
+	{
+		TestEqual(TEXT("Path should be parsed"), Actions[0].PropertyName, FString(TEXT("LightComponent.Intensity")));
+		TestEqual(TEXT("Value should be parsed"), Actions[0].PropertyValue, FString(TEXT("2500")));
+		
+		const FSceneEditPlan Plan = Manager.PlanActions(Actions, World);
+		TestEqual(TEXT("Both lights should change"), Plan.Actions[0].Changes.Num(), 2);
+		TestTrue(TEXT("Plan should execute"), Manager.ExecutePlan(Plan));
+	}
+	TestEqual(TEXT("First light should be updated"), First->PointLightComponent->Intensity, 2500.0f);
+	TestEqual(TEXT("Second light should be updated"), Second->PointLightComponent->Intensity, 2500.0f);
+	
+	// Actors without the property are left out and reported
+	FSceneEditAction Action;
+	Action.Operation = ESceneEditOperation::ModifyProperty;
+	Action.SearchPattern = TEXT("all");
+	Action.PropertyName = TEXT("LightComponent.AttenuationRadius");
+	Action.PropertyValue = TEXT("750");
+	const FSceneEditActionPlan Mixed = Manager.PlanAction(Action, World);
+	TestEqual(TEXT("Only the lights should be planned"), Mixed.Changes.Num(), 2);
+	TestFalse(TEXT("Skipped actors should be reported"), Mixed.Warning.IsEmpty());
+	
+	// Values already in place aren't written again
+	const FSceneEditPlan Repeat = Manager.PlanActions(Manager.ParseCommand(TEXT("Set lights LightComponent.Intensity to 2500")), World);
+	TestTrue(TEXT("Unchanged values should be left out"), Repeat.Actions.Num() == 1 && Repeat.Actions[0].Changes.Num() == 0);
+	
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Scene Property Batch Throughput
+ * Times planning and applying a property change across thousands of lights and reports it via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScenePropertyBatchPerfTest, "ChatGPTEditor.Perf.ScenePropertyBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FScenePropertyBatchPerfTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("ScenePropertyBatchPerfWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World))
+	{
+		return false;
+	}
+	
+	const int32 NumLights = 2000;
+	for (int32 Index = 0; Index < NumLights; ++Index)
+	{
+		World->SpawnActor<APointLight>(FVector(Index * 100.0, 0.0, 0.0), FRotator::ZeroRotator);
+	}
+	
+	FSceneEditAction Action;
+	Action.Operation = ESceneEditOperation::ModifyProperty;
+	Action.SearchPattern = TEXT("lights");
+	Action.PropertyName = TEXT("LightComponent.Intensity");
+	Action.PropertyValue = TEXT("1234");
+	Action.Description = TEXT("Perf: set light intensity");
+	
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	FScenePropertyAccessor::ResetCache();
+	
+	const double PlanStart = FPlatformTime::Seconds();
+	FSceneEditPlan Plan;
+	Plan.World = World;
+	Plan.Actions.Add(Manager.PlanAction(Action, World));
+	const double ApplyStart = FPlatformTime::Seconds();
+	Manager.ExecutePlan(Plan);
+	const double End = FPlatformTime::Seconds();
+	
+	AddInfo(FString::Printf(TEXT("Set property on %d lights: plan %.1f ms, apply %.1f ms (%.0f actors/s)"), Plan.Actions[0].Changes.Num(),
+		(ApplyStart - PlanStart) * 1000.0, (End - ApplyStart) * 1000.0, Plan.Actions[0].Changes.Num() / FMath::Max(End - PlanStart, KINDA_SMALL_NUMBER)));
+	TestEqual(TEXT("Every light should be planned"), Plan.Actions[0].Changes.Num(), NumLights);
+	
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Scene Edit Journal
+ * Verifies that recorded deltas undo in reverse, survive a round trip through a file and replay into another world
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneEditJournalTest, "ChatGPTEditor.SceneEditing.EditJournal", CHATGPT_TEST_FLAGS)
+
+bool FSceneEditJournalTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("SceneEditJournalTestWorld"));
+	UWorld* Copy = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("SceneEditJournalCopyWorld"));
+	if (!TestNotNull(TEXT("Test world should be created"), World) || !TestNotNull(TEXT("Copy world should be created"), Copy))
+	{
+		return false;
+	}
+	
+	APointLight* Light = World->SpawnActor<APointLight>(FVector::ZeroVector, FRotator::ZeroRotator);
+	AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>(FVector(500.0, 0.0, 0.0), FRotator::ZeroRotator);
+	Prop->SetActorLabel(TEXT("JournalProp"));
+	
+	// The copy has the same actors under the same names, as a duplicated level would
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = Light->GetFName();
+	APointLight* CopyLight = Copy->SpawnActor<APointLight>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	SpawnParams.Name = Prop->GetFName();
+	Copy->SpawnActor<AStaticMeshActor>(FVector(500.0, 0.0, 0.0), FRotator::ZeroRotator, SpawnParams);
+	
+	FString Error;
+	TSharedPtr<const FScenePropertyAccessor> Intensity = FScenePropertyAccessor::Find(APointLight::StaticClass(), TEXT("LightComponent.Intensity"), Error);
+	if (!TestTrue(TEXT("Intensity should resolve"), Intensity.IsValid()))
+	{
+		return false;
+	}
+	const float OldIntensity = Light->PointLightComponent->Intensity;
+	
+	// One batch: spawn a light, move and brighten the existing one, delete the prop
+	FSceneEditJournal Journal;
+	Journal.BeginBatch(TEXT("Journal test"));
+	
+	APointLight* Spawned = World->SpawnActor<APointLight>(FVector(0.0, 300.0, 0.0), FRotator::ZeroRotator);
+	Journal.RecordSpawn(Spawned);
+	
+	const FTransform OldTransform = Light->GetActorTransform();
+	Light->SetActorLocation(FVector(100.0, 0.0, 0.0));
+	Journal.RecordTransform(Light, OldTransform, Light->GetActorTransform());
+	
+	FString OldText;
+	FString NewText;
+	Intensity->GetValueText(Light, OldText);
+	Light->PointLightComponent->Intensity = 2500.0f;
+	Intensity->GetValueText(Light, NewText);
+	Journal.RecordProperty(Light, Intensity->GetPath(), OldText, NewText);
+	
+	Journal.RecordDestroy(Prop);
+	World->EditorDestroyActor(Prop, false);
+	Journal.CommitBatch();
+	
+	TestEqual(TEXT("One batch should be recorded"), Journal.GetNumBatches(), 1);
+	TestTrue(TEXT("Deltas should stay compact"), Journal.GetDataSize() < 512);
+	
+	// Empty batches leave nothing behind
+	const int64 Size = Journal.GetDataSize();
+	Journal.BeginBatch(TEXT("Nothing"));
+	Journal.CommitBatch();
+	TestEqual(TEXT("Empty batches should be dropped"), Journal.GetDataSize(), Size);
+	
+	// Round trip through a file; everything this test writes goes to its own directory, removed at the end
+	const FString JournalDirectory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("SceneEditJournalTest"), FGuid::NewGuid().ToString());
+	const FString Path = FPaths::Combine(JournalDirectory, TEXT("SceneEditJournalTest.scej"));
+	FSceneEditJournal Loaded;
+	TestTrue(TEXT("Journal should save"), Journal.SaveToFile(Path, Error));
+	TestTrue(TEXT("Journal should load"), Loaded.LoadFromFile(Path, Error));
+	TestEqual(TEXT("Loaded journal should have every record"), Loaded.GetNumRecords(), Journal.GetNumRecords());
+	TestEqual(TEXT("Loaded journal should keep its session"), Loaded.GetSessionId(), Journal.GetSessionId());
+	
+	// Replay into the copy, finding its actors by name
+	TestEqual(TEXT("Every edit should replay"), Loaded.Replay(Copy, Error), 4);
+	TestEqual(TEXT("Copy light should move"), CopyLight->GetActorLocation(), FVector(100.0, 0.0, 0.0));
+	TestEqual(TEXT("Copy light should brighten"), CopyLight->PointLightComponent->Intensity, 2500.0f);
+	
+	int32 NumCopyLights = 0;
+	int32 NumCopyProps = 0;
+	for (TActorIterator<AActor> It(Copy); It; ++It)
+	{
+		NumCopyLights += It->IsA<APointLight>() ? 1 : 0;
+		NumCopyProps += It->IsA<AStaticMeshActor>() ? 1 : 0;
+	}
+	TestEqual(TEXT("Copy should get the spawned light"), NumCopyLights, 2);
+	TestEqual(TEXT("Copy prop should be deleted"), NumCopyProps, 0);
+	
+	// Undo the session in the original world
+	Error.Reset();
+	TestEqual(TEXT("Every edit should be reverted"), Journal.UndoSession(World, Error), 4);
+	TestTrue(TEXT("Undo should report no problems"), Error.IsEmpty());
+	TestFalse(TEXT("Spawned light should be removed"), IsValid(Spawned));
+	TestEqual(TEXT("Light should move back"), Light->GetActorLocation(), FVector::ZeroVector);
+	TestEqual(TEXT("Light intensity should be restored"), Light->PointLightComponent->Intensity, OldIntensity);
+	
+	AStaticMeshActor* Restored = nullptr;
+	for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+	{
+		Restored = *It;
+	}
+	TestTrue(TEXT("Deleted prop should be restored with its label"), Restored && Restored->GetActorLabel() == TEXT("JournalProp"));
+	TestEqual(TEXT("Undo should start a new session"), Journal.GetNumRecords(), 0);
+	
+	// A deleted actor comes back as it was, not as its class defaults
+	APointLight* Dimmed = World->SpawnActor<APointLight>(FVector(0.0, -300.0, 0.0), FRotator::ZeroRotator);
+	Dimmed->PointLightComponent->Intensity = 123.0f;
+	Dimmed->PointLightComponent->LightColor = FColor::Red;
+	const FGuid DimmedGuid = Dimmed->GetActorGuid();
+	
+	Journal.BeginBatch(TEXT("Delete light"));
+	Journal.RecordDestroy(Dimmed);
+	World->EditorDestroyActor(Dimmed, false);
+	Journal.CommitBatch();
+	TestEqual(TEXT("Deleting the light should be reverted"), Journal.UndoSession(World, Error), 1);
+	
+	APointLight* Undeleted = nullptr;
+	for (TActorIterator<APointLight> It(World); It; ++It)
+	{
+		Undeleted = It->GetActorGuid() == DimmedGuid ? *It : Undeleted;
+	}
+	if (TestNotNull(TEXT("Deleted light should be restored"), Undeleted))
+	{
+		TestEqual(TEXT("Deleted light should keep its intensity"), Undeleted->PointLightComponent->Intensity, 123.0f);
+		TestEqual(TEXT("Deleted light should keep its color"), Undeleted->PointLightComponent->LightColor, FColor::Red);
+		TestEqual(TEXT("Deleted light should keep its place"), Undeleted->GetActorLocation(), FVector(0.0, -300.0, 0.0));
+	}
+	
+	// Executed plans are journaled by the manager, here into a fresh journal writing to the test directory instead of Saved/
+	FSceneEditingManager& Manager = FSceneEditingManager::Get();
+	Manager.Shutdown();
+	Manager.GetJournal().SetOutputDirectory(JournalDirectory);
+	Manager.ExecutePlan(Manager.PlanActions(Manager.ParseCommand(TEXT("Move lights up by 10")), World));
+	TestEqual(TEXT("Executed plans should be journaled"), Manager.GetJournal().GetNumBatches(), 1);
+	TestTrue(TEXT("Journaled batches should be written to the output directory"),
+		Manager.GetJournal().GetFilePath().StartsWith(JournalDirectory) && FPaths::FileExists(Manager.GetJournal().GetFilePath()));
+	
+	// The next edit gets a journal writing to Saved/ again
+	Manager.Shutdown();
+	IFileManager::Get().DeleteDirectory(*JournalDirectory, false, true);
+	
+	Copy->DestroyWorld(false);
+	World->DestroyWorld(false);
+	return true;
+}
+
+/**
+ * Test: Audit Log Write Cost
+ * Times logging through the writer thread against writing each line directly and reports both via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogWritePerfTest, "ChatGPTEditor.Perf.AuditLogWrite", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAuditLogWritePerfTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	const int32 NumEntries = 2000;
+	
+	// Direct writes open and close the file for every line, as every line did before the writer thread
+	Logger.Shutdown();
+	const double DirectStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Logger.LogEvent(TEXT("PERF_TEST"), FString::Printf(TEXT("Direct entry %d"), Index));
+	}
+	const double DirectSeconds = FPlatformTime::Seconds() - DirectStart;
+	
+	Logger.Initialize();
+	const double QueuedStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Logger.LogEvent(TEXT("PERF_TEST"), FString::Printf(TEXT("Queued entry %d"), Index));
+	}
+	const double QueuedSeconds = FPlatformTime::Seconds() - QueuedStart;
+	const bool bFlushed = Logger.Flush();
+	const double FlushSeconds = FPlatformTime::Seconds() - QueuedStart - QueuedSeconds;
+	
+	AddInfo(FString::Printf(TEXT("Audit log, %d lines: direct %.2f us/line, queued %.2f us/line (%.1fx), flush %.1f ms"), NumEntries,
+		DirectSeconds * 1e6 / NumEntries, QueuedSeconds * 1e6 / NumEntries, DirectSeconds / FMath::Max(QueuedSeconds, KINDA_SMALL_NUMBER), FlushSeconds * 1000.0));
+	TestTrue(TEXT("Flush should finish within its timeout"), bFlushed);
+	
+	return true;
+}
+
+/**
+ * Test: Audit Sink Throughput
+ * Measures formatting and appending each event on the calling thread against submitting typed events to the shared writer, and reports both via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditSinkPerfTest, "ChatGPTEditor.Perf.AuditSink", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAuditSinkPerfTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	const int32 NumEvents = 2000;
+	
+	FAssetAuditLogEntry Entry;
+	Entry.User = FPlatformProcess::UserName();
+	Entry.Operation = TEXT("CreateMaterial");
+	Entry.AssetName = TEXT("M_PerfTest");
+	Entry.bSucceeded = true;
+	Entry.Details = TEXT("Operation completed successfully");
+	
+	const FString ScratchPath = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("AuditSinkPerf.log");
+	const double AppendStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumEvents; ++Index)
+	{
+		const FString Line = FString::Printf(TEXT("[%s] User: %s | Operation: %s | Asset: %s | Success: %s | Details: %s\n"),
+			*Entry.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M:%S")), *Entry.User, *Entry.Operation, *Entry.AssetName,
+			Entry.bSucceeded ? TEXT("YES") : TEXT("NO"), *Entry.Details);
+		FFileHelper::SaveStringToFile(Line, *ScratchPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	}
+	const double AppendSeconds = FPlatformTime::Seconds() - AppendStart;
+	IFileManager::Get().Delete(*ScratchPath);
+	
+	const double SubmitStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumEvents; ++Index)
+	{
+		FAssetAutomation::WriteAuditLog(Entry);
+	}
+	const double SubmitSeconds = FPlatformTime::Seconds() - SubmitStart;
+	const bool bFlushed = Logger.Flush();
+	const double TotalSeconds = FPlatformTime::Seconds() - SubmitStart;
+	
+	AddInfo(FString::Printf(TEXT("Audit events, %d: own append %.2f us/event, shared sink %.2f us/event on the caller (%.1fx), %.2f us/event including the writer"), NumEvents,
+		AppendSeconds * 1e6 / NumEvents, SubmitSeconds * 1e6 / NumEvents, AppendSeconds / FMath::Max(SubmitSeconds, KINDA_SMALL_NUMBER), TotalSeconds * 1e6 / NumEvents));
+	TestTrue(TEXT("Flush should finish within its timeout"), bFlushed);
+	
+	return true;
+}
+
+/**
+ * Test: Audit Log Read Throughput
+ * Measures streaming events back through FAuditLogReader against splitting the same events written as text lines, and reports both via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditLogReadPerfTest, "ChatGPTEditor.Perf.AuditLogRead", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAuditLogReadPerfTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("AuditLogReadPerf");
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	const int32 NumEvents = 20000;
+	
+	FString Text;
+	{
+		FAuditSegmentWriter Writer(Directory);
+		for (int32 Index = 0; Index < NumEvents; ++Index)
+		{
+			FAuditEvent Event(EAuditSource::Asset, TEXT("ASSET_OPERATION"));
+			Event.Add(TEXT("Operation"), TEXT("CreateMaterial"))
+				.Add(TEXT("Asset"), FString::Printf(TEXT("M_PerfTest_%d"), Index))
+				.AddBool(TEXT("Success"), true)
+				.Add(TEXT("Details"), TEXT("Operation completed successfully"));
+			Writer.Add(Event);
+			Event.AppendLine(Text);
+		}
+		Writer.Write(EAuditLogFlushPolicy::Batch, false);
+	}
+	const FString TextPath = Directory / TEXT("AuditLogReadPerf.log");
+	FFileHelper::SaveStringToFile(Text, *TextPath);
+	
+	// Text needs each line split into fields before anything can filter on them
+	const double TextStart = FPlatformTime::Seconds();
+	FString Loaded;
+	FFileHelper::LoadFileToString(Loaded, *TextPath);
+	TArray<FString> Lines;
+	Loaded.ParseIntoArrayLines(Lines);
+	int32 NumTextMatches = 0;
+	TArray<FString> Fields;
+	for (const FString& Line : Lines)
+	{
+		Line.ParseIntoArray(Fields, TEXT(" | "));
+		NumTextMatches += Fields.Contains(TEXT("Success: YES")) ? 1 : 0;
+	}
+	const double TextSeconds = FPlatformTime::Seconds() - TextStart;
+	
+	const double ReadStart = FPlatformTime::Seconds();
+	int32 NumRecordMatches = 0;
+	FAuditLogReader Reader;
+	Reader.ReadDirectory(Directory, [&NumRecordMatches](const FAuditEvent& Event)
+	{
+		NumRecordMatches += Event.Fields.Num() > 2 && Event.Fields[2].Value == TEXT("YES") ? 1 : 0;
+		return true;
+	});
+	const double ReadSeconds = FPlatformTime::Seconds() - ReadStart;
+	
+	AddInfo(FString::Printf(TEXT("Audit log read, %d events: text %.2f us/event, records %.2f us/event (%.1fx); %lld bytes as text, %lld as records"), NumEvents,
+		TextSeconds * 1e6 / NumEvents, ReadSeconds * 1e6 / NumEvents, TextSeconds / FMath::Max(ReadSeconds, KINDA_SMALL_NUMBER),
+		IFileManager::Get().FileSize(*TextPath), IFileManager::Get().FileSize(*FAuditLogReader::FindSegments(Directory)[0])));
+	TestEqual(TEXT("Text lines should all be found"), NumTextMatches, NumEvents);
+	TestEqual(TEXT("Records should all be read back"), NumRecordMatches, NumEvents);
+	
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+/**
+ * Test: Audit Query Throughput
+ * Measures an indexed actor query, cold and warm, against reading every segment through FAuditLogReader, and reports them via AddInfo
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAuditQueryPerfTest, "ChatGPTEditor.Perf.AuditQuery", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAuditQueryPerfTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("ChatGPTEditor") / TEXT("AuditQueryPerf");
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	const int32 NumSegments = 8;
+	const int32 EventsPerSegment = 10000;
+	const FString Target = FString::Printf(TEXT("Actor_%d_%d"), NumSegments / 2, EventsPerSegment / 2);
+	
+	{
+		FAuditSegmentWriter Writer(Directory);
+		for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+		{
+			for (int32 Index = 0; Index < EventsPerSegment; ++Index)
+			{
+				FAuditEvent Event(EAuditSource::SceneEdit, TEXT("SCENE_EDIT"));
+				Event.Add(TEXT("Command"), TEXT("move the cube up"))
+					.Add(TEXT("Operation"), TEXT("Move"))
+					.Add(TEXT("Affected"), FString::Printf(TEXT("Actor_%d_%d"), Segment, Index))
+					.AddBool(TEXT("Success"), true);
+				Writer.Add(Event);
+			}
+			Writer.Write(EAuditLogFlushPolicy::Batch, false);
+			Writer.Rotate();
+		}
+	}
+	TestTrue(TEXT("Closed segments should be compressed within the timeout"), FAuditSegmentWriter::WaitForCompression(FAuditLogger::DefaultFlushTimeoutSeconds));
+	
+	const double ScanStart = FPlatformTime::Seconds();
+	int32 NumScanMatches = 0;
+	FAuditLogReader Reader;
+	Reader.ReadDirectory(Directory, [&NumScanMatches, &Target](const FAuditEvent& Event)
+	{
+		NumScanMatches += Event.Fields.Num() > 2 && Event.Fields[2].Value == Target ? 1 : 0;
+		return true;
+	});
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+	
+	FAuditLogQueryEngine Engine(Directory);
+	FAuditQuery Query;
+	Query.Actor = Target;
+	int32 NumColdMatches = 0;
+	int32 NumWarmMatches = 0;
+	FAuditQueryStats ColdStats;
+	FAuditQueryStats WarmStats;
+	Engine.Query(Query, [&NumColdMatches](const FAuditEvent&) { ++NumColdMatches; return true; }, &ColdStats);
+	Engine.Query(Query, [&NumWarmMatches](const FAuditEvent&) { ++NumWarmMatches; return true; }, &WarmStats);
+	
+	AddInfo(FString::Printf(TEXT("Audit query, %d events in %d segments: full scan %.2f ms; indexed query %.2f ms cold (building the index), %.3f ms warm, %d of %d segments skipped, %lld events decoded"),
+		NumSegments * EventsPerSegment, NumSegments, ScanSeconds * 1000.0, ColdStats.Seconds * 1000.0, WarmStats.Seconds * 1000.0,
+		WarmStats.NumSegmentsSkipped, WarmStats.NumSegments, WarmStats.NumEventsScanned));
+	TestEqual(TEXT("The scan should find the actor once"), NumScanMatches, 1);
+	TestEqual(TEXT("The cold query should find the actor once"), NumColdMatches, 1);
+	TestEqual(TEXT("The warm query should find the actor once"), NumWarmMatches, 1);
+	
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
 #undef CHATGPT_TEST_FLAGS
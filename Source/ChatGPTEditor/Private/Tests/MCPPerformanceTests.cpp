@@ -0,0 +1,581 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/**
+ * MCP Performance Tests
+ *
+ * These tests measure MCP server hot paths and report timings via AddInfo:
+ * - Tool registry contention under concurrent tools/call
+ * - Streaming response writer vs. FJsonObject + TJsonWriter responses
+ * - Batched thread-safe tool calls vs. the same calls sent one at a time
+ * - Pipelined request throughput over the localhost TCP transport
+ * - Per-message method dispatch cost
+ * - Latency histogram recording under contention
+ *
+ * Run these tests via:
+ * Session Frontend -> Automation tab -> Filter: "MCP.Perf"
+ * Or via command line:
+ * UnrealEditor-Cmd.exe ProjectName -ExecCmds="Automation RunTests MCP.Perf" -unattended -nopause -nosplash -nullrhi
+ */
+
+#include "Misc/AutomationTest.h"
+#include "MCP/MCPServer.h"
+#include "MCP/MCPTool.h"
+#include "MCP/MCPJsonWriter.h"
+#include "MCP/MCPServerStats.h"
+#include "MCP/MCPTransport.h"
+#include "MCP/Tools/EchoTool.h"
+#include "Async/Async.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+
+// Perf tests are heavier than smoke tests and are excluded from the default smoke run
+#define MCP_PERF_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace MCPPerfTests
+{
+	/** Tool that simulates a slow editor operation (e.g. a large spawn_actor call) */
+	class FSlowTool : public FMCPToolBase
+	{
+	public:
+		FSlowTool(float InSleepSeconds)
+			: FMCPToolBase(TEXT("slow"), TEXT("Sleeps to simulate a long-running tool"))
+			, SleepSeconds(InSleepSeconds)
+		{
+		}
+
+		virtual TSharedPtr<FJsonObject> GetInputSchema() const override
+		{
+			TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+			Schema->SetStringField(TEXT("type"), TEXT("object"));
+			return Schema;
+		}
+
+		virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override
+		{
+			FPlatformProcess::Sleep(SleepSeconds);
+			return CreateSuccessResponse(TEXT("done"));
+		}
+
+	private:
+		float SleepSeconds;
+	};
+
+	/** Slow tool that does not touch editor state, so batches may run it concurrently */
+	class FSlowThreadSafeTool : public FSlowTool
+	{
+	public:
+		FSlowThreadSafeTool(float InSleepSeconds)
+			: FSlowTool(InSleepSeconds)
+		{
+		}
+
+		virtual bool IsThreadSafe() const override { return true; }
+	};
+
+	static FString MakeToolsCall(int32 Id, const TCHAR* ToolName)
+	{
+		return FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":%d,"method":"tools/call","params":{"name":"%s","arguments":{}}})"), Id, ToolName);
+	}
+
+	/** Runs NumCallers concurrent callers, each issuing CallsPerCaller messages; returns wall time in seconds */
+	static double RunConcurrentCallers(FMCPServer& Server, int32 NumCallers, int32 CallsPerCaller, TFunction<FString(int32)> MakeMessage)
+	{
+		TArray<TFuture<void>> Callers;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 CallerIndex = 0; CallerIndex < NumCallers; ++CallerIndex)
+		{
+			Callers.Add(Async(EAsyncExecution::Thread, [&Server, CallerIndex, CallsPerCaller, MakeMessage]()
+			{
+				for (int32 Call = 0; Call < CallsPerCaller; ++Call)
+				{
+					Server.ProcessMessage(MakeMessage(CallerIndex * CallsPerCaller + Call));
+				}
+			}));
+		}
+
+		for (TFuture<void>& Caller : Callers)
+		{
+			Caller.Wait();
+		}
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+/**
+ * Test: Registry Contention
+ * Concurrent tools/call of a slow tool must overlap instead of serializing on the registry,
+ * and tools/list must stay fast while slow tools are executing.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPRegistryContentionTest, "MCP.Perf.RegistryContention", MCP_PERF_TEST_FLAGS)
+
+bool FMCPRegistryContentionTest::RunTest(const FString& Parameters)
+{
+	using namespace MCPPerfTests;
+
+	const float ToolSleepSeconds = 0.02f;
+	const int32 NumCallers = 8;
+	const int32 CallsPerCaller = 5;
+
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FSlowTool>(ToolSleepSeconds));
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+
+	// Serial baseline: one caller doing all the work
+	const double SerialSeconds = RunConcurrentCallers(MCPServer, 1, NumCallers * CallsPerCaller,
+		[](int32 Id) { return MakeToolsCall(Id, TEXT("slow")); });
+
+	// Concurrent: the same amount of work split across callers
+	const double ConcurrentSeconds = RunConcurrentCallers(MCPServer, NumCallers, CallsPerCaller,
+		[](int32 Id) { return MakeToolsCall(Id, TEXT("slow")); });
+
+	const double Speedup = SerialSeconds / FMath::Max(ConcurrentSeconds, KINDA_SMALL_NUMBER);
+	AddInfo(FString::Printf(TEXT("Slow tools/call x%d: serial %.1f ms, %d callers %.1f ms, speedup %.2fx"),
+		NumCallers * CallsPerCaller, SerialSeconds * 1000.0, NumCallers, ConcurrentSeconds * 1000.0, Speedup));
+
+	// With the registry lock held across Execute the speedup would be ~1x
+	TestTrue(TEXT("Concurrent tools/call should scale with callers"), Speedup > NumCallers * 0.5);
+
+	// tools/list and registration latency while slow calls are in flight
+	TFuture<double> SlowCalls = Async(EAsyncExecution::Thread, [&MCPServer, NumCallers, CallsPerCaller]()
+	{
+		return RunConcurrentCallers(MCPServer, NumCallers, CallsPerCaller,
+			[](int32 Id) { return MakeToolsCall(Id, TEXT("slow")); });
+	});
+
+	FPlatformProcess::Sleep(ToolSleepSeconds * 0.5f);
+
+	const int32 NumListCalls = 200;
+	const FString ListRequest = TEXT(R"({"jsonrpc":"2.0","id":1,"method":"tools/list"})");
+	const double ListStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumListCalls; ++Index)
+	{
+		MCPServer.ProcessMessage(ListRequest);
+		MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	}
+	const double ListSeconds = FPlatformTime::Seconds() - ListStart;
+	SlowCalls.Wait();
+
+	AddInfo(FString::Printf(TEXT("tools/list + RegisterTool during slow calls: %.3f ms per iteration"),
+		ListSeconds * 1000.0 / NumListCalls));
+	TestTrue(TEXT("tools/list should not wait for in-flight tool execution"), ListSeconds < ToolSleepSeconds * CallsPerCaller);
+
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: Response Writer
+ * Compares the previous DOM response path (FJsonObject tree -> TJsonWriter -> FString -> UTF-8)
+ * with FMCPJsonWriter streaming the same tool result into a reused UTF-8 buffer.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPResponseWriterPerfTest, "MCP.Perf.ResponseWriter", MCP_PERF_TEST_FLAGS)
+
+bool FMCPResponseWriterPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumContentItems = 2000;
+	const int32 NumIterations = 20;
+	
+	// A large tool result: many text blocks, like a scene dump or audit query
+	TArray<FString> Lines;
+	for (int32 Index = 0; Index < NumContentItems; ++Index)
+	{
+		Lines.Add(FString::Printf(TEXT("Actor_%d \"StaticMeshActor\" at (X=%d.5, Y=%d.25, Z=100.0) folder=/Props/Batch_%d"), Index, Index * 10, Index * 7, Index / 50));
+	}
+	
+	// DOM path, as CreateSuccessResponse used to do it
+	int32 DomUtf8Bytes = 0;
+	const double DomStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		TArray<TSharedPtr<FJsonValue>> ContentArray;
+		for (const FString& Line : Lines)
+		{
+			TSharedPtr<FJsonObject> TextContent = MakeShared<FJsonObject>();
+			TextContent->SetStringField(TEXT("type"), TEXT("text"));
+			TextContent->SetStringField(TEXT("text"), Line);
+			ContentArray.Add(MakeShared<FJsonValueObject>(TextContent));
+		}
+		
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetArrayField(TEXT("content"), ContentArray);
+		
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+		Response->SetNumberField(TEXT("id"), Iteration);
+		Response->SetObjectField(TEXT("result"), Result);
+		
+		FString ResponseString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+		FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+		
+		FTCHARToUTF8 Utf8Response(*ResponseString);
+		DomUtf8Bytes = Utf8Response.Length();
+	}
+	const double DomSeconds = (FPlatformTime::Seconds() - DomStart) / NumIterations;
+	
+	// Streaming path into a buffer reused across responses
+	TArray<uint8> ResponseBuffer;
+	int32 StreamGrowths = 0;
+	int32 WarmStreamGrowths = 0;
+	const double StreamStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		ResponseBuffer.Reset();
+		FMCPJsonWriter Writer(ResponseBuffer);
+		Writer.BeginResultResponse(Iteration);
+		Writer.WriteObjectStart();
+		Writer.WriteArrayStart("content");
+		for (const FString& Line : Lines)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue("type", TEXT("text"));
+			Writer.WriteValue("text", Line);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+		Writer.EndResponse();
+		
+		StreamGrowths += Writer.GetNumBufferGrowths();
+		if (Iteration > 0)
+		{
+			WarmStreamGrowths += Writer.GetNumBufferGrowths();
+		}
+	}
+	const double StreamSeconds = (FPlatformTime::Seconds() - StreamStart) / NumIterations;
+	
+	AddInfo(FString::Printf(TEXT("DOM path:       %.3f ms/response, %d bytes out"),
+		DomSeconds * 1000.0, DomUtf8Bytes));
+	AddInfo(FString::Printf(TEXT("Streaming path: %.3f ms/response, %d buffer growths (%d after warm-up), %d bytes out"),
+		StreamSeconds * 1000.0, StreamGrowths, WarmStreamGrowths, ResponseBuffer.Num()));
+	
+	TestEqual(TEXT("Warm reused buffer should not reallocate"), WarmStreamGrowths, 0);
+	
+	// Both paths must produce equivalent JSON
+	TSharedPtr<FJsonObject> Parsed;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FMCPJsonWriter::ToString(ResponseBuffer));
+	TestTrue(TEXT("Streamed response should parse"), FJsonSerializer::Deserialize(Reader, Parsed) && Parsed.IsValid());
+	if (Parsed.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>& Content = Parsed->GetObjectField(TEXT("result"))->GetArrayField(TEXT("content"));
+		TestEqual(TEXT("Streamed content count"), Content.Num(), NumContentItems);
+		if (Content.Num() > 0)
+		{
+			TestEqual(TEXT("Streamed text should round-trip escapes"), Content[0]->AsObject()->GetStringField(TEXT("text")), Lines[0]);
+		}
+	}
+	
+	return true;
+}
+
+/**
+ * Test: Batch Concurrency
+ * Sends N slow thread-safe tool calls one by one, then as a single JSON-RPC batch.
+ * Thread-safe batch entries fan out on the task graph, so the batch should take roughly one call's time.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPBatchConcurrencyPerfTest, "MCP.Perf.BatchConcurrency", MCP_PERF_TEST_FLAGS)
+
+bool FMCPBatchConcurrencyPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace MCPPerfTests;
+
+	const float ToolSleepSeconds = 0.05f;
+	const int32 NumCalls = 8;
+
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FSlowThreadSafeTool>(ToolSleepSeconds));
+
+	// Sequential: one request per message
+	const double SequentialStart = FPlatformTime::Seconds();
+	for (int32 Id = 0; Id < NumCalls; ++Id)
+	{
+		MCPServer.ProcessMessage(MakeToolsCall(Id, TEXT("slow")));
+	}
+	const double SequentialSeconds = FPlatformTime::Seconds() - SequentialStart;
+
+	// Batched: all requests in one message
+	FString BatchRequest = TEXT("[");
+	for (int32 Id = 0; Id < NumCalls; ++Id)
+	{
+		if (Id > 0)
+		{
+			BatchRequest += TEXT(",");
+		}
+		BatchRequest += MakeToolsCall(Id, TEXT("slow"));
+	}
+	BatchRequest += TEXT("]");
+
+	const double BatchStart = FPlatformTime::Seconds();
+	const FString BatchResponse = MCPServer.ProcessMessage(BatchRequest);
+	const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+	const double Speedup = SequentialSeconds / FMath::Max(BatchSeconds, KINDA_SMALL_NUMBER);
+	AddInfo(FString::Printf(TEXT("Slow tools/call x%d: sequential %.1f ms, batched %.1f ms, speedup %.2fx"),
+		NumCalls, SequentialSeconds * 1000.0, BatchSeconds * 1000.0, Speedup));
+
+	TArray<TSharedPtr<FJsonValue>> Responses;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BatchResponse);
+	TestTrue(TEXT("Batch response should parse"), FJsonSerializer::Deserialize(Reader, Responses));
+	TestEqual(TEXT("Batch should answer every call"), Responses.Num(), NumCalls);
+	TestTrue(TEXT("Thread-safe batch entries should run concurrently"), Speedup > 2.0);
+
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: TCP Transport Throughput
+ * A local client pipelines thousands of requests over the loopback transport and reads the
+ * responses back, measuring end-to-end requests per second through framing, dispatch and the writer queue.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPTcpTransportThroughputPerfTest, "MCP.Perf.TcpTransportThroughput", MCP_PERF_TEST_FLAGS)
+
+bool FMCPTcpTransportThroughputPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumRequests = 5000;
+	const double TimeoutSeconds = 30.0;
+
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+
+	// tools/list and echo are thread-safe, so skip the game thread hop (this test blocks it)
+	TSharedRef<FMCPTcpTransport, ESPMode::ThreadSafe> Transport = MakeShared<FMCPTcpTransport, ESPMode::ThreadSafe>(MCPServer, 0);
+	Transport->SetDispatchOnGameThread(false);
+	if (!Transport->Start())
+	{
+		AddError(TEXT("Failed to start TCP transport"));
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* Client = FTcpSocketBuilder(TEXT("MCPPerfClient")).Build();
+	const bool bConnected = Client && Client->Connect(*FIPv4Endpoint(FIPv4Address::InternalLoopback, static_cast<uint16>(Transport->GetBoundPort())).ToInternetAddr());
+	TestTrue(TEXT("Client should connect to the transport"), bConnected);
+
+	if (bConnected)
+	{
+		// Alternate cached tools/list and echo calls, all written up front (pipelined)
+		FString RequestText;
+		for (int32 Id = 0; Id < NumRequests; ++Id)
+		{
+			RequestText += (Id % 2 == 0)
+				? FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":%d,"method":"tools/list"})"), Id)
+				: FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":%d,"method":"tools/call","params":{"name":"echo","arguments":{"message":"ping %d"}}})"), Id, Id);
+			RequestText += TEXT("\n");
+		}
+		FTCHARToUTF8 RequestUtf8(*RequestText, RequestText.Len());
+
+		const double Start = FPlatformTime::Seconds();
+
+		TFuture<void> Writer = Async(EAsyncExecution::Thread, [Client, &RequestUtf8]()
+		{
+			const uint8* Data = reinterpret_cast<const uint8*>(RequestUtf8.Get());
+			int32 Remaining = RequestUtf8.Length();
+			while (Remaining > 0)
+			{
+				int32 BytesSent = 0;
+				if (!Client->Send(Data, Remaining, BytesSent))
+				{
+					break;
+				}
+				Data += BytesSent;
+				Remaining -= BytesSent;
+			}
+		});
+
+		// Count response lines as they stream back
+		int32 NumResponses = 0;
+		int64 BytesReceived = 0;
+		TArray<uint8> ReadBuffer;
+		ReadBuffer.SetNumUninitialized(64 * 1024);
+		while (NumResponses < NumRequests && FPlatformTime::Seconds() - Start < TimeoutSeconds)
+		{
+			if (!Client->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(100)))
+			{
+				continue;
+			}
+
+			int32 BytesRead = 0;
+			if (!Client->Recv(ReadBuffer.GetData(), ReadBuffer.Num(), BytesRead) || BytesRead == 0)
+			{
+				break;
+			}
+
+			BytesReceived += BytesRead;
+			for (int32 Index = 0; Index < BytesRead; ++Index)
+			{
+				NumResponses += ReadBuffer[Index] == '\n' ? 1 : 0;
+			}
+		}
+
+		const double Seconds = FPlatformTime::Seconds() - Start;
+		Writer.Wait();
+
+		AddInfo(FString::Printf(TEXT("TCP transport: %d pipelined requests in %.1f ms (%.0f req/s, %.1f MB/s out)"),
+			NumResponses, Seconds * 1000.0, NumResponses / FMath::Max(Seconds, KINDA_SMALL_NUMBER),
+			BytesReceived / (1024.0 * 1024.0) / FMath::Max(Seconds, KINDA_SMALL_NUMBER)));
+
+		TestEqual(TEXT("Every request should get a response"), NumResponses, NumRequests);
+		TestTrue(TEXT("Transport should sustain thousands of requests per second"), NumResponses / FMath::Max(Seconds, KINDA_SMALL_NUMBER) > 1000.0);
+	}
+
+	if (Client)
+	{
+		Client->Close();
+		SocketSubsystem->DestroySocket(Client);
+	}
+
+	Transport->Stop();
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: Method Dispatch
+ * Measures the per-message cost of resolving a method through the FName dispatch table, next to
+ * the FString compare chain it replaced, with 32 registered methods.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPMethodDispatchPerfTest, "MCP.Perf.MethodDispatch", MCP_PERF_TEST_FLAGS)
+
+bool FMCPMethodDispatchPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumMethods = 32;
+	const int32 NumIterations = 200000;
+
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+
+	TArray<FString> MethodNames;
+	for (int32 Index = 0; Index < NumMethods; ++Index)
+	{
+		MethodNames.Add(FString::Printf(TEXT("bench/method_%02d"), Index));
+		MCPServer.RegisterMethodHandler(MethodNames.Last(), FMCPMethodHandler::CreateLambda([](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			Writer.BeginResultResponse(Request.Id);
+			Writer.WriteNull();
+			Writer.EndResponse();
+			return true;
+		}));
+	}
+
+	// Incoming method strings are distinct allocations, as they would be after JSON parsing
+	TArray<FString> IncomingMethods;
+	for (int32 Index = 0; Index < NumIterations; ++Index)
+	{
+		IncomingMethods.Add(FString(*MethodNames[(Index * 7) % NumMethods]));
+	}
+
+	// Previous approach: compare against each method in turn
+	int32 ChainHits = 0;
+	const double ChainStart = FPlatformTime::Seconds();
+	for (const FString& Method : IncomingMethods)
+	{
+		for (const FString& Candidate : MethodNames)
+		{
+			if (Method == Candidate)
+			{
+				++ChainHits;
+				break;
+			}
+		}
+	}
+	const double ChainSeconds = FPlatformTime::Seconds() - ChainStart;
+
+	// Table lookup, as DispatchRequest does it
+	FMCPMethodTable Table;
+	for (const FString& Method : MethodNames)
+	{
+		FMCPMethodEntry Entry;
+		Entry.Method = Method;
+		Table.Methods.Add(FName(*Method), Entry);
+	}
+
+	int32 TableHits = 0;
+	const double TableStart = FPlatformTime::Seconds();
+	for (const FString& Method : IncomingMethods)
+	{
+		TableHits += Table.Find(Method) ? 1 : 0;
+	}
+	const double TableSeconds = FPlatformTime::Seconds() - TableStart;
+
+	// End to end through the server (parse + dispatch + write)
+	const int32 NumMessages = 20000;
+	TArray<uint8> ResponseBuffer;
+	const FString Message = FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":1,"method":"%s"})"), *MethodNames.Last());
+	const double ServerStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumMessages; ++Index)
+	{
+		ResponseBuffer.Reset();
+		MCPServer.ProcessMessage(Message, ResponseBuffer);
+	}
+	const double ServerSeconds = FPlatformTime::Seconds() - ServerStart;
+
+	AddInfo(FString::Printf(TEXT("Method resolution (%d methods): compare chain %.1f ns/msg, FName table %.1f ns/msg"),
+		NumMethods, ChainSeconds * 1.0e9 / NumIterations, TableSeconds * 1.0e9 / NumIterations));
+	AddInfo(FString::Printf(TEXT("ProcessMessage end to end: %.2f us/msg"), ServerSeconds * 1.0e6 / NumMessages));
+
+	TestEqual(TEXT("Compare chain should resolve every method"), ChainHits, NumIterations);
+	TestEqual(TEXT("Table should resolve every method"), TableHits, NumIterations);
+	TestTrue(TEXT("Server should answer through the table"), FMCPJsonWriter::ToString(ResponseBuffer).Contains(TEXT("\"result\":null")));
+
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: Latency Histogram
+ * Recording must stay cheap with many threads hitting the same histogram, and percentiles must
+ * land within the histogram's bucket precision.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPLatencyHistogramPerfTest, "MCP.Perf.LatencyHistogram", MCP_PERF_TEST_FLAGS)
+
+bool FMCPLatencyHistogramPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumThreads = 8;
+	const int32 RecordsPerThread = 250000;
+
+	FMCPLatencyHistogram Histogram;
+
+	// Uniform 1..10000us, so the true p50/p99 are ~5000us/~9900us
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<TFuture<void>> Writers;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Writers.Add(Async(EAsyncExecution::Thread, [&Histogram, RecordsPerThread]()
+		{
+			for (int32 Index = 0; Index < RecordsPerThread; ++Index)
+			{
+				Histogram.RecordMicros(static_cast<uint64>(Index % 10000) + 1);
+			}
+		}));
+	}
+	for (TFuture<void>& Writer : Writers)
+	{
+		Writer.Wait();
+	}
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	const FMCPLatencySummary Summary = Histogram.Summarize();
+	const int64 TotalRecords = static_cast<int64>(NumThreads) * RecordsPerThread;
+
+	AddInfo(FString::Printf(TEXT("%d threads x %d records: %.1f ns/record (wall), p50 %.0fus, p99 %.0fus, max %.0fus"),
+		NumThreads, RecordsPerThread, Seconds * 1.0e9 / TotalRecords, Summary.P50Micros, Summary.P99Micros, Summary.MaxMicros));
+
+	TestEqual(TEXT("No records should be lost"), Summary.Count, TotalRecords);
+	TestEqual(TEXT("Max should be exact"), Summary.MaxMicros, 10000.0);
+	TestTrue(TEXT("p50 should be within bucket precision"), FMath::IsNearlyEqual(Summary.P50Micros, 5000.0, 5000.0 * 0.07));
+	TestTrue(TEXT("p99 should be within bucket precision"), FMath::IsNearlyEqual(Summary.P99Micros, 9900.0, 9900.0 * 0.07));
+
+	return true;
+}
+
+#undef MCP_PERF_TEST_FLAGS
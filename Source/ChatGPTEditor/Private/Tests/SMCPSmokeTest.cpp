@@ -19,8 +19,18 @@
 #include "MCP/MCPServer.h"
 #include "MCP/MCPTool.h"
 #include "MCP/MCPTypes.h"
+#include "MCP/MCPJsonWriter.h"
+#include "MCP/MCPMessageFramer.h"
+#include "MCP/MCPSchemaValidator.h"
+#include "MCP/Tools/EchoTool.h"
+#include "MCP/Tools/SpawnActorsTool.h"
+#include "MCP/Tools/AuditQueryMethod.h"
+#include "AuditLogger.h"
 #include "Json.h"
 #include "JsonObjectConverter.h"
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
 
 // Test flags for MCP smoke tests
 #define MCP_SMOKE_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
@@ -401,3 +411,820 @@ bool FMCPInvalidRequestTest::RunTest(const FString& Parameters)
 	MCPServer.Shutdown();
 	return true;
 }
+
+/**
+ * Test: MCP Tool Registry Snapshots
+ * Verifies that registry snapshots are immutable and that registration swaps in a new one
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPToolRegistrySnapshotTest, "MCP.Smoke.ToolRegistrySnapshot", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPToolRegistrySnapshotTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	
+	FMCPToolRegistryPtr EmptySnapshot = MCPServer.GetToolRegistry();
+	TestTrue(TEXT("Initial snapshot should be valid"), EmptySnapshot.IsValid());
+	
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	FMCPToolRegistryPtr EchoSnapshot = MCPServer.GetToolRegistry();
+	
+	TestNotEqual(TEXT("Registration should publish a new snapshot"), EmptySnapshot.Get(), EchoSnapshot.Get());
+	TestEqual(TEXT("Old snapshot should be unchanged"), EmptySnapshot->Tools.Num(), 0);
+	TestTrue(TEXT("New snapshot should contain echo"), EchoSnapshot->Tools.Contains(TEXT("echo")));
+	TestTrue(TEXT("FindTool should resolve echo"), MCPServer.FindTool(TEXT("echo")).IsValid());
+	
+	MCPServer.UnregisterTool(TEXT("echo"));
+	TestFalse(TEXT("Echo should be gone from the current snapshot"), MCPServer.FindTool(TEXT("echo")).IsValid());
+	TestTrue(TEXT("Held snapshot should still contain echo"), EchoSnapshot->Tools.Contains(TEXT("echo")));
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: MCP Tools List Cache
+ * Verifies that tools/list is served from the versioned cache and that changes are announced
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPToolsListCacheTest, "MCP.Smoke.ToolsListCache", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPToolsListCacheTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	
+	TArray<FString> Notifications;
+	MCPServer.OnNotification().AddLambda([&Notifications](const FString& NotificationJson)
+	{
+		Notifications.Add(NotificationJson);
+	});
+	
+	const uint64 InitialGeneration = MCPServer.GetToolRegistry()->Generation;
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	
+	TestTrue(TEXT("Registration should bump the registry generation"), MCPServer.GetToolRegistry()->Generation > InitialGeneration);
+	TestEqual(TEXT("Registration should send one notification"), Notifications.Num(), 1);
+	if (Notifications.Num() > 0)
+	{
+		TestTrue(TEXT("Notification should be tools/list_changed"), Notifications[0].Contains(MCPProtocol::Notification_ToolsListChanged));
+	}
+	
+	FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc": "2.0", "id": 7, "method": "tools/list"})"));
+	
+	TSharedPtr<FJsonObject> ResponseJson;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+	if (FJsonSerializer::Deserialize(Reader, ResponseJson) && ResponseJson.IsValid())
+	{
+		TestEqual(TEXT("Response id should match request"), static_cast<int32>(ResponseJson->GetNumberField(TEXT("id"))), 7);
+		
+		const TSharedPtr<FJsonObject>* Result;
+		const TArray<TSharedPtr<FJsonValue>>* Tools;
+		if (ResponseJson->TryGetObjectField(TEXT("result"), Result) && (*Result)->TryGetArrayField(TEXT("tools"), Tools))
+		{
+			TestEqual(TEXT("Cached tools array should contain one tool"), Tools->Num(), 1);
+			if (Tools->Num() == 1)
+			{
+				const TSharedPtr<FJsonObject> Tool = (*Tools)[0]->AsObject();
+				TestEqual(TEXT("Cached tool name should be echo"), Tool->GetStringField(TEXT("name")), FString(TEXT("echo")));
+				TestTrue(TEXT("Cached tool should include inputSchema"), Tool->HasField(TEXT("inputSchema")));
+			}
+		}
+		else
+		{
+			AddError(TEXT("tools/list response should have result.tools"));
+		}
+	}
+	else
+	{
+		AddError(TEXT("Failed to parse cached tools/list response JSON"));
+	}
+	
+	MCPServer.UnregisterTool(TEXT("echo"));
+	TestEqual(TEXT("Unregistration should send a notification"), Notifications.Num(), 2);
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: MCP Streaming JSON Writer
+ * Verifies escaping, UTF-8 encoding and the streaming echo tool path
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPJsonWriterTest, "MCP.Smoke.JsonWriter", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPJsonWriterTest::RunTest(const FString& Parameters)
+{
+	// Escaping and number formatting
+	{
+		TArray<uint8> Buffer;
+		FMCPJsonWriter Writer(Buffer);
+		Writer.WriteObjectStart();
+		Writer.WriteValue("text", TEXT("quote \" slash \\ newline \n tab \t"));
+		Writer.WriteValue("count", 42);
+		Writer.WriteValue("scale", 0.5);
+		Writer.WriteValue("ok", true);
+		Writer.WriteArrayStart("empty");
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+		
+		TestEqual(TEXT("Writer should be balanced"), Writer.GetDepth(), 0);
+		TestEqual(TEXT("Writer output"), FMCPJsonWriter::ToString(Buffer),
+			FString(TEXT(R"({"text":"quote \" slash \\ newline \n tab \t","count":42,"scale":0.5,"ok":true,"empty":[]})")));
+	}
+	
+	// Non-ASCII text round-trips through UTF-8
+	{
+		const FString Unicode = TEXT("Caf\u00e9 \u5149");
+		TArray<uint8> Buffer;
+		FMCPJsonWriter Writer(Buffer);
+		Writer.WriteObjectStart();
+		Writer.WriteValue("text", Unicode);
+		Writer.WriteObjectEnd();
+		
+		TSharedPtr<FJsonObject> Parsed;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FMCPJsonWriter::ToString(Buffer));
+		TestTrue(TEXT("Unicode output should parse"), FJsonSerializer::Deserialize(Reader, Parsed) && Parsed.IsValid());
+		if (Parsed.IsValid())
+		{
+			TestEqual(TEXT("Unicode should round-trip"), Parsed->GetStringField(TEXT("text")), Unicode);
+		}
+	}
+	
+	// Echo opts into the streaming path
+	{
+		FMCPServer MCPServer;
+		MCPServer.Initialize();
+		MCPServer.RegisterTool(MakeShared<FEchoTool>());
+		
+		FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":9,"method":"tools/call","params":{"name":"echo","arguments":{"message":"streamed"}}})"));
+		TestTrue(TEXT("Streaming echo should produce the echoed text"), Response.Contains(TEXT("Echo: streamed")));
+		TestTrue(TEXT("Streaming echo should keep the request id"), Response.Contains(TEXT("\"id\":9")));
+		
+		MCPServer.Shutdown();
+	}
+	
+	return true;
+}
+
+/**
+ * Test: MCP Batch Requests
+ * Verifies JSON-RPC 2.0 batch handling: ordering, notifications and invalid entries
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPBatchRequestTest, "MCP.Smoke.BatchRequest", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPBatchRequestTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	
+	// Mixed batch: concurrent echo/list calls, an unknown method, a notification and a bad entry
+	{
+		FString BatchRequest = TEXT(R"([
+			{"jsonrpc":"2.0","id":1,"method":"tools/call","params":{"name":"echo","arguments":{"message":"first"}}},
+			{"jsonrpc":"2.0","id":2,"method":"tools/list"},
+			{"jsonrpc":"2.0","method":"tools/call","params":{"name":"echo","arguments":{"message":"silent"}}},
+			{"jsonrpc":"2.0","id":3,"method":"unknown/method"},
+			42,
+			{"jsonrpc":"2.0","id":4,"method":"tools/call","params":{"name":"echo","arguments":{"message":"last"}}}
+		])");
+		
+		FString Response = MCPServer.ProcessMessage(BatchRequest);
+		
+		TArray<TSharedPtr<FJsonValue>> Responses;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+		TestTrue(TEXT("Batch response should be a JSON array"), FJsonSerializer::Deserialize(Reader, Responses));
+		TestEqual(TEXT("Notification should not produce a response"), Responses.Num(), 5);
+		
+		if (Responses.Num() == 5)
+		{
+			// Responses come back in request order
+			TestEqual(TEXT("First response id"), static_cast<int32>(Responses[0]->AsObject()->GetNumberField(TEXT("id"))), 1);
+			TestEqual(TEXT("Second response id"), static_cast<int32>(Responses[1]->AsObject()->GetNumberField(TEXT("id"))), 2);
+			TestTrue(TEXT("Unknown method should be an error"), Responses[2]->AsObject()->HasField(TEXT("error")));
+			TestTrue(TEXT("Non-object entry should be an error"), Responses[3]->AsObject()->HasField(TEXT("error")));
+			TestEqual(TEXT("Last response id"), static_cast<int32>(Responses[4]->AsObject()->GetNumberField(TEXT("id"))), 4);
+		}
+		
+		TestFalse(TEXT("Notification result should not be sent"), Response.Contains(TEXT("silent")));
+		TestTrue(TEXT("Echo results should be present"), Response.Contains(TEXT("Echo: first")) && Response.Contains(TEXT("Echo: last")));
+	}
+	
+	// An empty batch is a single Invalid Request error
+	{
+		FString Response = MCPServer.ProcessMessage(TEXT("[]"));
+		TSharedPtr<FJsonObject> ResponseJson;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+		TestTrue(TEXT("Empty batch should return an error object"),
+			FJsonSerializer::Deserialize(Reader, ResponseJson) && ResponseJson.IsValid() && ResponseJson->HasField(TEXT("error")));
+	}
+	
+	// A batch of notifications returns nothing
+	{
+		FString Response = MCPServer.ProcessMessage(TEXT(R"([{"jsonrpc":"2.0","method":"tools/list"}])"));
+		TestTrue(TEXT("Notification-only batch should return nothing"), Response.IsEmpty());
+	}
+	
+	// Off the game thread, ProcessMessageAsync returns at once; game-thread entries run when the game thread gets to them
+	{
+		MCPServer.RegisterMethodHandler(TEXT("test/game_thread"), FMCPMethodHandler::CreateLambda([](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			Writer.BeginResultResponse(Request.Id);
+			Writer.WriteValue(IsInGameThread());
+			Writer.EndResponse();
+			return true;
+		}));
+		
+		std::atomic<bool> bReturned(false);
+		TFuture<FString> Response = Async(EAsyncExecution::ThreadPool, [&MCPServer, &bReturned]()
+		{
+			TFuture<FString> BatchResponse = MCPServer.ProcessMessageAsync(TEXT(R"([{"jsonrpc":"2.0","id":1,"method":"test/game_thread"},{"jsonrpc":"2.0","id":2,"method":"tools/list"}])"));
+			bReturned = true;
+			BatchResponse.WaitFor(FTimespan::FromSeconds(5.0));
+			return BatchResponse.IsReady() ? BatchResponse.Get() : FString();
+		});
+		
+		const double ReturnDeadline = FPlatformTime::Seconds() + 2.0;
+		while (!bReturned && FPlatformTime::Seconds() < ReturnDeadline)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestTrue(TEXT("A batch should not block its caller on the game thread"), bReturned.load());
+		
+		const double ResponseDeadline = FPlatformTime::Seconds() + 5.0;
+		while (!Response.IsReady() && FPlatformTime::Seconds() < ResponseDeadline)
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.001f);
+		}
+		const FString Text = Response.IsReady() ? Response.Get() : FString();
+		TestTrue(FString::Printf(TEXT("Game-thread entries should run on the game thread (got: %s)"), *Text), Text.Contains(TEXT(R"("id":1,"result":true)")) && Text.Contains(TEXT(R"("id":2)")));
+		MCPServer.UnregisterMethodHandler(TEXT("test/game_thread"));
+	}
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+namespace MCPSmokeTests
+{
+	/** Tool that runs until it is cancelled (or times out), reporting progress while it waits */
+	class FWaitForCancelTool : public FMCPToolBase
+	{
+	public:
+		FWaitForCancelTool()
+			: FMCPToolBase(TEXT("wait_for_cancel"), TEXT("Runs until the request is cancelled"))
+		{
+		}
+		
+		virtual TSharedPtr<FJsonObject> GetInputSchema() const override
+		{
+			TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+			Schema->SetStringField(TEXT("type"), TEXT("object"));
+			return Schema;
+		}
+		
+		virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) override
+		{
+			return CreateErrorResponse(TEXT("Only supported through ExecuteAsync"));
+		}
+		
+		virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context) override
+		{
+			return Async(EAsyncExecution::Thread, [this, Context]() -> TSharedPtr<FJsonObject>
+			{
+				for (int32 Step = 0; Step < 500 && !Context->IsCancelled(); ++Step)
+				{
+					Context->ReportProgress(Step);
+					FPlatformProcess::Sleep(0.01f);
+				}
+				return CreateSuccessResponse(TEXT("finished"));
+			});
+		}
+	};
+}
+
+/**
+ * Test: MCP Async Tools Call
+ * Verifies ProcessMessageAsync, progress notifications and notifications/cancelled
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPAsyncToolsCallTest, "MCP.Smoke.AsyncToolsCall", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPAsyncToolsCallTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	MCPServer.RegisterTool(MakeShared<MCPSmokeTests::FWaitForCancelTool>());
+	
+	FCriticalSection NotificationsLock;
+	TArray<FString> Notifications;
+	MCPServer.OnNotification().AddLambda([&NotificationsLock, &Notifications](const FString& Notification)
+	{
+		FScopeLock Lock(&NotificationsLock);
+		Notifications.Add(Notification);
+	});
+	
+	// Async echo completes with the usual response and reports progress against the token
+	{
+		TFuture<FString> Response = MCPServer.ProcessMessageAsync(TEXT(R"({"jsonrpc":"2.0","id":10,"method":"tools/call","params":{"name":"echo","arguments":{"message":"async"},"_meta":{"progressToken":"echo-progress"}}})"));
+		TestTrue(TEXT("Async echo should complete"), Response.WaitFor(FTimespan::FromSeconds(5.0)));
+		
+		const FString ResponseText = Response.Get();
+		TestTrue(TEXT("Async echo should produce the echoed text"), ResponseText.Contains(TEXT("Echo: async")));
+		TestTrue(TEXT("Async echo should keep the request id"), ResponseText.Contains(TEXT("\"id\":10")));
+		
+		FScopeLock Lock(&NotificationsLock);
+		const bool bSawProgress = Notifications.ContainsByPredicate([](const FString& Notification)
+		{
+			return Notification.Contains(MCPProtocol::Notification_Progress) && Notification.Contains(TEXT("echo-progress"));
+		});
+		TestTrue(TEXT("Async echo should report progress"), bSawProgress);
+	}
+	
+	// notifications/cancelled stops an in-flight call and suppresses its response
+	{
+		TFuture<FString> Response = MCPServer.ProcessMessageAsync(TEXT(R"({"jsonrpc":"2.0","id":11,"method":"tools/call","params":{"name":"wait_for_cancel","arguments":{}}})"));
+		TestEqual(TEXT("Call should be tracked while running"), MCPServer.GetNumInFlightRequests(), 1);
+		
+		const FString CancelResponse = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","method":"notifications/cancelled","params":{"requestId":11,"reason":"test"}})"));
+		TestTrue(TEXT("Cancellation is a notification and gets no response"), CancelResponse.IsEmpty());
+		
+		TestTrue(TEXT("Cancelled call should finish promptly"), Response.WaitFor(FTimespan::FromSeconds(2.0)));
+		TestTrue(TEXT("Cancelled call should not produce a response"), Response.Get().IsEmpty());
+		TestEqual(TEXT("Cancelled call should no longer be tracked"), MCPServer.GetNumInFlightRequests(), 0);
+	}
+	
+	MCPServer.OnNotification().Clear();
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: MCP Message Framer
+ * Verifies newline framing across partial reads, pipelined messages, CRLF and oversized lines
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPMessageFramerTest, "MCP.Smoke.MessageFramer", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPMessageFramerTest::RunTest(const FString& Parameters)
+{
+	auto AppendText = [](FMCPMessageFramer& Framer, const ANSICHAR* Text)
+	{
+		Framer.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+	};
+	
+	// A message split across reads is only returned once its delimiter arrives
+	{
+		FMCPMessageFramer Framer;
+		FString Message;
+		
+		AppendText(Framer, "{\"jsonrpc\":\"2.0\",");
+		TestFalse(TEXT("Partial message should not be returned"), Framer.NextMessage(Message));
+		AppendText(Framer, "\"id\":1}\r\n");
+		TestTrue(TEXT("Completed message should be returned"), Framer.NextMessage(Message));
+		TestEqual(TEXT("CRLF should be stripped"), Message, FString(TEXT("{\"jsonrpc\":\"2.0\",\"id\":1}")));
+		TestEqual(TEXT("Nothing should remain buffered"), Framer.GetNumPendingBytes(), 0);
+	}
+	
+	// Pipelined messages in a single read, with blank lines and a trailing partial
+	{
+		FMCPMessageFramer Framer;
+		FString Message;
+		TArray<FString> Messages;
+		
+		AppendText(Framer, "{\"id\":1}\n\n{\"id\":2}\n{\"id\"");
+		while (Framer.NextMessage(Message))
+		{
+			Messages.Add(Message);
+		}
+		TestEqual(TEXT("Both complete messages should be returned"), Messages.Num(), 2);
+		TestEqual(TEXT("Partial message should stay buffered"), Framer.GetNumPendingBytes(), 5);
+		
+		AppendText(Framer, ":3}\n");
+		TestTrue(TEXT("Trailing message should complete"), Framer.NextMessage(Message));
+		TestEqual(TEXT("Trailing message content"), Message, FString(TEXT("{\"id\":3}")));
+	}
+	
+	// Non-ASCII payloads decode from UTF-8
+	{
+		FMCPMessageFramer Framer;
+		FString Message;
+		AppendText(Framer, "{\"text\":\"Caf\xC3\xA9\"}\n");
+		TestTrue(TEXT("UTF-8 message should be returned"), Framer.NextMessage(Message));
+		TestTrue(TEXT("UTF-8 should decode"), Message.Contains(TEXT("Caf\u00e9")));
+	}
+	
+	// Oversized messages are dropped without disturbing the next one
+	{
+		FMCPMessageFramer Framer(16);
+		FString Message;
+		AppendText(Framer, "{\"padding\":\"0123456789");
+		AppendText(Framer, "0123456789\"}\n{\"id\":4}\n");
+		TestTrue(TEXT("Message after an oversized one should be returned"), Framer.NextMessage(Message));
+		TestEqual(TEXT("Message after an oversized one"), Message, FString(TEXT("{\"id\":4}")));
+		TestEqual(TEXT("Oversized message should be counted"), Framer.GetNumDroppedMessages(), 1);
+	}
+	
+	return true;
+}
+
+/**
+ * Test: MCP Method Handlers, Resources and Prompts
+ * Verifies custom method registration, case-sensitive dispatch and the resources/prompts methods
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPMethodHandlersTest, "MCP.Smoke.MethodHandlers", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPMethodHandlersTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	
+	auto ParseResponse = [](const FString& Response)
+	{
+		TSharedPtr<FJsonObject> ResponseJson;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+		FJsonSerializer::Deserialize(Reader, ResponseJson);
+		return ResponseJson;
+	};
+	
+	// Custom methods plug into the same table as the built-ins
+	{
+		MCPServer.RegisterMethodHandler(TEXT("test/ping"), FMCPMethodHandler::CreateLambda([](const FMCPRequest& Request, FMCPJsonWriter& Writer)
+		{
+			Writer.BeginResultResponse(Request.Id);
+			Writer.WriteObjectStart();
+			Writer.WriteValue("pong", true);
+			Writer.WriteObjectEnd();
+			Writer.EndResponse();
+			return true;
+		}));
+		TestTrue(TEXT("Custom method should be registered"), MCPServer.HasMethodHandler(TEXT("test/ping")));
+		
+		TSharedPtr<FJsonObject> Response = ParseResponse(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":20,"method":"test/ping"})")));
+		TestTrue(TEXT("Custom method should answer"), Response.IsValid() && Response->HasField(TEXT("result")));
+		
+		// JSON-RPC method names are case-sensitive even though FName keys are not
+		Response = ParseResponse(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":21,"method":"TEST/PING"})")));
+		TestTrue(TEXT("Method lookup should be case-sensitive"), Response.IsValid() && Response->HasField(TEXT("error")));
+		
+		MCPServer.UnregisterMethodHandler(TEXT("test/ping"));
+		TestFalse(TEXT("Custom method should be unregistered"), MCPServer.HasMethodHandler(TEXT("test/ping")));
+	}
+	
+	// Resources
+	{
+		FMCPResourceInfo Info;
+		Info.Uri = TEXT("test://notes/readme");
+		Info.Name = TEXT("Readme");
+		Info.MimeType = TEXT("text/plain");
+		MCPServer.RegisterResource(Info, FMCPResourceReader::CreateLambda([](const FString& Uri, FString& OutText, FString& OutError)
+		{
+			OutText = TEXT("Hello from a resource");
+			return true;
+		}));
+		
+		const FString ListResponse = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":22,"method":"resources/list"})"));
+		TestTrue(TEXT("resources/list should include the resource"), ListResponse.Contains(TEXT("test://notes/readme")));
+		
+		const FString ReadResponse = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":23,"method":"resources/read","params":{"uri":"test://notes/readme"}})"));
+		TestTrue(TEXT("resources/read should return the text"), ReadResponse.Contains(TEXT("Hello from a resource")));
+		
+		TSharedPtr<FJsonObject> MissingResponse = ParseResponse(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":24,"method":"resources/read","params":{"uri":"test://missing"}})")));
+		TestTrue(TEXT("Unknown resource should be an error"), MissingResponse.IsValid() && MissingResponse->HasField(TEXT("error")));
+	}
+	
+	// Prompts
+	{
+		FMCPPromptInfo Info;
+		Info.Name = TEXT("describe_level");
+		Info.Description = TEXT("Describe a level");
+		FMCPPromptArgument LevelArgument;
+		LevelArgument.Name = TEXT("level");
+		LevelArgument.bRequired = true;
+		Info.Arguments.Add(LevelArgument);
+		
+		MCPServer.RegisterPrompt(Info, FMCPPromptRenderer::CreateLambda([](const TMap<FString, FString>& Arguments, TArray<FMCPPromptMessage>& OutMessages, FString& OutError)
+		{
+			FMCPPromptMessage Message;
+			Message.Role = TEXT("user");
+			Message.Text = FString::Printf(TEXT("Describe the level %s"), *Arguments.FindRef(TEXT("level")));
+			OutMessages.Add(Message);
+			return true;
+		}));
+		
+		const FString ListResponse = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":25,"method":"prompts/list"})"));
+		TestTrue(TEXT("prompts/list should include the prompt"), ListResponse.Contains(TEXT("describe_level")));
+		
+		const FString GetResponse = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":26,"method":"prompts/get","params":{"name":"describe_level","arguments":{"level":"Arena"}}})"));
+		TestTrue(TEXT("prompts/get should render the prompt"), GetResponse.Contains(TEXT("Describe the level Arena")));
+		
+		TSharedPtr<FJsonObject> MissingArgument = ParseResponse(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":27,"method":"prompts/get","params":{"name":"describe_level"}})")));
+		TestTrue(TEXT("Missing required prompt argument should be an error"), MissingArgument.IsValid() && MissingArgument->HasField(TEXT("error")));
+	}
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: MCP Schema Validation
+ * Verifies compiled input schemas, typed argument slots and InvalidParams rejection in tools/call
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPSchemaValidationTest, "MCP.Smoke.SchemaValidation", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPSchemaValidationTest::RunTest(const FString& Parameters)
+{
+	auto ParseJson = [](const FString& Json)
+	{
+		TSharedPtr<FJsonObject> Object;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		FJsonSerializer::Deserialize(Reader, Object);
+		return Object;
+	};
+	
+	const FString SchemaJson = TEXT(R"({
+		"type": "object",
+		"properties": {
+			"name": { "type": "string", "minLength": 1 },
+			"mode": { "type": "string", "enum": ["fast", "safe"], "default": "safe" },
+			"count": { "type": "integer", "minimum": 1, "maximum": 10, "default": 1 },
+			"location": {
+				"type": "object",
+				"properties": { "x": { "type": "number" }, "y": { "type": "number" } },
+				"required": ["x"]
+			},
+			"tags": { "type": "array", "items": { "type": "string" } }
+		},
+		"required": ["name"],
+		"additionalProperties": false
+	})");
+	
+	FString Error;
+	FMCPSchemaValidatorPtr Validator = FMCPSchemaValidator::Compile(ParseJson(SchemaJson), Error);
+	if (!TestTrue(TEXT("Schema should compile"), Validator.IsValid()))
+	{
+		AddError(Error);
+		return false;
+	}
+	
+	TestTrue(TEXT("Nested properties should have slots"), Validator->FindSlot(TEXT("location.x")) != INDEX_NONE);
+	TestEqual(TEXT("Array items should not have slots"), Validator->FindSlot(TEXT("tags[]")), static_cast<int32>(INDEX_NONE));
+	
+	// Valid arguments: typed values and defaults
+	{
+		FMCPToolArguments Arguments;
+		const bool bValid = Validator->Validate(ParseJson(TEXT(R"({"name":"Lamp","location":{"x":5,"y":-2.5},"tags":["a","b"]})")), Arguments, Error);
+		TestTrue(TEXT("Valid arguments should pass"), bValid);
+		TestEqual(TEXT("String slot"), Arguments.GetString(TEXT("name")), FString(TEXT("Lamp")));
+		TestEqual(TEXT("Integer default"), Arguments.GetInteger(TEXT("count")), 1);
+		TestEqual(TEXT("String default"), Arguments.GetString(TEXT("mode")), FString(TEXT("safe")));
+		TestEqual(TEXT("Nested number"), Arguments.GetNumber(TEXT("location.y")), -2.5);
+		TestEqual(TEXT("Array items"), Arguments.Find(TEXT("tags")) ? Arguments.Find(TEXT("tags"))->ArrayValues.Num() : 0, 2);
+	}
+	
+	// Invalid arguments, each rejected with the offending path
+	struct FInvalidCase
+	{
+		const TCHAR* Json;
+		const TCHAR* ExpectedPath;
+	};
+	const FInvalidCase InvalidCases[] =
+	{
+		{ TEXT(R"({})"), TEXT("name") },
+		{ TEXT(R"({"name":5})"), TEXT("name") },
+		{ TEXT(R"({"name":""})"), TEXT("name") },
+		{ TEXT(R"({"name":"Lamp","count":11})"), TEXT("count") },
+		{ TEXT(R"({"name":"Lamp","count":1.5})"), TEXT("count") },
+		{ TEXT(R"({"name":"Lamp","mode":"FAST"})"), TEXT("mode") },
+		{ TEXT(R"({"name":"Lamp","location":{"y":1}})"), TEXT("location.x") },
+		{ TEXT(R"({"name":"Lamp","location":{"x":"1"}})"), TEXT("location.x") },
+		{ TEXT(R"({"name":"Lamp","tags":[1]})"), TEXT("tags[]") },
+		{ TEXT(R"({"name":"Lamp","colour":"red"})"), TEXT("colour") }
+	};
+	
+	for (const FInvalidCase& InvalidCase : InvalidCases)
+	{
+		FMCPToolArguments Arguments;
+		Error.Reset();
+		TestFalse(FString::Printf(TEXT("Should reject %s"), InvalidCase.Json), Validator->Validate(ParseJson(InvalidCase.Json), Arguments, Error));
+		TestTrue(FString::Printf(TEXT("Error should name %s (got: %s)"), InvalidCase.ExpectedPath, *Error), Error.Contains(FString::Printf(TEXT("'%s'"), InvalidCase.ExpectedPath)));
+	}
+	
+	// tools/call rejects bad arguments with InvalidParams before the tool runs
+	{
+		FMCPServer MCPServer;
+		MCPServer.Initialize();
+		MCPServer.RegisterTool(MakeShared<FEchoTool>());
+		
+		TSharedPtr<FJsonObject> Response = ParseJson(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":30,"method":"tools/call","params":{"name":"echo","arguments":{"message":42}}})")));
+		const TSharedPtr<FJsonObject>* ErrorObject = nullptr;
+		if (TestTrue(TEXT("Invalid arguments should produce an error"), Response.IsValid() && Response->TryGetObjectField(TEXT("error"), ErrorObject)))
+		{
+			TestEqual(TEXT("Error code should be InvalidParams"), static_cast<int32>((*ErrorObject)->GetNumberField(TEXT("code"))), MCPProtocol::InvalidParams);
+		}
+		
+		Response = ParseJson(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":31,"method":"tools/call","params":{"name":"echo","arguments":{"message":"ok"}}})")));
+		TestTrue(TEXT("Valid arguments should reach the tool"), Response.IsValid() && Response->HasField(TEXT("result")));
+		
+		MCPServer.Shutdown();
+	}
+	
+	return true;
+}
+
+/**
+ * Test: MCP Server Stats
+ * Verifies counters, per-tool and per-method latency, server/stats and reset
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPServerStatsTest, "MCP.Smoke.ServerStats", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPServerStatsTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	
+	MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":1,"method":"tools/list"})"));
+	MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":2,"method":"tools/call","params":{"name":"echo","arguments":{"message":"a"}}})"));
+	MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":3,"method":"tools/call","params":{"name":"echo","arguments":{"message":"b"}}})"));
+	MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":4,"method":"no/such/method"})"));
+	
+	TestEqual(TEXT("Requests should be counted"), MCPServer.GetRequestsProcessed(), static_cast<int64>(4));
+	TestEqual(TEXT("Unknown method should count as an error"), MCPServer.GetErrorsEncountered(), static_cast<int64>(1));
+	
+	TSharedPtr<FJsonObject> Response;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":5,"method":"server/stats","params":{"reset":true}})")));
+	const TSharedPtr<FJsonObject>* Result = nullptr;
+	if (!TestTrue(TEXT("server/stats should return a result"), FJsonSerializer::Deserialize(Reader, Response) && Response.IsValid() && Response->TryGetObjectField(TEXT("result"), Result)))
+	{
+		return false;
+	}
+	
+	const TSharedPtr<FJsonObject>& Phases = (*Result)->GetObjectField(TEXT("phases"));
+	TestEqual(TEXT("Every message should be parsed"), static_cast<int32>(Phases->GetObjectField(TEXT("parse"))->GetNumberField(TEXT("count"))), 5);
+	TestEqual(TEXT("Both tool calls should be executed"), static_cast<int32>(Phases->GetObjectField(TEXT("execute"))->GetNumberField(TEXT("count"))), 2);
+	
+	bool bFoundEcho = false;
+	for (const TSharedPtr<FJsonValue>& ToolValue : (*Result)->GetArrayField(TEXT("tools")))
+	{
+		const TSharedPtr<FJsonObject>& Tool = ToolValue->AsObject();
+		if (Tool->GetStringField(TEXT("name")) == TEXT("echo"))
+		{
+			bFoundEcho = true;
+			TestEqual(TEXT("Echo calls"), static_cast<int32>(Tool->GetNumberField(TEXT("calls"))), 2);
+			TestTrue(TEXT("Echo should report p99"), Tool->GetObjectField(TEXT("execute"))->HasField(TEXT("p99Us")));
+		}
+	}
+	TestTrue(TEXT("Tools should include echo"), bFoundEcho);
+	
+	bool bFoundToolsCall = false;
+	for (const TSharedPtr<FJsonValue>& MethodValue : (*Result)->GetArrayField(TEXT("methods")))
+	{
+		const TSharedPtr<FJsonObject>& Method = MethodValue->AsObject();
+		if (Method->GetStringField(TEXT("method")) == MCPProtocol::Method_ToolsCall)
+		{
+			bFoundToolsCall = true;
+			TestEqual(TEXT("tools/call requests"), static_cast<int32>(Method->GetNumberField(TEXT("requests"))), 2);
+		}
+	}
+	TestTrue(TEXT("Methods should include tools/call"), bFoundToolsCall);
+	
+	// {"reset": true} clears everything after reporting
+	TestEqual(TEXT("Reset should clear requests"), MCPServer.GetRequestsProcessed(), static_cast<int64>(0));
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: spawn_actors Tool
+ * Verifies that bad batches are rejected as a whole before anything is spawned
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPSpawnActorsToolTest, "MCP.Smoke.SpawnActorsTool", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPSpawnActorsToolTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FSpawnActorsTool>());
+	
+	auto CallSpawnActors = [&MCPServer](const FString& ArgumentsJson)
+	{
+		const FString Request = FString::Printf(
+			TEXT(R"({"jsonrpc":"2.0","id":1,"method":"tools/call","params":{"name":"spawn_actors","arguments":%s}})"), *ArgumentsJson);
+		return MCPServer.ProcessMessage(Request);
+	};
+	
+	// Schema violations are reported as invalid params
+	const TCHAR* InvalidArguments[] =
+	{
+		TEXT(R"({"actors":[]})"),
+		TEXT(R"({"actors":[{"location":{"x":0}}]})"),
+		TEXT(R"({"actors":[{"class":"PointLight","location":{"x":"far"}}]})")
+	};
+	for (const TCHAR* Arguments : InvalidArguments)
+	{
+		const FString Response = CallSpawnActors(Arguments);
+		TestTrue(FString::Printf(TEXT("Should reject %s (got: %s)"), Arguments, *Response),
+			Response.Contains(FString::Printf(TEXT("%d"), MCPProtocol::InvalidParams)));
+	}
+	
+	// A bad class or property anywhere in the batch fails the call with the entry's index
+	{
+		const FString Response = CallSpawnActors(TEXT(R"({"actors":[{"class":"PointLight"},{"class":"NoSuchActorClass"}]})"));
+		TestTrue(FString::Printf(TEXT("Unknown class should name its entry (got: %s)"), *Response), Response.Contains(TEXT("actors[1].class")));
+		TestFalse(TEXT("Nothing should be spawned"), Response.Contains(TEXT("\"spawned\"")));
+	}
+	{
+		const FString Response = CallSpawnActors(TEXT(R"({"actors":[{"class":"PointLight","properties":{"NoSuchProperty":1}}]})"));
+		TestTrue(FString::Printf(TEXT("Unknown property should name its entry (got: %s)"), *Response), Response.Contains(TEXT("actors[0].properties.NoSuchProperty")));
+		TestFalse(TEXT("Nothing should be spawned"), Response.Contains(TEXT("\"spawned\"")));
+	}
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: audit/query
+ * Verifies that tool calls are audited and that audit/query finds them and other events by their filters
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPAuditQueryTest, "MCP.Smoke.AuditQuery", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPAuditQueryTest::RunTest(const FString& Parameters)
+{
+	FAuditLogger& Logger = FAuditLogger::Get();
+	Logger.Initialize();
+	
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	MCPTools::RegisterAuditQueryMethod(MCPServer);
+	
+	const FString Since = (FDateTime::Now() - FTimespan::FromMinutes(1)).ToString(TEXT("%Y-%m-%dT%H:%M:%S"));
+	const FString Marker = FString::Printf(TEXT("AuditQuery_%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":1,"method":"tools/call","params":{"name":"echo","arguments":{"message":"audited"}}})"));
+	Logger.Submit(FAuditEvent(EAuditSource::SceneEdit, TEXT("SCENE_EDIT")).Add(TEXT("Operation"), TEXT("Move")).Add(TEXT("Affected"), Marker));
+	TestTrue(TEXT("Flush should finish within its timeout"), Logger.Flush());
+	
+	{
+		const FString Response = MCPServer.ProcessMessage(FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":2,"method":"audit/query","params":{"actor":"%s"}})"), *Marker));
+		TestTrue(FString::Printf(TEXT("Actor query should find the event (got: %s)"), *Response), Response.Contains(Marker) && Response.Contains(TEXT("\"type\":\"SCENE_EDIT\"")));
+		TestTrue(TEXT("Actor query should reach the end of the log"), Response.Contains(TEXT("\"nextCursor\":null")));
+		TestTrue(TEXT("Actor query should report stats"), Response.Contains(TEXT("\"segmentsSkipped\"")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(FString::Printf(TEXT(R"({"jsonrpc":"2.0","id":3,"method":"audit/query","params":{"types":["MCP_TOOL_CALL"],"tool":"echo","from":"%s"}})"), *Since));
+		TestTrue(FString::Printf(TEXT("Tool query should find the echo call (got: %s)"), *Response), Response.Contains(TEXT("\"value\":\"echo\"")) && Response.Contains(TEXT("\"source\":\"MCP\"")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":4,"method":"audit/query","params":{"from":"yesterday"}})"));
+		TestTrue(FString::Printf(TEXT("Bad dates should be invalid params (got: %s)"), *Response), Response.Contains(FString::Printf(TEXT("%d"), MCPProtocol::InvalidParams)));
+	}
+	
+	MCPServer.Shutdown();
+	return true;
+}
+
+/**
+ * Test: Request Ids
+ * Verifies that string and null ids are answered with the id echoed back unchanged, and only a missing id makes a notification
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPRequestIdTest, "MCP.Smoke.RequestIds", MCP_SMOKE_TEST_FLAGS)
+
+bool FMCPRequestIdTest::RunTest(const FString& Parameters)
+{
+	FMCPServer MCPServer;
+	MCPServer.Initialize();
+	MCPServer.RegisterTool(MakeShared<FEchoTool>());
+	
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":"req-7","method":"tools/list"})"));
+		TestTrue(FString::Printf(TEXT("String ids should be echoed as strings (got: %s)"), *Response), Response.Contains(TEXT(R"("id":"req-7")")) && Response.Contains(TEXT("\"result\"")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":null,"method":"tools/list"})"));
+		TestTrue(FString::Printf(TEXT("A null id is a request, not a notification (got: %s)"), *Response), Response.Contains(TEXT(R"("id":null)")) && Response.Contains(TEXT("\"result\"")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":12.5,"method":"no/such/method"})"));
+		TestTrue(FString::Printf(TEXT("Errors should echo the id too (got: %s)"), *Response), Response.Contains(TEXT(R"("id":12.5)")) && Response.Contains(TEXT("\"error\"")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","id":{"bad":1},"method":"tools/list"})"));
+		TestTrue(FString::Printf(TEXT("Object ids should be invalid requests (got: %s)"), *Response), Response.Contains(FString::Printf(TEXT("%d"), MCPProtocol::InvalidRequest)) && Response.Contains(TEXT(R"("id":null)")));
+	}
+	{
+		const FString Response = MCPServer.ProcessMessage(TEXT(R"({"jsonrpc":"2.0","method":"tools/list"})"));
+		TestTrue(TEXT("Only a missing id makes a notification"), Response.IsEmpty());
+	}
+	{
+		TFuture<FString> Future = MCPServer.ProcessMessageAsync(TEXT(R"({"jsonrpc":"2.0","id":"async-1","method":"tools/call","params":{"name":"echo","arguments":{"message":"hi"}}})"));
+		Future.WaitFor(FTimespan::FromSeconds(5.0));
+		const FString Response = Future.IsReady() ? Future.Get() : FString();
+		TestTrue(FString::Printf(TEXT("Async tool calls should echo string ids (got: %s)"), *Response), Response.Contains(TEXT(R"("id":"async-1")")));
+	}
+	
+	MCPServer.Shutdown();
+	return true;
+}
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Which part of the plugin an audit event came from */
+enum class EAuditSource : uint8
+{
+	Editor,
+	SceneEdit,
+	Asset,
+	Test,
+	Blueprint,
+	Console,
+	Python,
+	MCP
+};
+
+/** Name of a source, as audit/query reports it */
+CHATGPTEDITOR_API const TCHAR* LexToString(EAuditSource Source);
+
+/** A value on an audit event; keys are string literals (or, on events read back, strings the reader owns), so only the value is copied. A null key is the event's plain message. */
+struct FAuditField
+{
+	const TCHAR* Key = nullptr;
+	FString Value;
+};
+
+/**
+ * One typed audit record, as every subsystem submits it to FAuditLogger
+ * The caller fills in values it already has; encoding the event is left to the audit writer thread,
+ * so logging costs the caller no formatting and no file access. FAuditLogReader hands events back in this form.
+ */
+struct CHATGPTEDITOR_API FAuditEvent
+{
+	FAuditEvent() = default;
+	FAuditEvent(EAuditSource InSource, FName InType);
+
+	/** Add a named value */
+	FAuditEvent& Add(const TCHAR* Key, FString Value) &;
+
+	/** Add a named YES/NO value */
+	FAuditEvent& AddBool(const TCHAR* Key, bool bValue) &;
+
+	/** Add the plain message, written before the named values */
+	FAuditEvent& AddMessage(FString Message) &;
+
+	/** The same on a temporary, so an event can be built and submitted in one expression without a copy */
+	FAuditEvent&& Add(const TCHAR* Key, FString Value) && { return MoveTemp(Add(Key, MoveTemp(Value))); }
+	FAuditEvent&& AddBool(const TCHAR* Key, bool bValue) && { return MoveTemp(AddBool(Key, bValue)); }
+	FAuditEvent&& AddMessage(FString Message) && { return MoveTemp(AddMessage(MoveTemp(Message))); }
+
+	/** Append the event as one line of text, "[timestamp] TYPE | message | Key: Value | ...", ending in a newline */
+	void AppendLine(FString& Out) const;
+
+	/** Append the event as one line of JSON, in the shape audit/query returns events, ending in a newline */
+	void AppendJsonLine(FString& Out) const;
+
+	FDateTime Timestamp;
+	EAuditSource Source = EAuditSource::Editor;
+
+	/** Event type such as API_CONNECTION or ASSET_OPERATION; an FName, so a type is stored once however often it is logged */
+	FName Type;
+
+	TArray<FAuditField, TInlineAllocator<6>> Fields;
+};
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuditEvent.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * On-disk audit log format
+ *
+ * The log is a directory of segment files named by the time they were started, so they sort oldest
+ * first. The active segment (.aud) is a header followed by records, each a uint32 length and a payload;
+ * once the log rotates away from it, it is compressed in the background to a .audz beside it. Event
+ * types and field keys are interned per segment by definition records ahead of their first use, so an
+ * event record carries small ids plus its values and every segment reads back on its own.
+ */
+namespace AuditLogFormat
+{
+	constexpr uint32 SegmentMagic = 0x47445541; // "AUDG"
+	constexpr uint32 CompressedMagic = 0x5A445541; // "AUDZ"
+	constexpr uint32 Version = 1;
+
+	constexpr const TCHAR* SegmentExtension = TEXT(".aud");
+	constexpr const TCHAR* CompressedExtension = TEXT(".audz");
+
+	/** Marker a writing session keeps beside its first segment, holding its process id; see FAuditSegmentWriter */
+	constexpr const TCHAR* SessionExtension = TEXT(".session");
+
+	/** Magic and version */
+	constexpr int32 HeaderSize = 8;
+
+	enum class ERecordKind : uint8
+	{
+		/** uint16 id, string: the event type with that id */
+		DefineType,
+
+		/** uint16 id, string: the field key with that id */
+		DefineKey,
+
+		/** int64 timestamp ticks, uint8 source, uint16 type id, uint8 field count, then per field a uint16 key id and a string */
+		Event
+	};
+
+	/** Key id of an event's plain message */
+	constexpr uint16 MessageKeyId = 0xFFFF;
+
+	/** Types or keys a segment can define before the log rotates */
+	constexpr int32 MaxIdsPerSegment = MessageKeyId;
+
+	/** Fields an event record can hold; more are dropped */
+	constexpr int32 MaxFieldsPerEvent = 0xFF;
+
+	/**
+	 * Compress a closed segment into a .audz beside it with the given FCompression format, then delete it.
+	 * The compressed file is written under a temporary name and renamed, so a reader never sees half of one.
+	 * If the segment can't be deleted it is still open for writing, so the .audz is removed again and this fails.
+	 */
+	CHATGPTEDITOR_API bool CompressSegment(const FString& Path, FName Format);
+
+	/** Decompress a .audz file's bytes back into the segment they were made from */
+	CHATGPTEDITOR_API bool DecompressSegment(const uint8* Data, int64 Size, TArray64<uint8>& OutSegment, FString& OutError);
+
+	/** Whether bytes start with a segment header this version reads */
+	CHATGPTEDITOR_API bool HasSegmentHeader(const uint8* Data, int64 Size);
+}
+
+/**
+ * A segment file's bytes, memory-mapped where the platform can map it
+ * Otherwise the file is read, shared so that the segment still being written can be read too.
+ */
+class CHATGPTEDITOR_API FAuditSegmentView
+{
+public:
+	FAuditSegmentView();
+	~FAuditSegmentView();
+
+	bool Open(const FString& Path);
+	void Close();
+
+	const uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> Buffer;
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
+
+/**
+ * Decodes a segment's records one at a time
+ * Definitions accumulate as they are met, and an event is decoded into one reused FAuditEvent whose keys
+ * point into Keys. Seeded with a whole segment's definitions, decoding can start at any record.
+ */
+class CHATGPTEDITOR_API FAuditRecordDecoder
+{
+public:
+	/** Forget the definitions, before starting on another segment */
+	void Reset();
+
+	/**
+	 * Decode the record at Offset and move Offset past it. Returns false at the end of the data, which
+	 * includes a record cut short by a crash; bOutEvent says whether Event now holds the record's event.
+	 */
+	bool DecodeNext(const uint8* Data, int64 Size, int64& Offset, bool& bOutEvent);
+
+	/** The segment's definitions; event keys point into Keys, whose strings stay put while it grows */
+	TArray<FName> Types;
+	TArray<FString> Keys;
+
+	FAuditEvent Event;
+};
+
+/**
+ * Streams events back out of audit log segments
+ * Plain segments are decoded straight from the mapped file, compressed ones from a buffer the reader keeps
+ * between segments, so reading many costs little more than the decoding and there is no text parsing.
+ */
+class CHATGPTEDITOR_API FAuditLogReader
+{
+public:
+	/** Segment files in a directory, oldest first; a segment is listed once, compressed if it has been */
+	static TArray<FString> FindSegments(const FString& Directory);
+
+	/**
+	 * Call Visitor for each event in a segment, compressed or not, in order, until it returns false.
+	 * The event is only valid during the call. A record cut short by a crash ends the segment.
+	 * Returns false if the file can't be read.
+	 */
+	bool ReadSegment(const FString& Path, TFunctionRef<bool(const FAuditEvent&)> Visitor, FString& OutError);
+
+	/** Read every segment in a directory, oldest first, until Visitor returns false; returns how many events were visited */
+	int64 ReadDirectory(const FString& Directory, TFunctionRef<bool(const FAuditEvent&)> Visitor);
+
+private:
+	/** Open a segment, decompressing it if needed, and point SegmentData at its bytes */
+	bool LoadSegment(const FString& Path, FString& OutError);
+
+	/** Decode the loaded segment's records; returns false once Visitor asks to stop */
+	bool DecodeRecords(TFunctionRef<bool(const FAuditEvent&)> Visitor);
+
+	FAuditSegmentView View;
+	TArray64<uint8> Decompressed;
+	const uint8* SegmentData = nullptr;
+	int64 SegmentSize = 0;
+
+	FAuditRecordDecoder Decoder;
+};
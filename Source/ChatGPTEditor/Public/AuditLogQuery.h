@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuditEvent.h"
+#include "AuditLogFormat.h"
+
+/** What an audit log query matches; every filter that is set must match, and an empty one matches everything */
+struct CHATGPTEDITOR_API FAuditQuery
+{
+	/** Events at or after From and before To, in the editor's local time like the events themselves */
+	FDateTime From = FDateTime::MinValue();
+	FDateTime To = FDateTime::MaxValue();
+
+	/** Event types, such as SCENE_EDIT or ASSET_OPERATION; an event matches any of them */
+	TArray<FName> Types;
+
+	/** An actor, asset or MCP tool the event names, matched whole and ignoring case */
+	FString Actor;
+	FString Asset;
+	FString Tool;
+
+	/** Most events to visit; the cursor returned carries on from there */
+	int32 MaxResults = 100;
+
+	/** Where to carry on from, as returned by the query before ("segment@offset"); empty starts at the oldest event */
+	FString Cursor;
+
+	/**
+	 * Parse a query as typed into the editor's search box: key:value terms such as
+	 * "type:SCENE_EDIT,ASSET_OPERATION actor:Cube_1 since:24h", with type, actor, asset, tool,
+	 * since (30m, 24h, 7d), from and to (ISO 8601, local time), limit and cursor. Quote a value to give it spaces.
+	 */
+	static bool Parse(const FString& Text, FAuditQuery& OutQuery, FString& OutError);
+
+	/**
+	 * Parse a date in local time, as the events are; one with a zone (Z or +01:00) is refused rather than
+	 * compared against local timestamps as if it were local
+	 */
+	static bool ParseLocalDate(const FString& Text, FDateTime& OutDate);
+
+	/** Split a cursor into its segment name and offset; false if it isn't in the form Query returns */
+	static bool ParseCursor(const FString& Cursor, FString& OutSegment, int64& OutOffset);
+};
+
+/** How much of the log a query had to look at */
+struct FAuditQueryStats
+{
+	int32 NumSegments = 0;
+
+	/** Segments ruled out by their index without being opened */
+	int32 NumSegmentsSkipped = 0;
+
+	int64 NumEventsScanned = 0;
+	int32 NumMatched = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * Answers filtered queries over the audit log's segments
+ *
+ * Each segment is indexed once: the time span of every EventsPerBlock events, the event types it defines,
+ * and a bloom filter over the actor, asset and tool names its events carry. A query rules out whole
+ * segments, and blocks within the rest, from the index alone, and decodes only what is left straight
+ * from the memory-mapped file, or a compressed segment's decompressed bytes. The segment being written
+ * is indexed as far as it has been written and picked up from there by the next query. The index of a
+ * compressed segment is saved beside it as a .audx, so later sessions don't decompress it again.
+ * A query lists the directory again only when a segment has come or gone, or every RescanSeconds.
+ */
+class CHATGPTEDITOR_API FAuditLogQueryEngine
+{
+public:
+	/** The engine over FAuditLogger's log */
+	static FAuditLogQueryEngine& Get();
+
+	explicit FAuditLogQueryEngine(const FString& InDirectory);
+	~FAuditLogQueryEngine();
+
+	/**
+	 * Call Visitor for each matching event, oldest first, until MaxResults have been visited or it returns
+	 * false. The matches are collected under the engine's lock and visited after it is released, so a slow
+	 * visitor doesn't hold up other queries; the event is only valid during the call. Returns the cursor to
+	 * carry on from if it stopped there, or an empty string once it searched to the end of the log.
+	 */
+	FString Query(const FAuditQuery& Query, TFunctionRef<bool(const FAuditEvent&)> Visitor, FAuditQueryStats* OutStats = nullptr);
+
+	/** Bring the index up to date with every segment on disk */
+	void Refresh();
+
+	/** Whether a cursor is well formed and names a segment that is still on disk; OutError says why not */
+	bool IsValidCursor(const FString& Cursor, FString& OutError) const;
+
+	/** Events per block of the timestamp index */
+	static constexpr int32 EventsPerBlock = 256;
+
+	/** Longest a query goes without listing the directory, to notice segments deleted or added behind the log's back */
+	static constexpr double RescanSeconds = 1.0;
+
+	static constexpr const TCHAR* IndexExtension = TEXT(".audx");
+
+private:
+	struct FSegmentIndex;
+
+	/**
+	 * What a query does first: only re-index the segments still being written, unless the log has started
+	 * a segment not indexed yet, one has been compressed or deleted, or RescanSeconds have passed
+	 */
+	void RefreshChanged();
+
+	/** Index a segment that has grown, or been compressed, since it was last looked at */
+	void UpdateSegment(FSegmentIndex& Index, int64 FileSize);
+
+	/** Index a segment as far as its data goes, carrying on from where it was last indexed */
+	void IndexSegment(FSegmentIndex& Index, const uint8* Data, int64 Size);
+
+	/** The segment's bytes, from a mapped view or the decompressed copy kept of the last compressed one */
+	bool LoadSegment(FSegmentIndex& Index, const uint8*& OutData, int64& OutSize);
+
+	bool LoadIndexFile(FSegmentIndex& Index) const;
+	void SaveIndexFile(FSegmentIndex& Index) const;
+
+	FString Directory;
+	FCriticalSection Lock;
+
+	/** Indexes by segment name, and the same oldest first */
+	TMap<FString, TUniquePtr<FSegmentIndex>> Indexes;
+	TArray<FSegmentIndex*> Segments;
+
+	bool bRemovedStaleIndexFiles = false;
+	double LastScanSeconds = 0.0;
+
+	FAuditSegmentView View;
+	FString DecompressedName;
+	TArray64<uint8> Decompressed;
+};
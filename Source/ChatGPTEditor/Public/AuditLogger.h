@@ -3,13 +3,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
 #include "SceneEditingTypes.h"
+#include "AuditEvent.h"
+#include <atomic>
+
+class FEvent;
+class FRunnable;
+class FRunnableThread;
+class FAuditSegmentWriter;
+
+/** How far the audit writer pushes each batch of lines towards the disk */
+enum class EAuditLogFlushPolicy : uint8
+{
+	/** Leave the batch in the OS file cache; the cheapest, but a power loss can drop recent lines */
+	None,
+
+	/** Hand each batch to the OS, so a crash of the editor keeps it */
+	Batch,
+
+	/** Sync each batch to the storage device */
+	Sync
+};
+
+/** Formats FAuditLogger::ExportToFile can write */
+enum class EAuditLogExportFormat : uint8
+{
+	/** One line of text per event, as FAuditEvent::AppendLine writes it */
+	Text,
+
+	/** One JSON object per line, in the shape audit/query returns events */
+	JsonLines
+};
 
 /**
  * Comprehensive audit logger for tracking all ChatGPT Editor operations
  * Logs API connections, code changes, file operations, permission changes,
  * scene editing operations, and general events
- * Logs are stored in Saved/ChatGPTEditor/audit.log
+ * Logs are stored as binary segments in Saved/ChatGPTEditor/AuditLog (see AuditLogFormat.h)
+ *
+ * Between Initialize and Shutdown, events are queued and a writer thread encodes and appends them through
+ * one open file handle, a batch at a time, so logging costs the caller a queue push rather than a file open.
+ * Asset automation, test automation, the Blueprint assistant and the console and Python handlers submit
+ * their events here too.
  */
 class FAuditLogger
 {
@@ -51,33 +87,204 @@ public:
 	void LogOperation(const FString& UserCommand, const FString& OperationType, 
 		const FString& AffectedActors, bool bSuccess, const FString& ErrorMessage = TEXT(""));
 
-	/** Get all audit log entries */
+	/** Log an event from any subsystem; every audit line goes through here, so the file has one writer and one order */
+	void Submit(FAuditEvent&& Event);
+
+	/** Path of the log segment being written; it changes when the log rotates */
+	FString GetAuditLogPath() const;
+
+	/** Directory of the log's segment files, which FAuditLogReader reads back */
+	FString GetAuditLogDirectory() const;
+
+	/** Start a new log segment once the current one holds this many bytes or was started this long ago */
+	void SetRotationLimits(int64 MaxSegmentBytes, double MaxSegmentSeconds);
+
+	/** Wait until closed segments are compressed, for at most the timeout; false if it ran out */
+	bool WaitForCompression(double TimeoutSeconds = DefaultFlushTimeoutSeconds);
+
+	/** Get the audit log entries still in memory; older ones are only reachable through VisitEntries */
 	TArray<FAuditLogEntry> GetLogEntries() const;
 
 	/** Get recent log entries (last N entries) */
 	TArray<FAuditLogEntry> GetRecentEntries(int32 Count) const;
 
-	/** Clear all log entries */
+	/**
+	 * Call Visitor for up to MaxEntries entries in order, starting at the entry with sequence Cursor (clamped to
+	 * the oldest kept) and reading spilled entries back from disk. Entries are passed by reference and are only
+	 * valid during the call, which holds the log lock, so visitors should be quick and must not wait on other threads.
+	 * Returns the cursor for the next page; it equals GetNextSequence() when there is nothing more.
+	 */
+	int64 VisitEntries(int64 Cursor, int32 MaxEntries, TFunctionRef<void(const FAuditLogEntry&)> Visitor) const;
+
+	/** Visit the last Count entries, oldest first; returns how many were visited */
+	int32 VisitRecentEntries(int32 Count, TFunctionRef<void(const FAuditLogEntry&)> Visitor) const;
+
+	/** Sequence of the oldest entry kept, in memory or on disk */
+	int64 GetFirstSequence() const;
+
+	/** Sequence the next entry will get; the number of entries logged this session */
+	int64 GetNextSequence() const;
+
+	/** Entries held in memory, at most RingCapacity */
+	int32 GetNumEntriesInMemory() const;
+
+	/** Clear all log entries, including those spilled to disk */
 	void ClearLog();
 
 	/** Export log to string */
 	FString ExportLogToString() const;
+
+	/**
+	 * Write every event in the log's segments to a file, oldest first, so the binary log can be read without
+	 * the editor. Flushes first; false with OutError if the file can't be written.
+	 */
+	bool ExportToFile(const FString& Path, EAuditLogExportFormat Format, FString& OutError);
+
+	/** Wait until every line logged so far is written and synced, for at most the timeout; false if it ran out. Safe to call from crash handlers. */
+	bool Flush(double TimeoutSeconds = DefaultFlushTimeoutSeconds);
+
+	void SetFlushPolicy(EAuditLogFlushPolicy Policy) { FlushPolicy = static_cast<uint8>(Policy); }
+	EAuditLogFlushPolicy GetFlushPolicy() const { return static_cast<EAuditLogFlushPolicy>(FlushPolicy.load()); }
+
+	/** Whether lines go through the writer thread; before Initialize and after Shutdown each line is written directly */
+	bool IsWriterRunning() const { return bWriterRunning; }
+
+	/** The writer wakes this often to write whatever was queued... */
+	static constexpr int32 GroupCommitMilliseconds = 20;
+
+	/** ...or sooner once this many lines are waiting */
+	static constexpr int32 WakeWriterThreshold = 256;
+
+	static constexpr double DefaultFlushTimeoutSeconds = 2.0;
+
+	/** Flush timeout when the editor is going down with a fatal error */
+	static constexpr double CrashFlushTimeoutSeconds = 0.5;
+
+	/** Entries kept in memory... */
+	static constexpr int32 RingCapacity = 4096;
+
+	/** ...and how many of the oldest are written to a disk segment at a time once it is full */
+	static constexpr int32 SpillBlockSize = 1024;
+
+	/** Characters ExportToFile formats before converting and writing them */
+	static constexpr int32 ExportChunkChars = 64 * 1024;
 	
 private:
 	FAuditLogger();
-	~FAuditLogger() = default;
+	~FAuditLogger();
 	
 	// Prevent copying
 	FAuditLogger(const FAuditLogger&) = delete;
 	FAuditLogger& operator=(const FAuditLogger&) = delete;
 	
 	void EnsureLogDirectoryExists();
-	FString GetAuditLogPath() const;
-	void WriteLog(const FString& Entry);
-	void WriteLogEntry(const FString& Entry);
-	FString GetTimestamp() const;
+
+	/** Append an event on the calling thread, opening and closing the file; used when the writer isn't running */
+	void WriteLogDirect(const FAuditEvent& Event);
+
+	void StartWriter();
+	void StopWriter();
+	uint32 RunWriter();
+
+	/** Write everything queued as one batch; only the writer thread, or Shutdown once it has exited, may call this */
+	void WriteQueuedEvents();
+
+	void OnSystemError();
+
+	/** Add an entry to the ring, spilling the oldest block first if it is full; LogMutex must be held */
+	void AddEntry(FAuditLogEntry&& Entry);
+
+	/** Move the oldest block out of the ring and hand it to the writer thread; LogMutex must be held */
+	void SpillOldestEntries();
+
+	/** A spilled block on its way to disk */
+	struct FAuditSpill
+	{
+		FString Path;
+		int64 FirstSequence = 0;
+
+		/** Shared with the segment's PendingEntries; only read once spilled */
+		TSharedPtr<TArray<FAuditLogEntry>, ESPMode::ThreadSafe> Entries;
+	};
+
+	/** Write a spilled block's segment file; takes no lock, the outcome is picked up by ApplySpillResults */
+	void WriteSpill(const FAuditSpill& Spill);
+
+	/** Release the memory of spills that reached disk, and drop the segments of any that didn't; LogMutex must be held */
+	void ApplySpillResults();
+
+	/** Delete this session's segments, or those other sessions left behind long enough ago */
+	void DeleteSegments();
+	void DeleteStaleSegments();
+	FString GetSegmentDirectory() const;
+
+	/** Index of the segment holding a sequence, or INDEX_NONE; LogMutex must be held */
+	int32 FindSegment(int64 Sequence) const;
+
+	/** Entries of a segment, read back on demand and kept until another is needed; null if it can't be read. LogMutex must be held */
+	const TArray<FAuditLogEntry>* LoadSegment(int32 Index) const;
+
+	/** A block of spilled entries */
+	struct FAuditSegment
+	{
+		int64 FirstSequence = 0;
+		int32 NumEntries = 0;
+		FString Path;
+
+		/** The entries themselves until the writer has put them on disk */
+		TSharedPtr<const TArray<FAuditLogEntry>, ESPMode::ThreadSafe> PendingEntries;
+	};
+
+	/** Outcome of a spill, by segment path */
+	struct FAuditSpillResult
+	{
+		FString Path;
+		bool bWritten = false;
+	};
 
 	FCriticalSection LogMutex;
-	TArray<FAuditLogEntry> LogEntries;
 	bool bInitialized;
+
+	/** The newest entries; sequence S lives in slot S % RingCapacity */
+	TArray<FAuditLogEntry> Ring;
+
+	/** Oldest entry kept anywhere, oldest in the ring, and the next to be added */
+	int64 FirstSequence;
+	int64 RingFirstSequence;
+	int64 NextSequence;
+
+	/** Spilled blocks, oldest first */
+	TArray<FAuditSegment> Segments;
+	FGuid SegmentSession;
+
+	/** Last segment read back, so paging through it reads the file once */
+	mutable int32 CachedSegmentIndex;
+	mutable TArray<FAuditLogEntry> CachedSegmentEntries;
+
+	/** Events waiting for the writer, which formats them; any thread may enqueue, only the writer dequeues */
+	TQueue<FAuditEvent, EQueueMode::Mpsc> WriteQueue;
+
+	/** Spilled blocks waiting for the writer, enqueued under LogMutex; their outcomes come back through SpillResults */
+	TQueue<FAuditSpill, EQueueMode::Mpsc> SpillQueue;
+	TQueue<FAuditSpillResult, EQueueMode::Mpsc> SpillResults;
+	FEvent* WriterEvent;
+	FRunnable* WriterRunnable;
+	FRunnableThread* WriterThread;
+	FDelegateHandle SystemErrorHandle;
+
+	/** Encodes events into the log's segment files; only touched by the writer, or under LogMutex when it isn't running */
+	TUniquePtr<FAuditSegmentWriter> LogWriter;
+
+	/** Producers hold it shared while they enqueue and wake the writer; StopWriter takes it exclusively to shut them out */
+	FRWLock WriterLock;
+
+	std::atomic<bool> bWriterRunning;
+	std::atomic<bool> bStopRequested;
+	std::atomic<uint8> FlushPolicy;
+
+	/** Events queued and events written, and Flush calls made and served; Flush waits for both to catch up */
+	std::atomic<int64> NumQueued;
+	std::atomic<int64> NumWritten;
+	std::atomic<int64> NumFlushRequests;
+	std::atomic<int64> NumFlushesDone;
 };
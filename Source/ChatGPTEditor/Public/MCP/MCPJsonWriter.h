@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "MCP/MCPTypes.h"
+
+/**
+ * Streaming JSON writer for MCP responses
+ * Writes compact UTF-8 JSON straight into a caller-owned byte buffer without building an
+ * FJsonObject tree or an intermediate FString. Callers reuse the buffer across messages,
+ * so steady-state responses do not allocate.
+ *
+ * Method names mirror TJsonWriter. Keys are ANSI literals and are written without escaping.
+ */
+class CHATGPTEDITOR_API FMCPJsonWriter
+{
+public:
+	explicit FMCPJsonWriter(TArray<uint8>& InBuffer);
+
+	// Containers
+	void WriteObjectStart();
+	void WriteObjectStart(const ANSICHAR* Identifier);
+	void WriteObjectEnd();
+	void WriteArrayStart();
+	void WriteArrayStart(const ANSICHAR* Identifier);
+	void WriteArrayEnd();
+
+	// Values (array elements or after WriteIdentifier)
+	void WriteIdentifier(const ANSICHAR* Identifier);
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(int64 Value);
+	void WriteValue(int32 Value) { WriteValue(static_cast<int64>(Value)); }
+	void WriteValue(double Value);
+	void WriteValue(bool Value);
+	void WriteNull();
+
+	// Object fields
+	template <typename ValueType>
+	void WriteValue(const ANSICHAR* Identifier, const ValueType& Value)
+	{
+		WriteIdentifier(Identifier);
+		WriteValue(Value);
+	}
+	void WriteValue(const ANSICHAR* Identifier, const TCHAR* Value) { WriteIdentifier(Identifier); WriteValue(FStringView(Value)); }
+
+	/** Splice an already-serialized UTF-8 JSON value (e.g. the cached tools/list array) */
+	void WriteRawJSONValue(const TArray<uint8>& Utf8Json);
+	void WriteRawJSONValue(const ANSICHAR* Identifier, const TArray<uint8>& Utf8Json);
+
+	/** Stream an existing DOM value without serializing it to an FString first */
+	void WriteJsonValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonObject(const TSharedPtr<FJsonObject>& Object);
+	void WriteJsonObject(const ANSICHAR* Identifier, const TSharedPtr<FJsonObject>& Object);
+
+	// JSON-RPC 2.0 envelopes
+	/** Writes {"jsonrpc":"2.0","id":Id,"result": - follow with exactly one value, then EndResponse() */
+	void BeginResultResponse(const FMCPRequestId& Id);
+	void EndResponse();
+	void WriteErrorResponse(const FMCPRequestId& Id, int32 Code, FStringView Message);
+
+	/** Rollback support: remember the current position and discard everything written after it */
+	struct FMark
+	{
+		int32 BufferSize;
+		int32 Depth;
+		bool bNeedsComma;
+	};
+	FMark GetMark() const;
+	void RestoreMark(const FMark& Mark);
+
+	/** Nesting depth of open objects/arrays; 0 when every container has been closed */
+	int32 GetDepth() const { return Depth; }
+
+	/** Number of times the target buffer had to grow while writing (0 once a reused buffer is warm) */
+	int32 GetNumBufferGrowths() const { return NumBufferGrowths; }
+
+	const TArray<uint8>& GetBuffer() const { return Buffer; }
+
+	/** Decode a UTF-8 buffer into an FString (for callers that still need TCHAR output) */
+	static FString ToString(const TArray<uint8>& Utf8Json);
+
+private:
+	void WriteSeparator();
+	void PushContainer(ANSICHAR OpenChar);
+	void PopContainer(ANSICHAR CloseChar);
+	void WriteEscapedString(FStringView Value);
+	void AppendAnsi(const ANSICHAR* Text, int32 Length);
+	void AppendAnsi(const ANSICHAR* Text);
+	void AppendByte(uint8 Byte);
+	void NoteGrowth(int32 PreviousMax);
+
+	TArray<uint8>& Buffer;
+	int32 Depth;
+	int32 NumBufferGrowths;
+
+	// True when the next value in the current container must be preceded by a comma
+	bool bNeedsComma;
+};
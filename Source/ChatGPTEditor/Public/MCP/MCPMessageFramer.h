@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental parser for newline-delimited JSON-RPC messages (the MCP stdio framing)
+ * Bytes are appended as they arrive from a pipe or socket; complete lines are popped one at a
+ * time. Each byte is scanned for the delimiter once, no matter how the stream is split into reads,
+ * and only the unfinished tail of the buffer is ever moved.
+ */
+class CHATGPTEDITOR_API FMCPMessageFramer
+{
+public:
+	/** Lines longer than InMaxMessageBytes are dropped instead of buffered without bound */
+	explicit FMCPMessageFramer(int32 InMaxMessageBytes = 16 * 1024 * 1024);
+	
+	/** Append raw bytes read from the transport */
+	void Append(const uint8* Data, int32 NumBytes);
+	
+	/**
+	 * Pop the next complete message, without its line terminator.
+	 * Blank lines are skipped. Returns false when no complete message is buffered.
+	 */
+	bool NextMessage(FString& OutMessage);
+	
+	/** Bytes of the message currently being assembled */
+	int32 GetNumPendingBytes() const { return Buffer.Num() - MessageStart; }
+	
+	/** Messages discarded because they exceeded the size limit */
+	int32 GetNumDroppedMessages() const { return NumDroppedMessages; }
+	
+	void Reset();
+	
+private:
+	/** Move the unfinished message to the front of the buffer */
+	void Compact();
+	
+	TArray<uint8> Buffer;
+	
+	// First byte of the message being assembled
+	int32 MessageStart;
+	
+	// Bytes before this offset are known not to contain a delimiter
+	int32 ScanOffset;
+	
+	int32 MaxMessageBytes;
+	int32 NumDroppedMessages;
+	
+	// True while skipping the remainder of an oversized message
+	bool bDiscarding;
+};
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+class FMCPSchemaValidator;
+
+typedef TSharedPtr<const FMCPSchemaValidator, ESPMode::ThreadSafe> FMCPSchemaValidatorPtr;
+
+/**
+ * JSON Schema types understood by FMCPSchemaValidator
+ */
+enum class EMCPSchemaType : uint8
+{
+	Any,
+	Null,
+	Boolean,
+	Integer,
+	Number,
+	String,
+	Array,
+	Object
+};
+
+/**
+ * One validated argument value
+ * Holds plain copies rather than DOM references so validated arguments can cross threads.
+ * Objects and arrays without a compiled item schema keep their condensed JSON in StringValue.
+ */
+struct FMCPArgumentValue
+{
+	EMCPSchemaType Type = EMCPSchemaType::Any;
+	bool bIsSet = false;
+	bool BoolValue = false;
+	double NumberValue = 0.0;
+	FString StringValue;
+	TArray<FMCPArgumentValue> ArrayValues;
+};
+
+/**
+ * Tool arguments that have passed a compiled input schema
+ * Every declared property, including nested object properties ("location.x"), has a slot filled
+ * in a single pass during validation; defaults from the schema are applied. Reads need no type or
+ * presence checks beyond IsSet for optional properties without a default.
+ */
+class CHATGPTEDITOR_API FMCPToolArguments
+{
+public:
+	/** True once filled by FMCPSchemaValidator::Validate */
+	bool IsValid() const { return Validator.IsValid(); }
+
+	/** Slot for a property path, or nullptr if the schema does not declare it */
+	const FMCPArgumentValue* Find(const TCHAR* Path) const;
+
+	/** True if the property was supplied or has a default */
+	bool IsSet(const TCHAR* Path) const;
+
+	FString GetString(const TCHAR* Path, const FString& Default = FString()) const;
+	double GetNumber(const TCHAR* Path, double Default = 0.0) const;
+	int32 GetInteger(const TCHAR* Path, int32 Default = 0) const;
+	bool GetBool(const TCHAR* Path, bool Default = false) const;
+
+	/** Direct slot access for callers that resolved FMCPSchemaValidator::FindSlot once */
+	const FMCPArgumentValue& GetSlot(int32 Slot) const { return Values[Slot]; }
+
+private:
+	friend class FMCPSchemaValidator;
+
+	FMCPSchemaValidatorPtr Validator;
+	TArray<FMCPArgumentValue> Values;
+};
+
+/**
+ * A tool input schema compiled once into a flat node table
+ * Supports the subset of JSON Schema tools use: type, properties, required, additionalProperties,
+ * minimum/maximum, minLength/maxLength, string enum, items, minItems/maxItems and default. Validation walks the
+ * compiled properties and does one field lookup per declared property.
+ */
+class CHATGPTEDITOR_API FMCPSchemaValidator : public TSharedFromThis<FMCPSchemaValidator, ESPMode::ThreadSafe>
+{
+public:
+	/** Compile an object schema; returns null and sets OutError if the schema is unusable */
+	static FMCPSchemaValidatorPtr Compile(const TSharedPtr<FJsonObject>& Schema, FString& OutError);
+
+	/** Validate arguments (null counts as an empty object) and fill OutArguments */
+	bool Validate(const TSharedPtr<FJsonObject>& Arguments, FMCPToolArguments& OutArguments, FString& OutError) const;
+
+	/** Slot index of a property path such as "count" or "location.x"; INDEX_NONE if undeclared */
+	int32 FindSlot(const TCHAR* Path) const;
+
+	int32 GetNumSlots() const { return SlotPaths.Num(); }
+
+private:
+	struct FNode
+	{
+		EMCPSchemaType Type = EMCPSchemaType::Any;
+
+		/** Dotted property path, used for slot lookup and error messages */
+		FString Path;
+
+		/** Index into Values, or INDEX_NONE for the root and array items */
+		int32 Slot = INDEX_NONE;
+
+		TOptional<double> Minimum;
+		TOptional<double> Maximum;
+		int32 MinLength = INDEX_NONE;
+		int32 MaxLength = INDEX_NONE;
+		int32 MinItems = INDEX_NONE;
+		int32 MaxItems = INDEX_NONE;
+		TArray<FString> EnumValues;
+
+		// Object: a contiguous range of Properties
+		int32 FirstProperty = 0;
+		int32 NumProperties = 0;
+		bool bAdditionalProperties = true;
+
+		// Array: compiled item schema
+		int32 ItemsNode = INDEX_NONE;
+
+		bool bHasDefault = false;
+		FMCPArgumentValue Default;
+	};
+
+	struct FProperty
+	{
+		FString Name;
+		int32 Node = INDEX_NONE;
+		bool bRequired = false;
+	};
+
+	int32 CompileNode(const TSharedPtr<FJsonObject>& Schema, const FString& Path, bool bHasSlot, int32 Depth, FString& OutError);
+	bool ValidateObject(const FNode& Node, const FJsonObject& Object, FMCPToolArguments& OutArguments, FString& OutError) const;
+	bool ValidateValue(const FNode& Node, const TSharedPtr<FJsonValue>& Value, FMCPToolArguments& OutArguments, FMCPArgumentValue& OutValue, FString& OutError) const;
+
+	static bool ReadLiteral(const TSharedPtr<FJsonValue>& Value, FMCPArgumentValue& OutValue);
+
+	TArray<FNode> Nodes;
+	TArray<FProperty> Properties;
+	TArray<FString> SlotPaths;
+};
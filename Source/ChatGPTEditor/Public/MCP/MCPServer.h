@@ -5,6 +5,130 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 #include "MCPTool.h"
+#include "MCPTypes.h"
+#include "MCPServerStats.h"
+
+class FMCPJsonWriter;
+
+/**
+ * A tool entry in the registry
+ */
+struct FMCPRegisteredTool
+{
+	TSharedPtr<IMCPTool> Tool;
+	
+	/** {"name","description","inputSchema"} serialized once at registration (UTF-8) */
+	TArray<uint8> DescriptorJson;
+	
+	/** inputSchema compiled at registration; null if the schema could not be compiled */
+	FMCPSchemaValidatorPtr ArgumentValidator;
+	
+	/** Shared by every registry snapshot containing this registration */
+	TSharedPtr<FMCPToolStats, ESPMode::ThreadSafe> Stats;
+};
+
+/**
+ * Immutable view of the registered tools.
+ * Published copy-on-write by RegisterTool/UnregisterTool; readers keep a reference
+ * for as long as they need it and never block writers or each other.
+ */
+struct FMCPToolRegistry
+{
+	TMap<FString, FMCPRegisteredTool> Tools;
+	
+	/** Pre-serialized tools/list "tools" array (UTF-8), spliced into every tools/list response */
+	TArray<uint8> ToolsListJson;
+	
+	/** Registry generation; bumped on every RegisterTool/UnregisterTool */
+	uint64 Generation = 0;
+};
+
+typedef TSharedPtr<const FMCPToolRegistry, ESPMode::ThreadSafe> FMCPToolRegistryPtr;
+
+/**
+ * tools/call requests started by ProcessMessageAsync that have not completed yet, keyed by request id.
+ * Shared with completion callbacks so they stay valid even if they finish after the server.
+ */
+struct FMCPInFlightRequests
+{
+	FCriticalSection Lock;
+	TMap<FMCPRequestId, FMCPToolExecutionContextRef> Contexts;
+};
+
+/**
+ * Lets batch entries still queued or running after ProcessMessageAsync returned reach the server.
+ * Entries hold the read lock while they dispatch; the server takes the write lock to clear bServerAlive
+ * as it is destroyed, so an entry either runs against a live server or answers without it.
+ */
+struct FMCPServerLifetime
+{
+	FRWLock Lock;
+	bool bServerAlive = true;
+};
+
+/** Receives serialized server-to-client notifications (e.g. notifications/tools/list_changed) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMCPNotification, const FString& /*NotificationJson*/);
+
+/**
+ * Handles one JSON-RPC method. Writes exactly one response (result or error) to the writer;
+ * returns false if the request failed, for the error counters.
+ */
+DECLARE_DELEGATE_RetVal_TwoParams(bool, FMCPMethodHandler, const FMCPRequest& /*Request*/, FMCPJsonWriter& /*Writer*/);
+
+/** Reads a registered resource for resources/read; returns false and sets OutError on failure */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FMCPResourceReader, const FString& /*Uri*/, FString& /*OutText*/, FString& /*OutError*/);
+
+/** Renders a registered prompt for prompts/get; returns false and sets OutError on failure */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FMCPPromptRenderer, const TMap<FString, FString>& /*Arguments*/, TArray<FMCPPromptMessage>& /*OutMessages*/, FString& /*OutError*/);
+
+/**
+ * A registered JSON-RPC method
+ */
+struct FMCPMethodEntry
+{
+	/** Exact method name; FName keys are case-insensitive, JSON-RPC methods are not */
+	FString Method;
+	
+	FMCPMethodHandler Handler;
+	
+	/** Handler may run on a worker thread, concurrently with other batch entries */
+	bool bThreadSafe = false;
+	
+	/** Shared by every table snapshot containing this registration */
+	TSharedPtr<FMCPMethodStats, ESPMode::ThreadSafe> Stats;
+};
+
+/**
+ * Immutable method dispatch table, keyed by FName so a request costs one name-table probe
+ * and one integer-hash lookup. Published copy-on-write like the tool registry.
+ */
+struct CHATGPTEDITOR_API FMCPMethodTable
+{
+	TMap<FName, FMCPMethodEntry> Methods;
+	
+	/** Find the handler for a method; never adds the method string to the name table */
+	const FMCPMethodEntry* Find(const FString& Method) const;
+};
+
+typedef TSharedPtr<const FMCPMethodTable, ESPMode::ThreadSafe> FMCPMethodTablePtr;
+
+/**
+ * A resource exposed through resources/list and resources/read
+ */
+struct FMCPRegisteredResource
+{
+	FMCPResourceInfo Info;
+	FMCPResourceReader Reader;
+};
+
+/**
+ * A prompt exposed through prompts/list and prompts/get
+ */
+struct FMCPRegisteredPrompt
+{
+	FMCPPromptInfo Info;
+	FMCPPromptRenderer Renderer;
+};
 
 /**
  * Main MCP Server for Unreal Engine
@@ -25,26 +149,137 @@ public:
 	void RegisterTool(TSharedPtr<IMCPTool> Tool);
 	void UnregisterTool(const FString& ToolName);
 	TArray<TSharedPtr<IMCPTool>> GetRegisteredTools() const;
+	TSharedPtr<IMCPTool> FindTool(const FString& ToolName) const;
+	
+	/** Current registry snapshot; safe to hold across tool execution */
+	FMCPToolRegistryPtr GetToolRegistry() const;
+	
+	/**
+	 * Method registration. Replaces any existing handler for the method, including the built-in
+	 * initialize/tools/resources/prompts handlers. A name that differs from a registered method only in
+	 * case is rejected, since methods are matched case-sensitively but stored case-insensitively.
+	 */
+	void RegisterMethodHandler(const FString& Method, FMCPMethodHandler Handler, bool bThreadSafe = false);
+	void UnregisterMethodHandler(const FString& Method);
+	bool HasMethodHandler(const FString& Method) const;
+	
+	// Resource registration (resources/list, resources/read)
+	void RegisterResource(const FMCPResourceInfo& Info, FMCPResourceReader Reader);
+	void UnregisterResource(const FString& Uri);
+	
+	// Prompt registration (prompts/list, prompts/get)
+	void RegisterPrompt(const FMCPPromptInfo& Info, FMCPPromptRenderer Renderer);
+	void UnregisterPrompt(const FString& Name);
 	
 	// Message processing
 	FString ProcessMessage(const FString& JsonMessage);
 	
+	/**
+	 * Same as ProcessMessage, but appends the UTF-8 response to a caller-owned (reusable) buffer.
+	 * Accepts a single request or a JSON-RPC batch array; notifications produce no output.
+	 * A batch waits for its entries that must run on the game thread, so off the game thread
+	 * use ProcessMessageAsync for batches.
+	 */
+	void ProcessMessage(const FString& JsonMessage, TArray<uint8>& OutResponse);
+	
+	/**
+	 * Asynchronous variant of ProcessMessage. A tools/call runs through IMCPTool::ExecuteAsync and is
+	 * tracked by id until it completes, so notifications/cancelled can stop it and the tool can send
+	 * notifications/progress. A batch completes once its last entry does, without blocking the calling
+	 * thread on the game thread. Everything else completes immediately. Cancelled requests and
+	 * notifications yield an empty string.
+	 */
+	TFuture<FString> ProcessMessageAsync(const FString& JsonMessage);
+	
+	/** Number of tools/call requests from ProcessMessageAsync still running */
+	int32 GetNumInFlightRequests() const;
+	
+	/** Notifications the server wants delivered to the client; bind a transport or UI here */
+	FOnMCPNotification& OnNotification() { return NotificationDelegate; }
+	
+	// Statistics (safe from any thread)
+	int64 GetRequestsProcessed() const { return Stats->RequestsProcessed.load(std::memory_order_relaxed); }
+	int64 GetErrorsEncountered() const { return Stats->ErrorsEncountered.load(std::memory_order_relaxed); }
+	
+	/** Write the server/stats result: counters, per-phase, per-method and per-tool latency */
+	void WriteStats(FMCPJsonWriter& Writer) const;
+	
+	/** Zero all counters and histograms */
+	void ResetStats();
+	
 protected:
 	// Protocol handlers
-	TSharedPtr<FJsonObject> HandleInitialize(int32 Id, const TSharedPtr<FJsonObject>& Params);
-	TSharedPtr<FJsonObject> HandleToolsList(int32 Id);
-	TSharedPtr<FJsonObject> HandleToolsCall(int32 Id, const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleInitialize(const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Params);
+	void HandleToolsList(const FMCPRequestId& Id, FMCPJsonWriter& Writer);
+	bool HandleToolsCall(const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Params, FMCPJsonWriter& Writer);
+	TFuture<FString> HandleToolsCallAsync(const FMCPRequest& Request, const FMCPRegisteredTool& Entry);
+	void HandleCancelled(const TSharedPtr<FJsonObject>& Params);
+	bool HandleResourcesList(const FMCPRequest& Request, FMCPJsonWriter& Writer);
+	bool HandleResourcesRead(const FMCPRequest& Request, FMCPJsonWriter& Writer);
+	bool HandlePromptsList(const FMCPRequest& Request, FMCPJsonWriter& Writer);
+	bool HandlePromptsGet(const FMCPRequest& Request, FMCPJsonWriter& Writer);
+	bool HandleServerStats(const FMCPRequest& Request, FMCPJsonWriter& Writer);
 	
 	// Response builders
-	FString CreateSuccessResponse(int32 Id, const TSharedPtr<FJsonObject>& Result) const;
-	FString CreateErrorResponse(int32 Id, int32 Code, const FString& Message) const;
+	void WriteSuccessResponse(FMCPJsonWriter& Writer, const FMCPRequestId& Id, const TSharedPtr<FJsonObject>& Result) const;
+	void WriteErrorResponse(FMCPJsonWriter& Writer, const FMCPRequestId& Id, int32 Code, const FString& Message) const;
+	FString CreateNotification(const FString& Method) const;
 	
 	// Request parsing
-	bool ParseRequest(const FString& JsonMessage, FString& OutMethod, int32& OutId, TSharedPtr<FJsonObject>& OutParams);
+	bool ParseRequest(const TSharedPtr<FJsonObject>& RequestObject, FMCPRequest& OutRequest);
+	
+	// Request execution
+	void DispatchRequest(const FMCPRequest& Request, FMCPJsonWriter& Writer);
+	void ProcessBatch(const TArray<TSharedPtr<FJsonValue>>& BatchValues, FMCPJsonWriter& Writer);
+	
+	/** Run a batch's thread-safe entries on the task graph and the rest on the game thread; yields the stitched UTF-8 response */
+	TFuture<TArray<uint8>> ProcessBatchAsync(const TArray<TSharedPtr<FJsonValue>>& BatchValues);
+	bool CanRunConcurrently(const FMCPRequest& Request) const;
 	
 private:
-	// Registered tools
-	TMap<FString, TSharedPtr<IMCPTool>> RegisteredTools;
+	// Swap in a new registry snapshot (caller holds RegistrationLock)
+	void PublishToolRegistry(TSharedRef<FMCPToolRegistry, ESPMode::ThreadSafe> NewRegistry);
+	
+	// Serialize a tool's tools/list entry
+	static TArray<uint8> SerializeToolDescriptor(const IMCPTool& Tool);
+	
+	/** Extract tools/call arguments and check them against the tool's compiled schema */
+	static bool ValidateToolArguments(const FMCPRegisteredTool& Entry, const TSharedPtr<FJsonObject>& Params,
+		TSharedPtr<FJsonObject>& OutArguments, FMCPToolArguments& OutValidatedArguments, FString& OutError);
+	
+	// Tell the client that tools/list changed
+	void NotifyToolsListChanged();
+	
+	// Cancel every in-flight request and stop it from reaching NotificationDelegate
+	void CancelInFlightRequests();
+	
+	// Install the protocol's own methods in the dispatch table
+	void RegisterBuiltInMethods();
+	
+	FMCPMethodTablePtr GetMethodTable() const;
+	
+	// Registered tools (immutable snapshot, replaced on every change)
+	FMCPToolRegistryPtr ToolRegistry;
+	uint64 RegistryGeneration;
+	
+	// JSON-RPC method handlers (immutable snapshot, replaced on every change)
+	FMCPMethodTablePtr MethodTable;
+	mutable FRWLock MethodTableLock;
+	
+	// Resources by URI and prompts by name
+	TMap<FString, FMCPRegisteredResource> Resources;
+	TMap<FString, FMCPRegisteredPrompt> Prompts;
+	mutable FRWLock ResourcesLock;
+	mutable FRWLock PromptsLock;
+	
+	// Server-to-client notifications
+	FOnMCPNotification NotificationDelegate;
+	
+	// Async tools/call requests, for cancellation
+	TSharedRef<FMCPInFlightRequests, ESPMode::ThreadSafe> InFlightRequests;
+	
+	// Held by async batch entries, which can outlive the call that started them
+	TSharedRef<FMCPServerLifetime, ESPMode::ThreadSafe> Lifetime;
 	
 	// Server state
 	FString ProtocolVersion;
@@ -54,9 +289,11 @@ private:
 	TSharedPtr<FJsonObject> ServerCapabilities;
 	
 	// Thread safety
-	mutable FCriticalSection RegistrationLock;
+	// RegistrationLock serializes writers building the next snapshot.
+	// ToolRegistryLock only guards the pointer swap/copy, never tool execution.
+	FCriticalSection RegistrationLock;
+	mutable FRWLock ToolRegistryLock;
 	
-	// Statistics
-	int32 RequestsProcessed;
-	int32 ErrorsEncountered;
+	// Statistics (shared with async tools/call continuations, like InFlightRequests)
+	TSharedRef<FMCPServerStats, ESPMode::ThreadSafe> Stats;
 };
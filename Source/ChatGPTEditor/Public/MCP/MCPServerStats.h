@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FMCPJsonWriter;
+
+/**
+ * Percentile summary of an FMCPLatencyHistogram, in microseconds
+ */
+struct FMCPLatencySummary
+{
+	int64 Count = 0;
+	double TotalMicros = 0.0;
+	double MeanMicros = 0.0;
+	double P50Micros = 0.0;
+	double P90Micros = 0.0;
+	double P99Micros = 0.0;
+	double MaxMicros = 0.0;
+
+	/** {"count","totalMs","meanUs","p50Us","p90Us","p99Us","maxUs"} */
+	void Write(FMCPJsonWriter& Writer) const;
+};
+
+/**
+ * Lock-free log-linear latency histogram (HDR-style)
+ * Each power of two is split into 16 linear sub-buckets, so any recorded value is reported within
+ * ~6% of its true value from 1us up to ~12 days. Record is a few relaxed atomic adds and is safe
+ * from any thread; Summarize reads a consistent-enough view without stopping writers.
+ */
+class CHATGPTEDITOR_API FMCPLatencyHistogram
+{
+public:
+	FMCPLatencyHistogram();
+
+	void RecordMicros(uint64 Micros);
+
+	/** Record the time between an FPlatformTime::Cycles64() sample and now */
+	void RecordSince(uint64 StartCycles);
+
+	/** Microseconds elapsed since an FPlatformTime::Cycles64() sample */
+	static uint64 MicrosSince(uint64 StartCycles);
+
+	FMCPLatencySummary Summarize() const;
+
+	void Reset();
+
+private:
+	static constexpr int32 SubBucketBits = 4;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 MaxExponent = 40;
+	static constexpr int32 NumBuckets = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+	static int32 GetBucketIndex(uint64 Micros);
+
+	/** Largest value that maps to a bucket, used as the reported percentile */
+	static uint64 GetBucketUpperBound(int32 Index);
+
+	std::atomic<uint64> Buckets[NumBuckets];
+	std::atomic<uint64> Count;
+	std::atomic<uint64> TotalMicros;
+	std::atomic<uint64> MaxMicros;
+};
+
+/**
+ * Counters and latency for one JSON-RPC method
+ * Owned by the method table entry, so dispatch reaches it without another lookup.
+ */
+struct FMCPMethodStats
+{
+	std::atomic<int64> Requests{0};
+	std::atomic<int64> Errors{0};
+
+	/** Handler time, from method lookup to response written */
+	FMCPLatencyHistogram Latency;
+};
+
+/**
+ * Counters and latency for one tool, owned by its registry entry
+ */
+struct FMCPToolStats
+{
+	std::atomic<int64> Calls{0};
+	std::atomic<int64> Errors{0};
+
+	/** Tool execution; for async calls, from ExecuteAsync until the result is available */
+	FMCPLatencyHistogram Execute;
+
+	/** Writing the tool result into the response */
+	FMCPLatencyHistogram Serialize;
+};
+
+/**
+ * Server-wide counters and per-phase latency
+ */
+struct FMCPServerStats
+{
+	std::atomic<int64> RequestsProcessed{0};
+	std::atomic<int64> ErrorsEncountered{0};
+
+	/** JSON text to FMCPRequest */
+	FMCPLatencyHistogram Parse;
+
+	/** DispatchRequest, all methods */
+	FMCPLatencyHistogram Dispatch;
+
+	/** Tool execution, all tools */
+	FMCPLatencyHistogram Execute;
+
+	/** Tool result serialization, all tools */
+	FMCPLatencyHistogram Serialize;
+};
@@ -4,6 +4,55 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Async/Future.h"
+#include "MCPSchemaValidator.h"
+#include "MCPTypes.h"
+#include <atomic>
+
+class FMCPJsonWriter;
+
+/**
+ * Per-call state handed to IMCPTool::ExecuteAsync
+ * Carries the request id, a cancellation flag raised by notifications/cancelled and a progress
+ * channel bound to the caller's _meta.progressToken. Safe to use from any thread.
+ */
+class CHATGPTEDITOR_API FMCPToolExecutionContext
+{
+public:
+	FMCPToolExecutionContext(const FMCPRequestId& InRequestId, const TSharedPtr<FJsonValue>& InProgressToken, TFunction<void(const FString&)> InNotificationSink);
+	
+	const FMCPRequestId& GetRequestId() const { return RequestId; }
+	
+	/** Long-running tools should poll this between units of work and stop early */
+	bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+	
+	/** True when the client supplied a progress token */
+	bool WantsProgress() const { return ProgressToken.IsValid(); }
+	
+	/** Send notifications/progress to the client. Total <= 0 means unknown. No-op without a progress token */
+	void ReportProgress(double Progress, double Total = 0.0, const FString& Message = FString());
+	
+	/** Stop forwarding notifications; called by the server when it shuts down */
+	void DetachNotificationSink();
+	
+	/** Arguments validated against the tool's compiled input schema; invalid if none was supplied */
+	const FMCPToolArguments& GetArguments() const { return Arguments; }
+	
+	/** Set by the server before ExecuteAsync; immutable afterwards, so readable from any thread */
+	void SetArguments(FMCPToolArguments&& InArguments) { Arguments = MoveTemp(InArguments); }
+	
+private:
+	FMCPRequestId RequestId;
+	TSharedPtr<FJsonValue> ProgressToken;
+	FMCPToolArguments Arguments;
+	std::atomic<bool> bCancelled;
+	
+	FCriticalSection NotificationSinkLock;
+	TFunction<void(const FString&)> NotificationSink;
+};
+
+typedef TSharedRef<FMCPToolExecutionContext, ESPMode::ThreadSafe> FMCPToolExecutionContextRef;
 
 /**
  * Interface for MCP tools
@@ -22,6 +71,36 @@ public:
 	// Execution
 	virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Arguments) = 0;
 	
+	/**
+	 * Called by the server instead of Execute once the arguments have passed the compiled input
+	 * schema. The default forwards the raw arguments to Execute.
+	 */
+	virtual TSharedPtr<FJsonObject> ExecuteValidated(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolArguments& ValidatedArguments) { return Execute(Arguments); }
+	
+	/**
+	 * Asynchronous execution used by FMCPServer::ProcessMessageAsync.
+	 * The default runs Execute on the calling thread and returns a completed future. Long-running
+	 * tools override this, complete the future from wherever the work finishes, poll
+	 * Context->IsCancelled() and report progress through the context. When the call came through
+	 * the server, Context->GetArguments() holds the validated arguments.
+	 */
+	virtual TFuture<TSharedPtr<FJsonObject>> ExecuteAsync(const TSharedPtr<FJsonObject>& Arguments, const FMCPToolExecutionContextRef& Context);
+	
+	/**
+	 * Opt-in zero-DOM path. When this returns true the server calls ExecuteStreaming instead of
+	 * Execute, letting the tool write its result straight into the response buffer.
+	 */
+	virtual bool SupportsStreamingResult() const { return false; }
+	
+	/** Write exactly one JSON object (the tools/call result) to ResultWriter */
+	virtual void ExecuteStreaming(const TSharedPtr<FJsonObject>& Arguments, FMCPJsonWriter& ResultWriter) {}
+	
+	/**
+	 * Thread-safe tools (typically read-only) may run on task graph workers, concurrently with
+	 * other calls in the same batch. Others are executed in request order on the game thread.
+	 */
+	virtual bool IsThreadSafe() const { return false; }
+	
 	// Security
 	virtual bool RequiresConfirmation() const { return false; }
 	virtual bool IsDangerous() const { return false; }
@@ -41,11 +120,28 @@ public:
 	virtual FString GetDescription() const override { return Description; }
 	
 protected:
-	// Helper functions for creating responses
-	TSharedPtr<FJsonObject> CreateSuccessResponse(const FString& Message) const;
-	TSharedPtr<FJsonObject> CreateErrorResponse(const FString& ErrorMessage) const;
-	TSharedPtr<FJsonObject> CreateTextContent(const FString& Text) const;
+	// Helper functions for creating responses; static so game thread tasks can build results without the tool
+	static TSharedPtr<FJsonObject> CreateSuccessResponse(const FString& Message);
+	static TSharedPtr<FJsonObject> CreateErrorResponse(const FString& ErrorMessage);
+	static TSharedPtr<FJsonObject> CreateTextContent(const FString& Text);
+	
+	/** A JSON argument as Unreal property text: booleans as True/False, whole numbers without a fraction */
+	static FString ToPropertyText(const TSharedPtr<FJsonValue>& Value);
+	
+	// Streaming equivalents of CreateSuccessResponse/CreateErrorResponse
+	void WriteSuccessResponse(FMCPJsonWriter& Writer, FStringView Message) const;
+	void WriteErrorResponse(FMCPJsonWriter& Writer, FStringView ErrorMessage) const;
+	
+	/**
+	 * Validate against this tool's input schema, compiled on first use.
+	 * For direct callers of Execute/ExecuteAsync; calls through FMCPServer arrive pre-validated.
+	 */
+	bool ValidateArguments(const TSharedPtr<FJsonObject>& Arguments, FMCPToolArguments& OutArguments, FString& OutError) const;
 	
 	FString Name;
 	FString Description;
+	
+private:
+	mutable FCriticalSection ArgumentValidatorLock;
+	mutable FMCPSchemaValidatorPtr ArgumentValidator;
 };
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "MCPMessageFramer.h"
+#include <atomic>
+
+class FMCPServer;
+class FRunnableThread;
+class FSocket;
+
+/**
+ * Base class for MCP transports (newline-delimited JSON-RPC over a byte stream)
+ * A reader thread feeds an FMCPMessageFramer and hands each message to the server; responses and
+ * server notifications are queued and written by a dedicated writer thread, so slow clients never
+ * stall request processing.
+ *
+ * Create with MakeShared and Stop before releasing the last reference; the server must outlive
+ * the transport.
+ */
+class CHATGPTEDITOR_API FMCPTransport : public TSharedFromThis<FMCPTransport, ESPMode::ThreadSafe>
+{
+public:
+	explicit FMCPTransport(FMCPServer& InServer);
+	virtual ~FMCPTransport();
+
+	/** Open the stream and start the reader/writer threads */
+	bool Start();
+
+	/** Stop both threads and close the stream; queued responses are flushed first */
+	void Stop();
+
+	bool IsRunning() const { return bRunning; }
+
+	/** True once the client has closed the stream (e.g. stdin reached EOF) */
+	bool IsClosedByPeer() const { return bClosedByPeer; }
+
+	/** Queue one message for the client connected now; the line terminator is added here */
+	void Send(const FString& Message);
+
+	/**
+	 * Where requests are processed. The default (game thread) is safe for every tool.
+	 * Dispatching on the reader thread removes the per-frame hop and is meant for servers whose
+	 * tools are thread-safe or marshal to the game thread themselves.
+	 */
+	void SetDispatchOnGameThread(bool bInDispatchOnGameThread) { bDispatchOnGameThread = bInDispatchOnGameThread; }
+
+	// Statistics
+	int64 GetNumMessagesReceived() const { return NumMessagesReceived; }
+	int64 GetNumMessagesSent() const { return NumMessagesSent; }
+
+protected:
+	/** Open the underlying stream; called on the thread that calls Start */
+	virtual bool Open() = 0;
+
+	/** Close the underlying stream; called after both threads have exited */
+	virtual void Close() = 0;
+
+	/**
+	 * Read available bytes, blocking for at most a short interval so Stop is noticed.
+	 * Returns the number of bytes read, 0 on timeout, or -1 at end of stream.
+	 */
+	virtual int32 Read(uint8* Data, int32 MaxBytes) = 0;
+
+	/** Write all bytes; returns false if the stream is broken */
+	virtual bool Write(const uint8* Data, int32 NumBytes) = 0;
+
+	/** Human-readable name used for thread names and logs */
+	virtual const TCHAR* GetTransportName() const = 0;
+
+	/** True while Stop has not been requested; Read implementations may poll it */
+	bool ShouldRun() const { return !bStopRequested; }
+
+	/**
+	 * Start a new connection, before the new client can be read from or written to. The reader drops
+	 * any partial message the last client left, and messages queued for it are dropped unsent.
+	 */
+	void BeginConnection();
+
+private:
+	/** An outgoing UTF-8 line and the connection it answers */
+	struct FOutgoingLine
+	{
+		uint32 ConnectionId = 0;
+		TArray<uint8> Line;
+	};
+
+	uint32 RunReader();
+	uint32 RunWriter();
+	void Dispatch(FString&& Message, uint32 MessageConnectionId);
+	void SendToConnection(const FString& Message, uint32 MessageConnectionId);
+	void FlushSendQueue(TArray<uint8>& WriteBuffer);
+
+	FMCPServer& Server;
+
+	// Outgoing lines; any thread may enqueue, only the writer dequeues
+	TQueue<FOutgoingLine, EQueueMode::Mpsc> SendQueue;
+	FEvent* SendEvent;
+
+	// Bumped by BeginConnection; the writer holds ConnectionLock while it writes, so a line never reaches a later client
+	std::atomic<uint32> ConnectionId;
+	FCriticalSection ConnectionLock;
+
+	FRunnable* ReaderRunnable;
+	FRunnable* WriterRunnable;
+	FRunnableThread* ReaderThread;
+	FRunnableThread* WriterThread;
+
+	FDelegateHandle NotificationHandle;
+
+	std::atomic<bool> bRunning;
+	std::atomic<bool> bStopRequested;
+	std::atomic<bool> bClosedByPeer;
+	std::atomic<bool> bDispatchOnGameThread;
+	std::atomic<int64> NumMessagesReceived;
+	std::atomic<int64> NumMessagesSent;
+};
+
+/**
+ * MCP over the process's stdin/stdout, as launched by desktop MCP clients
+ * Nothing else may write to stdout while this transport is running.
+ */
+class CHATGPTEDITOR_API FMCPStdioTransport : public FMCPTransport
+{
+public:
+	explicit FMCPStdioTransport(FMCPServer& InServer);
+	virtual ~FMCPStdioTransport();
+
+protected:
+	virtual bool Open() override;
+	virtual void Close() override;
+	virtual int32 Read(uint8* Data, int32 MaxBytes) override;
+	virtual bool Write(const uint8* Data, int32 NumBytes) override;
+	virtual const TCHAR* GetTransportName() const override { return TEXT("MCPStdio"); }
+};
+
+/**
+ * MCP over a localhost TCP socket (one client at a time)
+ * Port 0 binds an ephemeral port; see GetBoundPort.
+ */
+class CHATGPTEDITOR_API FMCPTcpTransport : public FMCPTransport
+{
+public:
+	FMCPTcpTransport(FMCPServer& InServer, int32 InPort);
+	virtual ~FMCPTcpTransport();
+
+	/** Port actually listened on, valid after Start */
+	int32 GetBoundPort() const { return BoundPort; }
+
+protected:
+	virtual bool Open() override;
+	virtual void Close() override;
+	virtual int32 Read(uint8* Data, int32 MaxBytes) override;
+	virtual bool Write(const uint8* Data, int32 NumBytes) override;
+	virtual const TCHAR* GetTransportName() const override { return TEXT("MCPTcp"); }
+
+private:
+	/** Accept a pending client if none is connected; returns the current client */
+	FSocket* AcceptClient();
+	void CloseClient();
+
+	int32 Port;
+	int32 BoundPort;
+
+	FSocket* ListenSocket;
+
+	// Accepted by the reader, written to by the writer
+	FSocket* ClientSocket;
+	FCriticalSection ClientLock;
+};
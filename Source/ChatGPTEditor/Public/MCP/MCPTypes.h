@@ -21,6 +21,9 @@ namespace MCPProtocol
 	static constexpr int32 InvalidParams = -32602;
 	static constexpr int32 InternalError = -32603;
 	
+	// MCP error codes
+	static constexpr int32 ResourceNotFound = -32002;
+	
 	// MCP methods
 	static const FString Method_Initialize = TEXT("initialize");
 	static const FString Method_ToolsList = TEXT("tools/list");
@@ -28,21 +31,84 @@ namespace MCPProtocol
 	static const FString Method_ResourcesList = TEXT("resources/list");
 	static const FString Method_ResourcesRead = TEXT("resources/read");
 	static const FString Method_PromptsList = TEXT("prompts/list");
+	static const FString Method_PromptsGet = TEXT("prompts/get");
+	
+	// Server extensions
+	static const FString Method_ServerStats = TEXT("server/stats");
+	static const FString Method_AuditQuery = TEXT("audit/query");
+	
+	// MCP notifications (server -> client)
+	static const FString Notification_ToolsListChanged = TEXT("notifications/tools/list_changed");
+	static const FString Notification_Progress = TEXT("notifications/progress");
+	
+	// MCP notifications (either direction)
+	static const FString Notification_Cancelled = TEXT("notifications/cancelled");
 }
 
+class FMCPJsonWriter;
+
+/**
+ * JSON-RPC request id: a number, a string or null
+ * Kept as the client sent it, so the response echoes it back unchanged.
+ */
+struct CHATGPTEDITOR_API FMCPRequestId
+{
+	/** A null id, as used for responses to requests whose id couldn't be read */
+	FMCPRequestId() = default;
+	FMCPRequestId(int32 InNumber) : Kind(EKind::Number), Number(InNumber) {}
+	explicit FMCPRequestId(const FString& InString) : Kind(EKind::String), String(InString) {}
+	
+	/** Read an id from its JSON value; false for anything but a number, a string or null */
+	static bool FromJson(const TSharedPtr<FJsonValue>& Value, FMCPRequestId& OutId);
+	
+	/** Write the id as a JSON value */
+	void Write(FMCPJsonWriter& Writer) const;
+	
+	/** The id as JSON, for messages */
+	FString ToString() const;
+	
+	bool IsNull() const { return Kind == EKind::Null; }
+	
+	bool operator==(const FMCPRequestId& Other) const
+	{
+		return Kind == Other.Kind && Number == Other.Number && String.Equals(Other.String, ESearchCase::CaseSensitive);
+	}
+	bool operator!=(const FMCPRequestId& Other) const { return !(*this == Other); }
+	
+	friend uint32 GetTypeHash(const FMCPRequestId& Id)
+	{
+		return HashCombine(::GetTypeHash(static_cast<uint8>(Id.Kind)), Id.Kind == EKind::String ? FCrc::StrCrc32(*Id.String) : ::GetTypeHash(Id.Number));
+	}
+	
+private:
+	enum class EKind : uint8
+	{
+		Null,
+		Number,
+		String
+	};
+	
+	EKind Kind = EKind::Null;
+	double Number = 0.0;
+	FString String;
+};
+
 /**
  * JSON-RPC request structure
  */
 struct FMCPRequest
 {
 	FString JsonRpc;
-	int32 Id;
+	FMCPRequestId Id;
 	FString Method;
 	TSharedPtr<FJsonObject> Params;
 	
+	/** True when the request had no id field; the server must not reply. An id of null is still a request. */
+	bool bIsNotification;
+	
 	FMCPRequest()
 		: JsonRpc(TEXT("2.0"))
-		, Id(0)
+		, bIsNotification(false)
 	{}
 };
 
@@ -52,16 +118,18 @@ struct FMCPRequest
 struct FMCPResponse
 {
 	FString JsonRpc;
-	int32 Id;
+	FMCPRequestId Id;
 	TSharedPtr<FJsonObject> Result;
 	TSharedPtr<FJsonObject> Error;
 	
 	FMCPResponse()
 		: JsonRpc(TEXT("2.0"))
-		, Id(0)
 	{}
 	
 	FString ToJsonString() const;
+	
+	/** Append the compact UTF-8 encoding to OutBuffer (no DOM, no FString) */
+	void WriteJson(TArray<uint8>& OutBuffer) const;
 };
 
 /**
@@ -84,3 +152,32 @@ struct FMCPResourceInfo
 	FString Description;
 	FString MimeType;
 };
+
+/**
+ * MCP prompt argument metadata
+ */
+struct FMCPPromptArgument
+{
+	FString Name;
+	FString Description;
+	bool bRequired = false;
+};
+
+/**
+ * MCP prompt metadata
+ */
+struct FMCPPromptInfo
+{
+	FString Name;
+	FString Description;
+	TArray<FMCPPromptArgument> Arguments;
+};
+
+/**
+ * A rendered prompt message (text content only)
+ */
+struct FMCPPromptMessage
+{
+	FString Role;
+	FString Text;
+};
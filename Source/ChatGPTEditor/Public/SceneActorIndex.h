@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Math/GenericOctree.h"
+
+class AActor;
+class UWorld;
+class ULevel;
+class AVolume;
+struct FPropertyChangedEvent;
+
+/**
+ * Lookup tables for the actors of one world, keyed by class, tag, label and outliner folder, plus a
+ * loose octree of actor bounds for spatial queries. Kept current through the engine's level actor
+ * delegates, so queries cost about as much as the number of matches instead of a walk over every
+ * actor. Game thread only.
+ */
+class CHATGPTEDITOR_API FSceneActorIndex
+{
+public:
+	explicit FSceneActorIndex(UWorld* InWorld);
+	~FSceneActorIndex();
+
+	FSceneActorIndex(const FSceneActorIndex&) = delete;
+	FSceneActorIndex& operator=(const FSceneActorIndex&) = delete;
+
+	UWorld* GetWorld() const { return World.Get(); }
+
+	/** Number of indexed actors */
+	int32 Num();
+
+	/** Actors of a class or any of its subclasses */
+	void FindByClass(const UClass* Class, TArray<AActor*>& OutActors);
+
+	/** Actors carrying a tag */
+	void FindByTag(FName Tag, TArray<AActor*>& OutActors);
+
+	/** Actors with a label, compared case-insensitively */
+	void FindByLabel(const FString& Label, TArray<AActor*>& OutActors);
+
+	/** Actors in an outliner folder or any folder below it */
+	void FindByFolder(FName Folder, TArray<AActor*>& OutActors);
+
+	/** Every indexed actor */
+	void GetAllActors(TArray<AActor*>& OutActors);
+
+	/** Actors whose bounds intersect a sphere */
+	void FindInSphere(const FVector& Center, double Radius, TArray<AActor*>& OutActors);
+
+	/** Actors whose bounds intersect a box */
+	void FindInBox(const FBox& Box, TArray<AActor*>& OutActors);
+
+	/** Actors whose location is inside a volume, excluding the volume itself */
+	void FindInVolume(const AVolume* Volume, TArray<AActor*>& OutActors);
+
+	/** Re-read an actor's bounds; needed after moves made from code, which don't broadcast OnActorMoved */
+	void UpdateBounds(AActor* Actor);
+
+	/** Drop everything and re-read the world; called automatically when the actor list changes wholesale */
+	void Rebuild();
+
+private:
+	/** Keys an actor was filed under, so it can be removed without searching */
+	struct FEntry
+	{
+		const UClass* Class = nullptr;
+		TArray<FName> Tags;
+		FString Label;
+		FName Folder;
+		FOctreeElementId2 OctreeId;
+	};
+
+	struct FOctreeElement
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FBoxCenterAndExtent Bounds;
+
+		/** Owner, so element ids can be written back to the entry */
+		FSceneActorIndex* Index = nullptr;
+	};
+
+	struct FOctreeSemantics
+	{
+		enum { MaxElementsPerLeaf = 16 };
+		enum { MinInclusiveElementsPerNode = 7 };
+		enum { MaxNodeDepth = 12 };
+
+		typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+		FORCEINLINE static const FBoxCenterAndExtent& GetBoundingBox(const FOctreeElement& Element) { return Element.Bounds; }
+		FORCEINLINE static bool AreElementsEqual(const FOctreeElement& A, const FOctreeElement& B) { return A.Actor == B.Actor; }
+		static void SetElementId(const FOctreeElement& Element, FOctreeElementId2 Id);
+	};
+
+	typedef TOctree2<FOctreeElement, FOctreeSemantics> FActorOctree;
+
+	typedef TSet<TWeakObjectPtr<AActor>> FActorSet;
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+	void RefreshActor(AActor* Actor);
+	bool IsIndexable(const AActor* Actor) const;
+
+	/** Rebuild if a wholesale change was seen since the last query */
+	void EnsureUpToDate();
+
+	static void AppendValid(const FActorSet& Set, TArray<AActor*>& OutActors);
+	static FBox GetActorBounds(const AActor* Actor);
+
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorMoved(AActor* Actor);
+	void OnActorListChanged();
+	void OnActorLabelChanged(AActor* Actor);
+	void OnActorFolderChanged(const AActor* Actor, FName OldFolder);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnLevelAddedOrRemoved(ULevel* Level, UWorld* InWorld);
+
+	TWeakObjectPtr<UWorld> World;
+
+	TMap<TWeakObjectPtr<AActor>, FEntry> Entries;
+	TMap<const UClass*, FActorSet> ByClass;
+	TMap<FName, FActorSet> ByTag;
+	TMap<FString, FActorSet> ByLabel;
+	TMap<FName, FActorSet> ByFolder;
+	TUniquePtr<FActorOctree> Octree;
+
+	bool bDirty = true;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle ActorFolderChangedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
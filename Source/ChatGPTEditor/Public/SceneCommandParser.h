@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneEditingTypes.h"
+
+/**
+ * Kinds of token in a scene edit command
+ */
+enum class ESceneTokenType : uint8
+{
+	/** Letters, digits, '_', '-', '/' and inner '.' starting with a letter or '_' ("lights", "BP_Tree", "Foliage/Trees", "LightComponent.Intensity") */
+	Word,
+
+	/** Optionally signed decimal number */
+	Number,
+
+	Comma,
+	Colon,
+
+	/** Sentence punctuation: ';', '.', '!' or '?' */
+	Separator,
+
+	End
+};
+
+/**
+ * One token of a scene edit command. Text points into the command and is only valid while it is.
+ */
+struct FSceneToken
+{
+	ESceneTokenType Type = ESceneTokenType::End;
+	FStringView Text;
+
+	/** Value of Number tokens */
+	double Number = 0.0;
+
+	bool IsWord() const { return Type == ESceneTokenType::Word; }
+	bool IsNumber() const { return Type == ESceneTokenType::Number; }
+};
+
+/**
+ * Single pass lexer over a scene edit command; tokens are views into the input, so nothing is allocated
+ */
+class CHATGPTEDITOR_API FSceneCommandLexer
+{
+public:
+	explicit FSceneCommandLexer(FStringView InCommand)
+		: Command(InCommand)
+	{
+	}
+
+	/** Read the next token; returns End tokens once the input is used up */
+	FSceneToken Next();
+
+private:
+	/** A '.' followed by a letter, which joins a property path rather than ending a sentence */
+	static bool IsPathDot(FStringView Command, int32 Position);
+
+	FStringView Command;
+	int32 Position = 0;
+};
+
+/**
+ * Grammar for natural language scene edit commands:
+ *
+ *   command := clause { ("and" | "then" | "," | ";" | ".") clause }
+ *   clause  := verb { count | type | shape | location | region | direction [amount [unit]] | color | placement | pattern | path "to" value | key ":" value }
+ *   pattern := ("grid" | "ring" | "scatter" | "surface" | "ground") | ("spaced" | "radius") amount [unit]
+ *
+ * Clauses only split before a verb, so "at 100, 200, 0" stays one location. Each clause becomes one
+ * action and words the grammar doesn't know are skipped, so "add 3 spot lights and move cameras up 2 m"
+ * gives a spawn and a move.
+ */
+class CHATGPTEDITOR_API FSceneCommandParser
+{
+public:
+	/** Parse a command, appending one action per clause; returns the number of actions added */
+	static int32 Parse(FStringView Command, TArray<FSceneEditAction>& OutActions);
+
+	/** Color for a color name the grammar knows ("red", "Cyan"); false if unknown */
+	static bool FindNamedColor(FStringView Name, FLinearColor& OutColor);
+
+	/** Largest count one clause can ask for */
+	static constexpr int32 MaxCount = 10000;
+
+	/** Distance of a move that gives a direction but no amount */
+	static constexpr double DefaultMoveDistance = 100.0;
+};
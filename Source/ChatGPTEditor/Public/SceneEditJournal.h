@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+class UStaticMesh;
+class UMaterialInterface;
+
+/** Kinds of record in a scene edit journal */
+enum class ESceneJournalOp : uint8
+{
+	/** Defines the next name id: a class, mesh, material, tag, folder, property path, or component or property name */
+	Name,
+
+	/** Defines the next actor id from the actor's GUID */
+	Actor,
+
+	/** Starts a batch: one executed scene edit plan */
+	Batch,
+
+	Spawn,
+	Destroy,
+	Transform,
+	Property,
+	AddInstances
+};
+
+/**
+ * Binary journal of the deltas applied by scene edits: actors spawned and destroyed, transforms before
+ * and after, and the text of every changed property before and after. Actors are identified by GUID,
+ * falling back to their object name in a copy of the level, and names and GUIDs are interned so each
+ * record only carries small ids plus what changed.
+ *
+ * Records are appended in one byte stream, which is also the file format after a short header, so a
+ * session file grows one committed batch at a time and can be read back by scanning it once.
+ * Undo walks the records backwards and reuses the actors this session touched. Only when one of them
+ * is gone, or the journal is applied to another world, does it scan the level once to look actors up
+ * by GUID and name.
+ */
+class CHATGPTEDITOR_API FSceneEditJournal
+{
+public:
+	FSceneEditJournal();
+	~FSceneEditJournal();
+
+	/** Write each committed batch to a new session file in Directory as well; empty to keep the journal in memory */
+	void SetOutputDirectory(const FString& Directory);
+
+	/** Path of the session file, empty when there is none yet */
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Start recording the deltas of one plan; records made outside a batch are ignored */
+	void BeginBatch(const FString& Description);
+
+	/** Finish the open batch, appending it to the session file; a batch that recorded nothing is dropped */
+	void CommitBatch();
+
+	bool IsRecording() const { return BatchStart != INDEX_NONE; }
+
+	/** Record an actor the batch spawned, as it is now */
+	void RecordSpawn(AActor* Actor);
+
+	/**
+	 * Record an actor the batch is about to destroy, with what is needed to spawn it again: besides its class,
+	 * placement, label, folder and tags, every property of it and its class-made components that differs from
+	 * their defaults, in Unreal text format
+	 */
+	void RecordDestroy(AActor* Actor);
+
+	/** Record a transform change; only the components that differ are stored */
+	void RecordTransform(AActor* Actor, const FTransform& OldTransform, const FTransform& NewTransform);
+
+	/** Record a property change by path, with the old and new values in Unreal text format */
+	void RecordProperty(AActor* Actor, const FString& Path, const FString& OldValue, const FString& NewValue);
+
+	/** Record instances added to an instanced actor from FirstIndex on; bCreatedHolder if the batch created that actor */
+	void RecordAddInstances(AActor* Holder, const UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials, int32 FirstIndex, const TArray<FTransform>& Transforms, bool bCreatedHolder);
+
+	/** Revert every recorded batch, newest first, as one transaction, then start a new session; returns how many records were reverted */
+	int32 UndoSession(UWorld* World, FString& OutError);
+
+	/** Apply every recorded batch in order to another world, such as a copy of the level, as one transaction; returns how many records were applied */
+	int32 Replay(UWorld* World, FString& OutError) const;
+
+	/** Write the whole journal to a file */
+	bool SaveToFile(const FString& Path, FString& OutError) const;
+
+	/** Replace the journal with one read from a file; a batch cut short by a crash is left out */
+	bool LoadFromFile(const FString& Path, FString& OutError);
+
+	/** Drop every record and start a new session */
+	void Reset();
+
+	const FGuid& GetSessionId() const { return SessionId; }
+	int32 GetNumBatches() const { return NumBatches; }
+	int32 GetNumRecords() const { return RecordOffsets.Num(); }
+
+	/** Size of the record stream in bytes */
+	int64 GetDataSize() const { return Data.Num(); }
+
+	/** Identifies journal files */
+	static constexpr uint32 FileMagic = 0x4A454353; // "SCEJ"
+	static constexpr uint32 FileVersion = 2;
+
+private:
+	struct FRecord;
+	struct FApplyContext;
+
+	/** Id of a name or actor, adding a definition record the first time it is seen */
+	int32 InternName(const FString& Name);
+	int32 InternActor(AActor* Actor);
+
+	/** Fill in what a spawn or destroy record needs to create the actor again */
+	void DescribeActor(AActor* Actor, FRecord& OutRecord);
+
+	/** Add the actor's and its components' values that differ from their archetypes to a destroy record */
+	void DescribeState(AActor* Actor, FRecord& OutRecord);
+
+	/** Set the values a destroy record kept on the actor spawned again from it */
+	void RestoreState(const FRecord& Record, AActor* Actor) const;
+
+	void WriteRecord(FRecord& Record);
+
+	/** One encoding for writing and reading, so the two can't drift apart */
+	static void SerializeRecord(FArchive& Ar, FRecord& Record);
+
+	/** Decode the record at an offset; false if the stream ends inside it */
+	bool ReadRecord(int32 Offset, FRecord& OutRecord) const;
+
+	/** Scan the record stream, rebuilding the record offsets and the name and actor tables; returns the length of the complete batches */
+	int32 IndexRecords();
+
+	/** Forget names and actors defined after the given counts */
+	void TruncateTables(int32 NumNames, int32 NumActors);
+
+	/** Apply one change record forwards (replay) or backwards (undo); false if its actor is gone or has changed since */
+	bool ApplyRecord(const FRecord& Record, FApplyContext& Context, bool bReverse) const;
+	AActor* ResolveActor(int32 ActorId, FApplyContext& Context) const;
+	AActor* SpawnFromRecord(const FRecord& Record, FApplyContext& Context, bool bKeepGuid) const;
+
+	bool AppendToFile();
+
+	FGuid SessionId;
+	FString OutputDirectory;
+	FString FilePath;
+
+	/** Every record, back to back; the file format after the header */
+	TArray<uint8> Data;
+
+	/** Where each record starts, so the stream can be walked backwards */
+	TArray<int32> RecordOffsets;
+
+	/** Stream length already written to the session file */
+	int32 WrittenSize = 0;
+
+	/** Stream length, record count and table sizes when the open batch started; BatchStart is INDEX_NONE when none is open */
+	int32 BatchStart = INDEX_NONE;
+	int32 BatchFirstRecord = 0;
+	int32 BatchFirstName = 0;
+	int32 BatchFirstActor = 0;
+	bool bBatchHasChanges = false;
+	int32 NumBatches = 0;
+
+	/** Interned names by id, and their ids; case-insensitive like the object paths and FNames they hold */
+	TArray<FString> Names;
+	TMap<FString, int32> NameIds;
+
+	/** Interned actors by id: GUID, object name to fall back on, and the live actor while this session recorded it */
+	TArray<FGuid> ActorGuids;
+	TArray<FName> ActorNames;
+	TMap<FGuid, int32> ActorIds;
+	TArray<TWeakObjectPtr<AActor>> Actors;
+};
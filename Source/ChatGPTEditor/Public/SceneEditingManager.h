@@ -6,6 +6,11 @@
 #include "SceneEditingTypes.h"
 
 class UWorld;
+class UStaticMesh;
+class UMaterialInterface;
+class UHierarchicalInstancedStaticMeshComponent;
+class FSceneActorIndex;
+class FSceneEditJournal;
 
 /**
  * Scene editing manager - handles all level design and actor manipulation operations
@@ -20,39 +25,110 @@ public:
 	/** Parse natural language command into scene editing actions */
 	TArray<FSceneEditAction> ParseCommand(const FString& Command);
 
-	/** Execute scene editing actions (with preview and confirmation) */
+	/** Execute scene editing actions; a preview only resolves them and audits what they would do */
 	bool ExecuteActions(const TArray<FSceneEditAction>& Actions, UWorld* World, bool bPreviewOnly = false);
 
+	/** Resolve actions against the world without changing it: affected actors, resulting transforms and property changes. Every action sees the world as it is before any of them runs. */
+	FSceneEditPlan PlanActions(const TArray<FSceneEditAction>& Actions, UWorld* World);
+
+	/** Resolve a single action; see PlanActions */
+	FSceneEditActionPlan PlanAction(const FSceneEditAction& Action, UWorld* World);
+
+	/** Apply a plan as one undoable transaction, reusing the actors and transforms it resolved instead of querying the world again */
+	bool ExecutePlan(const FSceneEditPlan& Plan);
+
 	/** Spawn actors based on action */
 	TArray<AActor*> SpawnActors(const FSceneEditAction& Action, UWorld* World);
 
+	/** Add one instance per requested item to the shared instanced actor for the action's mesh; returns that actor */
+	AActor* SpawnInstances(const FSceneEditAction& Action, UWorld* World, int32& OutNumInstances);
+
+	/** Whether a spawn action will be placed as instances rather than actors */
+	bool ShouldSpawnInstanced(const FSceneEditAction& Action) const;
+
+	/** Replace matching static mesh actors with instances, one instanced actor per mesh and material set */
+	TArray<FString> ConvertActorsToInstances(const FSceneEditAction& Action, UWorld* World);
+
 	/** Delete actors based on action */
 	TArray<FString> DeleteActors(const FSceneEditAction& Action, UWorld* World);
 
 	/** Move actors based on action */
 	TArray<FString> MoveActors(const FSceneEditAction& Action, UWorld* World);
 
-	/** Modify actor properties based on action */
+	/** Set the action's property path to its value on every matching actor that has it */
 	TArray<FString> ModifyActorProperties(const FSceneEditAction& Action, UWorld* World);
 
-	/** Get actors matching a search pattern */
+	/** Get actors matching a search pattern: an actor type ("lights", "props", "all") or "tag:", "label:" or "folder:" followed by a name */
 	TArray<AActor*> FindActorsByPattern(const FString& Pattern, UWorld* World);
 
+	/** Actors an action applies to: its search pattern, limited to its region when one is set */
+	TArray<AActor*> FindActorsForAction(const FSceneEditAction& Action, UWorld* World);
+
+	/** Whether an actor matches a search pattern, as FindActorsByPattern would select it */
+	bool MatchesPattern(const AActor* Actor, const FString& Pattern) const;
+
+	/** Resolve a region's anchor to a world location; false if the anchor isn't available */
+	bool ResolveRegionCenter(const FSceneEditRegion& Region, UWorld* World, FVector& OutCenter);
+
+	/** Event-maintained actor lookup tables for a world; replaced when the world changes */
+	FSceneActorIndex& GetActorIndex(UWorld* World);
+
+	/** Deltas of every plan executed this session, for undoing the whole session or replaying it in another level */
+	FSceneEditJournal& GetJournal();
+
+	/** Find the instanced actor for a mesh and material set, creating it if none exists */
+	UHierarchicalInstancedStaticMeshComponent* FindOrCreateInstanceComponent(UWorld* World, UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials, bool* bOutCreated = nullptr);
+
+	/** Release the actor index and its engine delegates; called on module shutdown */
+	void Shutdown();
+
 	/** Find PlayerStart location in the world */
 	FVector FindPlayerStartLocation(UWorld* World);
 
+	/** Static mesh spawns of at least this many items use instancing in Auto mode */
+	static constexpr int32 AutoInstancingThreshold = 10;
+
+	/** Radius of "near ..." and "in this room" regions that don't give one */
+	static constexpr double DefaultRegionRadius = 1000.0;
+
+	/** Actors sharing a mesh are only converted when there are at least this many */
+	static constexpr int32 MinActorsToConvert = 2;
+
+	/** Tag on the actors that own instances created by the scene editor */
+	static const FName InstancedActorTag;
+
 private:
-	FSceneEditingManager() = default;
+	FSceneEditingManager();
+	~FSceneEditingManager();
+
+	/** Helper to map a parsed actor type to the class to spawn */
+	UClass* ResolveSpawnClass(const FString& ActorType) const;
+
+	/** Helper to find where a spawn action starts placing items: PlayerStart, the viewport or its explicit location */
+	FVector ResolveSpawnLocation(const FSceneEditAction& Action, UWorld* World);
+
+	/** Helper to load the mesh for a spawn action; null when it names no shape */
+	UStaticMesh* ResolveSpawnMesh(const FSceneEditAction& Action) const;
+
+	/** Helpers to fill in a plan for each kind of action */
+	void PlanSpawn(FSceneEditActionPlan& Plan, UWorld* World);
+	void PlanTargets(FSceneEditActionPlan& Plan, UWorld* World);
+	void PlanConvert(FSceneEditActionPlan& Plan, UWorld* World);
 
-	/** Helper to parse actor type from command */
-	FString ParseActorType(const FString& Command);
+	/** Helpers to apply a resolved plan; actors removed since it was made are skipped */
+	TArray<AActor*> ApplySpawnActors(const FSceneEditActionPlan& Plan, UWorld* World);
+	AActor* ApplySpawnInstances(const FSceneEditActionPlan& Plan, UWorld* World, int32& OutNumInstances);
+	TArray<FString> ApplyDelete(const FSceneEditActionPlan& Plan, UWorld* World);
+	TArray<FString> ApplyMove(const FSceneEditActionPlan& Plan, UWorld* World);
+	TArray<FString> ApplyModify(const FSceneEditActionPlan& Plan, UWorld* World);
+	TArray<FString> ApplyConvert(const FSceneEditActionPlan& Plan, UWorld* World);
 
-	/** Helper to parse count from command */
-	int32 ParseCount(const FString& Command);
+	/** Destroy actors with one selection change and one transaction record per level; returns how many were destroyed */
+	int32 DestroyActorsInBulk(UWorld* World, const TArray<AActor*>& Actors);
 
-	/** Helper to parse location from command */
-	FVector ParseLocation(const FString& Command, UWorld* World);
+	/** Index for the world last queried */
+	TUniquePtr<FSceneActorIndex> ActorIndex;
 
-	/** Helper to parse movement offset from command */
-	FVector ParseMovementOffset(const FString& Command);
+	/** Created on first use, writing to Saved/ChatGPTEditor/Journal */
+	TUniquePtr<FSceneEditJournal> Journal;
 };
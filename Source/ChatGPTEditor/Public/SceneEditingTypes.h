@@ -4,6 +4,11 @@
 
 #include "CoreMinimal.h"
 
+class AActor;
+class UWorld;
+class UStaticMesh;
+class UMaterialInterface;
+
 /**
  * Types of scene editing operations
  * Note: Using plain C++ enum instead of UENUM as these are editor-only types
@@ -15,7 +20,103 @@ enum class ESceneEditOperation : uint8
 	SpawnActor,
 	DeleteActor,
 	MoveActor,
-	ModifyProperty
+	ModifyProperty,
+	ConvertToInstances
+};
+
+/**
+ * How spawned static meshes are placed in the level
+ */
+enum class ESceneSpawnMode : uint8
+{
+	/** Instances for large static mesh spawns, actors otherwise */
+	Auto,
+
+	/** One actor per item */
+	Actors,
+
+	/** One instance per item in a shared instanced static mesh actor */
+	Instanced
+};
+
+/**
+ * How the items of one spawn are laid out
+ */
+enum class EScenePlacementPattern : uint8
+{
+	/** A line along +X, Spacing apart */
+	Row,
+
+	/** Rows of Columns items (square when Columns is 0), Spacing apart */
+	Grid,
+
+	/** Evenly around a circle of Radius, facing outwards */
+	Ring,
+
+	/** Evenly along a curve through SplinePoints */
+	Spline,
+
+	/** Random points in a disk of Radius, at least Spacing apart */
+	Scatter,
+
+	/** Scatter, dropped onto the surface below and aligned to it */
+	SurfaceScatter
+};
+
+/**
+ * Parameters of a placement pattern; positions are generated around the spawn location
+ */
+struct FScenePlacementSettings
+{
+	EScenePlacementPattern Pattern = EScenePlacementPattern::Row;
+
+	/** Distance between neighbours; the minimum distance for scatters */
+	double Spacing = 100.0;
+
+	double Radius = 1000.0;
+
+	int32 Columns = 0;
+
+	/** World space control points for Spline */
+	TArray<FVector> SplinePoints;
+
+	/** Scatters with the same seed and settings give the same points */
+	int32 Seed = 0;
+
+	/** Trace down from each point and place it on the first surface hit */
+	bool bSnapToGround = false;
+};
+
+/**
+ * What a location in a command is measured from; resolved when the action runs
+ */
+enum class ESceneLocationAnchor : uint8
+{
+	None,
+
+	/** Coordinates given in the command */
+	Explicit,
+
+	/** The level's PlayerStart */
+	PlayerStart,
+
+	/** The active level viewport camera ("here", "this room") */
+	ViewportCamera
+};
+
+/**
+ * Spatial restriction on the actors an action applies to
+ */
+struct FSceneEditRegion
+{
+	ESceneLocationAnchor Anchor = ESceneLocationAnchor::None;
+
+	/** Center for Explicit anchors */
+	FVector Location = FVector::ZeroVector;
+
+	double Radius = 0.0;
+
+	bool IsSet() const { return Anchor != ESceneLocationAnchor::None; }
 };
 
 /**
@@ -29,20 +130,93 @@ struct FSceneEditAction
 	FString ActorClass;
 	FVector Location = FVector::ZeroVector;
 	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Property path for ModifyProperty ("LightComponent.Intensity", or "Color" for a light's color) and its value in Unreal text format */
 	FString PropertyName;
 	FString PropertyValue;
 	int32 Count = 1;
+	FString MeshPath;
+	ESceneSpawnMode SpawnMode = ESceneSpawnMode::Auto;
+	FScenePlacementSettings Placement;
 	FString SearchPattern;
+	FSceneEditRegion Region;
 	FString Description;
 };
 
+/**
+ * One actor a planned action changes, with its state before and after
+ */
+struct FSceneEditActorChange
+{
+	TWeakObjectPtr<AActor> Actor;
+	FString ActorName;
+	FTransform OldTransform = FTransform::Identity;
+	FTransform NewTransform = FTransform::Identity;
+
+	/** Property values before and after, for property changes */
+	FString OldValue;
+	FString NewValue;
+};
+
+/**
+ * Static mesh actors a conversion replaces with one set of instances
+ */
+struct FSceneEditInstanceGroup
+{
+	TWeakObjectPtr<UStaticMesh> Mesh;
+	TArray<TWeakObjectPtr<UMaterialInterface>> Materials;
+
+	/** Indices into the plan's Changes */
+	TArray<int32> ChangeIndices;
+};
+
+/**
+ * An action resolved against the world without changing it
+ */
+struct FSceneEditActionPlan
+{
+	FSceneEditAction Action;
+
+	/** Actors the action moves, modifies, deletes or converts; empty for spawns */
+	TArray<FSceneEditActorChange> Changes;
+
+	/** Where each spawned item goes */
+	TArray<FTransform> SpawnTransforms;
+	TWeakObjectPtr<UClass> SpawnClass;
+	TWeakObjectPtr<UStaticMesh> SpawnMesh;
+	bool bSpawnInstanced = false;
+
+	/** Conversions only */
+	TArray<FSceneEditInstanceGroup> InstanceGroups;
+
+	/** Color property changes set */
+	FLinearColor Color = FLinearColor::White;
+
+	/** Why the action will do less than asked, if it will */
+	FString Warning;
+
+	int32 NumAffected() const { return Action.Operation == ESceneEditOperation::SpawnActor ? SpawnTransforms.Num() : Changes.Num(); }
+};
+
+/**
+ * A batch of actions resolved against one world. Executing a plan reuses what was resolved
+ * for the preview instead of querying the world again.
+ */
+struct FSceneEditPlan
+{
+	TWeakObjectPtr<UWorld> World;
+	TArray<FSceneEditActionPlan> Actions;
+};
+
 /**
  * Represents an audit log entry for scene editing operations
- * Note: Currently in-memory only. If persistent storage is needed,
- * convert to USTRUCT with UPROPERTY macros or implement custom serialization.
+ * The most recent entries are kept in memory; older ones are spilled to disk segments by FAuditLogger.
  */
 struct FAuditLogEntry
 {
+	/** Position in the session's entries, counting from 0; also the cursor for paged queries */
+	int64 Sequence = INDEX_NONE;
+
 	FDateTime Timestamp;
 	FString UserCommand;
 	FString OperationType;
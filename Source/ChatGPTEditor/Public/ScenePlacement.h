@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneEditingTypes.h"
+
+class UWorld;
+
+/**
+ * Placement positions in structure-of-arrays form. Generators and ground traces run over contiguous
+ * components, which the compiler can vectorize, and nothing becomes a transform until the end.
+ */
+struct CHATGPTEDITOR_API FScenePlacementBatch
+{
+	TArray<double> X;
+	TArray<double> Y;
+	TArray<double> Z;
+
+	/** Degrees about Z, added to the spawn rotation */
+	TArray<float> Yaw;
+
+	/** Surface normals from ground snapping; empty unless items are aligned to the surface */
+	TArray<FVector> Normals;
+
+	int32 Num() const { return X.Num(); }
+
+	/** Resize every component, leaving values uninitialized */
+	void SetNum(int32 Count);
+
+	void ToTransforms(const FRotator& BaseRotation, TArray<FTransform>& OutTransforms) const;
+};
+
+/**
+ * Placement patterns shared by scene edit spawns and the spawn_actor tool
+ */
+class CHATGPTEDITOR_API FScenePlacement
+{
+public:
+	/** Fill a batch with Count positions from Origin, or along the spline points; scatters stop early once the area is full */
+	static void Generate(const FScenePlacementSettings& Settings, const FVector& Origin, int32 Count, FScenePlacementBatch& OutBatch);
+
+	/** Move every position onto the first surface below it, tracing in parallel batches; returns how many hit. Game thread only. */
+	static int32 SnapToGround(UWorld* World, FScenePlacementBatch& Batch, bool bRecordNormals);
+
+	/** Generate, snap when the settings ask for it, and convert to transforms */
+	static void MakeTransforms(UWorld* World, const FScenePlacementSettings& Settings, const FVector& Origin, const FRotator& Rotation, int32 Count, TArray<FTransform>& OutTransforms);
+
+	/** Pattern for a name ("grid", "ring", "scatter"); false if unknown */
+	static bool ParsePattern(FStringView Name, EScenePlacementPattern& OutPattern);
+
+	static const TCHAR* GetPatternName(EScenePlacementPattern Pattern);
+
+	/** Ground traces start this far above each point... */
+	static constexpr double TraceUpDistance = 1000.0;
+
+	/** ...and end this far below it */
+	static constexpr double TraceDownDistance = 100000.0;
+
+	/** Positions traced per parallel task */
+	static constexpr int32 TraceBatchSize = 256;
+
+	/** Scatter lookup grids are capped at this many cells a side; larger areas get a coarser minimum distance */
+	static constexpr int32 MaxScatterGridSize = 2048;
+};
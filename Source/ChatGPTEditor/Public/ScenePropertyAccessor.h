@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A dotted property path ("LightComponent.Intensity", "LightComponent.LightColor.R") resolved once for
+ * a class into its chain of FProperty steps. Steps through object properties follow the actor's own
+ * components and subobjects, steps through structs stay in the same object; the last step is the
+ * value, which must be editable on instances as it would be in the Details panel.
+ *
+ * Accessors are cached per class and path, so a batch over thousands of actors resolves each path
+ * once per class and then only walks pointers.
+ */
+class CHATGPTEDITOR_API FScenePropertyAccessor
+{
+public:
+	/** Accessor for a path on a class; null with OutError set if the path doesn't name an editable property. Game thread only. */
+	static TSharedPtr<const FScenePropertyAccessor> Find(const UClass* Class, const FString& Path, FString& OutError);
+
+	/** Drop every cached accessor */
+	static void ResetCache();
+
+	/** Object holding the value (the root or one of its subobjects) and the value's address; false if a subobject along the path is missing */
+	bool Resolve(UObject* Root, UObject*& OutOwner, void*& OutValue) const;
+
+	/** Current value of the property on Root in Unreal text format */
+	bool GetValueText(UObject* Root, FString& OutText) const;
+
+	/** Import text into a detached value to check it parses; returns the value's canonical text */
+	bool NormalizeValueText(const FString& Text, FString& OutText) const;
+
+	/** The property that is changed */
+	FProperty* GetProperty() const { return Steps.Last().Property; }
+
+	/** Property of the owning object that contains the value: the value itself, or the outermost struct around it */
+	FProperty* GetMemberProperty() const { return Steps[MemberStep].Property; }
+
+	const FString& GetPath() const { return Path; }
+
+private:
+	enum class EStepKind : uint8
+	{
+		/** Follow an object pointer to a subobject of the root */
+		Object,
+
+		/** Step into a struct held inline */
+		Struct,
+
+		/** The value */
+		Value
+	};
+
+	struct FStep
+	{
+		FProperty* Property = nullptr;
+		EStepKind Kind = EStepKind::Value;
+
+		/** Struct or class the property belongs to, and its first field when resolved; a mismatch means it was recompiled */
+		TWeakObjectPtr<const UStruct> Owner;
+		const FField* OwnerFirstField = nullptr;
+	};
+
+	bool IsCurrent() const;
+
+	FString Path;
+	TArray<FStep, TInlineAllocator<4>> Steps;
+
+	/** First step after the last object hop */
+	int32 MemberStep = 0;
+};
@@ -0,0 +1,92 @@
+#!/bin/bash
+# Headless MCP startup benchmark - Linux/macOS
+# Compares the ChatGPTEditorMCP commandlet against a full editor launch:
+#   - commandlet: wall time until the first "initialize" response over stdio, plus peak RSS
+#   - editor:     wall time for a -nullrhi editor to start and quit, plus peak RSS
+# Usage: UE_ROOT=/path/to/UE ./scripts/mcp_headless_benchmark.sh /path/to/Project.uproject
+
+set -e
+
+PROJECT="$1"
+if [ -z "$PROJECT" ] || [ ! -f "$PROJECT" ]; then
+    echo "Usage: UE_ROOT=/path/to/UE $0 /path/to/Project.uproject"
+    exit 1
+fi
+
+if [ -z "$UE_ROOT" ]; then
+    echo "UE_ROOT is not set"
+    exit 1
+fi
+
+EDITOR_CMD="$UE_ROOT/Engine/Binaries/Linux/UnrealEditor-Cmd"
+if [ ! -x "$EDITOR_CMD" ]; then
+    EDITOR_CMD="$UE_ROOT/Engine/Binaries/Mac/UnrealEditor-Cmd"
+fi
+if [ ! -x "$EDITOR_CMD" ]; then
+    echo "UnrealEditor-Cmd not found under $UE_ROOT"
+    exit 1
+fi
+
+INIT_REQUEST='{"jsonrpc":"2.0","id":1,"method":"initialize","params":{}}'
+COMMON_ARGS="-nullrhi -unattended -nosplash -nopause"
+
+# Peak resident set size (MB) of a process, sampled until it exits
+watch_peak_rss() {
+    local pid=$1
+    local peak=0
+    while kill -0 "$pid" 2>/dev/null; do
+        local rss
+        rss=$(ps -o rss= -p "$pid" 2>/dev/null | tr -d ' ')
+        if [ -n "$rss" ] && [ "$rss" -gt "$peak" ]; then
+            peak=$rss
+        fi
+        sleep 0.2
+    done
+    echo $((peak / 1024))
+}
+
+echo "=== Headless MCP commandlet ==="
+FIFO_DIR=$(mktemp -d)
+mkfifo "$FIFO_DIR/in" "$FIFO_DIR/out"
+
+START=$(date +%s.%N)
+"$EDITOR_CMD" "$PROJECT" -run=ChatGPTEditorMCP $COMMON_ARGS < "$FIFO_DIR/in" > "$FIFO_DIR/out" 2>/dev/null &
+MCP_PID=$!
+watch_peak_rss "$MCP_PID" > "$FIFO_DIR/rss" &
+WATCH_PID=$!
+
+exec 3> "$FIFO_DIR/in"
+echo "$INIT_REQUEST" >&3
+read -r RESPONSE < "$FIFO_DIR/out"
+READY=$(date +%s.%N)
+
+# Closing stdin ends the stdio session
+exec 3>&-
+wait "$MCP_PID" || true
+wait "$WATCH_PID" || true
+
+COMMANDLET_SECONDS=$(echo "$READY - $START" | bc)
+COMMANDLET_RSS=$(cat "$FIFO_DIR/rss")
+rm -rf "$FIFO_DIR"
+
+if [[ "$RESPONSE" != *'"protocolVersion"'* ]]; then
+    echo "Unexpected initialize response: $RESPONSE"
+    exit 1
+fi
+echo "First response after ${COMMANDLET_SECONDS}s, peak RSS ${COMMANDLET_RSS} MB"
+
+echo ""
+echo "=== Full editor (start + quit) ==="
+START=$(date +%s.%N)
+"$EDITOR_CMD" "$PROJECT" $COMMON_ARGS -ExecCmds="QUIT_EDITOR" > /dev/null 2>&1 &
+EDITOR_PID=$!
+EDITOR_RSS=$(watch_peak_rss "$EDITOR_PID")
+wait "$EDITOR_PID" || true
+EDITOR_SECONDS=$(echo "$(date +%s.%N) - $START" | bc)
+echo "Editor round trip ${EDITOR_SECONDS}s, peak RSS ${EDITOR_RSS} MB"
+
+echo ""
+echo "=== Summary ==="
+printf "%-12s %10s %12s\n" "Mode" "Seconds" "Peak RSS MB"
+printf "%-12s %10.2f %12s\n" "commandlet" "$COMMANDLET_SECONDS" "$COMMANDLET_RSS"
+printf "%-12s %10.2f %12s\n" "editor" "$EDITOR_SECONDS" "$EDITOR_RSS"